@@ -108,6 +108,16 @@ namespace {
 		return target.IsTargetable();
 	}
 
+	// Check if a ship should look for a new target. Each ship only switches
+	// targets twice a second, so that it can focus on damaging one particular ship.
+	bool NeedsNewTarget(const Ship &ship, const Ship *target, bool isTargetTurn)
+	{
+		const Personality &personality = ship.GetPersonality();
+		return isTargetTurn || !target || target->IsDestroyed() || (target->IsDisabled() &&
+				(personality.Disables() || (!FighterHitHelper::IsValidTarget(target) && !personality.IsVindictive())))
+				|| (target->IsFleeing() && personality.IsMerciful()) || !target->IsTargetable();
+	}
+
 	double AngleDiff(double a, double b)
 	{
 		a = abs(a - b);
@@ -386,6 +396,35 @@ namespace {
 
 	// If a ship's velocity is below this value, the ship is considered stopped.
 	constexpr double VELOCITY_ZERO = .001;
+
+	// Get the event bits recorded for the given key, or 0 if there are none.
+	template<class Key>
+	int GetRecord(const vector<pair<Key, int>> &records, const Key &key)
+	{
+		for(const auto &it : records)
+			if(it.first == key)
+				return it.second;
+		return 0;
+	}
+
+	// Add event bits to the record for the given key.
+	template<class Key>
+	void AddRecord(vector<pair<Key, int>> &records, const Key &key, int type)
+	{
+		for(auto &it : records)
+			if(it.first == key)
+			{
+				it.second |= type;
+				return;
+			}
+		records.emplace_back(key, type);
+	}
+
+	void AddScan(vector<const Ship *> &scans, const Ship *target)
+	{
+		if(find(scans.begin(), scans.end(), target) == scans.end())
+			scans.push_back(target);
+	}
 }
 
 
@@ -607,20 +646,24 @@ void AI::UpdateEvents(const list<ShipEvent> &events)
 		if(!target)
 			continue;
 
+		// Giving the actor a slot may move the target's records.
+		const ShipId targetId = GetId(GetState(*target));
 		if(event.Actor())
 		{
-			actions[event.Actor()][target] |= event.Type();
+			ShipState &actorState = GetState(*event.Actor());
+			AddRecord(actorState.actions, targetId, event.Type());
 			if(event.TargetGovernment())
-				notoriety[event.Actor()][event.TargetGovernment()] |= event.Type();
+				AddRecord(actorState.notoriety, event.TargetGovernment(), event.Type());
 		}
 
 		const auto &actorGovernment = event.ActorGovernment();
 		if(actorGovernment)
 		{
-			governmentActions[actorGovernment][target] |= event.Type();
+			ShipState &targetState = shipStates[targetId.slot];
+			AddRecord(targetState.governmentActions, actorGovernment, event.Type());
 			if(actorGovernment->IsPlayer() && event.TargetGovernment())
 			{
-				int &bitmap = playerActions[target];
+				int &bitmap = targetState.playerActions;
 				int newActions = event.Type() - (event.Type() & bitmap);
 				bitmap |= event.Type();
 				// If you provoke the same ship twice, it should have an effect both times.
@@ -638,26 +681,17 @@ void AI::UpdateEvents(const list<ShipEvent> &events)
 // the player has entered a new one.
 void AI::Clean()
 {
-	// Records of what various AI ships and factions have done.
-	actions.clear();
-	notoriety.clear();
-	governmentActions.clear();
+	// Records of what various AI ships and factions have done. Ships that are
+	// waiting for help keep their slot; all the others are released.
+	for(ShipState &state : shipStates)
+		state.Clean();
+	for(uint32_t slot = 0; slot < shipStates.size(); ++slot)
+		if(shipStates[slot].ship && !shipStates[slot].hasHelper)
+			ReleaseSlot(slot);
 	scanPermissions.clear();
-	playerActions.clear();
-	swarmCount.clear();
-	fenceCount.clear();
-	cargoScans.clear();
-	outfitScans.clear();
-	scanTime.clear();
-	miningAngle.clear();
-	miningRadius.clear();
-	miningTime.clear();
-	appeasementThreshold.clear();
-	boarders.clear();
 	// Records for formations flying around lead ships and other objects.
 	formations.clear();
 	// Records that affect the combat behavior of various governments.
-	shipStrength.clear();
 	enemyStrength.clear();
 	allyStrength.clear();
 }
@@ -668,7 +702,11 @@ void AI::Clean()
 // when the player lands, but not when they change systems.
 void AI::ClearOrders()
 {
-	helperList.clear();
+	for(ShipState &state : shipStates)
+	{
+		state.hasHelper = false;
+		state.helper.reset();
+	}
 	orders.clear();
 }
 
@@ -678,28 +716,21 @@ void AI::Step(Command &activeCommands)
 {
 	// First, figure out the comparative strengths of the present governments.
 	const System *playerSystem = player.GetSystem();
+	UpdateShipSlots();
 	map<const Government *, int64_t> strength;
 	UpdateStrengths(strength, playerSystem);
 	CacheShipLists();
 
 	// Update the counts of how long ships have been outside the "invisible fence."
-	// If a ship ceases to exist, this also ensures that it will be removed from
-	// the fence count map after a few seconds.
-	for(auto it = fenceCount.begin(); it != fenceCount.end(); )
-	{
-		it->second -= FENCE_DECAY;
-		if(it->second < 0)
-			it = fenceCount.erase(it);
-		else
-			++it;
-	}
+	for(ShipState &state : shipStates)
+		state.fenceCount = max(state.fenceCount - FENCE_DECAY, -1);
 	for(const auto &it : ships)
 	{
 		const System *system = it->GetActualSystem();
 		if(system && it->Position().Length() >= system->InvisibleFenceRadius())
 		{
-			int &value = fenceCount[&*it];
-			value = min(FENCE_MAX, value + FENCE_DECAY + 1);
+			int &value = GetState(*it).fenceCount;
+			value = min(FENCE_MAX, max(value, 0) + FENCE_DECAY + 1);
 		}
 	}
 
@@ -711,14 +742,17 @@ void AI::Step(Command &activeCommands)
 
 	const Ship *flagship = player.Flagship();
 	step = (step + 1) & 31;
-	int targetTurn = 0;
 	int minerCount = 0;
 	const int maxMinerCount = minables.empty() ? 0 : 9;
 	bool opportunisticEscorts = !Preferences::Has("Turrets focus fire");
 	bool fightersRetreat = Preferences::Has("Damaged fighters retreat");
 	const int npcMaxMiningTime = GameData::GetGamerules().NPCMaxMiningTime();
+	// Plan the NPCs' decisions in parallel, then apply them in ship order.
+	PlanShips();
+	auto planIt = shipPlans.cbegin();
 	for(const auto &it : ships)
 	{
+		const ShipPlan &plan = *planIt++;
 		// A destroyed ship can't do anything.
 		if(it->IsDestroyed())
 			continue;
@@ -744,7 +778,7 @@ void AI::Step(Command &activeCommands)
 		{
 			// Attempt to find a friendly ship to render assistance.
 			if(!it->GetPersonality().IsDerelict())
-				AskForHelp(*it, isStranded, flagship);
+				AskForHelp(*it, isStranded, flagship, plan);
 
 			if(it->IsDisabled())
 			{
@@ -758,7 +792,7 @@ void AI::Step(Command &activeCommands)
 				if(personality.IsAppeasing())
 				{
 					double health = .5 * it->Shields() + it->Hull();
-					double &threshold = appeasementThreshold[it.get()];
+					double &threshold = GetState(*it).appeasementThreshold;
 					threshold = max((1. - health) + .1, threshold);
 				}
 				continue;
@@ -809,34 +843,29 @@ void AI::Step(Command &activeCommands)
 		shared_ptr<Flotsam> targetFlotsam = it->GetTargetFlotsam();
 		if(isPresent && it->IsYours() && targetFlotsam && FollowOrders(*it, command))
 			continue;
-		// Determine if this ship was trying to scan its previous target. If so, keep
-		// track of this ship's scan time and count.
-		if(isPresent && !it->IsYours())
-		{
-			// Assume that if the target is friendly, not disabled, of a different
-			// government to this ship, and this ship has scanning capabilities
-			// then it was attempting to scan the target. This isn't a perfect
-			// assumption, but should be good enough for now.
-			bool cargoScan = it->Attributes().Get("cargo scan power");
-			bool outfitScan = it->Attributes().Get("outfit scan power");
-			if((cargoScan || outfitScan) && target && !target->IsDisabled()
-				&& !target->GetGovernment()->IsEnemy(gov) && target->GetGovernment() != gov)
-			{
-				++scanTime[&*it];
-				if(it->CargoScanFraction() == 1.)
-					cargoScans[&*it].insert(&*target);
-				if(it->OutfitScanFraction() == 1.)
-					outfitScans[&*it].insert(&*target);
-			}
+		// If this ship was trying to scan its previous target, keep track of
+		// this ship's scan time and count.
+		if(plan.isScanning)
+		{
+			ShipState &state = GetState(*it);
+			++state.scanTime;
+			if(plan.finishedCargoScan)
+				AddScan(state.cargoScans, &*target);
+			if(plan.finishedOutfitScan)
+				AddScan(state.outfitScans, &*target);
 		}
 		if(isPresent && !personality.IsSwarming())
 		{
-			// Each ship only switches targets twice a second, so that it can
-			// focus on damaging one particular ship.
-			targetTurn = (targetTurn + 1) & 31;
-			if(targetTurn == step || !target || target->IsDestroyed() || (target->IsDisabled() &&
-					(personality.Disables() || (!FighterHitHelper::IsValidTarget(target.get()) && !personality.IsVindictive())))
-					|| (target->IsFleeing() && personality.IsMerciful()) || !target->IsTargetable())
+			// Every NPC in this system was planned, so use the target it picked then.
+			if(plan.isPlanned)
+			{
+				if(plan.hasNewTarget)
+				{
+					target = plan.newTarget ? plan.newTarget->shared_from_this() : nullptr;
+					it->SetTargetShip(target);
+				}
+			}
+			else if(NeedsNewTarget(*it, target.get(), plan.isTargetTurn))
 			{
 				target = FindTarget(*it);
 				it->SetTargetShip(target);
@@ -844,11 +873,19 @@ void AI::Step(Command &activeCommands)
 		}
 		if(isPresent)
 		{
-			AimTurrets(*it, firingCommands, it->IsYours() ? opportunisticEscorts : personality.IsOpportunistic());
-			if(targetAsteroid)
-				AutoFire(*it, firingCommands, *targetAsteroid);
+			// Use the planned aim and fire unless this ship's targets have changed since.
+			if(plan.hasFireCommand && plan.targetShip == it->GetTargetShip().get()
+					&& plan.targetAsteroid == targetAsteroid.get()
+					&& plan.isWaitingToJump == it->Commands().Has(Command::JUMP | Command::WAIT))
+				firingCommands = plan.command;
 			else
-				AutoFire(*it, firingCommands);
+			{
+				AimTurrets(*it, firingCommands, it->IsYours() ? opportunisticEscorts : personality.IsOpportunistic());
+				if(targetAsteroid)
+					AutoFire(*it, firingCommands, *targetAsteroid);
+				else
+					AutoFire(*it, firingCommands);
+			}
 		}
 
 		// If this ship is hyperspacing, or in the act of
@@ -905,7 +942,7 @@ void AI::Step(Command &activeCommands)
 			}
 			// Appeasing ships jettison cargo to distract their pursuers.
 			if(personality.IsAppeasing() && it->Cargo().Used())
-				DoAppeasing(it, &appeasementThreshold[it.get()]);
+				DoAppeasing(it, &GetState(*it).appeasementThreshold);
 		}
 
 		// If recruited to assist a ship, follow through on the commitment
@@ -966,7 +1003,7 @@ void AI::Step(Command &activeCommands)
 				it->SetParent(parent);
 			}
 			// Flock between allied, in-system ships.
-			DoSwarming(*it, command, target);
+			DoSwarming(*it, command, target, plan);
 			it->SetCommands(command);
 			it->SetCommands(firingCommands);
 			continue;
@@ -986,7 +1023,7 @@ void AI::Step(Command &activeCommands)
 		if(isPresent && personality.IsSurveillance() && !strandedWithHelper
 				&& (scanPermissions[gov] || it->IsSpecial()))
 		{
-			DoSurveillance(*it, command, target);
+			DoSurveillance(*it, command, target, plan);
 			it->SetCommands(command);
 			it->SetCommands(firingCommands);
 			continue;
@@ -1006,21 +1043,22 @@ void AI::Step(Command &activeCommands)
 			// Miners with free cargo space and available mining time should mine. Mission NPCs
 			// should mine even if there are other miners or they have been mining a while.
 			if(it->Cargo().Free() >= 5 && IsArmed(*it) && (it->IsSpecial()
-					|| (++miningTime[&*it] < npcMaxMiningTime && ++minerCount < maxMinerCount)))
+					|| (++GetState(*it).miningTime < npcMaxMiningTime && ++minerCount < maxMinerCount)))
 			{
 				if(it->HasBays())
 				{
 					command |= Command::DEPLOY;
 					Deploy(*it, false);
 				}
-				DoMining(*it, command);
+				DoMining(*it, command, plan);
 				it->SetCommands(command);
 				it->SetCommands(firingCommands);
 				continue;
 			}
 			// Fighters and drones should assist their parent's mining operation if they cannot
 			// carry ore, and the asteroid is near enough that the parent can harvest the ore.
-			if(it->CanBeCarried() && parent && miningTime[parent.get()] < 3601)
+			const ShipState *parentState = parent ? FindState(*parent) : nullptr;
+			if(it->CanBeCarried() && parent && (parentState ? parentState->miningTime : 0) < 3601)
 			{
 				const shared_ptr<Minable> &minable = parent->GetTargetAsteroid();
 				if(minable && minable->Position().Distance(parent->Position()) < 600.)
@@ -1241,6 +1279,13 @@ void AI::SetMousePosition(Point position)
 
 
 
+void AI::SetPlanningThreads(unsigned threads)
+{
+	planningThreads = threads;
+}
+
+
+
 // Get the in-system strength of each government's allies and enemies.
 int64_t AI::AllyStrength(const Government *government) const
 {
@@ -1300,90 +1345,108 @@ bool AI::CanPursue(const Ship &ship, const Ship &target) const
 		return true;
 
 	// Check if the target is beyond the "invisible fence" for this system.
-	const auto fit = fenceCount.find(&target);
-	if(fit == fenceCount.end())
-		return true;
-	else
-		return (fit->second != FENCE_MAX);
+	const ShipState *state = FindState(target);
+	return !state || state->fenceCount != FENCE_MAX;
 }
 
 
 
 // Check if the ship is being helped, and if not, ask for help.
-void AI::AskForHelp(Ship &ship, bool &isStranded, const Ship *flagship)
+void AI::AskForHelp(Ship &ship, bool &isStranded, const Ship *flagship, const ShipPlan &plan)
 {
 	bool needsFuel = NeedsFuel(ship);
 	bool needsEnergy = NeedsEnergy(ship);
 	if(HasHelper(ship, needsFuel, needsEnergy))
+	{
 		isStranded = true;
-	else if(!Random::Int(30))
+		return;
+	}
+
+	// Ask the helper picked when this ship was planned, if it was.
+	Ship *helper = plan.helper;
+	if(!plan.isPlanned && !Random::Int(30))
 	{
-		const Government *gov = ship.GetGovernment();
-		bool hasEnemy = false;
+		PlanRandom random(Random::Int());
+		helper = FindHelper(ship, flagship, random);
+	}
+	// A ship that was asked to help another ship earlier in this step can't help this one.
+	if(helper && ((helper->GetShipToAssist() && helper->GetShipToAssist().get() != &ship)
+			|| !CanHelp(ship, *helper, needsFuel, needsEnergy)))
+		helper = nullptr;
 
-		vector<Ship *> canHelp;
-		canHelp.reserve(ships.size());
-		for(const auto &helper : ships)
-		{
-			// Never ask yourself for help.
-			if(helper.get() == &ship)
-				continue;
+	if(helper)
+	{
+		helper->SetShipToAssist((&ship)->shared_from_this());
+		ShipState &state = GetState(ship);
+		state.hasHelper = true;
+		state.helper = helper->shared_from_this();
+		isStranded = true;
+	}
+	else
+		isStranded = false;
+}
 
-			// If any able enemies of this ship are in its system, it cannot call for help.
-			const System *system = ship.GetSystem();
-			if(helper->GetGovernment()->IsEnemy(gov) && flagship && system == flagship->GetSystem())
-			{
-				// Disabled, overheated, or otherwise untargetable ships pose no threat.
-				bool harmless = helper->IsDisabled() || (helper->IsOverheated() && helper->Heat() >= 1.1)
-						|| !helper->IsTargetable();
-				hasEnemy |= (system == helper->GetSystem() && !harmless);
-				if(hasEnemy)
-					break;
-			}
 
-			// Check if this ship is logically able to help.
-			// If the ship is already assisting someone else, it cannot help this ship.
-			if(helper->GetShipToAssist() && helper->GetShipToAssist().get() != &ship)
-				continue;
-			// If the ship is mining or chasing flotsam, it cannot help this ship.
-			if(helper->GetTargetAsteroid() || helper->GetTargetFlotsam())
-				continue;
-			// Your escorts only help other escorts, and your flagship never helps.
-			if((helper->IsYours() && !ship.IsYours()) || helper.get() == flagship)
-				continue;
-			// Your escorts should not help each other if already under orders.
-			auto foundOrders = orders.find(helper.get());
-			if(foundOrders != orders.end())
-			{
-				const OrderSet &helperOrders = foundOrders->second;
-				// If your own escorts become disabled, then your mining fleet
-				// should prioritize repairing escorts instead of mining or
-				// harvesting flotsam.
-				if(helper->IsYours() && ship.IsYours()
-						&& !(helperOrders.Has(Orders::Types::MINE) || helperOrders.Has(Orders::Types::HARVEST)))
-					continue;
-			}
 
-			// Check if this ship is physically able to help.
-			if(!CanHelp(ship, *helper, needsFuel, needsEnergy))
-				continue;
+// Pick a ship to ask for help, preferring fast ships. No ship can be asked if
+// any able enemies of this ship are present.
+Ship *AI::FindHelper(const Ship &ship, const Ship *flagship, PlanRandom &random) const
+{
+	bool needsFuel = NeedsFuel(ship);
+	bool needsEnergy = NeedsEnergy(ship);
+	const Government *gov = ship.GetGovernment();
 
-			// Prefer fast ships over slow ones.
-			canHelp.insert(canHelp.end(), 1 + .3 * helper->MaxVelocity(), helper.get());
-		}
+	vector<Ship *> canHelp;
+	canHelp.reserve(ships.size());
+	for(const auto &helper : ships)
+	{
+		// Never ask yourself for help.
+		if(helper.get() == &ship)
+			continue;
 
-		if(!hasEnemy && !canHelp.empty())
+		// If any able enemies of this ship are in its system, it cannot call for help.
+		const System *system = ship.GetSystem();
+		if(helper->GetGovernment()->IsEnemy(gov) && flagship && system == flagship->GetSystem())
 		{
-			Ship *helper = canHelp[Random::Int(canHelp.size())];
-			helper->SetShipToAssist((&ship)->shared_from_this());
-			helperList[&ship] = helper->shared_from_this();
-			isStranded = true;
+			// Disabled, overheated, or otherwise untargetable ships pose no threat.
+			bool harmless = helper->IsDisabled() || (helper->IsOverheated() && helper->Heat() >= 1.1)
+					|| !helper->IsTargetable();
+			if(system == helper->GetSystem() && !harmless)
+				return nullptr;
 		}
-		else
-			isStranded = false;
+
+		// Check if this ship is logically able to help.
+		// If the ship is already assisting someone else, it cannot help this ship.
+		if(helper->GetShipToAssist() && helper->GetShipToAssist().get() != &ship)
+			continue;
+		// If the ship is mining or chasing flotsam, it cannot help this ship.
+		if(helper->GetTargetAsteroid() || helper->GetTargetFlotsam())
+			continue;
+		// Your escorts only help other escorts, and your flagship never helps.
+		if((helper->IsYours() && !ship.IsYours()) || helper.get() == flagship)
+			continue;
+		// Your escorts should not help each other if already under orders.
+		auto foundOrders = orders.find(helper.get());
+		if(foundOrders != orders.end())
+		{
+			const OrderSet &helperOrders = foundOrders->second;
+			// If your own escorts become disabled, then your mining fleet
+			// should prioritize repairing escorts instead of mining or
+			// harvesting flotsam.
+			if(helper->IsYours() && ship.IsYours()
+					&& !(helperOrders.Has(Orders::Types::MINE) || helperOrders.Has(Orders::Types::HARVEST)))
+				continue;
+		}
+
+		// Check if this ship is physically able to help.
+		if(!CanHelp(ship, *helper, needsFuel, needsEnergy))
+			continue;
+
+		// Prefer fast ships over slow ones.
+		canHelp.insert(canHelp.end(), 1 + .3 * helper->MaxVelocity(), helper.get());
 	}
-	else
-		isStranded = false;
+
+	return canHelp.empty() ? nullptr : canHelp[random.Int(canHelp.size())];
 }
 
 
@@ -1392,7 +1455,8 @@ void AI::AskForHelp(Ship &ship, bool &isStranded, const Ship *flagship)
 bool AI::CanHelp(const Ship &ship, const Ship &helper, const bool needsFuel, const bool needsEnergy) const
 {
 	// A ship being assisted cannot assist.
-	if(helperList.find(&helper) != helperList.end())
+	const ShipState *helperState = FindState(helper);
+	if(helperState && helperState->hasHelper)
 		return false;
 
 	// Fighters, drones, and disabled / absent ships can't offer assistance.
@@ -1423,13 +1487,17 @@ bool AI::CanHelp(const Ship &ship, const Ship &helper, const bool needsFuel, con
 bool AI::HasHelper(const Ship &ship, const bool needsFuel, const bool needsEnergy)
 {
 	// Do we have an existing ship that was asked to assist?
-	if(helperList.find(&ship) != helperList.end())
+	ShipState *state = FindState(ship);
+	if(state && state->hasHelper)
 	{
-		shared_ptr<Ship> helper = helperList[&ship].lock();
+		shared_ptr<Ship> helper = state->helper.lock();
 		if(helper && helper->GetShipToAssist().get() == &ship && CanHelp(ship, *helper, needsFuel, needsEnergy))
 			return true;
 		else
-			helperList.erase(&ship);
+		{
+			state->hasHelper = false;
+			state->helper.reset();
+		}
 	}
 
 	return false;
@@ -1485,7 +1553,7 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 	// Ships with 'plunders' personality always destroy the ships they have boarded
 	// unless they also have either or both of the 'disables' or 'merciful' personalities.
 	if(oldTarget && person.Plunders() && !person.Disables() && !person.IsMerciful()
-			&& oldTarget->IsDisabled() && Has(ship, oldTarget, ShipEvent::BOARD))
+			&& oldTarget->IsDisabled() && Has(ship, *oldTarget, ShipEvent::BOARD))
 		return oldTarget;
 	shared_ptr<Ship> parentTarget;
 	if(ship.GetParent() && !ship.GetParent()->GetGovernment()->IsEnemy(gov))
@@ -1504,9 +1572,9 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 	bool canPlunder = person.Plunders() && ship.Cargo().Free() && !ship.CanBeCarried();
 	// Figure out how strong this ship is.
 	int64_t maxStrength = 0;
-	auto strengthIt = shipStrength.find(&ship);
-	if(!person.IsDaring() && strengthIt != shipStrength.end())
-		maxStrength = 2 * strengthIt->second;
+	const ShipState *state = FindState(ship);
+	if(!person.IsDaring() && state)
+		maxStrength = 2 * state->strength;
 
 	// Get a list of all targetable, hostile ships in this system.
 	const auto enemies = GetShipsList(ship, true);
@@ -1532,8 +1600,8 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 		// Unless this ship is "daring", it should not chase much stronger ships.
 		if(maxStrength && range > 1000. && !foe->IsDisabled())
 		{
-			const auto otherStrengthIt = shipStrength.find(foe);
-			if(otherStrengthIt != shipStrength.end() && otherStrengthIt->second > maxStrength)
+			const ShipState *foeState = FindState(*foe);
+			if(foeState && foeState->strength > maxStrength)
 				continue;
 		}
 
@@ -1543,7 +1611,7 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 
 		// Ships which only disable never target already-disabled ships.
 		if((person.Disables() || (!person.IsNemesis() && foe != oldTarget.get()))
-				&& foe->IsDisabled() && (!canPlunder || Has(ship, foe->shared_from_this(), ShipEvent::BOARD)))
+				&& foe->IsDisabled() && (!canPlunder || Has(ship, *foe, ShipEvent::BOARD)))
 			continue;
 
 		// Ships that don't (or can't) plunder strongly prefer active targets.
@@ -1552,10 +1620,11 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 		// While those that do, do so only if no "live" enemies are nearby.
 		else
 		{
-			if(any_of(boarders.begin(), boarders.end(), [&ship, &foe](auto &it)
-					{ return it.first != &ship && it.second == foe; }))
+			// Leave this target to any other ship that is already boarding it.
+			const ShipState *foeState = FindState(*foe);
+			if(foeState && foeState->boarderCount > (state && state->boarding == GetId(*foeState)))
 				continue;
-			range += 2000. * (2 * foe->IsDisabled() - !Has(ship, foe->shared_from_this(), ShipEvent::BOARD));
+			range += 2000. * (2 * foe->IsDisabled() - !Has(ship, *foe, ShipEvent::BOARD));
 		}
 
 		// Prefer to go after armed targets, especially if you're not a pirate.
@@ -1615,12 +1684,9 @@ shared_ptr<Ship> AI::FindNonHostileTarget(const Ship &ship) const
 
 	double cargoScan = ship.Attributes().Get("cargo scan power");
 	double outfitScan = ship.Attributes().Get("outfit scan power");
-	auto cargoScansIt = cargoScans.find(&ship);
-	auto outfitScansIt = outfitScans.find(&ship);
-	auto scanTimeIt = scanTime.find(&ship);
-	int shipScanCount = cargoScansIt != cargoScans.end() ? cargoScansIt->second.size() : 0;
-	shipScanCount += outfitScansIt != outfitScans.end() ? outfitScansIt->second.size() : 0;
-	int shipScanTime = scanTimeIt != scanTime.end() ? scanTimeIt->second : 0;
+	const ShipState *state = FindState(ship);
+	int shipScanCount = state ? state->cargoScans.size() + state->outfitScans.size() : 0;
+	int shipScanTime = state ? state->scanTime : 0;
 	if((cargoScan || outfitScan) && shipScanCount < maxScanCount && shipScanTime < forfeitTime)
 	{
 		// If this ship already has a target, and is in the process of scanning it, prioritise that,
@@ -1653,10 +1719,9 @@ shared_ptr<Ship> AI::FindNonHostileTarget(const Ship &ship) const
 			for(const auto &it : GetShipsList(ship, false))
 				if(it->GetGovernment() != gov)
 				{
-					auto ptr = it->shared_from_this();
 					// Scan friendly ships that are as-yet unscanned by this ship's government.
-					if((!cargoScan || Has(gov, ptr, ShipEvent::SCAN_CARGO))
-							&& (!outfitScan || Has(gov, ptr, ShipEvent::SCAN_OUTFITS)))
+					if((!cargoScan || Has(gov, *it, ShipEvent::SCAN_CARGO))
+							&& (!outfitScan || Has(gov, *it, ShipEvent::SCAN_OUTFITS)))
 						continue;
 
 					// Divide the distance by 10,000 to normalize to the scan range that
@@ -1665,7 +1730,7 @@ shared_ptr<Ship> AI::FindNonHostileTarget(const Ship &ship) const
 					if(range < closest)
 					{
 						closest = range;
-						target = std::move(ptr);
+						target = it->shared_from_this();
 					}
 				}
 		}
@@ -1904,25 +1969,25 @@ void AI::MoveIndependent(Ship &ship, Command &command)
 	else if(target && (gov->IsEnemy(target->GetGovernment()) || friendlyOverride))
 	{
 		bool shouldBoard = ship.Cargo().Free() && ship.GetPersonality().Plunders();
-		bool hasBoarded = Has(ship, target, ShipEvent::BOARD);
+		bool hasBoarded = Has(ship, *target, ShipEvent::BOARD);
 		if(shouldBoard && target->IsDisabled() && !hasBoarded)
 		{
 			if(ship.IsBoarding())
 				return;
 			MoveTo(ship, command, target->Position(), target->Velocity(), 40., .8);
 			command |= Command::BOARD;
-			boarders[&ship] = target.get();
+			SetBoarding(GetState(ship), target.get());
 		}
 		else
 		{
 			Attack(ship, command, *target);
-			boarders.erase(&ship);
+			SetBoarding(GetState(ship), nullptr);
 		}
 		return;
 	}
 	else
 	{
-		boarders.erase(&ship);
+		SetBoarding(GetState(ship), nullptr);
 		if(target)
 		{
 			// An AI ship that is targeting a non-hostile ship should scan it, or move on.
@@ -1935,8 +2000,8 @@ void AI::MoveIndependent(Ship &ship, Command &command)
 				ship.SetTargetShip(nullptr);
 			}
 			// Detarget if I cannot scan, or if I already scanned the ship.
-			else if((!cargoScan || Has(gov, target, ShipEvent::SCAN_CARGO))
-					&& (!outfitScan || Has(gov, target, ShipEvent::SCAN_OUTFITS)))
+			else if((!cargoScan || Has(gov, *target, ShipEvent::SCAN_CARGO))
+					&& (!outfitScan || Has(gov, *target, ShipEvent::SCAN_OUTFITS)))
 			{
 				target.reset();
 				ship.SetTargetShip(nullptr);
@@ -2991,18 +3056,21 @@ void AI::DoAppeasing(const shared_ptr<Ship> &ship, double *threshold) const
 
 
 // Find a target ship to flock around at high speed.
-void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target)
+void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target, const ShipPlan &plan)
 {
+	// Use the decision made when this ship was planned, unless its target has changed since.
+	bool isPlanned = plan.isPlanned && plan.targetShip == target.get();
 	// Find a new ship to target on average every 10 seconds, or if the current target
 	// is no longer eligible. If landing, release the old target so others can swarm it.
-	if(ship.IsLanding() || !target || !CanSwarm(ship, *target) || !Random::Int(600))
+	if(isPlanned ? plan.changesSwarmTarget
+			: (ship.IsLanding() || !target || !CanSwarm(ship, *target) || !Random::Int(600)))
 	{
 		if(target)
 		{
 			// Allow another swarming ship to consider the target.
-			auto sit = swarmCount.find(target.get());
-			if(sit != swarmCount.end() && sit->second > 0)
-				--sit->second;
+			ShipState *targetState = FindState(*target);
+			if(targetState && targetState->swarmCount > 0)
+				--targetState->swarmCount;
 			// Release the current target.
 			target.reset();
 			ship.SetTargetShip(target);
@@ -3011,23 +3079,17 @@ void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target)
 		if(ship.IsLanding())
 			return;
 
-		int lowestCount = 7;
-		// Consider swarming around non-hostile ships in the same system.
-		const auto others = GetShipsList(ship, false);
-		for(auto *other : others)
-			if(!other->GetPersonality().IsSwarming())
-			{
-				// Prefer to swarm ships that are not already being heavily swarmed.
-				int count = swarmCount[other] + Random::Int(4);
-				if(count < lowestCount)
-				{
-					target = other->shared_from_this();
-					lowestCount = count;
-				}
-			}
+		Ship *other = plan.swarmTarget;
+		if(!isPlanned)
+		{
+			PlanRandom random(Random::Int());
+			other = FindSwarmTarget(ship, random);
+		}
+		if(other)
+			target = other->shared_from_this();
 		ship.SetTargetShip(target);
 		if(target)
-			++swarmCount[target.get()];
+			++GetState(*target).swarmCount;
 	}
 	// If a friendly ship to flock with was not found, return to an available planet.
 	if(target)
@@ -3038,7 +3100,31 @@ void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target)
 
 
 
-void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
+// Pick a ship for a swarming ship to flock around.
+Ship *AI::FindSwarmTarget(const Ship &ship, PlanRandom &random) const
+{
+	Ship *target = nullptr;
+	int lowestCount = 7;
+	// Consider swarming around non-hostile ships in the same system.
+	const auto others = GetShipsList(ship, false);
+	for(auto *other : others)
+		if(!other->GetPersonality().IsSwarming())
+		{
+			// Prefer to swarm ships that are not already being heavily swarmed.
+			const ShipState *otherState = FindState(*other);
+			int count = (otherState ? otherState->swarmCount : 0) + random.Int(4);
+			if(count < lowestCount)
+			{
+				target = other;
+				lowestCount = count;
+			}
+		}
+	return target;
+}
+
+
+
+void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target, const ShipPlan &plan)
 {
 	const bool isStaying = ship.GetPersonality().IsStaying();
 	// Since DoSurveillance is called after target-seeking and firing, if this
@@ -3089,8 +3175,8 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 		bool outfitScan = ship.Attributes().Get("outfit scan power");
 		// If the pointer to the target ship exists, it is targetable and in-system.
 		const Government *gov = ship.GetGovernment();
-		bool mustScanCargo = cargoScan && !Has(gov, target, ShipEvent::SCAN_CARGO);
-		bool mustScanOutfits = outfitScan && !Has(gov, target, ShipEvent::SCAN_OUTFITS);
+		bool mustScanCargo = cargoScan && !Has(gov, *target, ShipEvent::SCAN_CARGO);
+		bool mustScanOutfits = outfitScan && !Has(gov, *target, ShipEvent::SCAN_OUTFITS);
 		if(!mustScanCargo && !mustScanOutfits)
 			ship.SetTargetShip(shared_ptr<Ship>());
 		else
@@ -3104,113 +3190,126 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 	}
 	else
 	{
-		const System *system = ship.GetSystem();
-		const Government *gov = ship.GetGovernment();
-
-		// Consider scanning any non-hostile ship in this system that your government hasn't scanned.
-		// A surveillance ship may only make up to 12 successful scans (6 ships scanned
-		// if the ship is using both scanners) and spend up to 5 minutes searching for
-		// scan targets. After that, stop scanning ship targets. This is so that scanning
-		// ships in high spawn rate systems don't build up over time, as they always have
-		// a new ship they can try to scan.
-		vector<Ship *> targetShips;
-		bool cargoScan = ship.Attributes().Get("cargo scan power");
-		bool outfitScan = ship.Attributes().Get("outfit scan power");
-		auto cargoScansIt = cargoScans.find(&ship);
-		auto outfitScansIt = outfitScans.find(&ship);
-		auto scanTimeIt = scanTime.find(&ship);
-		int shipScanCount = cargoScansIt != cargoScans.end() ? cargoScansIt->second.size() : 0;
-		shipScanCount += outfitScansIt != outfitScans.end() ? outfitScansIt->second.size() : 0;
-		int shipScanTime = scanTimeIt != scanTime.end() ? scanTimeIt->second : 0;
-		if((cargoScan || outfitScan) && shipScanCount < 12 && shipScanTime < 18000)
+		// Use the choice made when this ship was planned, if it was made then.
+		SurveillanceTarget next = plan.surveillanceTarget;
+		if(!plan.hasSurveillanceTarget)
 		{
-			for(const auto &it : GetShipsList(ship, false))
-				if(it->GetGovernment() != gov)
-				{
-					auto ptr = it->shared_from_this();
-					if((!cargoScan || Has(gov, ptr, ShipEvent::SCAN_CARGO))
-							&& (!outfitScan || Has(gov, ptr, ShipEvent::SCAN_OUTFITS)))
-						continue;
-
-					if(it->IsTargetable())
-						targetShips.emplace_back(it);
-				}
+			PlanRandom random(Random::Int());
+			next = FindSurveillanceTarget(ship, random);
 		}
-
-		// Consider scanning any planetary object in the system, if able.
-		vector<const StellarObject *> targetPlanets;
-		double atmosphereScan = ship.Attributes().Get("atmosphere scan");
-		if(atmosphereScan)
-			for(const StellarObject &object : system->Objects())
-				if(object.HasSprite() && !object.IsStar() && !object.IsStation())
-					targetPlanets.push_back(&object);
-
-		// If this ship can jump away, consider traveling to a nearby system.
-		vector<const System *> targetSystems;
-		// TODO: These ships cannot travel through wormholes?
-		if(ship.JumpsRemaining(false))
-		{
-			const auto &links = ship.JumpNavigation().HasJumpDrive() ?
-				system->JumpNeighbors(ship.JumpNavigation().JumpRange()) : system->Links();
-			for(const System *link : links)
-				if(!ship.IsRestrictedFrom(*link))
-					targetSystems.push_back(link);
-		}
-
-		unsigned total = targetShips.size() + targetPlanets.size() + targetSystems.size();
+		if(next.ship)
+			ship.SetTargetShip(next.ship->shared_from_this());
+		else if(next.stellar)
+			ship.SetTargetStellar(next.stellar);
+		else if(next.system)
+			ship.SetTargetSystem(next.system);
 		// If there is nothing for this ship to scan, have it patrol the entire system
 		// instead of drifting or stopping.
-		if(!total)
-		{
+		else
 			DoPatrol(ship, command);
-			return;
-		}
-		// Pick one of the valid surveillance targets at random to focus on.
-		unsigned index = Random::Int(total);
-		if(index < targetShips.size())
-			ship.SetTargetShip(targetShips[index]->shared_from_this());
+	}
+}
+
+
+
+// Pick something for a surveillance ship to scan or somewhere for it to go.
+AI::SurveillanceTarget AI::FindSurveillanceTarget(const Ship &ship, PlanRandom &random) const
+{
+	const System *system = ship.GetSystem();
+	const Government *gov = ship.GetGovernment();
+
+	// Consider scanning any non-hostile ship in this system that your government hasn't scanned.
+	// A surveillance ship may only make up to 12 successful scans (6 ships scanned
+	// if the ship is using both scanners) and spend up to 5 minutes searching for
+	// scan targets. After that, stop scanning ship targets. This is so that scanning
+	// ships in high spawn rate systems don't build up over time, as they always have
+	// a new ship they can try to scan.
+	vector<Ship *> targetShips;
+	bool cargoScan = ship.Attributes().Get("cargo scan power");
+	bool outfitScan = ship.Attributes().Get("outfit scan power");
+	const ShipState *state = FindState(ship);
+	int shipScanCount = state ? state->cargoScans.size() + state->outfitScans.size() : 0;
+	int shipScanTime = state ? state->scanTime : 0;
+	if((cargoScan || outfitScan) && shipScanCount < 12 && shipScanTime < 18000)
+	{
+		for(const auto &it : GetShipsList(ship, false))
+			if(it->GetGovernment() != gov)
+			{
+				if((!cargoScan || Has(gov, *it, ShipEvent::SCAN_CARGO))
+						&& (!outfitScan || Has(gov, *it, ShipEvent::SCAN_OUTFITS)))
+					continue;
+
+				if(it->IsTargetable())
+					targetShips.emplace_back(it);
+			}
+	}
+
+	// Consider scanning any planetary object in the system, if able.
+	vector<const StellarObject *> targetPlanets;
+	double atmosphereScan = ship.Attributes().Get("atmosphere scan");
+	if(atmosphereScan)
+		for(const StellarObject &object : system->Objects())
+			if(object.HasSprite() && !object.IsStar() && !object.IsStation())
+				targetPlanets.push_back(&object);
+
+	// If this ship can jump away, consider traveling to a nearby system.
+	vector<const System *> targetSystems;
+	// TODO: These ships cannot travel through wormholes?
+	if(ship.JumpsRemaining(false))
+	{
+		const auto &links = ship.JumpNavigation().HasJumpDrive() ?
+			system->JumpNeighbors(ship.JumpNavigation().JumpRange()) : system->Links();
+		for(const System *link : links)
+			if(!ship.IsRestrictedFrom(*link))
+				targetSystems.push_back(link);
+	}
+
+	SurveillanceTarget result;
+	unsigned total = targetShips.size() + targetPlanets.size() + targetSystems.size();
+	if(!total)
+		return result;
+	// Pick one of the valid surveillance targets at random to focus on.
+	unsigned index = random.Int(total);
+	if(index < targetShips.size())
+		result.ship = targetShips[index];
+	else
+	{
+		index -= targetShips.size();
+		if(index < targetPlanets.size())
+			result.stellar = targetPlanets[index];
 		else
-		{
-			index -= targetShips.size();
-			if(index < targetPlanets.size())
-				ship.SetTargetStellar(targetPlanets[index]);
-			else
-				ship.SetTargetSystem(targetSystems[index - targetPlanets.size()]);
-		}
+			result.system = targetSystems[index - targetPlanets.size()];
 	}
+	return result;
 }
 
 
 
-void AI::DoMining(Ship &ship, Command &command)
+void AI::DoMining(Ship &ship, Command &command, const ShipPlan &plan)
 {
 	// This function is only called for ships that are in the player's system.
 	// Update the radius that the ship is searching for asteroids at.
-	bool isNew = !miningAngle.contains(&ship);
-	Angle &angle = miningAngle[&ship];
-	if(isNew)
+	ShipState &state = GetState(ship);
+	Angle &angle = state.miningAngle;
+	if(!state.hasMiningAngle)
 	{
+		state.hasMiningAngle = true;
 		angle = Angle::Random();
-		miningRadius[&ship] = ship.GetSystem()->AsteroidBeltRadius();
+		state.miningRadius = ship.GetSystem()->AsteroidBeltRadius();
 	}
 	angle += Angle::Random(1.) - Angle::Random(1.);
-	double radius = miningRadius[&ship] * pow(2., angle.Unit().X());
+	double radius = state.miningRadius * pow(2., angle.Unit().X());
 
 	shared_ptr<Minable> target = ship.GetTargetAsteroid();
 	if(!target || target->Velocity().Length() > ship.MaxVelocity())
 	{
-		for(const shared_ptr<Minable> &minable : minables)
+		// Use the asteroid found when this ship was planned, unless its target has changed since.
+		shared_ptr<Minable> minable = (plan.isPlanned && plan.targetAsteroid == target.get())
+			? plan.miningTarget : FindAsteroidToMine(ship);
+		if(minable)
 		{
-			Point offset = minable->Position() - ship.Position();
-			// Target only nearby minables that are within 45deg of the current heading
-			// and not moving faster than the ship can catch.
-			if(offset.Length() < 800. && offset.Unit().Dot(ship.Facing().Unit()) > .7
-					&& minable->Velocity().Dot(offset.Unit()) < ship.MaxVelocity())
-			{
-				target = minable;
-				ship.SetTargetAsteroid(target);
-				break;
-			}
+			target = std::move(minable);
+			ship.SetTargetAsteroid(target);
 		}
 	}
 	if(target)
@@ -3234,6 +3333,23 @@ void AI::DoMining(Ship &ship, Command &command)
 
 
 
+// Find an asteroid near the given ship that it can mine.
+shared_ptr<Minable> AI::FindAsteroidToMine(const Ship &ship) const
+{
+	for(const shared_ptr<Minable> &minable : minables)
+	{
+		Point offset = minable->Position() - ship.Position();
+		// Target only nearby minables that are within 45deg of the current heading
+		// and not moving faster than the ship can catch.
+		if(offset.Length() < 800. && offset.Unit().Dot(ship.Facing().Unit()) > .7
+				&& minable->Velocity().Dot(offset.Unit()) < ship.MaxVelocity())
+			return minable;
+	}
+	return nullptr;
+}
+
+
+
 bool AI::DoHarvesting(Ship &ship, Command &command) const
 {
 	// If the ship has no target to pick up, do nothing.
@@ -3399,7 +3515,8 @@ bool AI::DoCloak(const Ship &ship, Command &command) const
 			// TODO: This could use an "Avoid" method, to account for other in-system hazards.
 			// Simple approximation: move equally away from both the system center and the
 			// nearest enemy, until the constrainment boundary is reached.
-			if(ship.GetPersonality().IsUnconstrained() || !fenceCount.contains(&ship))
+			const ShipState *state = FindState(ship);
+			if(ship.GetPersonality().IsUnconstrained() || !state || state->fenceCount < 0)
 				safety = 2 * ship.Position().Unit() - nearestEnemy->Position().Unit();
 			else
 				safety = -ship.Position().Unit();
@@ -3525,7 +3642,8 @@ bool AI::DoSecretive(Ship &ship, Command &command) const
 		if(distance < maxScanRange)
 		{
 			Point away;
-			if(ship.GetPersonality().IsUnconstrained() || !fenceCount.contains(&ship))
+			const ShipState *state = FindState(ship);
+			if(ship.GetPersonality().IsUnconstrained() || !state || state->fenceCount < 0)
 				away = pos - scanningPos;
 			else
 				away = -pos;
@@ -3640,8 +3758,8 @@ Point AI::TargetAim(const Ship &ship, const Body &target)
 
 
 // Aim the given ship's turrets.
-void AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic,
-		const optional<Point> &targetOverride) const
+bool AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic,
+		const optional<Point> &targetOverride, bool allowRandom) const
 {
 	// (Position, Velocity) pairs of the targets.
 	vector<pair<Point, Point>> targets;
@@ -3659,7 +3777,7 @@ void AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic,
 					maxRange = max(maxRange, hardpoint.GetWeapon()->Range());
 			// If this ship has no turrets, bail out.
 			if(!maxRange)
-				return;
+				return true;
 			// Extend the weapon range slightly to account for velocity differences.
 			maxRange *= 1.5;
 
@@ -3695,10 +3813,12 @@ void AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic,
 					double offset = (hardpoint.GetIdleAngle() - hardpoint.GetAngle()).Degrees();
 					command.SetAim(index, offset / hardpoint.TurnRate(ship));
 				}
-			return;
+			return true;
 		}
 		if(targetBodies.empty())
 		{
+			if(!allowRandom)
+				return false;
 			for(const Hardpoint &hardpoint : ship.Weapons())
 				if(hardpoint.CanAim(ship))
 				{
@@ -3719,7 +3839,7 @@ void AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic,
 					double acceleration = Random::Real() - Random::Real() + bias;
 					command.SetAim(index, previous + .1 * acceleration);
 				}
-			return;
+			return true;
 		}
 
 		targets.reserve(targetBodies.size());
@@ -3826,6 +3946,7 @@ void AI::AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic,
 				command.SetAim(index, bestAngle / hardpoint.TurnRate(ship));
 			}
 		}
+	return true;
 }
 
 
@@ -3966,7 +4087,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 		if(weapon->Homing() && currentTarget)
 		{
 			// NPCs shoot ships that they just plundered.
-			bool hasBoarded = !ship.IsYours() && Has(ship, currentTarget, ShipEvent::BOARD);
+			bool hasBoarded = !ship.IsYours() && Has(ship, *currentTarget, ShipEvent::BOARD);
 			if(currentTarget->IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride)
 				continue;
 			// Don't fire secondary weapons at targets that have started jumping.
@@ -4001,7 +4122,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 		for(const auto &target : enemies)
 		{
 			// NPCs shoot ships that they just plundered.
-			bool hasBoarded = !ship.IsYours() && Has(ship, target->shared_from_this(), ShipEvent::BOARD);
+			bool hasBoarded = !ship.IsYours() && Has(ship, *target, ShipEvent::BOARD);
 			if(target->IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride)
 				continue;
 			// Merciful ships let fleeing ships go.
@@ -4087,6 +4208,195 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, const Body &target) co
 
 
 
+// The "think" phase of a step: work out what each NPC will do, in parallel.
+// Aiming, firing and picking targets are the costliest part of a ship's AI in a
+// battle, since they check every ship in range, but deciding them only reads
+// the game state. Step() then goes through the ships in order, applying these
+// decisions and making the changes they call for to the AI's records, and
+// moving each ship. Movement stays there, since escorts follow the commands
+// that their parents were given earlier in the same step.
+void AI::PlanShips()
+{
+	// Small batches are not worth handing to other threads.
+	static const size_t BATCH_SIZE = 16;
+
+	const System *playerSystem = player.GetSystem();
+	const Ship *flagship = player.Flagship();
+
+	shipPlans.resize(ships.size());
+	plannedShips.clear();
+	int targetTurn = 0;
+	auto planIt = shipPlans.begin();
+	for(const auto &it : ships)
+	{
+		ShipPlan &plan = *planIt++;
+		plan.Clear();
+		bool isPresent = (it->GetSystem() == playerSystem);
+		if(isPresent)
+		{
+			// Bodies update their animation frame the first time their mask is
+			// requested in a step. Do that here, so the planning threads only read it.
+			it->GetMask(step);
+			if(it->GetTargetAsteroid())
+				it->GetTargetAsteroid()->GetMask(step);
+		}
+		if(it->IsDestroyed() || !it->GetSystem() || it.get() == flagship)
+			continue;
+
+		// Spread out the steps in which each ship reconsiders its target.
+		if(isPresent && !it->IsDisabled() && !it->IsOverheated() && !it->GetPersonality().IsSwarming())
+		{
+			targetTurn = (targetTurn + 1) & 31;
+			plan.isTargetTurn = (targetTurn == step);
+		}
+		// The player's escorts follow orders and may aim their turrets at
+		// random, so they are still worked out one at a time in Step().
+		if(!it->IsYours())
+		{
+			plan.seed = Random::Int();
+			plannedShips.emplace_back(it.get(), &plan);
+		}
+	}
+
+	auto planBatch = [this, flagship](size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; ++i)
+			PlanShip(*plannedShips[i].first, *plannedShips[i].second, flagship);
+	};
+	size_t batchSize = BATCH_SIZE;
+	if(planningThreads)
+		batchSize = max<size_t>(1, (plannedShips.size() + planningThreads - 1) / planningThreads);
+	if(plannedShips.size() <= batchSize)
+	{
+		planBatch(0, plannedShips.size());
+		return;
+	}
+	for(size_t begin = 0; begin < plannedShips.size(); begin += batchSize)
+		planQueue.Run([&planBatch, begin, end = min(begin + batchSize, plannedShips.size())]
+			{ planBatch(begin, end); });
+	planQueue.Wait();
+}
+
+
+
+void AI::PlanShip(const Ship &ship, ShipPlan &plan, const Ship *flagship) const
+{
+	PlanRandom random(plan.seed);
+	shared_ptr<Ship> target = ship.GetTargetShip();
+	plan.isPlanned = true;
+	plan.targetShip = target.get();
+	plan.targetAsteroid = ship.GetTargetAsteroid().get();
+	plan.isWaitingToJump = ship.Commands().Has(Command::JUMP | Command::WAIT);
+
+	// Stranded and disabled ships ask for help now and then.
+	const Personality &personality = ship.GetPersonality();
+	if((IsStranded(ship) || ship.IsDisabled()) && !personality.IsDerelict() && !random.Int(30))
+		plan.helper = FindHelper(ship, flagship, random);
+
+	// Everything else is only decided for ships in the player's system that can act.
+	if(ship.GetSystem() != player.GetSystem() || ship.IsDisabled() || ship.IsOverheated())
+		return;
+
+	// Determine if this ship was trying to scan its previous target. Assume that
+	// if the target is friendly, not disabled, of a different government to
+	// this ship, and this ship has scanning capabilities then it was attempting
+	// to scan the target. This isn't a perfect assumption, but should be good
+	// enough for now.
+	const Government *gov = ship.GetGovernment();
+	bool cargoScan = ship.Attributes().Get("cargo scan power");
+	bool outfitScan = ship.Attributes().Get("outfit scan power");
+	if((cargoScan || outfitScan) && target && !target->IsDisabled()
+		&& !target->GetGovernment()->IsEnemy(gov) && target->GetGovernment() != gov)
+	{
+		plan.isScanning = true;
+		plan.finishedCargoScan = (ship.CargoScanFraction() == 1.);
+		plan.finishedOutfitScan = (ship.OutfitScanFraction() == 1.);
+	}
+
+	// Pick a new target if this ship needs one.
+	if(personality.IsSwarming())
+	{
+		plan.changesSwarmTarget = ship.IsLanding() || !target || !CanSwarm(ship, *target) || !random.Int(600);
+		if(plan.changesSwarmTarget && !ship.IsLanding())
+			plan.swarmTarget = FindSwarmTarget(ship, random);
+	}
+	else if(NeedsNewTarget(ship, target.get(), plan.isTargetTurn))
+	{
+		plan.hasNewTarget = true;
+		plan.newTarget = FindTarget(ship).get();
+	}
+	const Ship *nextTarget = plan.hasNewTarget ? plan.newTarget : target.get();
+
+	// Surveillance ships with nothing to scan and nowhere to go choose what to do next.
+	if(personality.IsSurveillance() && !nextTarget && !ship.GetTargetSystem() && !ship.GetTargetStellar())
+	{
+		plan.hasSurveillanceTarget = true;
+		plan.surveillanceTarget = FindSurveillanceTarget(ship, random);
+	}
+	// Miners look for an asteroid if they have none they can catch.
+	if(personality.IsMining() && !minables.empty() && (!plan.targetAsteroid
+			|| plan.targetAsteroid->Velocity().Length() > ship.MaxVelocity()))
+		plan.miningTarget = FindAsteroidToMine(ship);
+
+	// Aim and fire at the targets this ship has now. Turrets that sweep at
+	// random are aimed in Step(), so that the random numbers are drawn on one
+	// thread in a fixed order.
+	plan.command.SetHardpoints(ship.Weapons().size());
+	if(!AimTurrets(ship, plan.command, personality.IsOpportunistic(), nullopt, false))
+		return;
+	if(ship.GetTargetAsteroid())
+		AutoFire(ship, plan.command, *ship.GetTargetAsteroid());
+	else
+		AutoFire(ship, plan.command);
+	plan.hasFireCommand = true;
+}
+
+
+
+AI::PlanRandom::PlanRandom(uint64_t seed)
+	: state(seed)
+{
+}
+
+
+
+uint32_t AI::PlanRandom::Int(uint32_t modulus)
+{
+	// This is the "SplitMix64" generator, which is fast to seed and whose
+	// numbers are well distributed even for similar seeds.
+	uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	const uint32_t x = (z ^ (z >> 31)) >> 32;
+	return (static_cast<uint64_t>(x) * static_cast<uint64_t>(modulus)) >> 32;
+}
+
+
+
+void AI::ShipPlan::Clear()
+{
+	isPlanned = false;
+	targetShip = nullptr;
+	targetAsteroid = nullptr;
+	isWaitingToJump = false;
+	isTargetTurn = false;
+	seed = 0;
+	helper = nullptr;
+	isScanning = false;
+	finishedCargoScan = false;
+	finishedOutfitScan = false;
+	hasNewTarget = false;
+	newTarget = nullptr;
+	changesSwarmTarget = false;
+	swarmTarget = nullptr;
+	hasSurveillanceTarget = false;
+	surveillanceTarget = SurveillanceTarget();
+	miningTarget.reset();
+	hasFireCommand = false;
+}
+
+
+
 // Get the amount of time it would take the given weapon to reach the given
 // target, assuming it can be fired in any direction (i.e. turreted). For
 // non-turreted weapons this can be used to calculate the ideal direction to
@@ -4374,13 +4684,13 @@ void AI::MovePlayer(Ship &ship, Command &activeCommands)
 						return [this, &ship](const Ship &other) noexcept -> double
 						{
 							// Use the exact cost if the ship was scanned, otherwise use an estimation.
-							return this->Has(ship, other.shared_from_this(), ShipEvent::SCAN_OUTFITS) ?
+							return this->Has(ship, other, ShipEvent::SCAN_OUTFITS) ?
 								other.Cost() : (other.ChassisCost() * 2.);
 						};
 					case Preferences::BoardingPriority::MIXED:
 						return [this, &ship, current](const Ship &other) noexcept -> double
 						{
-							double cost = this->Has(ship, other.shared_from_this(), ShipEvent::SCAN_OUTFITS) ?
+							double cost = this->Has(ship, other, ShipEvent::SCAN_OUTFITS) ?
 								other.Cost() : (other.ChassisCost() * 2.);
 							// Even if we divide by 0, doubles can contain and handle infinity,
 							// and we should definitely board that one then.
@@ -4855,32 +5165,25 @@ void AI::DisengageAutopilot()
 
 
 
-bool AI::Has(const Ship &ship, const weak_ptr<const Ship> &other, int type) const
+bool AI::Has(const Ship &ship, const Ship &other, int type) const
 {
-	auto sit = actions.find(ship.shared_from_this());
-	if(sit == actions.end())
-		return false;
-
-	auto oit = sit->second.find(other);
-	if(oit == sit->second.end())
+	const ShipState *state = FindState(ship);
+	const ShipState *otherState = FindState(other);
+	if(!state || !otherState)
 		return false;
 
-	return (oit->second & type);
+	return (GetRecord(state->actions, GetId(*otherState)) & type);
 }
 
 
 
-bool AI::Has(const Government *government, const weak_ptr<const Ship> &other, int type) const
+bool AI::Has(const Government *government, const Ship &other, int type) const
 {
-	auto git = governmentActions.find(government);
-	if(git == governmentActions.end())
-		return false;
-
-	auto oit = git->second.find(other);
-	if(oit == git->second.end())
+	const ShipState *state = FindState(other);
+	if(!state)
 		return false;
 
-	return (oit->second & type);
+	return (GetRecord(state->governmentActions, government) & type);
 }
 
 
@@ -4889,15 +5192,11 @@ bool AI::Has(const Government *government, const weak_ptr<const Ship> &other, in
 // example, if the player boarded any ship belonging to that government.
 bool AI::Has(const Ship &ship, const Government *government, int type) const
 {
-	auto sit = notoriety.find(ship.shared_from_this());
-	if(sit == notoriety.end())
+	const ShipState *state = FindState(ship);
+	if(!state)
 		return false;
 
-	auto git = sit->second.find(government);
-	if(git == sit->second.end())
-		return false;
-
-	return (git->second & type);
+	return (GetRecord(state->notoriety, government) & type);
 }
 
 
@@ -4948,7 +5247,7 @@ void AI::UpdateStrengths(map<const Government *, int64_t> &strength, const Syste
 		if(!gov || it->GetSystem() != playerSystem || it->IsDisabled() || Random::Int(60))
 			continue;
 
-		int64_t &myStrength = shipStrength[it.get()];
+		int64_t &myStrength = GetState(*it).strength;
 		for(const auto &allies : governmentRosters)
 		{
 			// If this is not an allied government, its ships will not assist this ship when attacked.
@@ -5162,3 +5461,128 @@ void AI::UpdateOrders(const Ship &ship)
 
 	it->second.Update(ship);
 }
+
+
+
+void AI::ShipState::Clean()
+{
+	actions.clear();
+	notoriety.clear();
+	governmentActions.clear();
+	playerActions = 0;
+	swarmCount = 0;
+	boarderCount = 0;
+	boarding = ShipId();
+	fenceCount = -1;
+	cargoScans.clear();
+	outfitScans.clear();
+	scanTime = 0;
+	hasMiningAngle = false;
+	miningRadius = 0.;
+	miningTime = 0;
+	appeasementThreshold = 0.;
+	strength = 0;
+}
+
+
+
+void AI::UpdateShipSlots()
+{
+	for(uint32_t slot = 0; slot < shipStates.size(); ++slot)
+		if(shipStates[slot].ship && shipStates[slot].owner.expired())
+			ReleaseSlot(slot);
+	for(const auto &it : ships)
+		GetState(*it);
+}
+
+
+
+AI::ShipState &AI::GetState(Ship &ship)
+{
+	ShipState *state = FindState(ship);
+	if(state)
+		return *state;
+
+	uint32_t slot = shipStates.size();
+	if(freeSlots.empty())
+		shipStates.emplace_back();
+	else
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	ShipState &newState = shipStates[slot];
+	newState.ship = &ship;
+	newState.owner = ship.shared_from_this();
+	ship.SetAISlot(slot);
+	return newState;
+}
+
+
+
+AI::ShipState *AI::FindState(const Ship &ship)
+{
+	uint32_t slot = ship.GetAISlot();
+	if(slot < shipStates.size() && shipStates[slot].ship == &ship)
+		return &shipStates[slot];
+	return nullptr;
+}
+
+
+
+const AI::ShipState *AI::FindState(const Ship &ship) const
+{
+	uint32_t slot = ship.GetAISlot();
+	if(slot < shipStates.size() && shipStates[slot].ship == &ship)
+		return &shipStates[slot];
+	return nullptr;
+}
+
+
+
+AI::ShipState *AI::FindState(ShipId id)
+{
+	if(id.slot < shipStates.size() && shipStates[id.slot].ship && shipStates[id.slot].generation == id.generation)
+		return &shipStates[id.slot];
+	return nullptr;
+}
+
+
+
+AI::ShipId AI::GetId(const ShipState &state) const
+{
+	return ShipId{static_cast<uint32_t>(&state - shipStates.data()), state.generation};
+}
+
+
+
+void AI::ReleaseSlot(uint32_t slot)
+{
+	ShipState &state = shipStates[slot];
+	SetBoarding(state, nullptr);
+	state.Clean();
+	state.hasHelper = false;
+	state.helper.reset();
+	state.ship = nullptr;
+	state.owner.reset();
+	// Records that refer to the ship by its ID will no longer match the slot.
+	++state.generation;
+	freeSlots.push_back(slot);
+}
+
+
+
+void AI::SetBoarding(ShipState &state, const Ship *target)
+{
+	ShipState *targetState = target ? FindState(*target) : nullptr;
+	ShipId targetId = targetState ? GetId(*targetState) : ShipId();
+	if(targetId == state.boarding)
+		return;
+
+	ShipState *oldState = FindState(state.boarding);
+	if(oldState)
+		--oldState->boarderCount;
+	if(targetState)
+		++targetState->boarderCount;
+	state.boarding = targetId;
+}
@@ -15,21 +15,21 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "Angle.h"
 #include "Command.h"
 #include "FireCommand.h"
 #include "FormationPositioner.h"
 #include "orders/OrderSet.h"
 #include "Point.h"
+#include "TaskQueue.h"
 
 #include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
 #include <optional>
-#include <set>
 #include <vector>
 
-class Angle;
 class AsteroidField;
 class Body;
 class ConditionsStore;
@@ -82,6 +82,10 @@ public:
 
 	// Set the mouse position for turning the player's flagship.
 	void SetMousePosition(Point position);
+	// Set how many threads plan the ships' decisions. 1 plans them all on the
+	// calling thread, and 0 (the default) splits them up by the number of ships.
+	// The commands that Step() gives do not depend on this.
+	void SetPlanningThreads(unsigned threads);
 
 	// Get the in-system strength of each government's allies and enemies.
 	int64_t AllyStrength(const Government *government) const;
@@ -91,11 +95,129 @@ public:
 	static const StellarObject *FindLandingLocation(const Ship &ship, const bool refuel = true);
 
 
+private:
+	// Random numbers for planning one ship. Each ship's generator is seeded in
+	// ship order, so the numbers it gives do not depend on which thread plans it.
+	class PlanRandom {
+	public:
+		explicit PlanRandom(uint64_t seed);
+
+		// The same as Random::Int(modulus).
+		uint32_t Int(uint32_t modulus);
+
+	private:
+		uint64_t state;
+	};
+
+	// Where a surveillance ship with nothing to do goes next: a ship or planet
+	// to scan, or a system to travel to. If none is set, it patrols its system.
+	struct SurveillanceTarget {
+		Ship *ship = nullptr;
+		const StellarObject *stellar = nullptr;
+		const System *system = nullptr;
+	};
+
+	// What the "think" phase decided for one ship, from the game state as it was
+	// at the start of the step. Each plan is written only by the thread planning
+	// that ship, and Step() applies the plans in ship order. A decision that
+	// assumed targets the ship no longer has is made again instead.
+	struct ShipPlan {
+		// Forget the previous step's plan.
+		void Clear();
+
+		bool isPlanned = false;
+		// The targets the ship had when it was planned.
+		const Ship *targetShip = nullptr;
+		const Minable *targetAsteroid = nullptr;
+		bool isWaitingToJump = false;
+		// Whether this is one of the steps in which the ship reconsiders its target.
+		bool isTargetTurn = false;
+		// The seed for this ship's PlanRandom.
+		uint64_t seed = 0;
+
+		// The ship this ship asks for help, if it is stranded and asks this step.
+		Ship *helper = nullptr;
+		// Whether this ship spent the step scanning its target, and which of
+		// those scans are now complete.
+		bool isScanning = false;
+		bool finishedCargoScan = false;
+		bool finishedOutfitScan = false;
+		// The replacement for a target that needs replacing.
+		bool hasNewTarget = false;
+		Ship *newTarget = nullptr;
+		// The ship a swarming ship moves on to, if it moves on.
+		bool changesSwarmTarget = false;
+		Ship *swarmTarget = nullptr;
+		// What a surveillance ship with nothing to do will do next.
+		bool hasSurveillanceTarget = false;
+		SurveillanceTarget surveillanceTarget;
+		// The asteroid a miner without a reachable one will go after.
+		std::shared_ptr<Minable> miningTarget;
+		// Turret aim and automatic fire.
+		bool hasFireCommand = false;
+		FireCommand command;
+	};
+
+	// A ship's slot in shipStates, and which of the ships that have used that
+	// slot it refers to.
+	struct ShipId {
+		uint32_t slot = NO_SLOT;
+		uint32_t generation = 0;
+
+		bool operator==(const ShipId &other) const = default;
+	};
+	static constexpr uint32_t NO_SLOT = static_cast<uint32_t>(-1);
+
+	// Everything the AI remembers about one ship. A ship is given a slot the
+	// first time the AI sees it, and the slot is recycled once the ship no
+	// longer exists, so these records are stored contiguously and looked up
+	// by index rather than in one map per kind of record.
+	struct ShipState {
+		// Forget what happened in the current system. Requests for help are
+		// kept, since ships keep those when the player changes systems.
+		void Clean();
+
+		// The ship occupying this slot, or nullptr if the slot is free.
+		const Ship *ship = nullptr;
+		std::weak_ptr<const Ship> owner;
+		uint32_t generation = 0;
+
+		// Records of what this ship has done to other ships and governments,
+		// and what governments (and the player) have done to this ship.
+		std::vector<std::pair<ShipId, int>> actions;
+		std::vector<std::pair<const Government *, int>> notoriety;
+		std::vector<std::pair<const Government *, int>> governmentActions;
+		int playerActions = 0;
+		// The ship this ship asked to assist it, if it asked one.
+		bool hasHelper = false;
+		std::weak_ptr<Ship> helper;
+		// How many ships are swarming around or boarding this ship.
+		int swarmCount = 0;
+		int boarderCount = 0;
+		// The ship this ship is moving to board.
+		ShipId boarding;
+		// How long this ship has been outside the "invisible fence," or -1 if
+		// it has not been outside it recently.
+		int fenceCount = -1;
+		// The ships this ship has scanned, and how long it has spent scanning.
+		std::vector<const Ship *> cargoScans;
+		std::vector<const Ship *> outfitScans;
+		int scanTime = 0;
+		bool hasMiningAngle = false;
+		Angle miningAngle;
+		double miningRadius = 0.;
+		int miningTime = 0;
+		double appeasementThreshold = 0.;
+		int64_t strength = 0;
+	};
+
+
 private:
 	// Check if a ship can pursue its target (i.e. beyond the "fence").
 	bool CanPursue(const Ship &ship, const Ship &target) const;
 	// Disabled or stranded ships coordinate with other ships to get assistance.
-	void AskForHelp(Ship &ship, bool &isStranded, const Ship *flagship);
+	void AskForHelp(Ship &ship, bool &isStranded, const Ship *flagship, const ShipPlan &plan);
+	Ship *FindHelper(const Ship &ship, const Ship *flagship, PlanRandom &random) const;
 	bool CanHelp(const Ship &ship, const Ship &helper, const bool needsFuel, const bool needsEnergy) const;
 	bool HasHelper(const Ship &ship, const bool needsFuel, const bool needsEnergy);
 	// Pick a new target for the given ship.
@@ -139,9 +261,12 @@ private:
 	static bool ShouldUseAfterburner(const Ship &ship);
 	// Special personality behaviors.
 	void DoAppeasing(const std::shared_ptr<Ship> &ship, double *threshold) const;
-	void DoSwarming(Ship &ship, Command &command, std::shared_ptr<Ship> &target);
-	void DoSurveillance(Ship &ship, Command &command, std::shared_ptr<Ship> &target);
-	void DoMining(Ship &ship, Command &command);
+	void DoSwarming(Ship &ship, Command &command, std::shared_ptr<Ship> &target, const ShipPlan &plan);
+	Ship *FindSwarmTarget(const Ship &ship, PlanRandom &random) const;
+	void DoSurveillance(Ship &ship, Command &command, std::shared_ptr<Ship> &target, const ShipPlan &plan);
+	SurveillanceTarget FindSurveillanceTarget(const Ship &ship, PlanRandom &random) const;
+	void DoMining(Ship &ship, Command &command, const ShipPlan &plan);
+	std::shared_ptr<Minable> FindAsteroidToMine(const Ship &ship) const;
 	bool DoHarvesting(Ship &ship, Command &command) const;
 	bool DoCloak(const Ship &ship, Command &command) const;
 	void DoPatrol(Ship &ship, Command &command) const;
@@ -156,9 +281,10 @@ private:
 	// returns the direction to the target.
 	static Point TargetAim(const Ship &ship);
 	static Point TargetAim(const Ship &ship, const Body &target);
-	// Aim the given ship's turrets.
-	void AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic = false,
-			const std::optional<Point> &targetOverride = std::nullopt) const;
+	// Aim the given ship's turrets. Turrets with nothing to aim at may sweep at
+	// random; if that is not allowed, this returns false instead.
+	bool AimTurrets(const Ship &ship, FireCommand &command, bool opportunistic = false,
+			const std::optional<Point> &targetOverride = std::nullopt, bool allowRandom = true) const;
 	// Fire whichever of the given ship's weapons can hit a hostile target.
 	// Return a bitmask giving the weapons to fire.
 	void AutoFire(const Ship &ship, FireCommand &command, bool secondary = true, bool isFlagship = false) const;
@@ -172,12 +298,17 @@ private:
 	// True if found asteroid.
 	bool TargetMinable(Ship &ship) const;
 	// True if the ship performed the indicated event to the other ship.
-	bool Has(const Ship &ship, const std::weak_ptr<const Ship> &other, int type) const;
+	bool Has(const Ship &ship, const Ship &other, int type) const;
 	// True if the government performed the indicated event to the other ship.
-	bool Has(const Government *government, const std::weak_ptr<const Ship> &other, int type) const;
+	bool Has(const Government *government, const Ship &other, int type) const;
 	// True if the ship has performed the indicated event against any member of the government.
 	bool Has(const Ship &ship, const Government *government, int type) const;
 
+	// The "think" phase: plan the NPC ships' decisions in parallel, before
+	// Step() goes through the ships and applies them.
+	void PlanShips();
+	void PlanShip(const Ship &ship, ShipPlan &plan, const Ship *flagship) const;
+
 	// Functions to classify ships based on government and system.
 	void UpdateStrengths(std::map<const Government *, int64_t> &strength, const System *playerSystem);
 	void CacheShipLists();
@@ -193,6 +324,19 @@ private:
 	// Convert order types based on fulfillment status.
 	void UpdateOrders(const Ship &ship);
 
+	// Ship slots. UpdateShipSlots() frees the slots of ships that no longer
+	// exist and gives a slot to each ship that does not have one yet.
+	void UpdateShipSlots();
+	ShipState &GetState(Ship &ship);
+	// Get a ship's records, or nullptr if the AI has none.
+	ShipState *FindState(const Ship &ship);
+	const ShipState *FindState(const Ship &ship) const;
+	ShipState *FindState(ShipId id);
+	ShipId GetId(const ShipState &state) const;
+	void ReleaseSlot(uint32_t slot);
+	// Start or stop moving the given ship to board the target.
+	void SetBoarding(ShipState &state, const Ship *target);
+
 
 private:
 	// TODO: Figure out a way to remove the player dependency.
@@ -215,6 +359,16 @@ private:
 	// each ship.
 	FireCommand firingCommands;
 
+	// The plan for each ship made by PlanShips(), in the same order as the ship
+	// list, and the ships that were planned. Plans only read the game state, and
+	// each is written to its own slot, so they do not depend on how many threads
+	// made them.
+	std::vector<ShipPlan> shipPlans;
+	std::vector<std::pair<const Ship *, ShipPlan *>> plannedShips;
+	TaskQueue planQueue;
+	// How many tasks to split the planning into, or 0 to use batches of ships.
+	unsigned planningThreads = 0;
+
 	bool isCloaking = false;
 
 	bool escortsAreFrugal = true;
@@ -228,30 +382,17 @@ private:
 	// ordinary pointers instead of weak pointers.
 	std::map<const Ship *, OrderSet> orders;
 
-	// Records of what various AI ships and factions have done.
-	typedef std::owner_less<std::weak_ptr<const Ship>> Comp;
-	std::map<std::weak_ptr<const Ship>, std::map<std::weak_ptr<const Ship>, int, Comp>, Comp> actions;
-	std::map<std::weak_ptr<const Ship>, std::map<const Government *, int>, Comp> notoriety;
-	std::map<const Government *, std::map<std::weak_ptr<const Ship>, int, Comp>> governmentActions;
+	// Records of what various AI ships have done and had done to them, by
+	// slot (see Ship::GetAISlot()), and the slots that are free to reuse.
+	std::vector<ShipState> shipStates;
+	std::vector<uint32_t> freeSlots;
+	// Records of what various factions are allowed to do.
 	std::map<const Government *, bool> scanPermissions;
-	std::map<std::weak_ptr<const Ship>, int, Comp> playerActions;
-	std::map<const Ship *, std::weak_ptr<Ship>> helperList;
-	std::map<const Ship *, int> swarmCount;
-	std::map<const Ship *, int> fenceCount;
-	std::map<const Ship *, std::set<const Ship *>> cargoScans;
-	std::map<const Ship *, std::set<const Ship *>> outfitScans;
-	std::map<const Ship *, int> scanTime;
-	std::map<const Ship *, Angle> miningAngle;
-	std::map<const Ship *, double> miningRadius;
-	std::map<const Ship *, int> miningTime;
-	std::map<const Ship *, double> appeasementThreshold;
-	std::map<const Ship *, const Ship *> boarders;
 
 	// Records for formations flying around leadships and other objects.
 	std::map<const Body *, std::map<const FormationPattern *, FormationPositioner>> formations;
 
 	// Records that affect the combat behavior of various governments.
-	std::map<const Ship *, int64_t> shipStrength;
 	std::map<const Government *, int64_t> enemyStrength;
 	std::map<const Government *, int64_t> allyStrength;
 	std::map<const Government *, std::vector<Ship *>> governmentRosters;
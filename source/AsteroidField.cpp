@@ -42,7 +42,9 @@ namespace {
 // Constructor, to set up the collision set parameters.
 AsteroidField::AsteroidField()
 	: asteroidCollisions(CELL_SIZE, CELL_COUNT, CollisionType::ASTEROID),
-	minableCollisions(CELL_SIZE, CELL_COUNT, CollisionType::MINABLE)
+	// Minables are spread over the whole system rather than wrapped into one
+	// grid-sized tile, so a grid would alias far-apart minables into the same cells.
+	minableCollisions(CELL_SIZE, CELL_COUNT, CollisionType::MINABLE, CollisionSet::BroadPhase::SWEEP)
 {
 }
 
@@ -89,6 +91,9 @@ void AsteroidField::Step(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flo
 	asteroidCollisions.Clear(step);
 	for(Asteroid &asteroid : asteroids)
 	{
+		// Update the animation frame now, so that collision detection (which
+		// may run in parallel) only reads it.
+		asteroid.GetMask(step);
 		asteroidCollisions.Add(asteroid);
 		asteroid.Step();
 	}
@@ -102,6 +107,7 @@ void AsteroidField::Step(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flo
 	{
 		if((*it)->Move(visuals, flotsam))
 		{
+			(*it)->GetMask(step);
 			minableCollisions.Add(**it);
 			++it;
 		}
@@ -0,0 +1,238 @@
+/* Attribute.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "Attribute.h"
+
+#include <cstring>
+#include <iterator>
+
+using namespace std;
+
+namespace {
+	// Sorted, so that Find() can use a binary search.
+	const char *const NAMES[] = {
+		"absolute threshold",
+		"acceleration multiplier",
+		"active cooling",
+		"afterburner burn",
+		"afterburner corrosion",
+		"afterburner discharge",
+		"afterburner disruption",
+		"afterburner energy",
+		"afterburner fuel",
+		"afterburner heat",
+		"afterburner hull",
+		"afterburner ion",
+		"afterburner leakage",
+		"afterburner scramble",
+		"afterburner shields",
+		"afterburner slowing",
+		"afterburner thrust",
+		"burn resistance",
+		"burn resistance energy",
+		"burn resistance fuel",
+		"burn resistance heat",
+		"cloak",
+		"cloak by mass",
+		"cloak hull threshold",
+		"cloak phasing",
+		"cloaked afterburner",
+		"cloaked boarding",
+		"cloaked communication",
+		"cloaked firing",
+		"cloaked pickup",
+		"cloaked regen multiplier",
+		"cloaked repair multiplier",
+		"cloaked scanning",
+		"cloaking energy",
+		"cloaking fuel",
+		"cloaking heat",
+		"cloaking hull",
+		"cloaking repair delay",
+		"cloaking shield delay",
+		"cloaking shields",
+		"cooling",
+		"cooling energy",
+		"cooling inefficiency",
+		"corrosion resistance",
+		"corrosion resistance energy",
+		"corrosion resistance fuel",
+		"corrosion resistance heat",
+		"delayed hull energy",
+		"delayed hull fuel",
+		"delayed hull heat",
+		"delayed hull repair rate",
+		"delayed shield energy",
+		"delayed shield fuel",
+		"delayed shield generation",
+		"delayed shield heat",
+		"depleted shield delay",
+		"disabled recovery burning",
+		"disabled recovery corrosion",
+		"disabled recovery discharge",
+		"disabled recovery disruption",
+		"disabled recovery energy",
+		"disabled recovery fuel",
+		"disabled recovery heat",
+		"disabled recovery ionization",
+		"disabled recovery leak",
+		"disabled recovery scrambling",
+		"disabled recovery slowing",
+		"disabled recovery time",
+		"disabled repair delay",
+		"discharge resistance",
+		"discharge resistance energy",
+		"discharge resistance fuel",
+		"discharge resistance heat",
+		"disruption resistance",
+		"disruption resistance energy",
+		"disruption resistance fuel",
+		"disruption resistance heat",
+		"drag",
+		"drag reduction",
+		"energy capacity",
+		"energy consumption",
+		"energy generation",
+		"fuel capacity",
+		"fuel consumption",
+		"fuel energy",
+		"fuel generation",
+		"fuel heat",
+		"heat capacity",
+		"heat dissipation",
+		"heat generation",
+		"hull",
+		"hull energy",
+		"hull energy multiplier",
+		"hull fuel",
+		"hull fuel multiplier",
+		"hull heat",
+		"hull heat multiplier",
+		"hull multiplier",
+		"hull repair multiplier",
+		"hull repair rate",
+		"hull threshold",
+		"inertia reduction",
+		"ion resistance",
+		"ion resistance energy",
+		"ion resistance fuel",
+		"ion resistance heat",
+		"jump speed",
+		"leak resistance",
+		"leak resistance energy",
+		"leak resistance fuel",
+		"leak resistance heat",
+		"overheat damage rate",
+		"overheat damage threshold",
+		"ramscoop",
+		"repair delay",
+		"reverse thrust",
+		"reverse thrusting burn",
+		"reverse thrusting corrosion",
+		"reverse thrusting discharge",
+		"reverse thrusting disruption",
+		"reverse thrusting energy",
+		"reverse thrusting fuel",
+		"reverse thrusting heat",
+		"reverse thrusting hull",
+		"reverse thrusting ion",
+		"reverse thrusting leakage",
+		"reverse thrusting scramble",
+		"reverse thrusting shields",
+		"reverse thrusting slowing",
+		"scram drive",
+		"scramble resistance",
+		"scramble resistance energy",
+		"scramble resistance fuel",
+		"scramble resistance heat",
+		"shield delay",
+		"shield energy",
+		"shield energy multiplier",
+		"shield fuel",
+		"shield fuel multiplier",
+		"shield generation",
+		"shield generation multiplier",
+		"shield heat",
+		"shield heat multiplier",
+		"shield multiplier",
+		"shields",
+		"slowing resistance",
+		"slowing resistance energy",
+		"slowing resistance fuel",
+		"slowing resistance heat",
+		"solar collection",
+		"solar heat",
+		"threshold percentage",
+		"thrust",
+		"thrusting burn",
+		"thrusting corrosion",
+		"thrusting discharge",
+		"thrusting disruption",
+		"thrusting energy",
+		"thrusting fuel",
+		"thrusting heat",
+		"thrusting hull",
+		"thrusting ion",
+		"thrusting leakage",
+		"thrusting scramble",
+		"thrusting shields",
+		"thrusting slowing",
+		"turn",
+		"turn multiplier",
+		"turning burn",
+		"turning corrosion",
+		"turning discharge",
+		"turning disruption",
+		"turning energy",
+		"turning fuel",
+		"turning heat",
+		"turning hull",
+		"turning ion",
+		"turning leakage",
+		"turning scramble",
+		"turning shields",
+		"turning slowing",
+	};
+	static_assert(size(NAMES) == Attribute::COUNT, "Every attribute ID needs a name.");
+}
+
+
+
+const char *Attribute::Name(Id id)
+{
+	return NAMES[id];
+}
+
+
+
+Attribute::Id Attribute::Find(const char *name)
+{
+	// At each step of the search, we know the name is in [low, high).
+	int low = 0;
+	int high = COUNT;
+	while(low != high)
+	{
+		int mid = (low + high) / 2;
+		int cmp = strcmp(name, NAMES[mid]);
+		if(!cmp)
+			return static_cast<Id>(mid);
+
+		if(cmp < 0)
+			high = mid;
+		else
+			low = mid + 1;
+	}
+	return COUNT;
+}
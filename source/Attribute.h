@@ -0,0 +1,220 @@
+/* Attribute.h
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+
+
+// Dense IDs for the attributes that ships read every frame (thrust, turn,
+// generation, resistances, and so on). An Outfit keeps the values of these in
+// a flat array indexed by ID, so the simulation can read them without
+// searching the attribute Dictionary by name. Any other attribute, including
+// ones that plugins define, still works through the Dictionary.
+class Attribute {
+public:
+	// In the same (alphabetical) order as the names.
+	enum Id : int {
+		ABSOLUTE_THRESHOLD,
+		ACCELERATION_MULTIPLIER,
+		ACTIVE_COOLING,
+		AFTERBURNER_BURN,
+		AFTERBURNER_CORROSION,
+		AFTERBURNER_DISCHARGE,
+		AFTERBURNER_DISRUPTION,
+		AFTERBURNER_ENERGY,
+		AFTERBURNER_FUEL,
+		AFTERBURNER_HEAT,
+		AFTERBURNER_HULL,
+		AFTERBURNER_ION,
+		AFTERBURNER_LEAKAGE,
+		AFTERBURNER_SCRAMBLE,
+		AFTERBURNER_SHIELDS,
+		AFTERBURNER_SLOWING,
+		AFTERBURNER_THRUST,
+		BURN_RESISTANCE,
+		BURN_RESISTANCE_ENERGY,
+		BURN_RESISTANCE_FUEL,
+		BURN_RESISTANCE_HEAT,
+		CLOAK,
+		CLOAK_BY_MASS,
+		CLOAK_HULL_THRESHOLD,
+		CLOAK_PHASING,
+		CLOAKED_AFTERBURNER,
+		CLOAKED_BOARDING,
+		CLOAKED_COMMUNICATION,
+		CLOAKED_FIRING,
+		CLOAKED_PICKUP,
+		CLOAKED_REGEN_MULTIPLIER,
+		CLOAKED_REPAIR_MULTIPLIER,
+		CLOAKED_SCANNING,
+		CLOAKING_ENERGY,
+		CLOAKING_FUEL,
+		CLOAKING_HEAT,
+		CLOAKING_HULL,
+		CLOAKING_REPAIR_DELAY,
+		CLOAKING_SHIELD_DELAY,
+		CLOAKING_SHIELDS,
+		COOLING,
+		COOLING_ENERGY,
+		COOLING_INEFFICIENCY,
+		CORROSION_RESISTANCE,
+		CORROSION_RESISTANCE_ENERGY,
+		CORROSION_RESISTANCE_FUEL,
+		CORROSION_RESISTANCE_HEAT,
+		DELAYED_HULL_ENERGY,
+		DELAYED_HULL_FUEL,
+		DELAYED_HULL_HEAT,
+		DELAYED_HULL_REPAIR_RATE,
+		DELAYED_SHIELD_ENERGY,
+		DELAYED_SHIELD_FUEL,
+		DELAYED_SHIELD_GENERATION,
+		DELAYED_SHIELD_HEAT,
+		DEPLETED_SHIELD_DELAY,
+		DISABLED_RECOVERY_BURNING,
+		DISABLED_RECOVERY_CORROSION,
+		DISABLED_RECOVERY_DISCHARGE,
+		DISABLED_RECOVERY_DISRUPTION,
+		DISABLED_RECOVERY_ENERGY,
+		DISABLED_RECOVERY_FUEL,
+		DISABLED_RECOVERY_HEAT,
+		DISABLED_RECOVERY_IONIZATION,
+		DISABLED_RECOVERY_LEAK,
+		DISABLED_RECOVERY_SCRAMBLING,
+		DISABLED_RECOVERY_SLOWING,
+		DISABLED_RECOVERY_TIME,
+		DISABLED_REPAIR_DELAY,
+		DISCHARGE_RESISTANCE,
+		DISCHARGE_RESISTANCE_ENERGY,
+		DISCHARGE_RESISTANCE_FUEL,
+		DISCHARGE_RESISTANCE_HEAT,
+		DISRUPTION_RESISTANCE,
+		DISRUPTION_RESISTANCE_ENERGY,
+		DISRUPTION_RESISTANCE_FUEL,
+		DISRUPTION_RESISTANCE_HEAT,
+		DRAG,
+		DRAG_REDUCTION,
+		ENERGY_CAPACITY,
+		ENERGY_CONSUMPTION,
+		ENERGY_GENERATION,
+		FUEL_CAPACITY,
+		FUEL_CONSUMPTION,
+		FUEL_ENERGY,
+		FUEL_GENERATION,
+		FUEL_HEAT,
+		HEAT_CAPACITY,
+		HEAT_DISSIPATION,
+		HEAT_GENERATION,
+		HULL,
+		HULL_ENERGY,
+		HULL_ENERGY_MULTIPLIER,
+		HULL_FUEL,
+		HULL_FUEL_MULTIPLIER,
+		HULL_HEAT,
+		HULL_HEAT_MULTIPLIER,
+		HULL_MULTIPLIER,
+		HULL_REPAIR_MULTIPLIER,
+		HULL_REPAIR_RATE,
+		HULL_THRESHOLD,
+		INERTIA_REDUCTION,
+		ION_RESISTANCE,
+		ION_RESISTANCE_ENERGY,
+		ION_RESISTANCE_FUEL,
+		ION_RESISTANCE_HEAT,
+		JUMP_SPEED,
+		LEAK_RESISTANCE,
+		LEAK_RESISTANCE_ENERGY,
+		LEAK_RESISTANCE_FUEL,
+		LEAK_RESISTANCE_HEAT,
+		OVERHEAT_DAMAGE_RATE,
+		OVERHEAT_DAMAGE_THRESHOLD,
+		RAMSCOOP,
+		REPAIR_DELAY,
+		REVERSE_THRUST,
+		REVERSE_THRUSTING_BURN,
+		REVERSE_THRUSTING_CORROSION,
+		REVERSE_THRUSTING_DISCHARGE,
+		REVERSE_THRUSTING_DISRUPTION,
+		REVERSE_THRUSTING_ENERGY,
+		REVERSE_THRUSTING_FUEL,
+		REVERSE_THRUSTING_HEAT,
+		REVERSE_THRUSTING_HULL,
+		REVERSE_THRUSTING_ION,
+		REVERSE_THRUSTING_LEAKAGE,
+		REVERSE_THRUSTING_SCRAMBLE,
+		REVERSE_THRUSTING_SHIELDS,
+		REVERSE_THRUSTING_SLOWING,
+		SCRAM_DRIVE,
+		SCRAMBLE_RESISTANCE,
+		SCRAMBLE_RESISTANCE_ENERGY,
+		SCRAMBLE_RESISTANCE_FUEL,
+		SCRAMBLE_RESISTANCE_HEAT,
+		SHIELD_DELAY,
+		SHIELD_ENERGY,
+		SHIELD_ENERGY_MULTIPLIER,
+		SHIELD_FUEL,
+		SHIELD_FUEL_MULTIPLIER,
+		SHIELD_GENERATION,
+		SHIELD_GENERATION_MULTIPLIER,
+		SHIELD_HEAT,
+		SHIELD_HEAT_MULTIPLIER,
+		SHIELD_MULTIPLIER,
+		SHIELDS,
+		SLOWING_RESISTANCE,
+		SLOWING_RESISTANCE_ENERGY,
+		SLOWING_RESISTANCE_FUEL,
+		SLOWING_RESISTANCE_HEAT,
+		SOLAR_COLLECTION,
+		SOLAR_HEAT,
+		THRESHOLD_PERCENTAGE,
+		THRUST,
+		THRUSTING_BURN,
+		THRUSTING_CORROSION,
+		THRUSTING_DISCHARGE,
+		THRUSTING_DISRUPTION,
+		THRUSTING_ENERGY,
+		THRUSTING_FUEL,
+		THRUSTING_HEAT,
+		THRUSTING_HULL,
+		THRUSTING_ION,
+		THRUSTING_LEAKAGE,
+		THRUSTING_SCRAMBLE,
+		THRUSTING_SHIELDS,
+		THRUSTING_SLOWING,
+		TURN,
+		TURN_MULTIPLIER,
+		TURNING_BURN,
+		TURNING_CORROSION,
+		TURNING_DISCHARGE,
+		TURNING_DISRUPTION,
+		TURNING_ENERGY,
+		TURNING_FUEL,
+		TURNING_HEAT,
+		TURNING_HULL,
+		TURNING_ION,
+		TURNING_LEAKAGE,
+		TURNING_SCRAMBLE,
+		TURNING_SHIELDS,
+		TURNING_SLOWING,
+		COUNT
+	};
+
+
+public:
+	// Get the name of the given attribute.
+	static const char *Name(Id id);
+	// Get the ID of the attribute with the given name, or COUNT if it does not
+	// have one.
+	static Id Find(const char *name);
+};
@@ -87,6 +87,16 @@ void Bitset::Set(size_t index) noexcept
 
 
 
+// Resets the bit at the specified index.
+void Bitset::Reset(size_t index) noexcept
+{
+	const auto blockIndex = index / BITS_PER_BLOCK;
+	const auto pos = index % BITS_PER_BLOCK;
+	bits[blockIndex] &= ~(uint64_t(1) << pos);
+}
+
+
+
 // Resets all bits in the bitset.
 void Bitset::Reset() noexcept
 {
@@ -25,6 +25,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Ship.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <numeric>
 #include <set>
@@ -38,16 +39,21 @@ namespace {
 	// Velocity used for any projectiles with v > MAX_VELOCITY
 	constexpr int USED_MAX_VELOCITY = MAX_VELOCITY - 1;
 	// Warn the user only once about too-large projectile velocities.
-	bool warned = false;
+	atomic<bool> warned = false;
 
 	thread_local vector<bool> seen;
+
+	// If the previous order is this far from sorted, it is faster to sort the
+	// boxes from scratch than to keep on insertion sorting them.
+	constexpr size_t MAX_SHIFTS_PER_BOX = 8;
 }
 
 
 // Initialize a collision set. The cell size and cell count should both be
 // powers of two; otherwise, they are rounded down to a power of two.
-CollisionSet::CollisionSet(unsigned cellSize, unsigned cellCount, CollisionType collisionType)
-	: collisionType(collisionType)
+CollisionSet::CollisionSet(unsigned cellSize, unsigned cellCount, CollisionType collisionType,
+		BroadPhase broadPhase)
+	: collisionType(collisionType), broadPhase(broadPhase)
 {
 	// Right shift amount to convert from (x, y) location to grid (x, y).
 	SHIFT = 0u;
@@ -68,6 +74,13 @@ CollisionSet::CollisionSet(unsigned cellSize, unsigned cellCount, CollisionType
 
 
 
+CollisionSet::BroadPhase CollisionSet::GetBroadPhase() const
+{
+	return broadPhase;
+}
+
+
+
 // Clear all objects in the set.
 void CollisionSet::Clear(int step)
 {
@@ -77,6 +90,10 @@ void CollisionSet::Clear(int step)
 	sorted.clear();
 	counts.clear();
 	all.clear();
+	boxes.clear();
+	if(broadPhase == BroadPhase::SWEEP)
+		return;
+
 	// The counts vector starts with two sentinel slots that will be used in the
 	// course of performing the radix sort.
 	counts.resize(CELLS * CELLS + 2u, 0u);
@@ -87,6 +104,13 @@ void CollisionSet::Clear(int step)
 // Add an object to the set.
 void CollisionSet::Add(Body &body)
 {
+	// The sweep and prune boxes are all built at once in Finish().
+	if(broadPhase == BroadPhase::SWEEP)
+	{
+		all.emplace_back(&body);
+		return;
+	}
+
 	// Calculate the range of (x, y) grid coordinates this object covers.
 	int minX = static_cast<int>(body.Position().X() - body.Radius()) >> SHIFT;
 	int minY = static_cast<int>(body.Position().Y() - body.Radius()) >> SHIFT;
@@ -114,6 +138,12 @@ void CollisionSet::Add(Body &body)
 // Finish adding objects (and organize them into the final lookup table).
 void CollisionSet::Finish()
 {
+	if(broadPhase == BroadPhase::SWEEP)
+	{
+		FinishSweep();
+		return;
+	}
+
 	// Perform a partial sum to convert the counts of items in each bin into the
 	// index of the output element where that bin begins.
 	partial_sum(counts.begin(), counts.end(), counts.begin());
@@ -155,6 +185,12 @@ void CollisionSet::Line(const Projectile &projectile, vector<Collision> &result)
 void CollisionSet::Line(const Point &from, const Point &to, vector<Collision> &lineResult,
 		const Government *pGov, const Body *target) const
 {
+	if(broadPhase == BroadPhase::SWEEP)
+	{
+		SweepLine(from, to, lineResult, pGov, target);
+		return;
+	}
+
 	const int x = from.X();
 	const int y = from.Y();
 	const int endX = to.X();
@@ -202,12 +238,9 @@ void CollisionSet::Line(const Point &from, const Point &to, vector<Collision> &l
 	if(pVelocity.Length() > MAX_VELOCITY)
 	{
 		// Cap projectile velocity to prevent integer overflows.
-		if(!warned)
-		{
+		if(!warned.exchange(true))
 			Logger::Log("A projectile exceeded the maximum allowed velocity (" + to_string(MAX_VELOCITY) + ").",
 				Logger::Level::WARNING);
-			warned = true;
-		}
 		Point newEnd = from + pVelocity.Unit() * USED_MAX_VELOCITY;
 
 		Line(from, newEnd, lineResult, pGov, target);
@@ -321,6 +354,12 @@ void CollisionSet::Circle(const Point &center, double radius, vector<Body *> &re
 // centered at the given point.
 void CollisionSet::Ring(const Point &center, double inner, double outer, vector<Body *> &circleResult) const
 {
+	if(broadPhase == BroadPhase::SWEEP)
+	{
+		SweepRing(center, inner, outer, circleResult);
+		return;
+	}
+
 	// Calculate the range of (x, y) grid coordinates this ring covers.
 	const int minX = static_cast<int>(center.X() - outer) >> SHIFT;
 	const int minY = static_cast<int>(center.Y() - outer) >> SHIFT;
@@ -364,7 +403,186 @@ void CollisionSet::Ring(const Point &center, double inner, double outer, vector<
 
 
 
+// Get all objects in the grid cells that the given circle overlaps, without
+// checking their shapes or distances.
+void CollisionSet::Nearby(const Point &center, double radius, vector<Body *> &nearbyResult) const
+{
+	if(broadPhase == BroadPhase::SWEEP)
+	{
+		SweepNearby(center, radius, nearbyResult);
+		return;
+	}
+
+	// Calculate the range of (x, y) grid coordinates this circle covers.
+	const int minX = static_cast<int>(center.X() - radius) >> SHIFT;
+	const int minY = static_cast<int>(center.Y() - radius) >> SHIFT;
+	const int maxX = static_cast<int>(center.X() + radius) >> SHIFT;
+	const int maxY = static_cast<int>(center.Y() + radius) >> SHIFT;
+
+	seen.clear();
+	seen.resize(all.size());
+
+	for(int y = minY; y <= maxY; ++y)
+	{
+		const auto gy = y & WRAP_MASK;
+		for(int x = minX; x <= maxX; ++x)
+		{
+			const auto gx = x & WRAP_MASK;
+			const auto index = gy * CELLS + gx;
+			vector<Entry>::const_iterator it = sorted.begin() + counts[index];
+			vector<Entry>::const_iterator end = sorted.begin() + counts[index + 1];
+
+			for( ; it != end; ++it)
+			{
+				// Skip objects that were put in this same grid cell only because
+				// of the cell coordinates wrapping around.
+				if(it->x != x || it->y != y)
+					continue;
+
+				if(seen[it->seenIndex])
+					continue;
+				seen[it->seenIndex] = true;
+
+				nearbyResult.push_back(it->body);
+			}
+		}
+	}
+}
+
+
+
 const vector<Body *> &CollisionSet::All() const
 {
 	return all;
 }
+
+
+
+CollisionSet::Box::Box(Body *body, unsigned index, const Point &center, double radius)
+	: body(body), index(index), minX(center.X() - radius), maxX(center.X() + radius),
+	minY(center.Y() - radius), maxY(center.Y() + radius)
+{
+}
+
+
+
+// Build the bounding boxes and sort them by their minimum x coordinate.
+void CollisionSet::FinishSweep()
+{
+	// If the objects are not the ones from the last step, there is no order
+	// worth keeping. (If only some of them changed, the sort below will just
+	// take a bit longer.)
+	bool reuseOrder = (order.size() == all.size());
+	if(!reuseOrder)
+	{
+		order.resize(all.size());
+		iota(order.begin(), order.end(), 0u);
+	}
+
+	maxWidth = 0.;
+	boxes.reserve(all.size());
+	for(unsigned index : order)
+	{
+		Body *body = all[index];
+		const double radius = body->Radius();
+		boxes.emplace_back(body, index, body->Position(), radius);
+		maxWidth = max(maxWidth, 2. * radius);
+	}
+
+	const auto byMinX = [](const Box &a, const Box &b) -> bool { return a.minX < b.minX; };
+	if(reuseOrder)
+	{
+		// The boxes should be almost sorted already, so an insertion sort is
+		// close to linear. Give up on it if that turns out not to be the case.
+		size_t budget = MAX_SHIFTS_PER_BOX * boxes.size();
+		for(size_t i = 1; i < boxes.size() && budget; ++i)
+		{
+			Box box = boxes[i];
+			size_t j = i;
+			for( ; j && box.minX < boxes[j - 1].minX && budget; --j, --budget)
+				boxes[j] = boxes[j - 1];
+			boxes[j] = box;
+		}
+		if(!budget)
+			sort(boxes.begin(), boxes.end(), byMinX);
+	}
+	else
+		sort(boxes.begin(), boxes.end(), byMinX);
+
+	for(size_t i = 0; i < boxes.size(); ++i)
+		order[i] = boxes[i].index;
+}
+
+
+
+void CollisionSet::SweepLine(const Point &from, const Point &to, vector<Collision> &lineResult,
+	const Government *pGov, const Body *target) const
+{
+	const double minX = min(from.X(), to.X());
+	const double maxX = max(from.X(), to.X());
+	const double minY = min(from.Y(), to.Y());
+	const double maxY = max(from.Y(), to.Y());
+	const Point velocity = to - from;
+	const double lengthSquared = velocity.LengthSquared();
+
+	for(auto it = SweepBegin(minX); it != boxes.end() && it->minX <= maxX; ++it)
+	{
+		if(it->maxX < minX || it->maxY < minY || it->minY > maxY)
+			continue;
+
+		// A long diagonal line has a large bounding box, so also check that the
+		// line actually comes within this object's radius.
+		const Point offset = it->body->Position() - from;
+		const double t = lengthSquared ? clamp(offset.Dot(velocity) / lengthSquared, 0., 1.) : 0.;
+		const double radius = .5 * (it->maxX - it->minX);
+		if((offset - velocity * t).LengthSquared() > radius * radius)
+			continue;
+
+		// Check if this projectile can hit this object. If either the
+		// projectile or the object has no government, it will always hit.
+		const Government *iGov = it->body->GetGovernment();
+		if(it->body != target && iGov && pGov && !iGov->IsEnemy(pGov))
+			continue;
+
+		const Mask &mask = it->body->GetMask(step);
+		const double range = mask.Collide(-offset, velocity, it->body->Facing());
+
+		if(range < 1.)
+			lineResult.emplace_back(it->body, collisionType, range);
+	}
+}
+
+
+
+void CollisionSet::SweepRing(const Point &center, double inner, double outer, vector<Body *> &circleResult) const
+{
+	for(auto it = SweepBegin(center.X() - outer); it != boxes.end() && it->minX <= center.X() + outer; ++it)
+	{
+		if(it->maxX < center.X() - outer || it->maxY < center.Y() - outer || it->minY > center.Y() + outer)
+			continue;
+
+		const Mask &mask = it->body->GetMask(step);
+		Point offset = center - it->body->Position();
+		const double length = offset.Length();
+		if((length <= outer && length >= inner)
+			|| mask.WithinRing(offset, it->body->Facing(), inner, outer))
+			circleResult.push_back(it->body);
+	}
+}
+
+
+
+void CollisionSet::SweepNearby(const Point &center, double radius, vector<Body *> &nearbyResult) const
+{
+	for(auto it = SweepBegin(center.X() - radius); it != boxes.end() && it->minX <= center.X() + radius; ++it)
+		if(it->maxX >= center.X() - radius && it->maxY >= center.Y() - radius && it->minY <= center.Y() + radius)
+			nearbyResult.push_back(it->body);
+}
+
+
+
+vector<CollisionSet::Box>::const_iterator CollisionSet::SweepBegin(double minX) const
+{
+	return lower_bound(boxes.begin(), boxes.end(), minX - maxWidth,
+		[](const Box &box, double x) -> bool { return box.minX < x; });
+}
@@ -29,12 +29,27 @@ class Projectile;
 
 // A CollisionSet allows efficient collision detection by splitting space up
 // into a grid and keeping track of which objects are in each grid cell. A check
-// for collisions can then only examine objects in certain cells.
+// for collisions can then only examine objects in certain cells. Alternatively,
+// a set can keep its objects' bounding boxes sorted along the x axis ("sweep and
+// prune"), which does not alias distant objects into the same cell and does not
+// need to walk every cell along a long line.
 class CollisionSet {
+public:
+	// The ways a set can find the objects that a query might touch.
+	enum class BroadPhase : int {
+		GRID,
+		SWEEP,
+	};
+
+
 public:
 	// Initialize a collision set. The cell size and cell count should both be
-	// powers of two; otherwise, they are rounded down to a power of two.
-	CollisionSet(unsigned cellSize, unsigned cellCount, CollisionType collisionType);
+	// powers of two; otherwise, they are rounded down to a power of two. They
+	// are not used if the set uses the sweep and prune broad phase.
+	CollisionSet(unsigned cellSize, unsigned cellCount, CollisionType collisionType,
+		BroadPhase broadPhase = BroadPhase::GRID);
+
+	BroadPhase GetBroadPhase() const;
 
 	// Clear all objects in the set. Specify which engine step we are on, so we
 	// know what animation frame each object is on.
@@ -58,6 +73,10 @@ public:
 	// Get all objects touching a ring with a given inner and outer range
 	// centered at the given point.
 	void Ring(const Point &center, double inner, double outer, std::vector<Body *> &result) const;
+	// Get all objects in the grid cells (or, when sweeping, all objects whose
+	// bounding boxes) the given circle overlaps, without checking their shapes
+	// or distances. This is a superset of Circle().
+	void Nearby(const Point &center, double radius, std::vector<Body *> &result) const;
 
 	// Get all objects within this collision set.
 	const std::vector<Body *> &All() const;
@@ -75,10 +94,36 @@ private:
 		int y;
 	};
 
+	// An object's bounding box, for the sweep and prune broad phase.
+	class Box {
+	public:
+		Box() = default;
+		Box(Body *body, unsigned index, const Point &center, double radius);
+
+		Body *body;
+		unsigned index;
+		double minX;
+		double maxX;
+		double minY;
+		double maxY;
+	};
+
+
+private:
+	// The sweep and prune versions of the queries above.
+	void FinishSweep();
+	void SweepLine(const Point &from, const Point &to, std::vector<Collision> &result,
+		const Government *pGov, const Body *target) const;
+	void SweepRing(const Point &center, double inner, double outer, std::vector<Body *> &result) const;
+	void SweepNearby(const Point &center, double radius, std::vector<Body *> &result) const;
+	// Get the first box that could overlap a query whose bounds begin at minX.
+	std::vector<Box>::const_iterator SweepBegin(double minX) const;
+
 
 private:
 	// The type of collisions this CollisionSet is responsible for.
 	CollisionType collisionType;
+	BroadPhase broadPhase;
 
 	// The size of individual cells of the grid.
 	unsigned CELL_SIZE;
@@ -98,4 +143,14 @@ private:
 	std::vector<Entry> sorted;
 	// After Finish(), counts[index] is where a certain bin begins.
 	std::vector<unsigned> counts;
+
+	// For sweep and prune, the bounding boxes sorted by their minimum x, and the
+	// order (as indices into "all") they were in after the last Finish(). Objects
+	// move only a little from one step to the next, so starting from the last
+	// order leaves very little to sort.
+	std::vector<Box> boxes;
+	std::vector<unsigned> order;
+	// The widest bounding box, which limits how far before a query's bounds an
+	// overlapping box can begin.
+	double maxWidth = 0.;
 };
@@ -15,9 +15,15 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "ConditionEntry.h"
 
+#include <atomic>
 
 using namespace std;
 
+namespace {
+	// Each change to any condition gets the next revision.
+	atomic<uint64_t> lastRevision = 0;
+}
+
 
 
 ConditionEntry::ConditionEntry(const string &name)
@@ -161,6 +167,20 @@ void ConditionEntry::ProvideNamed(function<int64_t(const ConditionEntry &)> getF
 
 void ConditionEntry::NotifyUpdate(uint64_t value)
 {
-	// Subscribing is not implemented yet.
-	return;
+	// Subscribing is not implemented yet, but remember when the change happened.
+	revision = ++lastRevision;
+}
+
+
+
+uint64_t ConditionEntry::LastRevision()
+{
+	return lastRevision;
+}
+
+
+
+bool ConditionEntry::ChangedSince(uint64_t revision) const
+{
+	return providingEntry || getFunction || this->revision > revision;
 }
@@ -70,10 +70,17 @@ public:
 	/// Notify all subscribed listeners that the value of the condition changed.
 	void NotifyUpdate(uint64_t value);
 
+	/// Get the revision of the most recent change to any condition. Revisions only ever increase.
+	static uint64_t LastRevision();
+	/// Check if this condition may have changed after the given revision. The values of derived conditions are not
+	/// tracked, so they always count as changed.
+	bool ChangedSince(uint64_t revision) const;
+
 
 private:
 	std::string name; ///< Name of this entry, set during construction of the entry object.
 	int64_t value = 0; ///< Value of this condition, in case of direct access.
+	uint64_t revision = 0; ///< Revision of the last change to this condition.
 
 	/// Get function to get the value of the ConditionEntry. GetFunctions are required for any derived provider.
 	std::function<int64_t(const ConditionEntry &)> getFunction;
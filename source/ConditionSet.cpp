@@ -21,6 +21,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Logger.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
 #include <numeric>
@@ -31,6 +32,9 @@ using namespace std;
 
 namespace
 {
+	/// The most values that a compiled program may need to keep on its stack. Deeper expressions are not compiled.
+	constexpr size_t MAX_STACK = 32;
+
 	typedef int64_t (*BinFun)(int64_t, int64_t);
 	BinFun Op(ConditionSet::ExpressionOp op)
 	{
@@ -124,6 +128,94 @@ namespace
 
 
 
+/// An expression flattened into a list of instructions that work on a stack of values, with each condition it
+/// uses looked up in the conditions store once, when it is compiled. The 'and' and 'or' instructions jump past
+/// the sub-expressions that no longer need to be evaluated, just like the tree evaluation stops early.
+class ConditionSet::Program {
+public:
+	enum class Code : uint8_t {
+		LITERAL, ///< Push the value.
+		ENTRY, ///< Push the value of the condition entry.
+		NAMED, ///< Push the value of the condition with the name at the given index, which has no entry of its own.
+		AND, ///< Pop a value. If it is zero, the result below it becomes zero and the program jumps to the value,
+			///< otherwise it becomes the result if the result is still zero.
+		OR, ///< If the top value is not zero, jump to the value. Otherwise pop it.
+		APPLY ///< Pop a value, and combine it into the value below it using the function.
+	};
+
+	struct Instruction {
+		Code code;
+		/// The literal value, the index of the condition name, or the instruction to jump to.
+		int64_t value = 0;
+		const ConditionEntry *entry = nullptr;
+		BinFun function = nullptr;
+	};
+
+
+public:
+	int64_t Run() const;
+
+
+public:
+	/// The conditions store that the entries were found in, and its generation at the time.
+	const ConditionsStore *conditions = nullptr;
+	uint64_t generation = 0;
+	/// The most values the stack will hold, or more than MAX_STACK if the expression could not be compiled.
+	size_t depth = 0;
+	std::vector<Instruction> code;
+	std::vector<std::string> names;
+};
+
+
+
+int64_t ConditionSet::Program::Run() const
+{
+	array<int64_t, MAX_STACK> stack;
+	size_t top = 0;
+	size_t next = 0;
+	while(next < code.size())
+	{
+		const Instruction &instruction = code[next++];
+		switch(instruction.code)
+		{
+			case Code::LITERAL:
+				stack[top++] = instruction.value;
+				break;
+			case Code::ENTRY:
+				stack[top++] = *instruction.entry;
+				break;
+			case Code::NAMED:
+				stack[top++] = conditions->Get(names[instruction.value]);
+				break;
+			case Code::AND:
+			{
+				int64_t childResult = stack[--top];
+				if(!childResult)
+				{
+					stack[top - 1] = 0;
+					next = instruction.value;
+				}
+				else if(!stack[top - 1])
+					stack[top - 1] = childResult;
+				break;
+			}
+			case Code::OR:
+				if(stack[top - 1])
+					next = instruction.value;
+				else
+					--top;
+				break;
+			case Code::APPLY:
+				--top;
+				stack[top - 1] = instruction.function(stack[top - 1], stack[top]);
+				break;
+		}
+	}
+	return stack[0];
+}
+
+
+
 ConditionSet::ConditionSet(const ConditionsStore *conditions)
 {
 	this->conditions = conditions;
@@ -166,6 +258,7 @@ ConditionSet &ConditionSet::operator=(const ConditionSet &&other) noexcept
 	conditionName = std::move(other.conditionName);
 	children = std::move(other.children);
 	conditions = other.conditions;
+	program = other.program;
 
 	return *this;
 }
@@ -189,6 +282,7 @@ ConditionSet &ConditionSet::operator=(const ConditionSet &other)
 	conditionName = other.conditionName;
 	children = other.children;
 	conditions = other.conditions;
+	program = other.program;
 
 	return *this;
 }
@@ -201,6 +295,7 @@ void ConditionSet::Load(const DataNode &node, const ConditionsStore *conditions)
 	if(!conditions)
 		throw runtime_error("Unable to Load ConditionSet without a pointer to a ConditionsStore!");
 	this->conditions = conditions;
+	program.reset();
 
 	// The top-node is always an 'and' node, without the keyword.
 	expressionOperator = ExpressionOp::AND;
@@ -316,6 +411,7 @@ void ConditionSet::SaveSubset(DataWriter &out) const
 
 void ConditionSet::MakeNever()
 {
+	program.reset();
 	children.clear();
 	expressionOperator = ExpressionOp::LIT;
 	literal = 0;
@@ -352,6 +448,30 @@ bool ConditionSet::Test() const
 
 
 int64_t ConditionSet::Evaluate() const
+{
+	// Without a conditions store, there is nothing to look the conditions up in ahead of time.
+	if(!conditions)
+		return EvaluateTree();
+
+	// Compile the expression again if the entries it found may have moved or been hidden.
+	if(!program || program->generation != conditions->Generation())
+	{
+		auto compiled = make_shared<Program>();
+		compiled->conditions = conditions;
+		compiled->generation = conditions->Generation();
+		if(!Compile(*compiled, 0))
+			compiled->depth = MAX_STACK + 1;
+		program = std::move(compiled);
+	}
+	if(program->depth > MAX_STACK)
+		return EvaluateTree();
+
+	return program->Run();
+}
+
+
+
+int64_t ConditionSet::EvaluateTree() const
 {
 	switch(expressionOperator)
 	{
@@ -373,7 +493,7 @@ int64_t ConditionSet::Evaluate() const
 			int64_t result = 0;
 			for(const ConditionSet &child : children)
 			{
-				int64_t childResult = child.Evaluate();
+				int64_t childResult = child.EvaluateTree();
 				if(!childResult)
 					return 0;
 				// Assign the first non-zero result to the result variable.
@@ -385,7 +505,7 @@ int64_t ConditionSet::Evaluate() const
 		case ExpressionOp::OR:
 			for(const ConditionSet &child : children)
 			{
-				int64_t childResult = child.Evaluate();
+				int64_t childResult = child.EvaluateTree();
 				// Return the first non-zero result.
 				if(childResult)
 					return childResult;
@@ -398,9 +518,9 @@ int64_t ConditionSet::Evaluate() const
 	// If we have an accumulator function and children, then let's use the accumulator on the children.
 	BinFun accumulatorOp = Op(expressionOperator);
 	if(accumulatorOp != nullptr && !children.empty())
-		return accumulate(next(children.begin()), children.end(), children[0].Evaluate(),
+		return accumulate(next(children.begin()), children.end(), children[0].EvaluateTree(),
 			[&accumulatorOp](int64_t accumulated, const ConditionSet &b) -> int64_t {
-				return accumulatorOp(accumulated, b.Evaluate());
+				return accumulatorOp(accumulated, b.EvaluateTree());
 		});
 
 	// If we don't have an accumulator function, or no children, then return the default value.
@@ -425,6 +545,104 @@ set<string> ConditionSet::RelevantConditions() const
 
 
 
+bool ConditionSet::Compile(Program &program, size_t height) const
+{
+	using Code = Program::Code;
+	auto Push = [&program, height](Code code, int64_t value = 0) -> Program::Instruction &
+	{
+		program.depth = max(program.depth, height + 1);
+		program.code.push_back(Program::Instruction{code, value});
+		return program.code.back();
+	};
+	// Point the given jumps at the end of the program so far.
+	auto Land = [&program](const vector<size_t> &jumps) -> void
+	{
+		for(size_t jump : jumps)
+			program.code[jump].value = program.code.size();
+	};
+
+	switch(expressionOperator)
+	{
+		case ExpressionOp::VAR:
+		{
+			// A compiled program only tracks the generation of a single store.
+			if(conditions != program.conditions)
+				return false;
+			const ConditionEntry *entry = conditions->Find(conditionName);
+			if(!entry)
+				Push(Code::LITERAL);
+			else if(entry->Name() == conditionName)
+				Push(Code::ENTRY).entry = entry;
+			else
+			{
+				Push(Code::NAMED, program.names.size());
+				program.names.push_back(conditionName);
+			}
+			return true;
+		}
+		case ExpressionOp::LIT:
+			Push(Code::LITERAL, literal);
+			return true;
+		case ExpressionOp::AND:
+		{
+			// An empty AND section returns true.
+			if(children.empty())
+			{
+				Push(Code::LITERAL, 1);
+				return true;
+			}
+
+			// The result starts out as zero, below the value of each child.
+			Push(Code::LITERAL);
+			vector<size_t> jumps;
+			for(const ConditionSet &child : children)
+			{
+				if(!child.Compile(program, height + 1))
+					return false;
+				jumps.push_back(program.code.size());
+				Push(Code::AND);
+			}
+			Land(jumps);
+			return true;
+		}
+		case ExpressionOp::OR:
+		{
+			vector<size_t> jumps;
+			for(const ConditionSet &child : children)
+			{
+				if(!child.Compile(program, height))
+					return false;
+				jumps.push_back(program.code.size());
+				Push(Code::OR);
+			}
+			Push(Code::LITERAL);
+			Land(jumps);
+			return true;
+		}
+		default:
+			break;
+	}
+
+	BinFun accumulatorOp = Op(expressionOperator);
+	if(accumulatorOp == nullptr || children.empty())
+	{
+		Push(Code::LITERAL);
+		return true;
+	}
+
+	if(!children[0].Compile(program, height))
+		return false;
+	for(auto it = next(children.begin()); it != children.end(); ++it)
+	{
+		if(!it->Compile(program, height + 1))
+			return false;
+		Push(Code::APPLY).function = accumulatorOp;
+	}
+	return true;
+}
+
+
+
 bool ConditionSet::ParseNode(const DataNode &node)
 {
 	if(!conditions)
@@ -17,6 +17,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -100,7 +101,13 @@ public:
 	bool Test() const;
 
 	// Evaluate this expression into a numerical value. (The value can also be used as boolean.)
+	// The first evaluation compiles the expression into a flat program that reads the conditions it uses without
+	// looking them up by name, and later evaluations run that program until the conditions store changes shape.
+	// Like the conditions store itself, this is not safe to do from more than one thread at a time.
 	int64_t Evaluate() const;
+	/// Evaluate this expression by walking through its sub-expressions, without compiling it. This gives the
+	/// same result as Evaluate(), and is meant for checking and measuring the compiled programs.
+	int64_t EvaluateTree() const;
 
 	/// Parse the remainder of a node into this expression.
 	bool ParseNode(const DataNode &node, int &tokenNr);
@@ -113,6 +120,14 @@ public:
 
 
 private:
+	class Program;
+
+
+private:
+	/// Compile this expression into the end of the given program, for a stack that already holds the given number
+	/// of values. Returns false if this expression cannot be compiled.
+	bool Compile(Program &program, size_t height) const;
+
 	/// Parse a node completely into this expression; all tokens on the line and all children if there are any.
 	bool ParseNode(const DataNode &node);
 
@@ -175,6 +190,9 @@ private:
 	std::string conditionName;
 	/// Nested sets of conditions to be tested.
 	std::vector<ConditionSet> children;
+	/// The compiled form of this expression, if it has been evaluated since it was last changed. Copies of this
+	/// expression share it, since it never changes once it is compiled.
+	mutable std::shared_ptr<const Program> program;
 
 	// Let the assignment class call internal functions and parsers.
 	friend class ConditionAssignments;
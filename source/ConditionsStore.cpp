@@ -20,10 +20,15 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "DataWriter.h"
 #include "Logger.h"
 
+#include <atomic>
 #include <utility>
 
 using namespace std;
 
+namespace {
+	atomic<uint64_t> lastGeneration = 0;
+}
+
 
 
 // Constructor with loading primary conditions from datanode.
@@ -52,6 +57,17 @@ ConditionsStore::ConditionsStore(const map<string, int64_t> &initialConditions)
 
 
 
+ConditionsStore &ConditionsStore::operator=(ConditionsStore &&other) noexcept
+{
+	storage = std::move(other.storage);
+	// Both stores now hold different entries than before.
+	generation = NextGeneration();
+	other.generation = NextGeneration();
+	return *this;
+}
+
+
+
 void ConditionsStore::Load(const DataNode &node)
 {
 	for(const DataNode &child : node)
@@ -140,6 +156,8 @@ ConditionEntry &ConditionsStore::operator[](const string &name)
 	// Create the entry (name is used as key, and as ConditionEntry constructor argument.
 	auto emp = storage.emplace(make_pair(name, name));
 	it = emp.first;
+	// The new entry may hide a provider that lookups of other names used to find.
+	generation = NextGeneration();
 
 	// If a relevant prefix provider is found, then provision this entry with the provider.
 	if(ceprov != nullptr)
@@ -151,6 +169,20 @@ ConditionEntry &ConditionsStore::operator[](const string &name)
 
 
 
+const ConditionEntry *ConditionsStore::Find(const string &name) const
+{
+	return GetEntry(name);
+}
+
+
+
+uint64_t ConditionsStore::Generation() const
+{
+	return generation;
+}
+
+
+
 int64_t ConditionsStore::PrimariesSize() const
 {
 	int64_t result = 0;
@@ -197,3 +229,10 @@ const ConditionEntry *ConditionsStore::GetEntry(const string &name) const
 	// And otherwise we don't have a match.
 	return nullptr;
 }
+
+
+
+uint64_t ConditionsStore::NextGeneration()
+{
+	return ++lastGeneration;
+}
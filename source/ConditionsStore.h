@@ -48,7 +48,7 @@ public:
 	ConditionsStore(const ConditionsStore &) = delete;
 	ConditionsStore &operator=(const ConditionsStore &) = delete;
 	ConditionsStore(ConditionsStore &&) = delete;
-	ConditionsStore &operator=(ConditionsStore &&) = default;
+	ConditionsStore &operator=(ConditionsStore &&other) noexcept;
 
 	// Serialization support for this class.
 	void Load(const DataNode &node);
@@ -67,6 +67,14 @@ public:
 	/// Direct access to a specific condition (using the ConditionEntry as proxy).
 	ConditionEntry &operator[](const std::string &name);
 
+	/// Find the entry that Get() reads a condition from, without creating it. For a derived condition that does not
+	/// have an entry of its own, this is the entry of its prefixed provider. The entry stays where it is until the
+	/// generation of this store changes.
+	const ConditionEntry *Find(const std::string &name) const;
+	/// Get a number that changes whenever an entry is added to this store, or when another store is moved into it.
+	/// No two stores ever have the same generation.
+	uint64_t Generation() const;
+
 	// Helper for testing; check how many primary conditions are registered.
 	int64_t PrimariesSize() const;
 
@@ -78,8 +86,12 @@ private:
 	ConditionEntry *GetEntry(const std::string &name);
 	const ConditionEntry *GetEntry(const std::string &name) const;
 
+	static uint64_t NextGeneration();
+
 
 private:
 	// Storage for both the primary conditions as well as the providers.
 	std::map<std::string, ConditionEntry> storage;
+	// Anything that remembers entries of this store must look them up again when this changes.
+	uint64_t generation = NextGeneration();
 };
@@ -16,10 +16,96 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "DataFile.h"
 
 #include "Files.h"
+#include "Logger.h"
 #include "text/Utf8.h"
 
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <utility>
+#include <vector>
+
 using namespace std;
 
+namespace {
+	// Compiled data files begin with this tag and version number. Change the
+	// version whenever the format or the way files are parsed changes.
+	constexpr uint32_t CACHE_TAG = 0x43445345;
+	constexpr uint32_t CACHE_VERSION = 1;
+
+	filesystem::path cacheDirectory;
+
+
+	template <class Type>
+	void Write(string &out, Type value)
+	{
+		out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+
+
+	void Write(string &out, const string &value)
+	{
+		Write(out, static_cast<uint32_t>(value.size()));
+		out += value;
+	}
+
+
+	// Read values back out of a compiled data file, checking that each one
+	// is actually there.
+	class CacheReader {
+	public:
+		explicit CacheReader(const string &data) : data(data) {}
+
+		template <class Type>
+		bool Read(Type &value)
+		{
+			if(data.size() - pos < sizeof(value))
+				return false;
+			memcpy(&value, data.data() + pos, sizeof(value));
+			pos += sizeof(value);
+			return true;
+		}
+
+		bool Read(string &value)
+		{
+			uint32_t length = 0;
+			if(!Read(length) || data.size() - pos < length)
+				return false;
+			value.assign(data, pos, length);
+			pos += length;
+			return true;
+		}
+
+		size_t Remaining() const
+		{
+			return data.size() - pos;
+		}
+
+	private:
+		const string &data;
+		size_t pos = 0;
+	};
+}
+
+
+
+// Set the directory that compiled copies of data files are kept in.
+void DataFile::SetCacheDirectory(const filesystem::path &directory)
+{
+	cacheDirectory.clear();
+	if(directory.empty())
+		return;
+
+	error_code error;
+	filesystem::create_directories(directory, error);
+	if(error)
+		Logger::Log("Unable to create the data cache directory " + directory.string() + ": " + error.message(),
+			Logger::Level::WARNING);
+	else
+		cacheDirectory = directory;
+}
+
 
 
 // Constructor, taking a file path (in UTF-8).
@@ -80,8 +166,47 @@ void DataFile::Load(istream &in)
 
 
 
+// Load from a file path, building the nodes from a compiled copy of the file
+// if there is one that is up to date.
+void DataFile::LoadCached(const filesystem::path &path)
+{
+	// Files inside of zipped plugins have no timestamp to check a copy against.
+	error_code error;
+	const filesystem::file_time_type time = filesystem::last_write_time(path, error);
+	if(cacheDirectory.empty() || error)
+	{
+		Load(path);
+		return;
+	}
+	const int64_t timestamp = time.time_since_epoch().count();
+	const filesystem::path cachePath = cacheDirectory / (to_string(hash<string>()(path.string())) + ".bin");
+
+	// Note what file this node is in, so it will show up in error traces.
+	root.tokens.push_back("file");
+	root.tokens.push_back(path.string());
+	if(ReadCache(cachePath, path, timestamp))
+		return;
+
+	string data = Files::Read(path);
+	if(data.empty())
+	{
+		root.tokens.clear();
+		return;
+	}
+	// As a sentinel, make sure the file always ends in a newline.
+	if(data.back() != '\n')
+		data.push_back('\n');
+
+	// Only save files that parse without warnings, so that the warnings are
+	// repeated every time the file is loaded until it is fixed.
+	if(LoadData(data))
+		WriteCache(cachePath, path, timestamp);
+}
+
+
+
 // Get an iterator to the start of the list of nodes in this file.
-list<DataNode>::const_iterator DataFile::begin() const
+pmr::list<DataNode>::const_iterator DataFile::begin() const
 {
 	return root.begin();
 }
@@ -89,15 +214,15 @@ list<DataNode>::const_iterator DataFile::begin() const
 
 
 // Get an iterator to the end of the list of nodes in this file.
-list<DataNode>::const_iterator DataFile::end() const
+pmr::list<DataNode>::const_iterator DataFile::end() const
 {
 	return root.end();
 }
 
 
 
-// Parse the given text.
-void DataFile::LoadData(const string &data)
+// Parse the given text. Return false if any warnings were printed.
+bool DataFile::LoadData(const string &data)
 {
 	// Keep track of the current stack of indentation levels and the most recent
 	// node at each level - that is, the node that will be the "parent" of any
@@ -107,6 +232,10 @@ void DataFile::LoadData(const string &data)
 	bool fileIsTabs = false;
 	bool fileIsSpaces = false;
 	size_t lineNumber = 0;
+	bool isClean = true;
+	// Collect each line's tokens here, so that the node can be given exactly as
+	// much room for them as it needs.
+	vector<string> tokens;
 
 	size_t end = data.length();
 
@@ -147,7 +276,10 @@ void DataFile::LoadData(const string &data)
 		if(c == '#')
 		{
 			if(mixedIndentation)
+			{
 				root.PrintTrace("Mixed whitespace usage for comment at line " + to_string(lineNumber));
+				isClean = false;
+			}
 			while(c != '\n')
 				c = Utf8::DecodeCodePoint(data, pos);
 		}
@@ -164,7 +296,7 @@ void DataFile::LoadData(const string &data)
 		}
 
 		// Add this node as a child of the proper node.
-		list<DataNode> &children = stack.back()->children;
+		pmr::list<DataNode> &children = stack.back()->children;
 		children.emplace_back(stack.back());
 		DataNode &node = children.back();
 		node.lineNumber = lineNumber;
@@ -174,6 +306,7 @@ void DataFile::LoadData(const string &data)
 		separatorStack.push_back(separators);
 
 		// Tokenize the line. Skip comments and empty lines.
+		bool missingQuote = false;
 		while(c != '\n')
 		{
 			// Check if this token begins with a quotation mark. If so, it will
@@ -199,12 +332,13 @@ void DataFile::LoadData(const string &data)
 			// range, but it appears that some libraries do not handle that case
 			// correctly. So:
 			if(tokenPos == endPos)
-				node.tokens.emplace_back();
+				tokens.emplace_back();
 			else
-				node.tokens.emplace_back(data, tokenPos, endPos - tokenPos);
-			// This is not a fatal error, but it may indicate a format mistake:
+				tokens.emplace_back(data, tokenPos, endPos - tokenPos);
+			// This is not a fatal error, but it may indicate a format mistake.
+			// It can only happen for the last token, so it is reported below.
 			if(isQuoted && c == '\n')
-				node.PrintTrace("Closing quotation mark is missing:");
+				missingQuote = true;
 
 			if(c != '\n')
 			{
@@ -231,10 +365,119 @@ void DataFile::LoadData(const string &data)
 			}
 		}
 		// Now that we've reached the end of the line, we know no more tokens will be added to the node.
-		node.tokens.shrink_to_fit();
+		node.tokens.assign(make_move_iterator(tokens.begin()), make_move_iterator(tokens.end()));
+		tokens.clear();
+
+		if(missingQuote)
+		{
+			node.PrintTrace("Closing quotation mark is missing:");
+			isClean = false;
+		}
 
 		// Now that we've tokenized this node, print any mixed whitespace warnings.
 		if(mixedIndentation)
+		{
 			node.PrintTrace("Mixed whitespace usage at line");
+			isClean = false;
+		}
 	}
+	return isClean;
+}
+
+
+
+// Build the nodes from the compiled copy of the given file, if it exists and
+// is up to date. Return false if it could not be used.
+bool DataFile::ReadCache(const filesystem::path &cachePath, const filesystem::path &path, int64_t timestamp)
+{
+	error_code error;
+	if(!filesystem::is_regular_file(cachePath, error))
+		return false;
+
+	const string data = Files::Read(cachePath);
+	CacheReader in(data);
+	uint32_t tag = 0;
+	uint32_t version = 0;
+	int64_t sourceTimestamp = 0;
+	string sourcePath;
+	uint32_t count = 0;
+	if(!in.Read(tag) || !in.Read(version) || !in.Read(sourceTimestamp) || !in.Read(sourcePath)
+			|| tag != CACHE_TAG || version != CACHE_VERSION || sourceTimestamp != timestamp
+			|| sourcePath != path.string() || !in.Read(count))
+		return false;
+
+	// The nodes were written depth first. Keep track of how many children of
+	// each node on the current branch are still to be read.
+	vector<pair<DataNode *, uint32_t>> stack(1, make_pair(&root, count));
+	while(!stack.empty())
+	{
+		if(!stack.back().second)
+		{
+			stack.pop_back();
+			continue;
+		}
+		--stack.back().second;
+
+		DataNode *parent = stack.back().first;
+		DataNode &node = parent->children.emplace_back(parent);
+		uint32_t lineNumber = 0;
+		uint32_t tokens = 0;
+		// Each token takes at least four bytes, so a larger count means the data is corrupt.
+		bool isValid = in.Read(lineNumber) && in.Read(tokens) && tokens <= in.Remaining() / sizeof(uint32_t);
+		node.lineNumber = lineNumber;
+		node.tokens.resize(isValid ? tokens : 0);
+		for(string &token : node.tokens)
+			isValid &= in.Read(token);
+		if(!isValid || !in.Read(count))
+		{
+			root.children.clear();
+			return false;
+		}
+		if(count)
+			stack.emplace_back(&node, count);
+	}
+	if(in.Remaining())
+	{
+		root.children.clear();
+		return false;
+	}
+	return true;
+}
+
+
+
+// Save a compiled copy of the nodes that were parsed from the given file.
+void DataFile::WriteCache(const filesystem::path &cachePath, const filesystem::path &path, int64_t timestamp) const
+{
+	string out;
+	Write(out, CACHE_TAG);
+	Write(out, CACHE_VERSION);
+	Write(out, timestamp);
+	Write(out, path.string());
+	Write(out, static_cast<uint32_t>(root.children.size()));
+
+	// Write the nodes depth first, each followed by its number of children.
+	using Range = pair<pmr::list<DataNode>::const_iterator, pmr::list<DataNode>::const_iterator>;
+	vector<Range> stack(1, Range(root.children.begin(), root.children.end()));
+	while(!stack.empty())
+	{
+		if(stack.back().first == stack.back().second)
+		{
+			stack.pop_back();
+			continue;
+		}
+
+		const DataNode &node = *stack.back().first++;
+		Write(out, static_cast<uint32_t>(node.lineNumber));
+		Write(out, static_cast<uint32_t>(node.tokens.size()));
+		for(const string &token : node.tokens)
+			Write(out, token);
+		Write(out, static_cast<uint32_t>(node.children.size()));
+		if(!node.children.empty())
+			stack.emplace_back(node.children.begin(), node.children.end());
+	}
+
+	// Files::Write() uses text mode on some platforms, which would mangle the data.
+	ofstream file(cachePath, ios::binary);
+	file.write(out.data(), out.size());
 }
@@ -17,9 +17,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "DataNode.h"
 
+#include <cstdint>
 #include <filesystem>
 #include <istream>
 #include <list>
+#include <memory_resource>
 #include <string>
 
 
@@ -31,6 +33,12 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 // just a collection of one or more tokens that can be interpreted either as
 // strings or as floating point values; see DataNode for more information.
 class DataFile {
+public:
+	// Set the directory that compiled copies of data files are kept in. If it
+	// is empty (the default), LoadCached() is the same as Load().
+	static void SetCacheDirectory(const std::filesystem::path &directory);
+
+
 public:
 	// A DataFile can be loaded either from a file path or an istream.
 	DataFile() = default;
@@ -39,17 +47,29 @@ public:
 
 	void Load(const std::filesystem::path &path);
 	void Load(std::istream &in);
+	// Load from a file path, but build the nodes from a compiled copy of the
+	// file in the cache directory if there is one that is up to date, rather
+	// than parsing the text. Otherwise, parse it and save a compiled copy.
+	void LoadCached(const std::filesystem::path &path);
 
 	// Functions for iterating through all DataNodes in this file.
-	std::list<DataNode>::const_iterator begin() const;
-	std::list<DataNode>::const_iterator end() const;
+	std::pmr::list<DataNode>::const_iterator begin() const;
+	std::pmr::list<DataNode>::const_iterator end() const;
 
 
 private:
-	void LoadData(const std::string &data);
+	// Parse the given text. Return false if any warnings were printed.
+	bool LoadData(const std::string &data);
+	// Read or write the compiled copy of the given file.
+	bool ReadCache(const std::filesystem::path &cachePath, const std::filesystem::path &path, int64_t timestamp);
+	void WriteCache(const std::filesystem::path &cachePath, const std::filesystem::path &path, int64_t timestamp) const;
 
 
 private:
+	// All the nodes in this file are allocated from this arena, so that loading
+	// a file takes only a few large allocations, and they are all freed at once.
+	// Nodes copied out of the file are allocated normally.
+	std::pmr::monotonic_buffer_resource arena;
 	// This is the container for all DataNodes in this file.
-	DataNode root;
+	DataNode root{nullptr, &arena};
 };
@@ -38,9 +38,28 @@ DataNode::DataNode(const DataNode *parent) noexcept(false)
 
 
 
-// Copy constructor.
+// Construct a DataNode whose children and tokens are allocated with the given
+// allocator. DataFile sets the exact number of tokens after reading them, so
+// no capacity is reserved up front.
+DataNode::DataNode(const DataNode *parent, const allocator_type &allocator)
+	: children(allocator), tokens(allocator), parent(parent)
+{
+}
+
+
+
+// Copy constructor. The copy does not use the other node's allocator.
 DataNode::DataNode(const DataNode &other)
-	: children(other.children), tokens(other.tokens), lineNumber(std::move(other.lineNumber))
+	: children(other.children, allocator_type()), tokens(other.tokens, allocator_type()),
+	lineNumber(std::move(other.lineNumber))
+{
+	Reparent();
+}
+
+
+
+DataNode::DataNode(const DataNode &other, const allocator_type &allocator)
+	: children(other.children, allocator), tokens(other.tokens, allocator), lineNumber(other.lineNumber)
 {
 	Reparent();
 }
@@ -67,10 +86,21 @@ DataNode::DataNode(DataNode &&other) noexcept
 
 
 
+DataNode::DataNode(DataNode &&other, const allocator_type &allocator)
+	: children(std::move(other.children), allocator), tokens(std::move(other.tokens), allocator),
+	lineNumber(other.lineNumber)
+{
+	Reparent();
+}
+
+
+
 DataNode &DataNode::operator=(DataNode &&other) noexcept
 {
-	children.swap(other.children);
-	tokens.swap(other.tokens);
+	// Swapping is only allowed if both nodes use the same allocator. Otherwise,
+	// the contents are moved one by one.
+	children = std::move(other.children);
+	tokens = std::move(other.tokens);
 	lineNumber = other.lineNumber;
 	Reparent();
 	return *this;
@@ -87,7 +117,7 @@ int DataNode::Size() const noexcept
 
 
 // Get all tokens.
-const vector<string> &DataNode::Tokens() const noexcept
+const pmr::vector<string> &DataNode::Tokens() const noexcept
 {
 	return tokens;
 }
@@ -311,7 +341,7 @@ bool DataNode::HasChildren() const noexcept
 
 
 // Iterator to the beginning of the list of children.
-list<DataNode>::const_iterator DataNode::begin() const noexcept
+pmr::list<DataNode>::const_iterator DataNode::begin() const noexcept
 {
 	return children.begin();
 }
@@ -319,7 +349,7 @@ list<DataNode>::const_iterator DataNode::begin() const noexcept
 
 
 // Iterator to the end of the list of children.
-list<DataNode>::const_iterator DataNode::end() const noexcept
+pmr::list<DataNode>::const_iterator DataNode::end() const noexcept
 {
 	return children.end();
 }
@@ -17,6 +17,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <cstdint>
 #include <list>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -28,21 +29,31 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 // The tokens of a node are separated by white space, with quotation marks being
 // used to group multiple words into a single token. If the token text contains
 // quotation marks, it should be enclosed in backticks instead.
+// A node and all of its children can be allocated from a single memory resource,
+// which is how a DataFile keeps all of its nodes in one arena. Copies of a node
+// are always allocated normally, so they can outlive the arena.
 class DataNode {
+public:
+	using allocator_type = std::pmr::polymorphic_allocator<DataNode>;
+
+
 public:
 	// Construct a DataNode. For the purpose of printing stack traces, each node
 	// must remember what its parent node is.
 	explicit DataNode(const DataNode *parent = nullptr) noexcept(false);
+	DataNode(const DataNode *parent, const allocator_type &allocator);
 	// Copying or moving a DataNode requires updating the parent pointers.
 	DataNode(const DataNode &other);
+	DataNode(const DataNode &other, const allocator_type &allocator);
 	DataNode &operator=(const DataNode &other);
 	DataNode(DataNode &&) noexcept;
+	DataNode(DataNode &&other, const allocator_type &allocator);
 	DataNode &operator=(DataNode &&) noexcept;
 
 	// Get the number of tokens in this node.
 	int Size() const noexcept;
 	// Get all the tokens in this node as an iterable vector.
-	const std::vector<std::string> &Tokens() const noexcept;
+	const std::pmr::vector<std::string> &Tokens() const noexcept;
 	// Add tokens to the node.
 	void AddToken(const std::string &token);
 	// Get the token at the given index. DataFile loading guarantees index 0 always exists.
@@ -72,8 +83,8 @@ public:
 	// Check if this node has any children. If so, the iterator functions below
 	// can be used to access them.
 	bool HasChildren() const noexcept;
-	std::list<DataNode>::const_iterator begin() const noexcept;
-	std::list<DataNode>::const_iterator end() const noexcept;
+	std::pmr::list<DataNode>::const_iterator begin() const noexcept;
+	std::pmr::list<DataNode>::const_iterator end() const noexcept;
 
 	// Print a message followed by a "trace" of this node and its parents.
 	int PrintTrace(const std::string &message = "") const;
@@ -86,9 +97,9 @@ private:
 
 private:
 	// These are "child" nodes found on subsequent lines with deeper indentation.
-	std::list<DataNode> children;
+	std::pmr::list<DataNode> children;
 	// These are the tokens found in this particular line of the data file.
-	std::vector<std::string> tokens;
+	std::pmr::vector<std::string> tokens;
 	// The parent pointer is used only for printing stack traces.
 	const DataNode *parent = nullptr;
 	// The line number in the given file that produced this node.
@@ -15,6 +15,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "DistanceMap.h"
 
+#include "DistanceTable.h"
+#include "GameData.h"
 #include "Planet.h"
 #include "PlayerInfo.h"
 #include "Ship.h"
@@ -23,6 +25,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "System.h"
 #include "Wormhole.h"
 
+#include <optional>
+
 using namespace std;
 
 
@@ -116,6 +120,19 @@ int DistanceMap::Days(const System &target) const
 
 
 
+// Find out how many days away the given system is in a map from the given
+// center with the given settings and no limits.
+int DistanceMap::Days(const System &center, const System &target,
+		WormholeStrategy wormholeStrategy, bool useJumpDrive)
+{
+	optional<int> days = GameData::Distances().Days(center, target, wormholeStrategy, useJumpDrive);
+	if(days)
+		return *days;
+	return DistanceMap(&center, wormholeStrategy, useJumpDrive).Days(target);
+}
+
+
+
 // Get a set containing all the systems.
 set<const System *> DistanceMap::Systems() const
 {
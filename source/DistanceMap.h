@@ -51,6 +51,13 @@ public:
 	explicit DistanceMap(const System *center, WormholeStrategy wormholeStrategy,
 			bool useJumpDrive, int maxSystems = -1, int maxDays = -1);
 
+	// Find out how many days away the given system is in a map from the given
+	// center with the given settings and no limits, or -1 if there is no route.
+	// This looks the answer up in the galaxy-wide distance table if it can, so
+	// it is much faster than building a map for it.
+	static int Days(const System &center, const System &system,
+			WormholeStrategy wormholeStrategy = WormholeStrategy::NONE, bool useJumpDrive = false);
+
 	// Find out if the given system is reachable.
 	bool HasRoute(const System &system) const;
 	// Find out how many days away the given system is.
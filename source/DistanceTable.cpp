@@ -0,0 +1,229 @@
+/* DistanceTable.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "DistanceTable.h"
+
+#include "Outfit.h"
+#include "Planet.h"
+#include "Set.h"
+#include "StellarObject.h"
+#include "System.h"
+#include "TaskQueue.h"
+#include "Wormhole.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// One table for each wormhole strategy, with and without a jump drive.
+	constexpr size_t VARIANTS = 6;
+	// The number of rows of a table that are filled in by each parallel task.
+	constexpr size_t BATCH_SIZE = 32;
+	// The entry for a system that cannot be reached.
+	constexpr uint16_t NO_ROUTE = numeric_limits<uint16_t>::max();
+
+	size_t Variant(WormholeStrategy wormholeStrategy, bool useJumpDrive)
+	{
+		return static_cast<size_t>(wormholeStrategy) * 2 + useJumpDrive;
+	}
+
+	// Every hop that can be made out of each system, with the fuel it takes,
+	// with the systems numbered by their position in the table.
+	struct Graph {
+		vector<size_t> offsets;
+		vector<size_t> targets;
+		vector<int> fuel;
+
+		bool operator==(const Graph &other) const = default;
+	};
+
+	// Find the same hops as DistanceMap would for a map without a ship or player.
+	Graph BuildGraph(const vector<const System *> &systems, const unordered_map<const System *, size_t> &index,
+		WormholeStrategy wormholeStrategy, bool useJumpDrive)
+	{
+		Graph graph;
+		graph.offsets.reserve(systems.size() + 1);
+		auto AddHop = [&graph, &index](const System *to, int fuel) -> void
+		{
+			auto it = index.find(to);
+			if(it == index.end())
+				return;
+			graph.targets.push_back(it->second);
+			graph.fuel.push_back(fuel);
+		};
+
+		for(const System *system : systems)
+		{
+			graph.offsets.push_back(graph.targets.size());
+
+			// Wormholes cost no fuel.
+			if(wormholeStrategy != WormholeStrategy::NONE)
+				for(const StellarObject &object : system->Objects())
+					if(object.HasSprite() && object.HasValidPlanet() && object.GetPlanet()->IsWormhole()
+						&& (object.GetPlanet()->IsUnrestricted() || wormholeStrategy == WormholeStrategy::ALL))
+						AddHop(&object.GetPlanet()->GetWormhole()->WormholeDestination(*system), 0);
+
+			const auto &links = system->Links();
+			for(const System *link : (useJumpDrive ? system->JumpNeighbors(System::DEFAULT_NEIGHBOR_DISTANCE) : links))
+				AddHop(link, static_cast<int>(links.contains(link)
+					? Outfit::DEFAULT_HYPERDRIVE_COST : Outfit::DEFAULT_JUMP_DRIVE_COST));
+		}
+		graph.offsets.push_back(graph.targets.size());
+
+		return graph;
+	}
+
+	// Fill in one row of a table. Like DistanceMap, this finds the route that
+	// uses the least fuel, and of those the one that takes the fewest days.
+	void FillRow(const Graph &graph, size_t from, uint16_t *row)
+	{
+		const size_t count = graph.offsets.size() - 1;
+		vector<pair<int, int>> best(count, make_pair(numeric_limits<int>::max(), 0));
+		using Entry = tuple<int, int, size_t>;
+		priority_queue<Entry, vector<Entry>, greater<Entry>> edgesTodo;
+
+		best[from] = make_pair(0, 0);
+		edgesTodo.emplace(0, 0, from);
+		while(!edgesTodo.empty())
+		{
+			auto [fuel, days, system] = edgesTodo.top();
+			edgesTodo.pop();
+			// Skip any entry for which a better route was found after it was queued.
+			if(best[system] != make_pair(fuel, days))
+				continue;
+
+			for(size_t i = graph.offsets[system]; i < graph.offsets[system + 1]; ++i)
+			{
+				pair<int, int> next(fuel + graph.fuel[i], days + 1);
+				size_t to = graph.targets[i];
+				if(next < best[to])
+				{
+					best[to] = next;
+					edgesTodo.emplace(next.first, next.second, to);
+				}
+			}
+		}
+
+		for(size_t to = 0; to < count; ++to)
+			row[to] = (best[to].first == numeric_limits<int>::max() ? NO_ROUTE : best[to].second);
+	}
+}
+
+
+
+class DistanceTable::Snapshot {
+public:
+	// Every system, in the order of the rows and columns of each table.
+	vector<const System *> systems;
+	unordered_map<const System *, size_t> index;
+	// The graph each table was built from, so that an update can tell whether
+	// the table is still correct.
+	array<Graph, VARIANTS> graphs;
+	// Tables that were built from the same graph are shared.
+	array<shared_ptr<const vector<uint16_t>>, VARIANTS> days;
+};
+
+
+
+DistanceTable::DistanceTable() = default;
+
+
+
+DistanceTable::~DistanceTable() = default;
+
+
+
+// Check how each system links to the others, and rebuild the tables of any
+// settings for which that changed.
+void DistanceTable::Update(const Set<System> &systems)
+{
+	const shared_ptr<const Snapshot> latest = atomic_load(&current);
+	auto next = make_shared<Snapshot>();
+	for(const auto &it : systems)
+	{
+		next->index.emplace(&it.second, next->systems.size());
+		next->systems.push_back(&it.second);
+	}
+	// The number of days to any system is less than the number of systems.
+	const size_t count = next->systems.size();
+	if(count >= NO_ROUTE)
+	{
+		atomic_store(&current, shared_ptr<const Snapshot>());
+		return;
+	}
+
+	const bool sameSystems = latest && latest->systems == next->systems;
+	TaskQueue queue;
+	for(size_t variant = 0; variant < VARIANTS; ++variant)
+	{
+		const Graph &graph = next->graphs[variant] = BuildGraph(next->systems, next->index,
+			static_cast<WormholeStrategy>(variant / 2), variant % 2);
+
+		// Most changes to the universe leave the travel graph alone.
+		if(sameSystems && latest->graphs[variant] == graph)
+		{
+			next->days[variant] = latest->days[variant];
+			continue;
+		}
+		// If no wormhole is restricted, for example, two variants have the same graph.
+		for(size_t other = 0; other < variant && !next->days[variant]; ++other)
+			if(next->graphs[other] == graph)
+				next->days[variant] = next->days[other];
+		if(next->days[variant])
+			continue;
+
+		auto table = make_shared<vector<uint16_t>>(count * count);
+		for(size_t begin = 0; begin < count; begin += BATCH_SIZE)
+			queue.Run([&graph, rows = table->data(), begin, count]() -> void
+				{
+					for(size_t from = begin; from < count && from < begin + BATCH_SIZE; ++from)
+						FillRow(graph, from, rows + from * count);
+				});
+		next->days[variant] = std::move(table);
+	}
+	queue.Wait();
+
+	atomic_store(&current, shared_ptr<const Snapshot>(std::move(next)));
+}
+
+
+
+// Find out how many days it takes to get from one system to the other, or -1
+// if there is no route.
+optional<int> DistanceTable::Days(const System &from, const System &to,
+	WormholeStrategy wormholeStrategy, bool useJumpDrive) const
+{
+	const shared_ptr<const Snapshot> tables = atomic_load(&current);
+	if(!tables)
+		return nullopt;
+
+	auto fromIt = tables->index.find(&from);
+	auto toIt = tables->index.find(&to);
+	if(fromIt == tables->index.end() || toIt == tables->index.end())
+		return nullopt;
+
+	uint16_t days = (*tables->days[Variant(wormholeStrategy, useJumpDrive)])
+		[fromIt->second * tables->systems.size() + toIt->second];
+	return days == NO_ROUTE ? -1 : days;
+}
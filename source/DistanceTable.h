@@ -0,0 +1,65 @@
+/* DistanceTable.h
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "WormholeStrategy.h"
+
+#include <memory>
+#include <optional>
+
+class System;
+
+template<class Type>
+class Set;
+
+
+
+// A galaxy-wide table of how many days it takes to get from any system to any
+// other, for each way of using wormholes with or without a jump drive. Each entry
+// is what a DistanceMap built from the first system with those settings (and no
+// ship, player, or limits) reports for the second, but looking it up does not
+// require a search. Reading the table may be done from any thread, even while
+// the main thread is updating it.
+class DistanceTable {
+public:
+	DistanceTable();
+	DistanceTable(const DistanceTable &) = delete;
+	DistanceTable &operator=(const DistanceTable &) = delete;
+	~DistanceTable();
+
+	// Check how each system links to the others, and rebuild the tables of any
+	// settings for which that changed. This must be done after the systems are
+	// updated, and whenever wormholes may have changed.
+	void Update(const Set<System> &systems);
+
+	// Find out how many days it takes to get from one system to the other, or -1
+	// if there is no route. If the table does not know about either system, for
+	// example because it has not been built yet, nothing is returned.
+	std::optional<int> Days(const System &from, const System &to,
+		WormholeStrategy wormholeStrategy, bool useJumpDrive) const;
+
+
+private:
+	class Snapshot;
+
+
+private:
+	// The tables that readers see. Each update replaces them as a whole. This is
+	// only accessed through std::atomic_load() and std::atomic_store(), and each
+	// reader holds its own reference, so replaced tables live until the last
+	// reader using them is done.
+	std::shared_ptr<const Snapshot> current;
+};
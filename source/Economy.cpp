@@ -0,0 +1,176 @@
+/* Economy.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "Economy.h"
+
+#include "Random.h"
+#include "Set.h"
+#include "System.h"
+#include "TaskQueue.h"
+#include "Trade.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+	// Dynamic economy parameters: how much of its production each system keeps
+	// and exports each day:
+	const double KEEP = .89;
+	const double EXPORT = .10;
+	// Standard deviation of the daily production of each commodity:
+	const double VOLUME = 2000.;
+
+	// The column of a trade good that is not one of the commodities.
+	constexpr size_t NO_COLUMN = numeric_limits<size_t>::max();
+	// The number of systems that receive their imports in each parallel task.
+	constexpr size_t BATCH_SIZE = 64;
+}
+
+
+
+// One commodity that a system trades.
+class Economy::Entry {
+public:
+	System::Price *price;
+	size_t column;
+};
+
+
+
+Economy::Economy() = default;
+
+
+
+Economy::~Economy() = default;
+
+
+
+void Economy::Invalidate()
+{
+	isBuilt = false;
+}
+
+
+
+// Advance the economy by one day.
+void Economy::Step(Set<System> &systems, const Trade &trade)
+{
+	if(!isBuilt)
+		Build(systems, trade);
+
+	// First, have each system generate new goods for local use and trade. The
+	// random numbers are drawn in the order the systems store their goods, so
+	// that a seeded game plays out the same as it always has.
+	fill(supply.begin(), supply.end(), 0.);
+	fill(exports.begin(), exports.end(), 0.);
+	const size_t rows = entryOffsets.size() - 1;
+	for(size_t row = 0; row < rows; ++row)
+		for(size_t i = entryOffsets[row]; i < entryOffsets[row + 1]; ++i)
+		{
+			System::Price &price = *entries[i].price;
+			double produced = price.supply * KEEP + Random::Normal() * VOLUME;
+			if(entries[i].column == NO_COLUMN)
+			{
+				// Goods that are not commodities are never traded with other systems.
+				price.exports = EXPORT * price.supply;
+				price.supply = produced;
+				price.Update();
+				continue;
+			}
+			const size_t cell = row * columns + entries[i].column;
+			exports[cell] = EXPORT * price.supply;
+			supply[cell] = produced;
+		}
+
+	// Then, send out the trade goods. Every system has already produced its goods,
+	// so each one can receive its imports independently of the others.
+	TaskQueue queue;
+	for(size_t begin = 0; begin < rows; begin += BATCH_SIZE)
+		queue.Run([this, begin, end = min(rows, begin + BATCH_SIZE)]() -> void
+			{
+				for(size_t row = begin; row < end; ++row)
+				{
+					double *received = supply.data() + row * columns;
+					for(size_t i = linkOffsets[row]; i < linkOffsets[row + 1]; ++i)
+					{
+						const double *sent = exports.data() + links[i] * columns;
+						const double scale = linkScales[i];
+						for(size_t column = 0; column < columns; ++column)
+							received[column] += sent[column] / scale;
+					}
+
+					for(size_t i = entryOffsets[row]; i < entryOffsets[row + 1]; ++i)
+						if(entries[i].column != NO_COLUMN)
+						{
+							System::Price &price = *entries[i].price;
+							price.supply = received[entries[i].column];
+							price.exports = exports[row * columns + entries[i].column];
+							price.Update();
+						}
+				}
+			});
+	queue.Wait();
+}
+
+
+
+// Find what each system trades and links to.
+void Economy::Build(Set<System> &systems, const Trade &trade)
+{
+	unordered_map<string, size_t> commodityColumns;
+	for(const auto &commodity : trade.Commodities())
+		commodityColumns.emplace(commodity.name, commodityColumns.size());
+	columns = trade.Commodities().size();
+
+	unordered_map<const System *, size_t> rows;
+	for(auto &it : systems)
+		rows.emplace(&it.second, rows.size());
+
+	entryOffsets.clear();
+	entries.clear();
+	linkOffsets.clear();
+	links.clear();
+	linkScales.clear();
+	for(auto &it : systems)
+	{
+		System &system = it.second;
+		entryOffsets.push_back(entries.size());
+		for(auto &good : system.trade)
+		{
+			auto column = commodityColumns.find(good.first);
+			entries.push_back(Entry{&good.second, column == commodityColumns.end() ? NO_COLUMN : column->second});
+		}
+
+		linkOffsets.push_back(links.size());
+		for(const System *link : system.Links())
+		{
+			auto row = rows.find(link);
+			if(row == rows.end() || link->Links().empty())
+				continue;
+			links.push_back(row->second);
+			linkScales.push_back(link->Links().size());
+		}
+	}
+	entryOffsets.push_back(entries.size());
+	linkOffsets.push_back(links.size());
+
+	supply.assign(rows.size() * columns, 0.);
+	exports.assign(rows.size() * columns, 0.);
+	isBuilt = true;
+}
@@ -0,0 +1,75 @@
+/* Economy.h
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class System;
+class Trade;
+
+template<class Type>
+class Set;
+
+
+
+// The daily production and exchange of trade goods between all systems. While
+// a day is being stepped, the supply of every commodity in every system is kept
+// in one table, with a row for each system and a column for each commodity, so
+// that no commodity has to be looked up by name. Each system still keeps its own
+// supply and prices in between steps, so they can be read and changed as before.
+class Economy {
+public:
+	Economy();
+	Economy(const Economy &) = delete;
+	Economy &operator=(const Economy &) = delete;
+	~Economy();
+
+	// Forget what each system trades and links to, so that it is looked up again
+	// before the next step. This must be done whenever any system may have been
+	// added, removed, or changed.
+	void Invalidate();
+
+	// Advance the economy by one day. Each system produces some of every commodity
+	// it trades, then receives part of what the systems it is linked to export.
+	void Step(Set<System> &systems, const Trade &trade);
+
+
+private:
+	class Entry;
+
+	// Find what each system trades and links to.
+	void Build(Set<System> &systems, const Trade &trade);
+
+
+private:
+	bool isBuilt = false;
+	size_t columns = 0;
+
+	// The commodities that each system trades, in the order the system stores
+	// them. The entries of each row start at its offset.
+	std::vector<size_t> entryOffsets;
+	std::vector<Entry> entries;
+	// The rows of the systems that each system is linked to, along with how many
+	// links each of those systems has.
+	std::vector<size_t> linkOffsets;
+	std::vector<size_t> links;
+	std::vector<double> linkScales;
+
+	// The supply and exports of each commodity in each system.
+	std::vector<double> supply;
+	std::vector<double> exports;
+};
@@ -1447,7 +1447,7 @@ void Engine::SetMode(Mode mode)
 
 
 
-Mode Engine::GetMode() const
+Engine::Mode Engine::GetMode() const
 {
 	return gameMode;
 }
@@ -1514,13 +1514,7 @@ void Engine::EnterSystem()
 	GameData::SetDate(today);
 	GameData::StepEconomy();
 	// SetDate() clears any bribes from yesterday, so restore any auto-clearance.
-	for(const Mission &mission : player.Missions())
-		if(mission.ClearanceMessage() == "auto")
-		{
-			mission.Destination()->Bribe(mission.HasFullClearance());
-			for(const Planet *planet : mission.Stopovers())
-				planet->Bribe(mission.HasFullClearance());
-		}
+	player.RestoreAutoClearance();
 
 	if(usedWormhole)
 	{
@@ -1862,9 +1856,8 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
 	PrunePointers(flotsam);
 
 	// Move the projectiles.
-	for(Projectile &projectile : projectiles)
-		projectile.Move(newVisuals, newProjectiles);
-	Prune(projectiles);
+	projectiles.Move(newVisuals, newProjectiles);
+	projectiles.Prune();
 
 	// Step the weather.
 	for(Weather &weather : activeWeather)
@@ -1889,7 +1882,7 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
 	// detection) but they should not be moved, which is why we put off adding
 	// them to the lists until now.
 	ships.splice(ships.end(), newShips);
-	Append(projectiles, newProjectiles);
+	projectiles.Append(newProjectiles);
 	flotsam.splice(flotsam.end(), newFlotsam);
 	Append(visuals, newVisuals);
 
@@ -1900,9 +1893,12 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
 	// Populate the collision detection lookup sets.
 	FillCollisionSets();
 
-	// Perform collision detection.
-	for(Projectile &projectile : projectiles)
-		DoCollisions(projectile);
+	// Perform collision detection. The collisions are found in parallel, but
+	// resolved in projectile order so that the outcome does not depend on how
+	// the work was split up.
+	FindCollisions();
+	for(size_t i = 0; i < projectiles.size(); ++i)
+		DoCollisions(projectiles[i], projectileCollisions[i]);
 	// Now that collision detection is done, clear the cache of ships with anti-
 	// missile systems ready to fire.
 	hasAntiMissile.clear();
@@ -2043,7 +2039,12 @@ void Engine::FillCollisionSets()
 	shipCollisions.Clear(step);
 	for(const shared_ptr<Ship> &it : ships)
 		if(it->GetSystem() == player.GetSystem() && it->Zoom() == 1.)
+		{
+			// Bodies update their animation frame the first time their mask is
+			// requested in a step. Do that here, so collision detection only reads it.
+			it->GetMask(step);
 			shipCollisions.Add(*it);
+		}
 
 	// Get the ship collision set ready to query.
 	shipCollisions.Finish();
@@ -2431,35 +2432,53 @@ void Engine::HandleMouseInput(Command &activeCommands)
 
 
 
-// Perform collision detection. Note that unlike the preceding functions, this
-// one adds any visuals that are created directly to the main visuals list. If
-// this is multi-threaded in the future, that will need to change.
-void Engine::DoCollisions(Projectile &projectile)
+// Find the possible collisions of every projectile, in parallel. This only
+// reads the collision sets, the ships in them and the projectiles, and each
+// projectile's collisions go into a list of its own.
+void Engine::FindCollisions()
+{
+	// Small batches are not worth handing to other threads.
+	static const size_t BATCH_SIZE = 64;
+
+	// Keep the lists from previous steps, so their storage is reused.
+	if(projectileCollisions.size() < projectiles.size())
+		projectileCollisions.resize(projectiles.size());
+
+	auto findBatch = [this](size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; ++i)
+		{
+			projectileCollisions[i].clear();
+			FindCollisions(projectiles[i], projectileCollisions[i]);
+		}
+	};
+	if(projectiles.size() <= BATCH_SIZE)
+	{
+		findBatch(0, projectiles.size());
+		return;
+	}
+	for(size_t begin = 0; begin < projectiles.size(); begin += BATCH_SIZE)
+		collisionQueue.Run([&findBatch, begin, end = min(begin + BATCH_SIZE, projectiles.size())]
+			{ findBatch(begin, end); });
+	collisionQueue.Wait();
+}
+
+
+
+// Find what the given projectile may hit this step. Whether it hits a ship it
+// targets while phasing is left to DoCollisions(), because that ship may not
+// be in the collision sets.
+void Engine::FindCollisions(const Projectile &projectile, vector<Collision> &collisions) const
 {
 	// The asteroids can collide with projectiles, the same as any other
 	// object. If the asteroid turns out to be closer than the ship, it
 	// shields the ship (unless the projectile has a blast radius).
-	vector<Collision> collisions;
 	const Government *gov = projectile.GetGovernment();
 	const Weapon &weapon = projectile.GetWeapon();
 
 	if(projectile.ShouldExplode())
 		collisions.emplace_back(nullptr, CollisionType::NONE, 0.);
-	else if(weapon.IsPhasing() && projectile.Target())
-	{
-		// "Phasing" projectiles that have a target will never hit any other ship.
-		// They also don't care whether the weapon has "no ship collisions" on, as
-		// otherwise a phasing projectile would never hit anything.
-		shared_ptr<Ship> target = projectile.TargetPtr();
-		if(target)
-		{
-			Point offset = projectile.Position() - target->Position();
-			double range = target->GetMask(step).Collide(offset, projectile.Velocity(), target->Facing());
-			if(range < 1.)
-				collisions.emplace_back(target.get(), CollisionType::SHIP, range);
-		}
-	}
-	else
+	else if(!weapon.IsPhasing() || !projectile.Target())
 	{
 		// For weapons with a trigger radius, check if any detectable object will set it off.
 		double triggerRadius = weapon.TriggerRadius();
@@ -2491,6 +2510,32 @@ void Engine::DoCollisions(Projectile &projectile)
 				asteroids.CollideMinables(projectile, collisions);
 		}
 	}
+}
+
+
+
+// Resolve the collisions found for the given projectile. Note that unlike the
+// preceding functions, this one adds any visuals that are created directly to
+// the main visuals list, so it must not be run in parallel.
+void Engine::DoCollisions(Projectile &projectile, vector<Collision> &collisions)
+{
+	const Government *gov = projectile.GetGovernment();
+	const Weapon &weapon = projectile.GetWeapon();
+
+	if(!projectile.ShouldExplode() && weapon.IsPhasing() && projectile.Target())
+	{
+		// "Phasing" projectiles that have a target will never hit any other ship.
+		// They also don't care whether the weapon has "no ship collisions" on, as
+		// otherwise a phasing projectile would never hit anything.
+		shared_ptr<Ship> target = projectile.TargetPtr();
+		if(target)
+		{
+			Point offset = projectile.Position() - target->Position();
+			double range = target->GetMask(step).Collide(offset, projectile.Velocity(), target->Facing());
+			if(range < 1.)
+				collisions.emplace_back(target.get(), CollisionType::SHIP, range);
+		}
+	}
 
 	// Sort the Collisions by increasing range so that the closer collisions are evaluated first.
 	sort(collisions.begin(), collisions.end());
@@ -33,6 +33,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Point.h"
 #include "Preferences.h"
 #include "Projectile.h"
+#include "ProjectilePool.h"
 #include "Radar.h"
 #include "Rectangle.h"
 #include "TaskQueue.h"
@@ -222,7 +223,9 @@ private:
 
 	void FillCollisionSets();
 
-	void DoCollisions(Projectile &projectile);
+	void FindCollisions();
+	void FindCollisions(const Projectile &projectile, std::vector<Collision> &collisions) const;
+	void DoCollisions(Projectile &projectile, std::vector<Collision> &collisions);
 	void DoWeather(Weather &weather);
 	void DoCollection(Flotsam &flotsam);
 	void DoScanning(const std::shared_ptr<Ship> &ship);
@@ -242,7 +245,7 @@ private:
 	PlayerInfo &player;
 
 	std::list<std::shared_ptr<Ship>> ships;
-	std::vector<Projectile> projectiles;
+	ProjectilePool projectiles;
 	std::vector<Weather> activeWeather;
 	std::list<std::shared_ptr<Flotsam>> flotsam;
 	std::vector<Visual> visuals;
@@ -313,6 +316,10 @@ private:
 	int grudgeTime = 0;
 
 	CollisionSet shipCollisions;
+	// The possible collisions of each projectile this step, which are found in
+	// parallel and then resolved in order.
+	std::vector<std::vector<Collision>> projectileCollisions;
+	TaskQueue collisionQueue;
 
 	int alarmTime = 0;
 	double flash = 0.;
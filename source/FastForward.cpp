@@ -0,0 +1,87 @@
+/* FastForward.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "FastForward.h"
+
+#include "GameData.h"
+#include "PlayerInfo.h"
+
+#include <iomanip>
+#include <string>
+
+using namespace std;
+
+namespace {
+	// Do the given work, and add the time it took to the given total.
+	template<class Work>
+	void Time(FastForward::Duration &total, Work work)
+	{
+		const auto start = chrono::steady_clock::now();
+		work();
+		total += chrono::steady_clock::now() - start;
+	}
+
+	void PrintLine(ostream &out, const string &name, FastForward::Duration duration, int days)
+	{
+		const double milliseconds = chrono::duration<double, milli>(duration).count();
+		out << left << setw(12) << name << right << fixed << setprecision(3)
+			<< setw(12) << milliseconds << " ms" << setw(12) << (days ? milliseconds / days : 0.) << " ms/day" << endl;
+	}
+}
+
+
+
+// Print one line for each part of the work.
+void FastForward::Timings::Print(ostream &out) const
+{
+	out << "Advanced " << days << (days == 1 ? " day:" : " days:") << endl;
+	PrintLine(out, "events", events, days);
+	PrintLine(out, "missions", missions, days);
+	PrintLine(out, "accounting", accounting, days);
+	PrintLine(out, "systems", systems, days);
+	PrintLine(out, "economy", economy, days);
+	PrintLine(out, "finish", finish, days);
+	PrintLine(out, "total", events + missions + accounting + systems + economy + finish, days);
+}
+
+
+
+// Advance the player's date, and the universe along with it, by the given
+// number of days.
+FastForward::Timings FastForward::Run(PlayerInfo &player, int days)
+{
+	Timings timings;
+	if(days <= 0)
+		return timings;
+
+	// A player who dies along the way, for example from bad debts, stops advancing.
+	for(timings.days = 0; timings.days < days && !player.IsDead(); ++timings.days)
+	{
+		// These are the same steps that PlayerInfo::AdvanceDate() and
+		// Engine::EnterSystem() take when the player jumps to a new system.
+		Time(timings.events, [&player]() { player.StartNextDay(); });
+		Time(timings.missions, [&player]() { player.DoDailyMissions(); });
+		Time(timings.accounting, [&player]() { player.DoAccounting(); });
+		Time(timings.systems, [&player]()
+			{
+				GameData::SetDate(player.GetDate());
+				player.RestoreAutoClearance();
+			});
+		Time(timings.economy, []() { GameData::StepEconomy(); });
+	}
+	Time(timings.finish, [&player]() { player.FinishAdvancingDate(); });
+
+	return timings;
+}
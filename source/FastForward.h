@@ -0,0 +1,62 @@
+/* FastForward.h
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <ostream>
+
+class PlayerInfo;
+
+
+
+// Advances the game by whole days without playing them, for example so that a
+// server can catch up after being down, or to measure how the economy and events
+// hold up over a long run. Each day does the same work as a jump to another
+// system, except for anything that is only shown to the player, such as music,
+// the system's haze, or loading its planets' landscapes.
+class FastForward {
+public:
+	using Duration = std::chrono::steady_clock::duration;
+
+	// How long each part of the daily work took, in total over all days.
+	class Timings {
+	public:
+		// Print one line for each part of the work.
+		void Print(std::ostream &out) const;
+
+	public:
+		int days = 0;
+		// Scheduled events, and the changes they make to the universe.
+		Duration events{};
+		// Mission deadlines and daily mission actions.
+		Duration missions{};
+		// Salaries, maintenance, and debts.
+		Duration accounting{};
+		// Moving the stellar objects and resetting daily politics.
+		Duration systems{};
+		// Production and trade of commodities.
+		Duration economy{};
+		// Work that is only done once after all of the days, like updating
+		// the deadlines of missions.
+		Duration finish{};
+	};
+
+
+public:
+	// Advance the player's date, and the universe along with it, by the given
+	// number of days.
+	static Timings Run(PlayerInfo &player, int days);
+};
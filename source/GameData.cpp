@@ -100,6 +100,9 @@ namespace {
 
 	const Government *playerGovernment = nullptr;
 	map<const System *, map<string, int>> purchases;
+	// Whether a change since the distance tables were last built may have
+	// moved or changed a link or wormhole.
+	bool distancesChanged = false;
 
 	ConditionsStore globalConditions;
 
@@ -437,6 +440,8 @@ void GameData::Revert()
 	objects.persons.Revert(defaultPersons);
 	for(auto &it : objects.persons)
 		it.second.Restore();
+	objects.distances.Update(objects.systems);
+	objects.economy.Invalidate();
 
 	politics.Reset();
 	purchases.clear();
@@ -544,29 +549,8 @@ void GameData::StepEconomy()
 	}
 	purchases.clear();
 
-	// Then, have each system generate new goods for local use and trade.
-	for(auto &it : objects.systems)
-		it.second.StepEconomy();
-
-	// Finally, send out the trade goods. This has to be done in a separate step
-	// because otherwise whichever systems trade last would already have gotten
-	// supplied by the other systems.
-	for(auto &it : objects.systems)
-	{
-		System &system = it.second;
-		if(!system.Links().empty())
-			for(const Trade::Commodity &commodity : Commodities())
-			{
-				double supply = system.Supply(commodity.name);
-				for(const System *neighbor : system.Links())
-				{
-					double scale = neighbor->Links().size();
-					if(scale)
-						supply += neighbor->Exports(commodity.name) / scale;
-				}
-				system.SetSupply(commodity.name, supply);
-			}
-	}
+	// Then, have each system generate new goods and trade them with its neighbors.
+	objects.economy.Step(objects.systems, objects.trade);
 }
 
 
@@ -583,6 +567,28 @@ void GameData::AddPurchase(const System &system, const string &commodity, int to
 void GameData::Change(const DataNode &node, PlayerInfo &player)
 {
 	objects.Change(node, player);
+	// Any system's trade goods or links may have changed.
+	objects.economy.Invalidate();
+	// Links or wormholes may have been moved or changed, which changes how far
+	// apart systems are.
+	const string &key = node.Token(0);
+	if(key == "event" || key == "planet" || key == "wormhole"
+			|| key == "system" || key == "link" || key == "unlink")
+		distancesChanged = true;
+	// A government's attitudes toward the others may have changed.
+	if(key == "government")
+		politics.UpdateRelations();
+}
+
+
+
+// Bring anything that depends on the universe as a whole up to date after a
+// batch of changes.
+void GameData::FinishChanges()
+{
+	if(distancesChanged)
+		objects.distances.Update(objects.systems);
+	distancesChanged = false;
 }
 
 
@@ -592,6 +598,8 @@ void GameData::Change(const DataNode &node, PlayerInfo &player)
 void GameData::UpdateSystems()
 {
 	objects.UpdateSystems();
+	// That also rebuilt the distance tables.
+	distancesChanged = false;
 }
 
 
@@ -727,6 +735,13 @@ const Set<Mission> &GameData::Missions()
 
 
 
+const MissionOfferIndex &GameData::MissionOffers()
+{
+	return objects.missionOffers;
+}
+
+
+
 const Set<News> &GameData::SpaceportNews()
 {
 	return objects.news;
@@ -825,6 +840,13 @@ const Set<Wormhole> &GameData::Wormholes()
 
 
 
+const DistanceTable &GameData::Distances()
+{
+	return objects.distances;
+}
+
+
+
 const Government *GameData::PlayerGovernment()
 {
 	return playerGovernment;
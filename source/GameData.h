@@ -36,6 +36,7 @@ class Conversation;
 class DataNode;
 class DataWriter;
 class Date;
+class DistanceTable;
 class Effect;
 class Fleet;
 class FormationPattern;
@@ -49,6 +50,7 @@ class Interface;
 class MaskManager;
 class Minable;
 class Mission;
+class MissionOfferIndex;
 class News;
 class Outfit;
 class Panel;
@@ -109,8 +111,10 @@ public:
 	static void WriteEconomy(DataWriter &out);
 	static void StepEconomy();
 	static void AddPurchase(const System &system, const std::string &commodity, int tons);
-	// Apply the given change to the universe.
+	// Apply the given change to the universe. Once all the changes of a batch
+	// have been applied, FinishChanges() must be called.
 	static void Change(const DataNode &node, PlayerInfo &player);
+	static void FinishChanges();
 	// Update the neighbor lists and other information for all the systems.
 	// This must be done any time that a change creates or moves a system.
 	static void UpdateSystems();
@@ -137,6 +141,8 @@ public:
 	static const Set<Message> &Messages();
 	static const Set<Minable> &Minables();
 	static const Set<Mission> &Missions();
+	// The missions that can be offered when landing, by where they can be offered.
+	static const MissionOfferIndex &MissionOffers();
 	static const Set<News> &SpaceportNews();
 	static const Set<Outfit> &Outfits();
 	static const Set<Shop<Outfit>> &Outfitters();
@@ -150,6 +156,8 @@ public:
 	static const Set<Test> &Tests();
 	static const Set<TestData> &TestDataSets();
 	static const Set<Wormhole> &Wormholes();
+	// How many days it takes to travel between any two systems.
+	static const DistanceTable &Distances();
 
 	static ConditionsStore &GlobalConditions();
 
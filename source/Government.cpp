@@ -432,6 +432,13 @@ void Government::Load(const DataNode &node, const set<const System *> *visitedSy
 
 
 
+unsigned Government::GetID() const
+{
+	return id;
+}
+
+
+
 // Get the display name of this government.
 const string &Government::DisplayName() const
 {
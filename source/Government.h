@@ -63,6 +63,9 @@ public:
 	void Load(const DataNode &node, const std::set<const System *> *visitedSystems,
 		const std::set<const Planet *> *visitedPlanets);
 
+	// Get the number identifying this government. Governments are numbered
+	// from 0 in the order they are created.
+	unsigned GetID() const;
 	// Get the display name of this government.
 	const std::string &DisplayName() const;
 	// Set / Get the true name used for this government in the data files.
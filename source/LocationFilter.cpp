@@ -30,7 +30,6 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "System.h"
 
 #include <algorithm>
-#include <mutex>
 
 using namespace std;
 
@@ -74,37 +73,9 @@ namespace {
 	// Check if the given system is within the given distance of the center.
 	int Distance(const System *center, const System *system, int maximum, DistanceCalculationSettings distanceSettings)
 	{
-		// This function should only ever be called from the main thread, but
-		// just to be sure, use mutex protection on the static locals.
-		static mutex distanceMutex;
-		lock_guard<mutex> lock(distanceMutex);
-
-		static const System *previousCenter = center;
-		static DistanceMap distance(
-			center,
-			distanceSettings.WormholeStrat(),
-			distanceSettings.AssumesJumpDrive(),
-			-1,
-			maximum
-		);
-		static int previousMaximum = maximum;
-		static DistanceCalculationSettings previousDistanceSettings = distanceSettings;
-
-		if(center != previousCenter || maximum > previousMaximum || distanceSettings != previousDistanceSettings)
-		{
-			previousCenter = center;
-			previousMaximum = maximum;
-			previousDistanceSettings = distanceSettings;
-			distance = DistanceMap(
-				center,
-				distanceSettings.WormholeStrat(),
-				distanceSettings.AssumesJumpDrive(),
-				-1,
-				maximum
-			);
-		}
 		// If the distance is greater than the maximum, this is not a match.
-		int d = distance.Days(*system);
+		int d = DistanceMap::Days(*center, *system, distanceSettings.WormholeStrat(),
+			distanceSettings.AssumesJumpDrive());
 		return (d > maximum) ? -1 : d;
 	}
 
@@ -340,6 +311,34 @@ bool LocationFilter::IsValid() const
 
 
 
+const set<const Planet *> &LocationFilter::Planets() const
+{
+	return planets;
+}
+
+
+
+const set<const System *> &LocationFilter::Systems() const
+{
+	return systems;
+}
+
+
+
+const set<const Government *> &LocationFilter::Governments() const
+{
+	return governments;
+}
+
+
+
+const list<set<string>> &LocationFilter::Attributes() const
+{
+	return attributes;
+}
+
+
+
 // If the player is in the given system, does this filter match?
 bool LocationFilter::Matches(const Planet *planet, const System *origin) const
 {
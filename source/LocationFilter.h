@@ -53,6 +53,13 @@ public:
 	bool IsEmpty() const;
 	bool IsValid() const;
 
+	// Get the planets, systems, governments, and sets of attributes of which a
+	// planet must match one each for this filter to match it.
+	const std::set<const Planet *> &Planets() const;
+	const std::set<const System *> &Systems() const;
+	const std::set<const Government *> &Governments() const;
+	const std::list<std::set<std::string>> &Attributes() const;
+
 	// If the player is in the given system, does this filter match?
 	bool Matches(const Planet *planet, const System *origin = nullptr) const;
 	bool Matches(const System *system, const System *origin = nullptr) const;
@@ -734,6 +734,27 @@ bool Mission::IsAtLocation(Location location) const
 
 
 
+const Planet *Mission::SourcePlanet() const
+{
+	return source;
+}
+
+
+
+const LocationFilter &Mission::SourceFilter() const
+{
+	return sourceFilter;
+}
+
+
+
+set<string> Mission::OfferConditions() const
+{
+	return toOffer.RelevantConditions();
+}
+
+
+
 // Information about what you are doing.
 const Ship *Mission::SourceShip() const
 {
@@ -949,7 +970,7 @@ bool Mission::HasFullClearance() const
 
 
 // Check if it's possible to offer or complete this mission right now.
-bool Mission::CanOffer(const PlayerInfo &player, const shared_ptr<Ship> &boardingShip) const
+bool Mission::CanOffer(const PlayerInfo &player, const shared_ptr<Ship> &boardingShip, bool *unmetConditions) const
 {
 	if(location == BOARDING || location == ASSISTING)
 	{
@@ -973,8 +994,14 @@ bool Mission::CanOffer(const PlayerInfo &player, const shared_ptr<Ship> &boardin
 			return false;
 	}
 
+	// Some conditions, like "random", give a different value each time they are
+	// checked, so the caller must not test these again itself.
 	if(!toOffer.Test())
+	{
+		if(unmetConditions)
+			*unmetConditions = true;
 		return false;
+	}
 
 	if(!toFail.IsEmpty() && toFail.Test())
 		return false;
@@ -1741,17 +1768,19 @@ int Mission::CalculateJumps(const System *sourceSystem)
 	while(!destinations.empty())
 	{
 		// Find the closest destination to this location.
-		DistanceMap distance(sourceSystem,
-				distanceCalcSettings.WormholeStrat(),
-				distanceCalcSettings.AssumesJumpDrive());
+		auto Days = [this, sourceSystem](const System *system) -> int
+		{
+			return DistanceMap::Days(*sourceSystem, *system,
+				distanceCalcSettings.WormholeStrat(), distanceCalcSettings.AssumesJumpDrive());
+		};
 		auto it = destinations.begin();
 		auto bestIt = it;
-		int bestDays = distance.Days(**bestIt);
+		int bestDays = Days(*bestIt);
 		if(bestDays < 0)
 			bestDays = numeric_limits<int>::max();
 		for(++it; it != destinations.end(); ++it)
 		{
-			int days = distance.Days(**it);
+			int days = Days(*it);
 			if(days >= 0 && days < bestDays)
 			{
 				bestIt = it;
@@ -1764,11 +1793,9 @@ int Mission::CalculateJumps(const System *sourceSystem)
 		expectedJumps += bestDays == numeric_limits<int>::max() ? -1 : bestDays;
 		destinations.erase(bestIt);
 	}
-	DistanceMap distance(sourceSystem,
-			distanceCalcSettings.WormholeStrat(),
-			distanceCalcSettings.AssumesJumpDrive());
 	// If currently unreachable, this system adds -1 to the deadline, to match previous behavior.
-	expectedJumps += distance.Days(*destination->GetSystem());
+	expectedJumps += DistanceMap::Days(*sourceSystem, *destination->GetSystem(),
+		distanceCalcSettings.WormholeStrat(), distanceCalcSettings.AssumesJumpDrive());
 
 	return expectedJumps;
 }
@@ -107,6 +107,12 @@ public:
 	// Find out where this mission is offered.
 	enum Location {SPACEPORT, LANDING, JOB, ASSISTING, BOARDING, SHIPYARD, OUTFITTER, JOB_BOARD, ENTERING};
 	bool IsAtLocation(Location location) const;
+	// Find out which planets this mission can be offered on: the source planet,
+	// if one is given, and otherwise any planet that matches the source filter.
+	const Planet *SourcePlanet() const;
+	const LocationFilter &SourceFilter() const;
+	// Get the conditions that the "to offer" conditions depend on.
+	std::set<std::string> OfferConditions() const;
 
 	// Information about what you are doing.
 	const Ship *SourceShip() const;
@@ -149,8 +155,10 @@ public:
 	// Check if it's possible to offer or complete this mission right now. The
 	// check for whether you can offer a mission does not take available space
 	// into account, so before actually offering a mission you should also check
-	// if the player has enough space.
-	bool CanOffer(const PlayerInfo &player, const std::shared_ptr<Ship> &boardingShip = nullptr) const;
+	// if the player has enough space. If the mission cannot be offered because its
+	// "to offer" conditions are not met, unmetConditions is set to true.
+	bool CanOffer(const PlayerInfo &player, const std::shared_ptr<Ship> &boardingShip = nullptr,
+		bool *unmetConditions = nullptr) const;
 	bool CanAccept(const PlayerInfo &player) const;
 	bool HasSpace(const PlayerInfo &player) const;
 	bool HasSpace(const Ship &ship) const;
@@ -0,0 +1,115 @@
+/* MissionOfferIndex.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "MissionOfferIndex.h"
+
+#include "LocationFilter.h"
+#include "Mission.h"
+#include "Planet.h"
+#include "Set.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+	// Add the indices filed under the given key, if any, to the list.
+	template<class Key>
+	void Append(const map<Key, vector<size_t>> &buckets, const Key &key, vector<size_t> &found)
+	{
+		auto it = buckets.find(key);
+		if(it != buckets.end())
+			found.insert(found.end(), it->second.begin(), it->second.end());
+	}
+}
+
+
+
+// Sort the given missions by where they can be offered.
+void MissionOfferIndex::Build(const Set<Mission> &missions)
+{
+	this->missions.clear();
+	byPlanet.clear();
+	bySystem.clear();
+	byGovernment.clear();
+	byAttribute.clear();
+	anywhere.clear();
+	++version;
+
+	for(const auto &it : missions)
+	{
+		const Mission &mission = it.second;
+		if(mission.IsAtLocation(Mission::BOARDING) || mission.IsAtLocation(Mission::ASSISTING)
+				|| mission.IsAtLocation(Mission::ENTERING))
+			continue;
+
+		const size_t index = this->missions.size();
+		this->missions.push_back(&mission);
+
+		// File the mission under the most specific thing that the filter requires.
+		const LocationFilter &filter = mission.SourceFilter();
+		if(mission.SourcePlanet())
+			byPlanet[mission.SourcePlanet()].push_back(index);
+		else if(!filter.Planets().empty())
+			for(const Planet *planet : filter.Planets())
+				byPlanet[planet].push_back(index);
+		else if(!filter.Systems().empty())
+			for(const System *system : filter.Systems())
+				bySystem[system].push_back(index);
+		else if(!filter.Governments().empty())
+			for(const Government *government : filter.Governments())
+				byGovernment[government].push_back(index);
+		else if(!filter.Attributes().empty())
+			for(const string &attribute : filter.Attributes().front())
+				byAttribute[attribute].push_back(index);
+		else
+			anywhere.push_back(index);
+	}
+}
+
+
+
+// Get every mission that might be offered when landing on the given planet.
+vector<const Mission *> MissionOfferIndex::Candidates(const Planet *planet) const
+{
+	if(!planet)
+		return missions;
+
+	// A planet's system, government, and attributes can be changed by events,
+	// so they are looked up at the time of landing.
+	vector<size_t> found = anywhere;
+	Append(byPlanet, planet, found);
+	Append(bySystem, planet->GetSystem(), found);
+	Append(byGovernment, planet->GetGovernment(), found);
+	for(const string &attribute : planet->Attributes())
+		Append(byAttribute, attribute, found);
+
+	// A mission may be filed under more than one of the planet's attributes.
+	sort(found.begin(), found.end());
+	found.erase(unique(found.begin(), found.end()), found.end());
+
+	vector<const Mission *> candidates;
+	candidates.reserve(found.size());
+	for(size_t index : found)
+		candidates.push_back(missions[index]);
+	return candidates;
+}
+
+
+
+int MissionOfferIndex::Version() const
+{
+	return version;
+}
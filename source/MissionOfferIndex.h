@@ -0,0 +1,65 @@
+/* MissionOfferIndex.h
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+class Government;
+class Mission;
+class Planet;
+class System;
+
+template<class Type>
+class Set;
+
+
+
+// An index of the missions that can be offered when landing, sorted by where
+// they can be offered. Each mission is filed under one thing that every planet
+// it can be offered on must have: the planet itself, its system, its government,
+// or one of its attributes. Looking up a planet then only returns the missions
+// that could be offered there, so the rest never need to be checked.
+class MissionOfferIndex {
+public:
+	// Sort the given missions by where they can be offered. The missions must
+	// not be changed or removed while this index is in use.
+	void Build(const Set<Mission> &missions);
+
+	// Get every mission that might be offered when landing on the given planet,
+	// in the order of the set the index was built from. If no planet is given,
+	// every mission that can be offered when landing is returned.
+	std::vector<const Mission *> Candidates(const Planet *planet) const;
+	// Get a number that changes each time the index is built, so that anything
+	// remembered about the missions it was built from can be discarded.
+	int Version() const;
+
+
+private:
+	// Every mission that can be offered when landing, in their original order.
+	// The buckets below hold indices into this list.
+	std::vector<const Mission *> missions;
+
+	std::map<const Planet *, std::vector<size_t>> byPlanet;
+	std::map<const System *, std::vector<size_t>> bySystem;
+	std::map<const Government *, std::vector<size_t>> byGovernment;
+	std::map<std::string, std::vector<size_t>> byAttribute;
+	// Missions that may be offered on any planet.
+	std::vector<size_t> anywhere;
+
+	int version = 0;
+};
@@ -403,6 +403,9 @@ void Outfit::Load(const DataNode &node, const ConditionsStore *playerConditions)
 	};
 	convertScan("outfit");
 	convertScan("cargo");
+
+	for(int id = 0; id < Attribute::COUNT; ++id)
+		knownAttributes[id] = attributes.Get(Attribute::Name(static_cast<Attribute::Id>(id)));
 }
 
 
@@ -503,6 +506,13 @@ double Outfit::Get(const string &attribute) const
 
 
 
+double Outfit::Get(Attribute::Id attribute) const
+{
+	return knownAttributes[attribute];
+}
+
+
+
 const Dictionary &Outfit::Attributes() const
 {
 	return attributes;
@@ -556,6 +566,7 @@ void Outfit::Add(const Outfit &other, int count)
 		attributes[at.first] += at.second * count;
 		if(fabs(attributes[at.first]) < EPS)
 			attributes[at.first] = 0.;
+		UpdateKnownAttribute(at.first);
 	}
 
 	for(const auto &it : other.flareSprites)
@@ -593,6 +604,7 @@ void Outfit::AddLicenses(const Outfit &other)
 void Outfit::Set(const char *attribute, double value)
 {
 	attributes[attribute] = value;
+	UpdateKnownAttribute(attribute);
 }
 
 
@@ -741,3 +753,12 @@ void Outfit::AddLicense(const string &name)
 	if(it == licenses.end())
 		licenses.push_back(name);
 }
+
+
+
+void Outfit::UpdateKnownAttribute(const char *attribute)
+{
+	Attribute::Id id = Attribute::Find(attribute);
+	if(id != Attribute::COUNT)
+		knownAttributes[id] = attributes.Get(attribute);
+}
@@ -15,9 +15,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "Attribute.h"
 #include "Dictionary.h"
 #include "Paragraphs.h"
 
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
@@ -73,6 +75,8 @@ public:
 
 	double Get(const char *attribute) const;
 	double Get(const std::string &attribute) const;
+	// Get a well-known attribute without searching for it by name.
+	double Get(Attribute::Id attribute) const;
 	const Dictionary &Attributes() const;
 
 	// Determine whether the given number of instances of the given outfit can
@@ -121,6 +125,8 @@ public:
 private:
 	// Add the license with the given name to the licenses required by this outfit, if it is not already present.
 	void AddLicense(const std::string &name);
+	// Copy the given attribute's value into knownAttributes, if it has an ID.
+	void UpdateKnownAttribute(const char *attribute);
 
 
 private:
@@ -141,6 +147,9 @@ private:
 	std::vector<std::string> licenses;
 
 	Dictionary attributes;
+	// The values of the attributes that have an ID. These are also in the
+	// dictionary, which remains the authority for iterating over attributes.
+	std::array<double, Attribute::COUNT> knownAttributes = {};
 
 	std::shared_ptr<const Weapon> weapon;
 	// Non-weapon outfits can have ammo so that storage outfits
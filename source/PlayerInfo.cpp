@@ -29,6 +29,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Government.h"
 #include "Logger.h"
 #include "Messages.h"
+#include "MissionOfferIndex.h"
 #include "Outfit.h"
 #include "Person.h"
 #include "Planet.h"
@@ -201,6 +202,16 @@ bool PlayerInfo::ScheduledEvent::operator<(const ScheduledEvent &other) const
 
 
 
+bool PlayerInfo::RefusedOffer::HasChanged() const
+{
+	for(const ConditionEntry *condition : conditions)
+		if(condition->ChangedSince(revision))
+			return true;
+	return false;
+}
+
+
+
 // Completely clear all loaded information, to prepare for loading a file or
 // creating a new pilot.
 void PlayerInfo::Clear()
@@ -661,6 +672,9 @@ void PlayerInfo::AddChanges(list<DataNode> &changes, bool instantChanges)
 		if(instantChanges)
 			CacheMissionInformation(true);
 	}
+	// Updating the systems already brought everything else up to date.
+	else
+		GameData::FinishChanges();
 }
 
 
@@ -805,33 +819,53 @@ void PlayerInfo::AdvanceDate(int amount)
 		return;
 	while(amount--)
 	{
-		++date;
+		StartNextDay();
+		DoDailyMissions();
+		DoAccounting();
+	}
+	FinishAdvancingDate();
+}
 
-		// Check if any special events should happen today.
-		markedChangesToday = false;
-		auto it = scheduledEvents.begin();
-		list<DataNode> eventChanges;
-		while(it != scheduledEvents.end() && date >= it->date)
-		{
-			TriggerEvent(*(it->event), eventChanges);
-			it = scheduledEvents.erase(it);
-		}
-		if(!eventChanges.empty())
-			AddChanges(eventChanges);
 
-		// Check if any missions have failed because of deadlines and
-		// do any daily mission actions for those that have not failed.
-		for(Mission &mission : missions)
-		{
-			if(mission.CheckDeadline(date) && mission.IsVisible())
-				Messages::Add({"You failed to meet the deadline for the mission \"" + mission.DisplayName() + "\".",
-					GameData::MessageCategories().Get("high")});
-			if(!mission.IsFailed())
-				mission.Do(Mission::DAILY, *this);
-		}
 
-		DoAccounting();
+// Move on to the next day, and check if any special events should happen on it.
+void PlayerInfo::StartNextDay()
+{
+	++date;
+
+	markedChangesToday = false;
+	auto it = scheduledEvents.begin();
+	list<DataNode> eventChanges;
+	while(it != scheduledEvents.end() && date >= it->date)
+	{
+		TriggerEvent(*(it->event), eventChanges);
+		it = scheduledEvents.erase(it);
 	}
+	if(!eventChanges.empty())
+		AddChanges(eventChanges);
+}
+
+
+
+// Check if any missions have failed because of deadlines and do any daily
+// mission actions for those that have not failed.
+void PlayerInfo::DoDailyMissions()
+{
+	for(Mission &mission : missions)
+	{
+		if(mission.CheckDeadline(date) && mission.IsVisible())
+			Messages::Add({"You failed to meet the deadline for the mission \"" + mission.DisplayName() + "\".",
+				GameData::MessageCategories().Get("high")});
+		if(!mission.IsFailed())
+			mission.Do(Mission::DAILY, *this);
+	}
+}
+
+
+
+// Do the work that only needs to be done once after any number of days.
+void PlayerInfo::FinishAdvancingDate()
+{
 	// Reset the reload counters for all your ships.
 	for(const shared_ptr<Ship> &ship : ships)
 		ship->GetArmament().ReloadAll();
@@ -845,6 +879,19 @@ void PlayerInfo::AdvanceDate(int amount)
 
 
 
+void PlayerInfo::RestoreAutoClearance() const
+{
+	for(const Mission &mission : missions)
+		if(mission.ClearanceMessage() == "auto")
+		{
+			mission.Destination()->Bribe(mission.HasFullClearance());
+			for(const Planet *planet : mission.Stopovers())
+				planet->Bribe(mission.HasFullClearance());
+		}
+}
+
+
+
 const CoreStartData &PlayerInfo::StartData() const noexcept
 {
 	return startData;
@@ -4227,10 +4274,7 @@ void PlayerInfo::RegisterDerivedConditions()
 		if(!origin)
 			return -1;
 
-		auto distanceMap = DistanceMap(origin);
-		if(!distanceMap.HasRoute(*destination))
-			return -1;
-		return distanceMap.Days(*destination);
+		return DistanceMap::Days(*origin, *destination);
 	};
 
 	conditions["hyperjumps to system: "].ProvidePrefixed([this, HyperspaceTravelDays](const ConditionEntry &ce) -> int {
@@ -4377,15 +4421,42 @@ void PlayerInfo::CreateMissions()
 	bool skipJobs = planet && !planet->GetPort().HasService(Port::ServicesType::JobBoard);
 	bool hasPriorityMissions = false;
 	unsigned nonBlockingMissions = 0;
-	for(const auto &[name, mission] : GameData::Missions())
+	// If the missions were reloaded, forget what was known about their conditions.
+	const MissionOfferIndex &offers = GameData::MissionOffers();
+	if(refusedOffersVersion != offers.Version())
 	{
-		if(mission.IsAtLocation(Mission::BOARDING) || mission.IsAtLocation(Mission::ASSISTING)
-				|| mission.IsAtLocation(Mission::ENTERING))
-			continue;
+		refusedOffers.clear();
+		refusedOffersVersion = offers.Version();
+	}
+	// Only check the missions that could be offered on this planet.
+	for(const Mission *candidate : offers.Candidates(planet))
+	{
+		const Mission &mission = *candidate;
 		if(skipJobs && mission.IsAtLocation(Mission::JOB))
 			continue;
 
-		if(mission.CanOffer(*this))
+		// Skip any mission whose offer conditions are known to still be unmet.
+		auto refused = refusedOffers.find(&mission);
+		if(refused != refusedOffers.end() && !refused->second.HasChanged())
+			continue;
+		const uint64_t revision = ConditionEntry::LastRevision();
+		bool unmetConditions = false;
+		const bool canOffer = mission.CanOffer(*this, nullptr, &unmetConditions);
+		if(unmetConditions)
+		{
+			if(refused == refusedOffers.end())
+			{
+				refused = refusedOffers.emplace(&mission, RefusedOffer()).first;
+				for(const string &name : mission.OfferConditions())
+					refused->second.conditions.push_back(&conditions[name]);
+			}
+			refused->second.revision = revision;
+			continue;
+		}
+		if(refused != refusedOffers.end())
+			refusedOffers.erase(refused);
+
+		if(canOffer)
 		{
 			list<Mission> &missions =
 				mission.IsAtLocation(Mission::JOB) ? availableJobs : availableMissions;
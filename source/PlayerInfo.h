@@ -123,6 +123,17 @@ public:
 	// Get or change the current date.
 	const Date &GetDate() const;
 	void AdvanceDate(int amount = 1);
+	// The parts of AdvanceDate(), for code that needs to do its own work in between
+	// them. Each day starts with StartNextDay(), which also triggers any events
+	// scheduled for it, followed by DoDailyMissions() and DoAccounting().
+	// FinishAdvancingDate() must be called once after the last day.
+	void StartNextDay();
+	void DoDailyMissions();
+	void DoAccounting();
+	void FinishAdvancingDate();
+	// Give back the landing clearance of missions that grant it automatically,
+	// after the start of a new day has cleared all bribes.
+	void RestoreAutoClearance() const;
 
 	// Get basic data about the player's starting scenario.
 	const CoreStartData &StartData() const noexcept;
@@ -397,6 +408,16 @@ private:
 		Date date;
 	};
 
+	// A mission whose offer conditions were not met when last checked. Until one
+	// of the conditions they depend on changes, they cannot be met now either.
+	class RefusedOffer {
+	public:
+		bool HasChanged() const;
+
+		uint64_t revision = 0;
+		std::vector<const ConditionEntry *> conditions;
+	};
+
 
 private:
 	// Apply any "changes" saved in this player info to the global game state.
@@ -434,8 +455,6 @@ private:
 
 	// Check that this player's current state can be saved.
 	bool CanBeSaved() const;
-	// Handle the daily salaries and payments.
-	void DoAccounting();
 
 	bool HasClearance() const;
 
@@ -503,6 +522,10 @@ private:
 	// by the number of days of travel it will take to complete the mission if the
 	// "Deadline blink by distance" preference is true.
 	std::map<const Mission *, int> remainingDeadlines;
+	// Missions that were not offered when landing because their offer conditions
+	// were not met, so that they can be skipped until those conditions change.
+	std::map<const Mission *, RefusedOffer> refusedOffers;
+	int refusedOffersVersion = 0;
 	// How to sort availableJobs
 	bool availableSortAsc = true;
 	SortType availableSortType;
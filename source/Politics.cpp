@@ -71,6 +71,8 @@ void Politics::Reset()
 	// were already checked for when you first landed).
 	for(const auto &it : GameData::Governments())
 		fined.insert(&it.second);
+
+	UpdateRelations();
 }
 
 
@@ -80,27 +82,27 @@ bool Politics::IsEnemy(const Government *first, const Government *second) const
 	if(!first || !second)
 		return false;
 
-	if(first == second)
-		return false;
+	unsigned firstID = first->GetID();
+	unsigned secondID = second->GetID();
+	if(firstID < relationsSize && secondID < relationsSize)
+		return enemies.Test(firstID * relationsSize + secondID);
+	return CalculateIsEnemy(first, second);
+}
 
-	// Just for simplicity, if one of the governments is the player, make sure
-	// it is the first one.
-	if(second->IsPlayer())
-		swap(first, second);
-	if(first->IsPlayer())
-	{
-		if(bribed.contains(second))
-			return false;
-		if(provoked.contains(second))
-			return true;
 
-		auto it = reputationWith.find(second);
-		return (it != reputationWith.end() && it->second < 0.);
-	}
 
-	// Neither government is the player, so the question of enemies depends only
-	// on the attitude matrix.
-	return (first->AttitudeToward(second) < 0. || second->AttitudeToward(first) < 0.);
+void Politics::UpdateRelations()
+{
+	relationsSize = 0;
+	for(const auto &it : GameData::Governments())
+		relationsSize = max(relationsSize, it.second.GetID() + 1);
+
+	enemies.Clear();
+	enemies.Resize(relationsSize * relationsSize);
+	for(const auto &first : GameData::Governments())
+		for(const auto &second : GameData::Governments())
+			if(CalculateIsEnemy(&first.second, &second.second))
+				enemies.Set(first.second.GetID() * relationsSize + second.second.GetID());
 }
 
 
@@ -132,6 +134,7 @@ void Politics::Offend(const Government *gov, int eventType, int count)
 				// your bribe is canceled out.
 				bribed.erase(other);
 				provoked.insert(other);
+				UpdatePlayerRelations(other);
 			}
 		}
 		if(count && abs(weight) >= .05)
@@ -157,6 +160,7 @@ void Politics::Bribe(const Government *gov)
 	bribed.insert(gov);
 	provoked.erase(gov);
 	fined.insert(gov);
+	UpdatePlayerRelations(gov);
 }
 
 
@@ -419,6 +423,7 @@ void Politics::SetReputation(const Government *gov, double value)
 	value = min(value, gov->ReputationMax());
 	value = max(value, gov->ReputationMin());
 	reputationWith[gov] = value;
+	UpdatePlayerRelations(gov);
 }
 
 
@@ -430,4 +435,71 @@ void Politics::ResetDaily()
 	bribed.clear();
 	bribedPlanets.clear();
 	fined.clear();
+	UpdatePlayerRelations();
+}
+
+
+
+bool Politics::CalculateIsEnemy(const Government *first, const Government *second) const
+{
+	if(!first || !second)
+		return false;
+
+	if(first == second)
+		return false;
+
+	// Just for simplicity, if one of the governments is the player, make sure
+	// it is the first one.
+	if(second->IsPlayer())
+		swap(first, second);
+	if(first->IsPlayer())
+	{
+		if(bribed.contains(second))
+			return false;
+		if(provoked.contains(second))
+			return true;
+
+		auto it = reputationWith.find(second);
+		return (it != reputationWith.end() && it->second < 0.);
+	}
+
+	// Neither government is the player, so the question of enemies depends only
+	// on the attitude matrix.
+	return (first->AttitudeToward(second) < 0. || second->AttitudeToward(first) < 0.);
+}
+
+
+
+// Recalculate the cached relationships between the player and the given government.
+void Politics::UpdatePlayerRelations(const Government *gov)
+{
+	const Government *playerGovernment = GameData::PlayerGovernment();
+	if(!gov || !playerGovernment)
+		return;
+
+	unsigned id = gov->GetID();
+	unsigned playerID = playerGovernment->GetID();
+	if(id >= relationsSize || playerID >= relationsSize)
+		return;
+
+	SetEnemy(id, playerID, CalculateIsEnemy(gov, playerGovernment));
+	SetEnemy(playerID, id, CalculateIsEnemy(playerGovernment, gov));
+}
+
+
+
+void Politics::UpdatePlayerRelations()
+{
+	for(const auto &it : GameData::Governments())
+		UpdatePlayerRelations(&it.second);
+}
+
+
+
+void Politics::SetEnemy(unsigned first, unsigned second, bool isEnemy)
+{
+	if(isEnemy)
+		enemies.Set(first * relationsSize + second);
+	else
+		enemies.Reset(first * relationsSize + second);
 }
@@ -15,6 +15,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "Bitset.h"
+
 #include <map>
 #include <set>
 #include <string>
@@ -36,7 +38,13 @@ public:
 	// Reset to the initial political state defined in the game data.
 	void Reset();
 
+	// Check if the two governments are enemies. This only reads a cached
+	// table, so it may be called from several threads at once as long as the
+	// political state is not being changed.
 	bool IsEnemy(const Government *first, const Government *second) const;
+	// Recalculate the cached relationships between all governments. This must
+	// be done whenever a government's attitudes toward the others change.
+	void UpdateRelations();
 
 	// Commit the given "offense" against the given government (which may not
 	// actually consider it to be an offense). This may result in temporary
@@ -73,6 +81,15 @@ public:
 	void ResetDaily();
 
 
+private:
+	bool CalculateIsEnemy(const Government *first, const Government *second) const;
+	// Recalculate the cached relationships between the player and the given
+	// government, or all governments.
+	void UpdatePlayerRelations(const Government *gov);
+	void UpdatePlayerRelations();
+	void SetEnemy(unsigned first, unsigned second, bool isEnemy);
+
+
 private:
 	// attitude[target][other] stores how much an action toward the given target
 	// government will affect your reputation with the given other government.
@@ -85,4 +102,10 @@ private:
 	std::map<const Planet *, bool> bribedPlanets;
 	std::set<const Planet *> dominatedPlanets;
 	std::set<const Government *> fined;
+
+	// Whether the governments with the given IDs are enemies, with the bit for
+	// first and second at first * relationsSize + second. Governments created
+	// after the table was built are looked up the slow way.
+	Bitset enemies;
+	unsigned relationsSize = 0;
 };
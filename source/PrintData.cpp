@@ -687,6 +687,7 @@ namespace {
 				break;
 			}
 		}
+		GameData::FinishChanges();
 
 		cout << "Systems matching provided location filter:\n";
 		for(const auto &it : GameData::Systems())
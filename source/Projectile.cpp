@@ -157,20 +157,7 @@ void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
 		if(!Random::Int(it.second))
 			visuals.emplace_back(*it.first, position, velocity, angle);
 
-	// If the target has left the system, stop following it. Also stop if the
-	// target has been captured by a different government.
-	// Also stop targeting fighters that have become disabled after this projectile was fired.
-	const Ship *target = cachedTarget;
-	if(target)
-	{
-		target = TargetPtr().get();
-		if(!target || !target->IsTargetable() || target->GetGovernment() != targetGovernment ||
-				(!targetDisabled && !FighterHitHelper::IsValidTarget(target)))
-		{
-			BreakTarget();
-			target = nullptr;
-		}
-	}
+	const Ship *target = UpdateTarget();
 
 	double turn = weapon->Turn();
 	double accel = weapon->Acceleration();
@@ -280,6 +267,45 @@ void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
 
 
 
+bool Projectile::IsBallistic() const
+{
+	return !weapon->Homing() && !weapon->Turn() && !weapon->Acceleration() && weapon->LiveEffects().empty();
+}
+
+
+
+bool Projectile::IsExpiring() const
+{
+	return lifetime <= 1;
+}
+
+
+
+// This does what Move() does for a projectile that does not steer, accelerate,
+// or create effects, skipping every check that only matters for those.
+void Projectile::MoveBallistic()
+{
+	--lifetime;
+	const Ship *target = UpdateTarget();
+
+	// Move() always makes these draws, even for a projectile that cannot turn.
+	// Making them here too keeps the random number stream, and therefore any
+	// replay of a seeded game, the same as if Move() had been called.
+	if(!Random::Int(ceil(180 / weapon->Turn())))
+		confusionDirection = Random::Int(2) ? -1 : 1;
+
+	position += velocity;
+	distanceTraveled += dV.Length();
+
+	if(target && (position - target->Position()).Length() < weapon->SplitRange())
+		lifetime = 0;
+
+	if(lifetime < weapon->FadeOut())
+		alpha = static_cast<double>(lifetime) / weapon->FadeOut();
+}
+
+
+
 // This projectile hit something. Create the explosion, if any. This also
 // marks the projectile as needing deletion if it has run out of hits.
 void Projectile::Explode(vector<Visual> &visuals, double intersection, Point hitVelocity)
@@ -386,6 +412,27 @@ void Projectile::BreakTarget()
 
 
 
+// If the target has left the system, stop following it. Also stop if the
+// target has been captured by a different government.
+// Also stop targeting fighters that have become disabled after this projectile was fired.
+const Ship *Projectile::UpdateTarget()
+{
+	const Ship *target = cachedTarget;
+	if(target)
+	{
+		target = TargetPtr().get();
+		if(!target || !target->IsTargetable() || target->GetGovernment() != targetGovernment ||
+				(!targetDisabled && !FighterHitHelper::IsValidTarget(target)))
+		{
+			BreakTarget();
+			target = nullptr;
+		}
+	}
+	return target;
+}
+
+
+
 // TODO: add more conditions in the future. For example maybe proximity to stars
 // and their brightness could could cause IR missiles to lose their locks more
 // often, and dense asteroid fields could do the same for radar and optically
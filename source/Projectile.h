@@ -67,6 +67,15 @@ public:
 
 	// Move the projectile. It may create effects or submunitions.
 	void Move(std::vector<Visual> &visuals, std::vector<Projectile> &projectiles);
+	// Check if this projectile always flies in a straight line at a constant
+	// speed and never creates effects while in flight. Moving such a projectile
+	// only changes its position, unless it is expiring.
+	bool IsBallistic() const;
+	// Check if the next Move() will end this projectile's life.
+	bool IsExpiring() const;
+	// Move a ballistic projectile that is not expiring. This has the same
+	// result as Move(), including the random numbers it uses, but costs less.
+	void MoveBallistic();
 	// This projectile hit something. Create the explosion, if any. This also
 	// marks the projectile as needing deletion if it has run out of penetrations.
 	void Explode(std::vector<Visual> &visuals, double intersection, Point hitVelocity = Point());
@@ -111,6 +120,8 @@ public:
 
 
 private:
+	// Stop following the target if it is no longer valid, and return it.
+	const Ship *UpdateTarget();
 	void CheckLock(const Ship &target);
 	void CheckConfused(const Ship &target);
 
@@ -0,0 +1,96 @@
+/* ProjectilePool.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ProjectilePool.h"
+
+#include <utility>
+
+using namespace std;
+
+
+
+void ProjectilePool::Add(Projectile &&projectile)
+{
+	PushBack(std::move(projectile));
+}
+
+
+
+void ProjectilePool::Append(vector<Projectile> &added)
+{
+	projectiles.reserve(projectiles.size() + added.size());
+	for(Projectile &projectile : added)
+		PushBack(std::move(projectile));
+	added.clear();
+}
+
+
+
+void ProjectilePool::clear()
+{
+	projectiles.clear();
+	ballistic.clear();
+}
+
+
+
+void ProjectilePool::Move(vector<Visual> &visuals, vector<Projectile> &spawned)
+{
+	// Projectiles that steer, accelerate, create effects or come to the end of
+	// their lives this step take the full Move().
+	for(size_t i = 0; i < projectiles.size(); ++i)
+	{
+		Projectile &projectile = projectiles[i];
+		if(ballistic[i] && !projectile.IsExpiring())
+			projectile.MoveBallistic();
+		else
+			projectile.Move(visuals, spawned);
+	}
+}
+
+
+
+void ProjectilePool::Prune()
+{
+	for(size_t i = 0; i < projectiles.size(); )
+	{
+		if(projectiles[i].ShouldBeRemoved())
+			SwapRemove(i);
+		else
+			++i;
+	}
+}
+
+
+
+void ProjectilePool::PushBack(Projectile &&projectile)
+{
+	ballistic.push_back(projectile.IsBallistic());
+	projectiles.push_back(std::move(projectile));
+}
+
+
+
+void ProjectilePool::SwapRemove(size_t index)
+{
+	const size_t last = projectiles.size() - 1;
+	if(index != last)
+	{
+		projectiles[index] = std::move(projectiles[last]);
+		ballistic[index] = ballistic[last];
+	}
+	projectiles.pop_back();
+	ballistic.pop_back();
+}
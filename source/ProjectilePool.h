@@ -0,0 +1,77 @@
+/* ProjectilePool.h
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Projectile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Visual;
+
+
+
+// The projectiles in flight, stored contiguously. Whether each projectile is
+// ballistic (see Projectile::IsBallistic()) is decided once, when it is added,
+// and kept in a parallel array, so that moving the pool can take the cheaper
+// Projectile::MoveBallistic() for most projectiles without asking each weapon
+// again. Removing a projectile moves the last one into its place, so the
+// order of the projectiles is not preserved.
+//
+// Positions, velocities and lifetimes stay in the Projectile objects rather
+// than in separate arrays. A Projectile is a Body, and drawing, collision
+// checks, submunitions and the network code all read those fields through it,
+// so arrays could only ever be a second copy that has to be kept in sync.
+class ProjectilePool {
+public:
+	using iterator = std::vector<Projectile>::iterator;
+	using const_iterator = std::vector<Projectile>::const_iterator;
+
+
+public:
+	iterator begin() { return projectiles.begin(); }
+	iterator end() { return projectiles.end(); }
+	const_iterator begin() const { return projectiles.begin(); }
+	const_iterator end() const { return projectiles.end(); }
+	size_t size() const { return projectiles.size(); }
+	bool empty() const { return projectiles.empty(); }
+	Projectile &operator[](size_t index) { return projectiles[index]; }
+	const Projectile &operator[](size_t index) const { return projectiles[index]; }
+
+	void clear();
+
+	void Add(Projectile &&projectile);
+	// Move all the given projectiles into the pool, leaving the vector empty.
+	void Append(std::vector<Projectile> &added);
+
+	// Move every projectile for one step. Any effects or submunitions they
+	// create are added to the given lists.
+	void Move(std::vector<Visual> &visuals, std::vector<Projectile> &spawned);
+	// Remove the projectiles that are marked for removal.
+	void Prune();
+
+
+private:
+	void PushBack(Projectile &&projectile);
+	void SwapRemove(size_t index);
+
+
+private:
+	std::vector<Projectile> projectiles;
+	// Whether each projectile is ballistic.
+	std::vector<uint8_t> ballistic;
+};
@@ -49,6 +49,8 @@ void Random::Seed(uint64_t seed)
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
 	gen.seed(seed);
+	// Normal distributions generate values in pairs, so forget any that is left over.
+	normal.reset();
 }
 
 
@@ -16,6 +16,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Ship.h"
 
 #include "audio/Audio.h"
+#include "Attribute.h"
 #include "CategoryList.h"
 #include "CategoryType.h"
 #include "DamageDealt.h"
@@ -875,9 +876,10 @@ void Ship::FinishLoading(bool isNewInstance)
 		if(val < 0)
 			warning += attr + ": " + Format::Number(val) + "\n";
 	}
-	if(attributes.Get("drag") <= 0.)
+	if(attributes.Get(Attribute::DRAG) <= 0.)
 	{
-		warning += "Defaulting " + string(attributes.Get("drag") ? "invalid" : "missing") + " \"drag\" attribute to 100.0\n";
+		warning += "Defaulting " + string(attributes.Get(Attribute::DRAG) ? "invalid" : "missing")
+			+ " \"drag\" attribute to 100.0\n";
 		attributes.Set("drag", 100.);
 	}
 
@@ -1348,22 +1350,22 @@ vector<string> Ship::FlightCheck() const
 {
 	auto checks = vector<string>{};
 
-	double generation = attributes.Get("energy generation") - attributes.Get("energy consumption");
-	double consuming = attributes.Get("fuel energy");
-	double solar = attributes.Get("solar collection");
-	double battery = attributes.Get("energy capacity");
+	double generation = attributes.Get(Attribute::ENERGY_GENERATION) - attributes.Get(Attribute::ENERGY_CONSUMPTION);
+	double consuming = attributes.Get(Attribute::FUEL_ENERGY);
+	double solar = attributes.Get(Attribute::SOLAR_COLLECTION);
+	double battery = attributes.Get(Attribute::ENERGY_CAPACITY);
 	double energy = generation + consuming + solar + battery;
-	double fuelChange = attributes.Get("fuel generation") - attributes.Get("fuel consumption");
-	double fuelCapacity = attributes.Get("fuel capacity");
+	double fuelChange = attributes.Get(Attribute::FUEL_GENERATION) - attributes.Get(Attribute::FUEL_CONSUMPTION);
+	double fuelCapacity = attributes.Get(Attribute::FUEL_CAPACITY);
 	double fuel = fuelCapacity + fuelChange;
-	double thrust = attributes.Get("thrust");
-	double reverseThrust = attributes.Get("reverse thrust");
-	double afterburner = attributes.Get("afterburner thrust");
-	double thrustEnergy = attributes.Get("thrusting energy");
-	double thrustHeat = attributes.Get("thrusting heat");
-	double turn = attributes.Get("turn");
-	double turnEnergy = attributes.Get("turning energy");
-	double turnHeat = attributes.Get("turning heat");
+	double thrust = attributes.Get(Attribute::THRUST);
+	double reverseThrust = attributes.Get(Attribute::REVERSE_THRUST);
+	double afterburner = attributes.Get(Attribute::AFTERBURNER_THRUST);
+	double thrustEnergy = attributes.Get(Attribute::THRUSTING_ENERGY);
+	double thrustHeat = attributes.Get(Attribute::THRUSTING_HEAT);
+	double turn = attributes.Get(Attribute::TURN);
+	double turnEnergy = attributes.Get(Attribute::TURNING_ENERGY);
+	double turnHeat = attributes.Get(Attribute::TURNING_HEAT);
 	double hyperDrive = navigation.HasHyperdrive();
 	double jumpDrive = navigation.HasJumpDrive();
 	int bunks = attributes.Get("bunks");
@@ -1677,6 +1679,20 @@ void Ship::UpdateCaches(bool massLessChange)
 
 
 
+uint32_t Ship::GetAISlot() const
+{
+	return aiSlot;
+}
+
+
+
+void Ship::SetAISlot(uint32_t slot)
+{
+	aiSlot = slot;
+}
+
+
+
 bool Ship::CanSendHail(const PlayerInfo &player, bool allowUntranslated) const
 {
 	const System *playerSystem = player.GetSystem();
@@ -1843,7 +1859,7 @@ void Ship::Launch(list<shared_ptr<Ship>> &ships, vector<Visual> &visuals)
 
 				// This ship will refuel naturally based on the carrier's fuel
 				// collection, but the carrier may have some reserves to spare.
-				double maxFuel = bay.ship->attributes.Get("fuel capacity");
+				double maxFuel = bay.ship->attributes.Get(Attribute::FUEL_CAPACITY);
 				if(maxFuel)
 				{
 					double spareFuel = fuel - navigation.JumpFuel();
@@ -1923,7 +1939,8 @@ shared_ptr<Ship> Ship::Board(bool autoPlunder, bool nonDocking)
 		if(victim->Attributes().Get("energy capacity") > 0 && victim->energy < 200.)
 		{
 			helped = true;
-			double toGive = max(attributes.Get("energy capacity") * 0.1, victim->Attributes().Get("energy capacity") * 0.2);
+			double toGive = max(attributes.Get(Attribute::ENERGY_CAPACITY) * 0.1,
+				victim->Attributes().Get(Attribute::ENERGY_CAPACITY) * 0.2);
 			TransferEnergy(max(200., toGive), victim.get());
 		}
 		if(helped)
@@ -2181,7 +2198,7 @@ void Ship::Fire(vector<Projectile> &projectiles, vector<Visual> &visuals, vector
 				armament.Fire(i, *this, projectiles, visuals, Random::Real() < jamChance);
 				if(cloak)
 				{
-					double cloakingFiring = attributes.Get("cloaked firing");
+					double cloakingFiring = attributes.Get(Attribute::CLOAKED_FIRING);
 					// Any negative value means shooting does not decloak.
 					if(cloakingFiring > 0)
 						cloak -= cloakingFiring;
@@ -2344,9 +2361,9 @@ bool Ship::IsIonized() const
 		return false;
 
 	// A ship can only be fully ionized if its engines or weapons require energy.
-	bool usesEnergy = attributes.Get("thrusting energy") > 0
-		|| attributes.Get("reverse thrusting energy") > 0
-		|| attributes.Get("turning energy") > 0
+	bool usesEnergy = attributes.Get(Attribute::THRUSTING_ENERGY) > 0
+		|| attributes.Get(Attribute::REVERSE_THRUSTING_ENERGY) > 0
+		|| attributes.Get(Attribute::TURNING_ENERGY) > 0
 		|| any_of(outfits.begin(), outfits.end(), [](const auto &it) -> bool {
 			const Weapon *weapon = it.first->GetWeapon().get();
 			return weapon && weapon->FiringEnergy() > 0;
@@ -2421,22 +2438,22 @@ bool Ship::CannotAct(ActionType actionType) const
 		switch(actionType)
 		{
 			case ActionType::AFTERBURNER:
-				canActCloaked = attributes.Get("cloaked afterburner");
+				canActCloaked = attributes.Get(Attribute::CLOAKED_AFTERBURNER);
 				break;
 			case ActionType::BOARD:
-				canActCloaked = attributes.Get("cloaked boarding");
+				canActCloaked = attributes.Get(Attribute::CLOAKED_BOARDING);
 				break;
 			case ActionType::COMMUNICATION:
-				canActCloaked = attributes.Get("cloaked communication");
+				canActCloaked = attributes.Get(Attribute::CLOAKED_COMMUNICATION);
 				break;
 			case ActionType::FIRE:
-				canActCloaked = attributes.Get("cloaked firing");
+				canActCloaked = attributes.Get(Attribute::CLOAKED_FIRING);
 				break;
 			case ActionType::PICKUP:
-				canActCloaked = attributes.Get("cloaked pickup");
+				canActCloaked = attributes.Get(Attribute::CLOAKED_PICKUP);
 				break;
 			case ActionType::SCAN:
-				canActCloaked = attributes.Get("cloaked scanning");
+				canActCloaked = attributes.Get(Attribute::CLOAKED_SCANNING);
 				break;
 		}
 	return (cloak == 1. && !canActCloaked) || (cloak != 1. && cloak && !cloakDisruption && !canActCloaked);
@@ -2530,7 +2547,7 @@ bool Ship::IsReadyToJump(bool waitingIsReady) const
 
 	Point direction = targetSystem->Position() - currentSystem->Position();
 	bool isJump = (jumpUsed.first == JumpType::JUMP_DRIVE);
-	double scramThreshold = attributes.Get("scram drive");
+	double scramThreshold = attributes.Get(Attribute::SCRAM_DRIVE);
 
 	// If the system has a departure distance the ship is only allowed to leave the system
 	// if it is beyond this distance.
@@ -2549,7 +2566,7 @@ bool Ship::IsReadyToJump(bool waitingIsReady) const
 		if(deviation > scramThreshold)
 			return false;
 	}
-	else if(velocity.Length() > attributes.Get("jump speed"))
+	else if(velocity.Length() > attributes.Get(Attribute::JUMP_SPEED))
 		return false;
 
 	if(!isJump)
@@ -2700,14 +2717,14 @@ void Ship::Recharge(int rechargeType, bool hireCrew)
 	pilotError = 0;
 	pilotOkay = 0;
 
-	if((rechargeType & Port::RechargeType::Shields) || attributes.Get("shield generation"))
+	if((rechargeType & Port::RechargeType::Shields) || attributes.Get(Attribute::SHIELD_GENERATION))
 		shields = MaxShields();
-	if((rechargeType & Port::RechargeType::Hull) || attributes.Get("hull repair rate"))
+	if((rechargeType & Port::RechargeType::Hull) || attributes.Get(Attribute::HULL_REPAIR_RATE))
 		hull = MaxHull();
-	if((rechargeType & Port::RechargeType::Energy) || attributes.Get("energy generation"))
-		energy = attributes.Get("energy capacity");
-	if((rechargeType & Port::RechargeType::Fuel) || attributes.Get("fuel generation"))
-		fuel = attributes.Get("fuel capacity");
+	if((rechargeType & Port::RechargeType::Energy) || attributes.Get(Attribute::ENERGY_GENERATION))
+		energy = attributes.Get(Attribute::ENERGY_CAPACITY);
+	if((rechargeType & Port::RechargeType::Fuel) || attributes.Get(Attribute::FUEL_GENERATION))
+		fuel = attributes.Get(Attribute::FUEL_CAPACITY);
 
 	heat = IdleHeat();
 	ionization = 0.;
@@ -2734,7 +2751,8 @@ bool Ship::CanRefuel(const Ship &other) const
 
 bool Ship::CanGiveEnergy(const Ship &other) const
 {
-	double toGive = min(other.attributes.Get("energy capacity"), max(200., other.attributes.Get("energy capacity") * 0.2));
+	double toGive = min(other.attributes.Get(Attribute::ENERGY_CAPACITY),
+		max(200., other.attributes.Get(Attribute::ENERGY_CAPACITY) * 0.2));
 	return energy >= 2 * toGive;
 }
 
@@ -2742,10 +2760,10 @@ bool Ship::CanGiveEnergy(const Ship &other) const
 
 double Ship::TransferFuel(double amount, Ship *to)
 {
-	amount = max(fuel - attributes.Get("fuel capacity"), amount);
+	amount = max(fuel - attributes.Get(Attribute::FUEL_CAPACITY), amount);
 	if(to)
 	{
-		amount = min(to->attributes.Get("fuel capacity") - to->fuel, amount);
+		amount = min(to->attributes.Get(Attribute::FUEL_CAPACITY) - to->fuel, amount);
 		to->fuel += amount;
 	}
 	fuel -= amount;
@@ -2756,10 +2774,10 @@ double Ship::TransferFuel(double amount, Ship *to)
 
 double Ship::TransferEnergy(double amount, Ship *to)
 {
-	amount = max(energy - attributes.Get("energy capacity"), amount);
+	amount = max(energy - attributes.Get(Attribute::ENERGY_CAPACITY), amount);
 	if(to)
 	{
-		amount = min(to->attributes.Get("energy capacity") - to->energy, amount);
+		amount = min(to->attributes.Get(Attribute::ENERGY_CAPACITY) - to->energy, amount);
 		to->energy += amount;
 	}
 	energy -= amount;
@@ -2858,7 +2876,7 @@ double Ship::Hull() const
 
 double Ship::Fuel() const
 {
-	double maximum = attributes.Get("fuel capacity");
+	double maximum = attributes.Get(Attribute::FUEL_CAPACITY);
 	return maximum ? min(1., fuel / maximum) : 0.;
 }
 
@@ -2866,7 +2884,7 @@ double Ship::Fuel() const
 
 double Ship::Energy() const
 {
-	double maximum = attributes.Get("energy capacity");
+	double maximum = attributes.Get(Attribute::ENERGY_CAPACITY);
 	return maximum ? min(1., energy / maximum) : (hull > 0.) ? 1. : 0.;
 }
 
@@ -2913,13 +2931,13 @@ double Ship::DisabledHull() const
 // Get the maximum shield and hull values of the ship, accounting for multipliers.
 double Ship::MaxShields() const
 {
-	return attributes.Get("shields") * (1 + attributes.Get("shield multiplier"));
+	return attributes.Get(Attribute::SHIELDS) * (1 + attributes.Get(Attribute::SHIELD_MULTIPLIER));
 }
 
 
 double Ship::MaxHull() const
 {
-	return attributes.Get("hull") * (1 + attributes.Get("hull multiplier"));
+	return attributes.Get(Attribute::HULL) * (1 + attributes.Get(Attribute::HULL_MULTIPLIER));
 }
 
 
@@ -3017,15 +3035,15 @@ bool Ship::NeedsFuel(bool followParent) const
 	}
 	if(!jumpFuel)
 		jumpFuel = navigation.JumpFuel(targetSystem);
-	return (fuel < jumpFuel) && (attributes.Get("fuel capacity") >= jumpFuel);
+	return (fuel < jumpFuel) && (attributes.Get(Attribute::FUEL_CAPACITY) >= jumpFuel);
 }
 
 
 
 bool Ship::NeedsEnergy() const
 {
-	return attributes.Get("energy capacity") && !energy && !attributes.Get("energy generation")
-			&& !attributes.Get("fuel energy") && !attributes.Get("solar collection");
+	return attributes.Get(Attribute::ENERGY_CAPACITY) && !energy && !attributes.Get(Attribute::ENERGY_GENERATION)
+			&& !attributes.Get(Attribute::FUEL_ENERGY) && !attributes.Get(Attribute::SOLAR_COLLECTION);
 }
 
 
@@ -3035,7 +3053,7 @@ double Ship::JumpFuelMissing() const
 	// Used for smart refueling: transfer only as much as really needed
 	// includes checking if fuel cap is high enough at all
 	double jumpFuel = navigation.JumpFuel(targetSystem);
-	if(!jumpFuel || fuel > jumpFuel || jumpFuel > attributes.Get("fuel capacity"))
+	if(!jumpFuel || fuel > jumpFuel || jumpFuel > attributes.Get(Attribute::FUEL_CAPACITY))
 		return 0.;
 
 	return jumpFuel - fuel;
@@ -3048,14 +3066,14 @@ double Ship::IdleHeat() const
 {
 	// This ship's cooling ability:
 	double coolingEfficiency = CoolingEfficiency();
-	double cooling = coolingEfficiency * attributes.Get("cooling");
-	double activeCooling = coolingEfficiency * attributes.Get("active cooling");
+	double cooling = coolingEfficiency * attributes.Get(Attribute::COOLING);
+	double activeCooling = coolingEfficiency * attributes.Get(Attribute::ACTIVE_COOLING);
 
 	// Idle heat is the heat level where:
 	// heat = heat - heat * diss + heatGen - cool - activeCool * heat / maxHeat
 	// heat = heat - heat * (diss + activeCool / maxHeat) + (heatGen - cool)
 	// heat * (diss + activeCool / maxHeat) = (heatGen - cool)
-	double production = max(0., attributes.Get("heat generation") - cooling);
+	double production = max(0., attributes.Get(Attribute::HEAT_GENERATION) - cooling);
 	double dissipation = HeatDissipation() + activeCooling / MaximumHeat();
 	if(!dissipation) return production ? numeric_limits<double>::max() : 0;
 	return production / dissipation;
@@ -3066,7 +3084,7 @@ double Ship::IdleHeat() const
 // Get the heat dissipation, in heat units per heat unit per frame.
 double Ship::HeatDissipation() const
 {
-	return .001 * attributes.Get("heat dissipation");
+	return .001 * attributes.Get(Attribute::HEAT_DISSIPATION);
 }
 
 
@@ -3074,7 +3092,7 @@ double Ship::HeatDissipation() const
 // Get the maximum heat level, in heat units (not temperature).
 double Ship::MaximumHeat() const
 {
-	return MAXIMUM_TEMPERATURE * (cargo.Used() + attributes.Mass() + attributes.Get("heat capacity"));
+	return MAXIMUM_TEMPERATURE * (cargo.Used() + attributes.Mass() + attributes.Get(Attribute::HEAT_CAPACITY));
 }
 
 
@@ -3088,7 +3106,7 @@ bool Ship::IsCloaked() const
 
 double Ship::CloakingSpeed() const
 {
-	return attributes.Get("cloak") + attributes.Get("cloak by mass") * 1000. / Mass();
+	return attributes.Get(Attribute::CLOAK) + attributes.Get(Attribute::CLOAK_BY_MASS) * 1000. / Mass();
 }
 
 
@@ -3096,18 +3114,18 @@ double Ship::CloakingSpeed() const
 bool Ship::Phases(Projectile &projectile) const
 {
 	// No Phasing if we are not cloaked, or not having cloak phasing.
-	if(!IsCloaked() || attributes.Get("cloak phasing") == 0)
+	if(!IsCloaked() || attributes.Get(Attribute::CLOAK_PHASING) == 0)
 		return false;
 
 	// Check for full phasing first, to avoid more expensive lookups.
-	if(attributes.Get("cloak phasing") >= 1 || projectile.Phases(*this))
+	if(attributes.Get(Attribute::CLOAK_PHASING) >= 1 || projectile.Phases(*this))
 		return true;
 
 	// Perform the most expensive checks last.
 	// If multiple ships with partial phasing are stacked on top of each other, then the chance of collision increases
 	// significantly, because each ship in the firing-line resets the SetPhase of the previous one. But such stacks
 	// are rare, so we are not going to do anything special for this.
-	if(attributes.Get("cloak phasing") >= Random::Real())
+	if(attributes.Get(Attribute::CLOAK_PHASING) >= Random::Real())
 	{
 		projectile.SetPhases(this);
 		return true;
@@ -3124,7 +3142,7 @@ double Ship::CoolingEfficiency() const
 	// This is an S-curve where the efficiency is 100% if you have no outfits
 	// that create "cooling inefficiency", and as that value increases the
 	// efficiency stays high for a while, then drops off, then approaches 0.
-	double x = attributes.Get("cooling inefficiency");
+	double x = attributes.Get(Attribute::COOLING_INEFFICIENCY);
 	return 2. + 2. / (1. + exp(x / -2.)) - 4. / (1. + exp(x / -4.));
 }
 
@@ -3140,7 +3158,7 @@ int Ship::Crew() const
 // Calculate the drag on this ship. The drag can be no greater than the mass.
 double Ship::Drag() const
 {
-	double drag = attributes.Get("drag") / (1. + attributes.Get("drag reduction"));
+	double drag = attributes.Get(Attribute::DRAG) / (1. + attributes.Get(Attribute::DRAG_REDUCTION));
 	double mass = InertialMass();
 	return drag >= mass ? mass : drag;
 }
@@ -3151,7 +3169,7 @@ double Ship::Drag() const
 // divided by the mass, up to a value of 1.
 double Ship::DragForce() const
 {
-	double drag = attributes.Get("drag") / (1. + attributes.Get("drag reduction"));
+	double drag = attributes.Get(Attribute::DRAG) / (1. + attributes.Get(Attribute::DRAG_REDUCTION));
 	double mass = InertialMass();
 	return drag >= mass ? 1. : drag / mass;
 }
@@ -3204,15 +3222,15 @@ double Ship::Mass() const
 // Account for inertia reduction, which affects movement but has no effect on the ship's heat capacity.
 double Ship::InertialMass() const
 {
-	return Mass() / (1. + attributes.Get("inertia reduction"));
+	return Mass() / (1. + attributes.Get(Attribute::INERTIA_REDUCTION));
 }
 
 
 
 double Ship::TurnRate() const
 {
-	return attributes.Get("turn") / InertialMass()
-		* (1. + attributes.Get("turn multiplier"));
+	return attributes.Get(Attribute::TURN) / InertialMass()
+		* (1. + attributes.Get(Attribute::TURN_MULTIPLIER));
 }
 
 
@@ -3234,9 +3252,9 @@ double Ship::CrewTurnRate() const
 
 double Ship::Acceleration() const
 {
-	double thrust = attributes.Get("thrust");
-	return (thrust ? thrust : attributes.Get("afterburner thrust")) / InertialMass()
-		* (1. + attributes.Get("acceleration multiplier"));
+	double thrust = attributes.Get(Attribute::THRUST);
+	return (thrust ? thrust : attributes.Get(Attribute::AFTERBURNER_THRUST)) / InertialMass()
+		* (1. + attributes.Get(Attribute::ACCELERATION_MULTIPLIER));
 }
 
 
@@ -3261,8 +3279,8 @@ double Ship::MaxVelocity(bool withAfterburner) const
 	// v * drag / mass == thrust / mass
 	// v * drag == thrust
 	// v = thrust / drag
-	double thrust = attributes.Get("thrust");
-	double afterburnerThrust = attributes.Get("afterburner thrust");
+	double thrust = attributes.Get(Attribute::THRUST);
+	double afterburnerThrust = attributes.Get(Attribute::AFTERBURNER_THRUST);
 	return (thrust ? thrust + afterburnerThrust * withAfterburner : afterburnerThrust) / Drag();
 }
 
@@ -3270,15 +3288,15 @@ double Ship::MaxVelocity(bool withAfterburner) const
 
 double Ship::ReverseAcceleration() const
 {
-	return attributes.Get("reverse thrust") / InertialMass()
-		* (1. + attributes.Get("acceleration multiplier"));
+	return attributes.Get(Attribute::REVERSE_THRUST) / InertialMass()
+		* (1. + attributes.Get(Attribute::ACCELERATION_MULTIPLIER));
 }
 
 
 
 double Ship::MaxReverseVelocity() const
 {
-	return attributes.Get("reverse thrust") / Drag();
+	return attributes.Get(Attribute::REVERSE_THRUST) / Drag();
 }
 
 
@@ -3319,13 +3337,13 @@ int Ship::TakeDamage(vector<Visual> &visuals, const DamageDealt &damage, const G
 	shields -= damage.Shield();
 	if(damage.Shield() && !isDisabled)
 	{
-		int disabledDelay = attributes.Get("depleted shield delay");
+		int disabledDelay = attributes.Get(Attribute::DEPLETED_SHIELD_DELAY);
 		shieldDelay = max<int>(shieldDelay, (shields <= 0. && disabledDelay)
-			? disabledDelay : attributes.Get("shield delay"));
+			? disabledDelay : attributes.Get(Attribute::SHIELD_DELAY));
 	}
 	hull -= damage.Hull();
 	if(damage.Hull() && !isDisabled)
-		hullDelay = max(hullDelay, static_cast<int>(attributes.Get("repair delay")));
+		hullDelay = max(hullDelay, static_cast<int>(attributes.Get(Attribute::REPAIR_DELAY)));
 
 	energy -= damage.Energy();
 	heat += damage.Heat();
@@ -3362,7 +3380,7 @@ int Ship::TakeDamage(vector<Visual> &visuals, const DamageDealt &damage, const G
 	if(!wasDisabled && isDisabled)
 	{
 		type |= ShipEvent::DISABLE;
-		hullDelay = max(hullDelay, static_cast<int>(attributes.Get("disabled repair delay")));
+		hullDelay = max(hullDelay, static_cast<int>(attributes.Get(Attribute::DISABLED_REPAIR_DELAY)));
 	}
 	if(!wasDestroyed && IsDestroyed())
 	{
@@ -3768,10 +3786,11 @@ Ship::CanFireResult Ship::CanFire(const Weapon *weapon) const
 	}
 
 	if(weapon->ConsumesEnergy()
-			&& energy < weapon->FiringEnergy() + weapon->RelativeFiringEnergy() * attributes.Get("energy capacity"))
+			&& energy < weapon->FiringEnergy()
+				+ weapon->RelativeFiringEnergy() * attributes.Get(Attribute::ENERGY_CAPACITY))
 		return CanFireResult::NO_ENERGY;
 	if(weapon->ConsumesFuel()
-			&& fuel < weapon->FiringFuel() + weapon->RelativeFiringFuel() * attributes.Get("fuel capacity"))
+			&& fuel < weapon->FiringFuel() + weapon->RelativeFiringFuel() * attributes.Get(Attribute::FUEL_CAPACITY))
 		return CanFireResult::NO_FUEL;
 	// We do check hull, but we don't check shields. Ships can survive with all shields depleted.
 	// Ships should not disable themselves, so we check if we stay above minimumHull.
@@ -3803,8 +3822,8 @@ void Ship::ExpendAmmo(const Weapon &weapon)
 {
 	// Compute this ship's initial capacities, in case the consumption of the ammunition outfit(s)
 	// modifies them, so that relative costs are calculated based on the pre-firing state of the ship.
-	const double relativeEnergyChange = weapon.RelativeFiringEnergy() * attributes.Get("energy capacity");
-	const double relativeFuelChange = weapon.RelativeFiringFuel() * attributes.Get("fuel capacity");
+	const double relativeEnergyChange = weapon.RelativeFiringEnergy() * attributes.Get(Attribute::ENERGY_CAPACITY);
+	const double relativeFuelChange = weapon.RelativeFiringFuel() * attributes.Get(Attribute::FUEL_CAPACITY);
 	const double relativeHeatChange = !weapon.RelativeFiringHeat() ? 0. : weapon.RelativeFiringHeat() * MaximumHeat();
 	const double relativeHullChange = weapon.RelativeFiringHull() * MaxHull();
 	const double relativeShieldChange = weapon.RelativeFiringShields() * MaxShields();
@@ -4184,36 +4203,36 @@ void Ship::DoGeneration()
 		// 4. Shields of carried fighters
 		// 5. Transfer of excess energy and fuel to carried fighters.
 
-		const double hullAvailable = (attributes.Get("hull repair rate")
-			+ (hullDelay ? 0 : attributes.Get("delayed hull repair rate")))
-			* (1. + attributes.Get("hull repair multiplier"))
-			* (1. + attributes.Get("cloaked repair multiplier") * Cloaking());
-		const double hullEnergy = (attributes.Get("hull energy")
-			+ (hullDelay ? 0 : attributes.Get("delayed hull energy")))
-			* (1. + attributes.Get("hull energy multiplier")) / hullAvailable;
-		const double hullFuel = (attributes.Get("hull fuel")
-			+ (hullDelay ? 0 : attributes.Get("delayed hull fuel")))
-			* (1. + attributes.Get("hull fuel multiplier")) / hullAvailable;
-		const double hullHeat = (attributes.Get("hull heat")
-			+ (hullDelay ? 0 : attributes.Get("delayed hull heat")))
-			* (1. + attributes.Get("hull heat multiplier")) / hullAvailable;
+		const double hullAvailable = (attributes.Get(Attribute::HULL_REPAIR_RATE)
+			+ (hullDelay ? 0 : attributes.Get(Attribute::DELAYED_HULL_REPAIR_RATE)))
+			* (1. + attributes.Get(Attribute::HULL_REPAIR_MULTIPLIER))
+			* (1. + attributes.Get(Attribute::CLOAKED_REPAIR_MULTIPLIER) * Cloaking());
+		const double hullEnergy = (attributes.Get(Attribute::HULL_ENERGY)
+			+ (hullDelay ? 0 : attributes.Get(Attribute::DELAYED_HULL_ENERGY)))
+			* (1. + attributes.Get(Attribute::HULL_ENERGY_MULTIPLIER)) / hullAvailable;
+		const double hullFuel = (attributes.Get(Attribute::HULL_FUEL)
+			+ (hullDelay ? 0 : attributes.Get(Attribute::DELAYED_HULL_FUEL)))
+			* (1. + attributes.Get(Attribute::HULL_FUEL_MULTIPLIER)) / hullAvailable;
+		const double hullHeat = (attributes.Get(Attribute::HULL_HEAT)
+			+ (hullDelay ? 0 : attributes.Get(Attribute::DELAYED_HULL_HEAT)))
+			* (1. + attributes.Get(Attribute::HULL_HEAT_MULTIPLIER)) / hullAvailable;
 		double hullRemaining = hullAvailable;
 		DoRepair(hull, hullRemaining, MaxHull(),
 			energy, hullEnergy, fuel, hullFuel, heat, hullHeat);
 
-		const double shieldsAvailable = (attributes.Get("shield generation")
-			+ (shieldDelay ? 0 : attributes.Get("delayed shield generation")))
-			* (1. + attributes.Get("shield generation multiplier"))
-			* (1. + attributes.Get("cloaked regen multiplier") * Cloaking());
-		const double shieldsEnergy = (attributes.Get("shield energy")
-			+ (shieldDelay ? 0 : attributes.Get("delayed shield energy")))
-			* (1. + attributes.Get("shield energy multiplier")) / shieldsAvailable;
-		const double shieldsFuel = (attributes.Get("shield fuel")
-			+ (shieldDelay ? 0 : attributes.Get("delayed shield fuel")))
-			* (1. + attributes.Get("shield fuel multiplier")) / shieldsAvailable;
-		const double shieldsHeat = (attributes.Get("shield heat")
-			+ (shieldDelay ? 0 : attributes.Get("delayed shield heat")))
-			* (1. + attributes.Get("shield heat multiplier")) / shieldsAvailable;
+		const double shieldsAvailable = (attributes.Get(Attribute::SHIELD_GENERATION)
+			+ (shieldDelay ? 0 : attributes.Get(Attribute::DELAYED_SHIELD_GENERATION)))
+			* (1. + attributes.Get(Attribute::SHIELD_GENERATION_MULTIPLIER))
+			* (1. + attributes.Get(Attribute::CLOAKED_REGEN_MULTIPLIER) * Cloaking());
+		const double shieldsEnergy = (attributes.Get(Attribute::SHIELD_ENERGY)
+			+ (shieldDelay ? 0 : attributes.Get(Attribute::DELAYED_SHIELD_ENERGY)))
+			* (1. + attributes.Get(Attribute::SHIELD_ENERGY_MULTIPLIER)) / shieldsAvailable;
+		const double shieldsFuel = (attributes.Get(Attribute::SHIELD_FUEL)
+			+ (shieldDelay ? 0 : attributes.Get(Attribute::DELAYED_SHIELD_FUEL)))
+			* (1. + attributes.Get(Attribute::SHIELD_FUEL_MULTIPLIER)) / shieldsAvailable;
+		const double shieldsHeat = (attributes.Get(Attribute::SHIELD_HEAT)
+			+ (shieldDelay ? 0 : attributes.Get(Attribute::DELAYED_SHIELD_HEAT)))
+			* (1. + attributes.Get(Attribute::SHIELD_HEAT_MULTIPLIER)) / shieldsAvailable;
 		double shieldsRemaining = shieldsAvailable;
 		DoRepair(shields, shieldsRemaining, MaxShields(),
 			energy, shieldsEnergy, fuel, shieldsFuel, heat, shieldsHeat);
@@ -4249,15 +4268,15 @@ void Ship::DoGeneration()
 
 			// Now that there is no more need to use energy for hull and shield
 			// repair, if there is still excess energy, transfer it.
-			double energyRemaining = energy - attributes.Get("energy capacity");
-			double fuelRemaining = fuel - attributes.Get("fuel capacity");
+			double energyRemaining = energy - attributes.Get(Attribute::ENERGY_CAPACITY);
+			double fuelRemaining = fuel - attributes.Get(Attribute::FUEL_CAPACITY);
 			for(const pair<double, Ship *> &it : carried)
 			{
 				Ship &ship = *it.second;
 				if(energyRemaining > 0.)
-					DoRepair(ship.energy, energyRemaining, ship.attributes.Get("energy capacity"));
+					DoRepair(ship.energy, energyRemaining, ship.attributes.Get(Attribute::ENERGY_CAPACITY));
 				if(fuelRemaining > 0.)
-					DoRepair(ship.fuel, fuelRemaining, ship.attributes.Get("fuel capacity"));
+					DoRepair(ship.fuel, fuelRemaining, ship.attributes.Get(Attribute::FUEL_CAPACITY));
 			}
 
 			// Carried ships can recharge energy from their parent's batteries,
@@ -4266,7 +4285,7 @@ void Ship::DoGeneration()
 			{
 				Ship &ship = *it.second;
 				if(ship.HasDeployOrder())
-					DoRepair(ship.energy, energy, ship.attributes.Get("energy capacity"));
+					DoRepair(ship.energy, energy, ship.attributes.Get(Attribute::ENERGY_CAPACITY));
 			}
 		}
 		// Decrease the shield and hull delays by 1 now that shield generation
@@ -4275,28 +4294,28 @@ void Ship::DoGeneration()
 		hullDelay = max(0, hullDelay - 1);
 	}
 	// Let the ship repair itself when disabled if it has the appropriate attribute.
-	if(isDisabled && attributes.Get("disabled recovery time"))
+	if(isDisabled && attributes.Get(Attribute::DISABLED_RECOVERY_TIME))
 	{
 		disabledRecoveryCounter += 1;
-		double disabledRepairEnergy = attributes.Get("disabled recovery energy");
-		double disabledRepairFuel = attributes.Get("disabled recovery fuel");
+		double disabledRepairEnergy = attributes.Get(Attribute::DISABLED_RECOVERY_ENERGY);
+		double disabledRepairFuel = attributes.Get(Attribute::DISABLED_RECOVERY_FUEL);
 
 		// Repair only if the counter has reached the limit and if the ship can meet the energy and fuel costs.
-		if(disabledRecoveryCounter >= attributes.Get("disabled recovery time")
+		if(disabledRecoveryCounter >= attributes.Get(Attribute::DISABLED_RECOVERY_TIME)
 			&& energy >= disabledRepairEnergy && fuel >= disabledRepairFuel)
 		{
 			energy -= disabledRepairEnergy;
 			fuel -= disabledRepairFuel;
 
-			heat += attributes.Get("disabled recovery heat");
-			ionization += attributes.Get("disabled recovery ionization");
-			scrambling += attributes.Get("disabled recovery scrambling");
-			disruption += attributes.Get("disabled recovery disruption");
-			slowness += attributes.Get("disabled recovery slowing");
-			discharge += attributes.Get("disabled recovery discharge");
-			corrosion += attributes.Get("disabled recovery corrosion");
-			leakage += attributes.Get("disabled recovery leak");
-			burning += attributes.Get("disabled recovery burning");
+			heat += attributes.Get(Attribute::DISABLED_RECOVERY_HEAT);
+			ionization += attributes.Get(Attribute::DISABLED_RECOVERY_IONIZATION);
+			scrambling += attributes.Get(Attribute::DISABLED_RECOVERY_SCRAMBLING);
+			disruption += attributes.Get(Attribute::DISABLED_RECOVERY_DISRUPTION);
+			slowness += attributes.Get(Attribute::DISABLED_RECOVERY_SLOWING);
+			discharge += attributes.Get(Attribute::DISABLED_RECOVERY_DISCHARGE);
+			corrosion += attributes.Get(Attribute::DISABLED_RECOVERY_CORROSION);
+			leakage += attributes.Get(Attribute::DISABLED_RECOVERY_LEAK);
+			burning += attributes.Get(Attribute::DISABLED_RECOVERY_BURNING);
 
 			disabledRecoveryCounter = 0;
 			hull = min(max(hull, MinimumHull() * 1.5), MaxHull());
@@ -4314,80 +4333,80 @@ void Ship::DoGeneration()
 	// TODO: Mothership gives status resistance to carried ships?
 	if(ionization)
 	{
-		double ionResistance = attributes.Get("ion resistance");
-		double ionEnergy = attributes.Get("ion resistance energy") / ionResistance;
-		double ionFuel = attributes.Get("ion resistance fuel") / ionResistance;
-		double ionHeat = attributes.Get("ion resistance heat") / ionResistance;
+		double ionResistance = attributes.Get(Attribute::ION_RESISTANCE);
+		double ionEnergy = attributes.Get(Attribute::ION_RESISTANCE_ENERGY) / ionResistance;
+		double ionFuel = attributes.Get(Attribute::ION_RESISTANCE_FUEL) / ionResistance;
+		double ionHeat = attributes.Get(Attribute::ION_RESISTANCE_HEAT) / ionResistance;
 		DoStatusEffect(isDisabled, ionization, ionResistance,
 			energy, ionEnergy, fuel, ionFuel, heat, ionHeat);
 	}
 
 	if(scrambling)
 	{
-		double scramblingResistance = attributes.Get("scramble resistance");
-		double scramblingEnergy = attributes.Get("scramble resistance energy") / scramblingResistance;
-		double scramblingFuel = attributes.Get("scramble resistance fuel") / scramblingResistance;
-		double scramblingHeat = attributes.Get("scramble resistance heat") / scramblingResistance;
+		double scramblingResistance = attributes.Get(Attribute::SCRAMBLE_RESISTANCE);
+		double scramblingEnergy = attributes.Get(Attribute::SCRAMBLE_RESISTANCE_ENERGY) / scramblingResistance;
+		double scramblingFuel = attributes.Get(Attribute::SCRAMBLE_RESISTANCE_FUEL) / scramblingResistance;
+		double scramblingHeat = attributes.Get(Attribute::SCRAMBLE_RESISTANCE_HEAT) / scramblingResistance;
 		DoStatusEffect(isDisabled, scrambling, scramblingResistance,
 			energy, scramblingEnergy, fuel, scramblingFuel, heat, scramblingHeat);
 	}
 
 	if(disruption)
 	{
-		double disruptionResistance = attributes.Get("disruption resistance");
-		double disruptionEnergy = attributes.Get("disruption resistance energy") / disruptionResistance;
-		double disruptionFuel = attributes.Get("disruption resistance fuel") / disruptionResistance;
-		double disruptionHeat = attributes.Get("disruption resistance heat") / disruptionResistance;
+		double disruptionResistance = attributes.Get(Attribute::DISRUPTION_RESISTANCE);
+		double disruptionEnergy = attributes.Get(Attribute::DISRUPTION_RESISTANCE_ENERGY) / disruptionResistance;
+		double disruptionFuel = attributes.Get(Attribute::DISRUPTION_RESISTANCE_FUEL) / disruptionResistance;
+		double disruptionHeat = attributes.Get(Attribute::DISRUPTION_RESISTANCE_HEAT) / disruptionResistance;
 		DoStatusEffect(isDisabled, disruption, disruptionResistance,
 			energy, disruptionEnergy, fuel, disruptionFuel, heat, disruptionHeat);
 	}
 
 	if(slowness)
 	{
-		double slowingResistance = attributes.Get("slowing resistance");
-		double slowingEnergy = attributes.Get("slowing resistance energy") / slowingResistance;
-		double slowingFuel = attributes.Get("slowing resistance fuel") / slowingResistance;
-		double slowingHeat = attributes.Get("slowing resistance heat") / slowingResistance;
+		double slowingResistance = attributes.Get(Attribute::SLOWING_RESISTANCE);
+		double slowingEnergy = attributes.Get(Attribute::SLOWING_RESISTANCE_ENERGY) / slowingResistance;
+		double slowingFuel = attributes.Get(Attribute::SLOWING_RESISTANCE_FUEL) / slowingResistance;
+		double slowingHeat = attributes.Get(Attribute::SLOWING_RESISTANCE_HEAT) / slowingResistance;
 		DoStatusEffect(isDisabled, slowness, slowingResistance,
 			energy, slowingEnergy, fuel, slowingFuel, heat, slowingHeat);
 	}
 
 	if(discharge)
 	{
-		double dischargeResistance = attributes.Get("discharge resistance");
-		double dischargeEnergy = attributes.Get("discharge resistance energy") / dischargeResistance;
-		double dischargeFuel = attributes.Get("discharge resistance fuel") / dischargeResistance;
-		double dischargeHeat = attributes.Get("discharge resistance heat") / dischargeResistance;
+		double dischargeResistance = attributes.Get(Attribute::DISCHARGE_RESISTANCE);
+		double dischargeEnergy = attributes.Get(Attribute::DISCHARGE_RESISTANCE_ENERGY) / dischargeResistance;
+		double dischargeFuel = attributes.Get(Attribute::DISCHARGE_RESISTANCE_FUEL) / dischargeResistance;
+		double dischargeHeat = attributes.Get(Attribute::DISCHARGE_RESISTANCE_HEAT) / dischargeResistance;
 		DoStatusEffect(isDisabled, discharge, dischargeResistance,
 			energy, dischargeEnergy, fuel, dischargeFuel, heat, dischargeHeat);
 	}
 
 	if(corrosion)
 	{
-		double corrosionResistance = attributes.Get("corrosion resistance");
-		double corrosionEnergy = attributes.Get("corrosion resistance energy") / corrosionResistance;
-		double corrosionFuel = attributes.Get("corrosion resistance fuel") / corrosionResistance;
-		double corrosionHeat = attributes.Get("corrosion resistance heat") / corrosionResistance;
+		double corrosionResistance = attributes.Get(Attribute::CORROSION_RESISTANCE);
+		double corrosionEnergy = attributes.Get(Attribute::CORROSION_RESISTANCE_ENERGY) / corrosionResistance;
+		double corrosionFuel = attributes.Get(Attribute::CORROSION_RESISTANCE_FUEL) / corrosionResistance;
+		double corrosionHeat = attributes.Get(Attribute::CORROSION_RESISTANCE_HEAT) / corrosionResistance;
 		DoStatusEffect(isDisabled, corrosion, corrosionResistance,
 			energy, corrosionEnergy, fuel, corrosionFuel, heat, corrosionHeat);
 	}
 
 	if(leakage)
 	{
-		double leakResistance = attributes.Get("leak resistance");
-		double leakEnergy = attributes.Get("leak resistance energy") / leakResistance;
-		double leakFuel = attributes.Get("leak resistance fuel") / leakResistance;
-		double leakHeat = attributes.Get("leak resistance heat") / leakResistance;
+		double leakResistance = attributes.Get(Attribute::LEAK_RESISTANCE);
+		double leakEnergy = attributes.Get(Attribute::LEAK_RESISTANCE_ENERGY) / leakResistance;
+		double leakFuel = attributes.Get(Attribute::LEAK_RESISTANCE_FUEL) / leakResistance;
+		double leakHeat = attributes.Get(Attribute::LEAK_RESISTANCE_HEAT) / leakResistance;
 		DoStatusEffect(isDisabled, leakage, leakResistance,
 			energy, leakEnergy, fuel, leakFuel, heat, leakHeat);
 	}
 
 	if(burning)
 	{
-		double burnResistance = attributes.Get("burn resistance");
-		double burnEnergy = attributes.Get("burn resistance energy") / burnResistance;
-		double burnFuel = attributes.Get("burn resistance fuel") / burnResistance;
-		double burnHeat = attributes.Get("burn resistance heat") / burnResistance;
+		double burnResistance = attributes.Get(Attribute::BURN_RESISTANCE);
+		double burnEnergy = attributes.Get(Attribute::BURN_RESISTANCE_ENERGY) / burnResistance;
+		double burnFuel = attributes.Get(Attribute::BURN_RESISTANCE_FUEL) / burnResistance;
+		double burnHeat = attributes.Get(Attribute::BURN_RESISTANCE_HEAT) / burnResistance;
 		DoStatusEffect(isDisabled, burning, burnResistance,
 			energy, burnEnergy, fuel, burnFuel, heat, burnHeat);
 	}
@@ -4396,16 +4415,16 @@ void Ship::DoGeneration()
 	// maximum capacity for the rest of the turn, but must be clamped to the
 	// maximum here before they gain more. This is so that, for example, a ship
 	// with no batteries but a good generator can still move.
-	energy = min(energy, attributes.Get("energy capacity"));
-	fuel = min(fuel, attributes.Get("fuel capacity"));
+	energy = min(energy, attributes.Get(Attribute::ENERGY_CAPACITY));
+	fuel = min(fuel, attributes.Get(Attribute::FUEL_CAPACITY));
 
 	heat -= heat * HeatDissipation();
 	if(heat > MaximumHeat())
 	{
 		isOverheated = true;
-		double heatRatio = Heat() / (1. + attributes.Get("overheat damage threshold"));
+		double heatRatio = Heat() / (1. + attributes.Get(Attribute::OVERHEAT_DAMAGE_THRESHOLD));
 		if(heatRatio > 1.)
-			hull -= attributes.Get("overheat damage rate") * heatRatio;
+			hull -= attributes.Get(Attribute::OVERHEAT_DAMAGE_RATE) * heatRatio;
 	}
 	else if(heat < .9 * MaximumHeat())
 		isOverheated = false;
@@ -4427,34 +4446,35 @@ void Ship::DoGeneration()
 		if(currentSystem)
 		{
 			System::SolarGeneration generation = currentSystem->GetSolarGeneration(position,
-				attributes.Get("ramscoop"), attributes.Get("solar collection"), attributes.Get("solar heat"));
+				attributes.Get(Attribute::RAMSCOOP), attributes.Get(Attribute::SOLAR_COLLECTION),
+				attributes.Get(Attribute::SOLAR_HEAT));
 			fuel += generation.fuel;
 			energy += generation.energy;
 			heat += generation.heat;
 		}
 
 		double coolingEfficiency = CoolingEfficiency();
-		energy += attributes.Get("energy generation") - attributes.Get("energy consumption");
-		fuel += attributes.Get("fuel generation");
-		heat += attributes.Get("heat generation");
-		heat -= coolingEfficiency * attributes.Get("cooling");
+		energy += attributes.Get(Attribute::ENERGY_GENERATION) - attributes.Get(Attribute::ENERGY_CONSUMPTION);
+		fuel += attributes.Get(Attribute::FUEL_GENERATION);
+		heat += attributes.Get(Attribute::HEAT_GENERATION);
+		heat -= coolingEfficiency * attributes.Get(Attribute::COOLING);
 
 		// Convert fuel into energy and heat only when the required amount of fuel is available.
-		if(attributes.Get("fuel consumption") <= fuel)
+		if(attributes.Get(Attribute::FUEL_CONSUMPTION) <= fuel)
 		{
-			fuel -= attributes.Get("fuel consumption");
-			energy += attributes.Get("fuel energy");
-			heat += attributes.Get("fuel heat");
+			fuel -= attributes.Get(Attribute::FUEL_CONSUMPTION);
+			energy += attributes.Get(Attribute::FUEL_ENERGY);
+			heat += attributes.Get(Attribute::FUEL_HEAT);
 		}
 
 		// Apply active cooling. The fraction of full cooling to apply equals
 		// your ship's current fraction of its maximum temperature.
-		double activeCooling = coolingEfficiency * attributes.Get("active cooling");
+		double activeCooling = coolingEfficiency * attributes.Get(Attribute::ACTIVE_COOLING);
 		if(activeCooling > 0. && heat > 0. && energy >= 0.)
 		{
 			// Handle the case where "active cooling"
 			// does not require any energy.
-			double coolingEnergy = attributes.Get("cooling energy");
+			double coolingEnergy = attributes.Get(Attribute::COOLING_ENERGY);
 			if(coolingEnergy)
 			{
 				double spentEnergy = min(energy, coolingEnergy * min(1., Heat()));
@@ -4534,15 +4554,15 @@ void Ship::DoCloakDecision()
 
 	// Attempting to cloak when the cloaking device can no longer operate (because of hull damage)
 	// will result in it being uncloaked.
-	const double minimalHullForCloak = attributes.Get("cloak hull threshold");
-	if(minimalHullForCloak && (hull / attributes.Get("hull") < minimalHullForCloak))
+	const double minimalHullForCloak = attributes.Get(Attribute::CLOAK_HULL_THRESHOLD);
+	if(minimalHullForCloak && (hull / attributes.Get(Attribute::HULL) < minimalHullForCloak))
 		cloakDisruption = 1.;
 
 	const double cloakingSpeed = CloakingSpeed();
-	const double cloakingFuel = attributes.Get("cloaking fuel");
-	const double cloakingEnergy = attributes.Get("cloaking energy");
-	const double cloakingHull = attributes.Get("cloaking hull");
-	const double cloakingShield = attributes.Get("cloaking shields");
+	const double cloakingFuel = attributes.Get(Attribute::CLOAKING_FUEL);
+	const double cloakingEnergy = attributes.Get(Attribute::CLOAKING_ENERGY);
+	const double cloakingHull = attributes.Get(Attribute::CLOAKING_HULL);
+	const double cloakingShield = attributes.Get(Attribute::CLOAKING_SHIELDS);
 	bool canCloak = (!isDisabled && cloakingSpeed > 0. && !cloakDisruption
 		&& fuel >= cloakingFuel && energy >= cloakingEnergy
 		&& MinimumHull() < hull - cloakingHull && shields >= cloakingShield);
@@ -4553,9 +4573,9 @@ void Ship::DoCloakDecision()
 		energy -= cloakingEnergy;
 		shields -= cloakingShield;
 		hull -= cloakingHull;
-		heat += attributes.Get("cloaking heat");
-		double cloakingShieldDelay = attributes.Get("cloaking shield delay");
-		double cloakingHullDelay = attributes.Get("cloaking repair delay");
+		heat += attributes.Get(Attribute::CLOAKING_HEAT);
+		double cloakingShieldDelay = attributes.Get(Attribute::CLOAKING_SHIELD_DELAY);
+		double cloakingHullDelay = attributes.Get(Attribute::CLOAKING_REPAIR_DELAY);
 		cloakingShieldDelay = (cloakingShieldDelay < 1.) ?
 			(Random::Real() <= cloakingShieldDelay) : cloakingShieldDelay;
 		cloakingHullDelay = (cloakingHullDelay < 1.) ?
@@ -4785,7 +4805,7 @@ bool Ship::DoLandingLogic()
 		}
 	}
 	// Only refuel if this planet has a spaceport.
-	else if(fuel >= attributes.Get("fuel capacity")
+	else if(fuel >= attributes.Get(Attribute::FUEL_CAPACITY)
 			|| !landingPlanet
 			|| !landingPlanet->GetPort().CanRecharge(Port::RechargeType::Fuel, isYours))
 	{
@@ -4794,7 +4814,7 @@ bool Ship::DoLandingLogic()
 		landingPlanet = nullptr;
 	}
 	else
-		fuel = min(fuel + 1., attributes.Get("fuel capacity"));
+		fuel = min(fuel + 1., attributes.Get(Attribute::FUEL_CAPACITY));
 
 	// Move the ship at the velocity it had when it began landing, but
 	// scaled based on how small it is now.
@@ -4872,23 +4892,23 @@ void Ship::DoMovement(bool &isUsingAfterburner)
 		if(commands.Turn())
 		{
 			// Check if we are able to turn.
-			double cost = attributes.Get("turning energy");
+			double cost = attributes.Get(Attribute::TURNING_ENERGY);
 			if(cost > 0. && energy < cost * fabs(commands.Turn()))
 				commands.SetTurn(copysign(energy / cost, commands.Turn()));
 
-			cost = attributes.Get("turning shields");
+			cost = attributes.Get(Attribute::TURNING_SHIELDS);
 			if(cost > 0. && shields < cost * fabs(commands.Turn()))
 				commands.SetTurn(copysign(shields / cost, commands.Turn()));
 
-			cost = attributes.Get("turning hull");
+			cost = attributes.Get(Attribute::TURNING_HULL);
 			if(cost > 0. && hull < cost * fabs(commands.Turn()))
 				commands.SetTurn(copysign(hull / cost, commands.Turn()));
 
-			cost = attributes.Get("turning fuel");
+			cost = attributes.Get(Attribute::TURNING_FUEL);
 			if(cost > 0. && fuel < cost * fabs(commands.Turn()))
 				commands.SetTurn(copysign(fuel / cost, commands.Turn()));
 
-			cost = -attributes.Get("turning heat");
+			cost = -attributes.Get(Attribute::TURNING_HEAT);
 			if(cost > 0. && heat < cost * fabs(commands.Turn()))
 				commands.SetTurn(copysign(heat / cost, commands.Turn()));
 
@@ -4902,19 +4922,19 @@ void Ship::DoMovement(bool &isUsingAfterburner)
 				// of the turning energy and produce a fraction of the heat.
 				double scale = fabs(commands.Turn());
 
-				shields -= scale * attributes.Get("turning shields");
-				hull -= scale * attributes.Get("turning hull");
-				energy -= scale * attributes.Get("turning energy");
-				fuel -= scale * attributes.Get("turning fuel");
-				heat += scale * attributes.Get("turning heat");
-				discharge += scale * attributes.Get("turning discharge");
-				corrosion += scale * attributes.Get("turning corrosion");
-				ionization += scale * attributes.Get("turning ion");
-				scrambling += scale * attributes.Get("turning scramble");
-				leakage += scale * attributes.Get("turning leakage");
-				burning += scale * attributes.Get("turning burn");
-				slowness += scale * attributes.Get("turning slowing");
-				disruption += scale * attributes.Get("turning disruption");
+				shields -= scale * attributes.Get(Attribute::TURNING_SHIELDS);
+				hull -= scale * attributes.Get(Attribute::TURNING_HULL);
+				energy -= scale * attributes.Get(Attribute::TURNING_ENERGY);
+				fuel -= scale * attributes.Get(Attribute::TURNING_FUEL);
+				heat += scale * attributes.Get(Attribute::TURNING_HEAT);
+				discharge += scale * attributes.Get(Attribute::TURNING_DISCHARGE);
+				corrosion += scale * attributes.Get(Attribute::TURNING_CORROSION);
+				ionization += scale * attributes.Get(Attribute::TURNING_ION);
+				scrambling += scale * attributes.Get(Attribute::TURNING_SCRAMBLE);
+				leakage += scale * attributes.Get(Attribute::TURNING_LEAKAGE);
+				burning += scale * attributes.Get(Attribute::TURNING_BURN);
+				slowness += scale * attributes.Get(Attribute::TURNING_SLOWING);
+				disruption += scale * attributes.Get(Attribute::TURNING_DISRUPTION);
 
 				Turn(commands.Turn() * TurnRate() * slowMultiplier);
 			}
@@ -4925,27 +4945,27 @@ void Ship::DoMovement(bool &isUsingAfterburner)
 		{
 			// Check if we are able to apply this thrust.
 			double cost = attributes.Get((thrustCommand > 0.) ?
-				"thrusting energy" : "reverse thrusting energy");
+				Attribute::THRUSTING_ENERGY : Attribute::REVERSE_THRUSTING_ENERGY);
 			if(cost > 0. && energy < cost * fabs(thrustCommand))
 				thrustCommand = copysign(energy / cost, thrustCommand);
 
 			cost = attributes.Get((thrustCommand > 0.) ?
-				"thrusting shields" : "reverse thrusting shields");
+				Attribute::THRUSTING_SHIELDS : Attribute::REVERSE_THRUSTING_SHIELDS);
 			if(cost > 0. && shields < cost * fabs(thrustCommand))
 				thrustCommand = copysign(shields / cost, thrustCommand);
 
 			cost = attributes.Get((thrustCommand > 0.) ?
-				"thrusting hull" : "reverse thrusting hull");
+				Attribute::THRUSTING_HULL : Attribute::REVERSE_THRUSTING_HULL);
 			if(cost > 0. && hull < cost * fabs(thrustCommand))
 				thrustCommand = copysign(hull / cost, thrustCommand);
 
 			cost = attributes.Get((thrustCommand > 0.) ?
-				"thrusting fuel" : "reverse thrusting fuel");
+				Attribute::THRUSTING_FUEL : Attribute::REVERSE_THRUSTING_FUEL);
 			if(cost > 0. && fuel < cost * fabs(thrustCommand))
 				thrustCommand = copysign(fuel / cost, thrustCommand);
 
 			cost = -attributes.Get((thrustCommand > 0.) ?
-				"thrusting heat" : "reverse thrusting heat");
+				Attribute::THRUSTING_HEAT : Attribute::REVERSE_THRUSTING_HEAT);
 			if(cost > 0. && heat < cost * fabs(thrustCommand))
 				thrustCommand = copysign(heat / cost, thrustCommand);
 
@@ -4954,27 +4974,39 @@ void Ship::DoMovement(bool &isUsingAfterburner)
 				// If a reverse thrust is commanded and the capability does not
 				// exist, ignore it (do not even slow under drag).
 				isThrusting = (thrustCommand > 0.);
-				isReversing = !isThrusting && attributes.Get("reverse thrust");
-				thrust = attributes.Get(isThrusting ? "thrust" : "reverse thrust");
+				isReversing = !isThrusting && attributes.Get(Attribute::REVERSE_THRUST);
+				thrust = attributes.Get(isThrusting ? Attribute::THRUST : Attribute::REVERSE_THRUST);
 				IncrementThrusterHeld(isReversing ? ThrustKind::REVERSE : ThrustKind::FORWARD);
 				if(thrust)
 				{
 					double scale = fabs(thrustCommand);
 
-					shields -= scale * attributes.Get(isThrusting ? "thrusting shields" : "reverse thrusting shields");
-					hull -= scale * attributes.Get(isThrusting ? "thrusting hull" : "reverse thrusting hull");
-					energy -= scale * attributes.Get(isThrusting ? "thrusting energy" : "reverse thrusting energy");
-					fuel -= scale * attributes.Get(isThrusting ? "thrusting fuel" : "reverse thrusting fuel");
-					heat += scale * attributes.Get(isThrusting ? "thrusting heat" : "reverse thrusting heat");
-					discharge += scale * attributes.Get(isThrusting ? "thrusting discharge" : "reverse thrusting discharge");
-					corrosion += scale * attributes.Get(isThrusting ? "thrusting corrosion" : "reverse thrusting corrosion");
-					ionization += scale * attributes.Get(isThrusting ? "thrusting ion" : "reverse thrusting ion");
-					scrambling += scale * attributes.Get(isThrusting ? "thrusting scramble" :
-						"reverse thrusting scramble");
-					burning += scale * attributes.Get(isThrusting ? "thrusting burn" : "reverse thrusting burn");
-					leakage += scale * attributes.Get(isThrusting ? "thrusting leakage" : "reverse thrusting leakage");
-					slowness += scale * attributes.Get(isThrusting ? "thrusting slowing" : "reverse thrusting slowing");
-					disruption += scale * attributes.Get(isThrusting ? "thrusting disruption" : "reverse thrusting disruption");
+					shields -= scale * attributes.Get(isThrusting ? Attribute::THRUSTING_SHIELDS
+						: Attribute::REVERSE_THRUSTING_SHIELDS);
+					hull -= scale * attributes.Get(isThrusting ? Attribute::THRUSTING_HULL
+						: Attribute::REVERSE_THRUSTING_HULL);
+					energy -= scale * attributes.Get(isThrusting ? Attribute::THRUSTING_ENERGY
+						: Attribute::REVERSE_THRUSTING_ENERGY);
+					fuel -= scale * attributes.Get(isThrusting ? Attribute::THRUSTING_FUEL
+						: Attribute::REVERSE_THRUSTING_FUEL);
+					heat += scale * attributes.Get(isThrusting ? Attribute::THRUSTING_HEAT
+						: Attribute::REVERSE_THRUSTING_HEAT);
+					discharge += scale * attributes.Get(isThrusting ? Attribute::THRUSTING_DISCHARGE
+						: Attribute::REVERSE_THRUSTING_DISCHARGE);
+					corrosion += scale * attributes.Get(isThrusting ? Attribute::THRUSTING_CORROSION
+						: Attribute::REVERSE_THRUSTING_CORROSION);
+					ionization += scale * attributes.Get(isThrusting ? Attribute::THRUSTING_ION
+						: Attribute::REVERSE_THRUSTING_ION);
+					scrambling += scale * attributes.Get(isThrusting ? Attribute::THRUSTING_SCRAMBLE :
+						Attribute::REVERSE_THRUSTING_SCRAMBLE);
+					burning += scale * attributes.Get(isThrusting ? Attribute::THRUSTING_BURN
+						: Attribute::REVERSE_THRUSTING_BURN);
+					leakage += scale * attributes.Get(isThrusting ? Attribute::THRUSTING_LEAKAGE
+						: Attribute::REVERSE_THRUSTING_LEAKAGE);
+					slowness += scale * attributes.Get(isThrusting ? Attribute::THRUSTING_SLOWING
+						: Attribute::REVERSE_THRUSTING_SLOWING);
+					disruption += scale * attributes.Get(isThrusting ? Attribute::THRUSTING_DISRUPTION
+						: Attribute::REVERSE_THRUSTING_DISRUPTION);
 
 					acceleration += angle.Unit() * thrustCommand * (isThrusting ? Acceleration() : ReverseAcceleration());
 				}
@@ -4984,22 +5016,22 @@ void Ship::DoMovement(bool &isUsingAfterburner)
 				&& !CannotAct(Ship::ActionType::AFTERBURNER);
 		if(applyAfterburner)
 		{
-			thrust = attributes.Get("afterburner thrust");
-			double shieldCost = attributes.Get("afterburner shields");
-			double hullCost = attributes.Get("afterburner hull");
-			double energyCost = attributes.Get("afterburner energy");
-			double fuelCost = attributes.Get("afterburner fuel");
-			double heatCost = -attributes.Get("afterburner heat");
-
-			double dischargeCost = attributes.Get("afterburner discharge");
-			double corrosionCost = attributes.Get("afterburner corrosion");
-			double ionCost = attributes.Get("afterburner ion");
-			double scramblingCost = attributes.Get("afterburner scramble");
-			double leakageCost = attributes.Get("afterburner leakage");
-			double burningCost = attributes.Get("afterburner burn");
-
-			double slownessCost = attributes.Get("afterburner slowing");
-			double disruptionCost = attributes.Get("afterburner disruption");
+			thrust = attributes.Get(Attribute::AFTERBURNER_THRUST);
+			double shieldCost = attributes.Get(Attribute::AFTERBURNER_SHIELDS);
+			double hullCost = attributes.Get(Attribute::AFTERBURNER_HULL);
+			double energyCost = attributes.Get(Attribute::AFTERBURNER_ENERGY);
+			double fuelCost = attributes.Get(Attribute::AFTERBURNER_FUEL);
+			double heatCost = -attributes.Get(Attribute::AFTERBURNER_HEAT);
+
+			double dischargeCost = attributes.Get(Attribute::AFTERBURNER_DISCHARGE);
+			double corrosionCost = attributes.Get(Attribute::AFTERBURNER_CORROSION);
+			double ionCost = attributes.Get(Attribute::AFTERBURNER_ION);
+			double scramblingCost = attributes.Get(Attribute::AFTERBURNER_SCRAMBLE);
+			double leakageCost = attributes.Get(Attribute::AFTERBURNER_LEAKAGE);
+			double burningCost = attributes.Get(Attribute::AFTERBURNER_BURN);
+
+			double slownessCost = attributes.Get(Attribute::AFTERBURNER_SLOWING);
+			double disruptionCost = attributes.Get(Attribute::AFTERBURNER_DISRUPTION);
 
 			if(thrust && shields >= shieldCost && hull >= hullCost
 				&& energy >= energyCost && fuel >= fuelCost && heat >= heatCost)
@@ -5020,7 +5052,8 @@ void Ship::DoMovement(bool &isUsingAfterburner)
 				slowness += slownessCost;
 				disruption += disruptionCost;
 
-				acceleration += angle.Unit() * (1. + attributes.Get("acceleration multiplier")) * thrust / mass;
+				acceleration += angle.Unit() * (1. + attributes.Get(Attribute::ACCELERATION_MULTIPLIER))
+					* thrust / mass;
 
 				// Only create the afterburner effects if the ship is in the player's system.
 				isUsingAfterburner = !forget;
@@ -5031,7 +5064,8 @@ void Ship::DoMovement(bool &isUsingAfterburner)
 	{
 		acceleration *= slowMultiplier;
 		// Acceleration multiplier needs to modify effective drag, otherwise it changes top speeds.
-		Point dragAcceleration = acceleration - velocity * dragForce * (1. + attributes.Get("acceleration multiplier"));
+		Point dragAcceleration = acceleration
+			- velocity * dragForce * (1. + attributes.Get(Attribute::ACCELERATION_MULTIPLIER));
 		// Make sure dragAcceleration has nonzero length, to avoid divide by zero.
 		if(dragAcceleration)
 		{
@@ -5106,7 +5140,7 @@ void Ship::StepTargeting()
 
 			if(distance < 10. && speed < 1. && ((CanBeCarried() && government == target->government) || !turn))
 			{
-				if(cloak && !attributes.Get("cloaked boarding"))
+				if(cloak && !attributes.Get(Attribute::CLOAKED_BOARDING))
 				{
 					// Allow the player to get all the way to the end of the
 					// boarding sequence (including locking on to the ship) but
@@ -5198,16 +5232,16 @@ double Ship::MinimumHull() const
 		return 0.;
 
 	double maximumHull = MaxHull();
-	double absoluteThreshold = attributes.Get("absolute threshold");
+	double absoluteThreshold = attributes.Get(Attribute::ABSOLUTE_THRESHOLD);
 	if(absoluteThreshold > 0.)
 		return absoluteThreshold;
 
-	double thresholdPercent = attributes.Get("threshold percentage");
+	double thresholdPercent = attributes.Get(Attribute::THRESHOLD_PERCENTAGE);
 	double transition = 1 / (1 + 0.0005 * maximumHull);
 	double minimumHull = maximumHull * (thresholdPercent > 0.
 		? min(thresholdPercent, 1.) : 0.1 * (1. - transition) + 0.5 * transition);
 
-	return max(0., floor(minimumHull + attributes.Get("hull threshold")));
+	return max(0., floor(minimumHull + attributes.Get(Attribute::HULL_THRESHOLD)));
 }
 
 
@@ -5318,13 +5352,13 @@ double Ship::CalculateDeterrence() const
 			// Other damage types don't outright destroy ships, so they aren't considered
 			// as heavily in the strength of a weapon.
 			double energyFactor = weapon->EnergyDamage()
-					+ weapon->RelativeEnergyDamage() * attributes.Get("energy capacity")
+					+ weapon->RelativeEnergyDamage() * attributes.Get(Attribute::ENERGY_CAPACITY)
 					+ weapon->IonDamage() * 100.;
 			double heatFactor = weapon->HeatDamage()
 					+ weapon->RelativeHeatDamage() * MaximumHeat()
 					+ weapon->BurnDamage() * 100.;
 			double fuelFactor = weapon->FuelDamage()
-					+ weapon->RelativeFuelDamage() * attributes.Get("fuel capacity")
+					+ weapon->RelativeFuelDamage() * attributes.Get(Attribute::FUEL_CAPACITY)
 					+ weapon->LeakDamage() * 100.;
 			double scramblingFactor = weapon->ScramblingDamage() * 100.;
 			double slowingFactor = weapon->SlowingDamage() * 100.;
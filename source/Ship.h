@@ -32,6 +32,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "ShipJumpNavigation.h"
 
 #include <array>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
@@ -246,6 +247,9 @@ public:
 	// Updates the AI and navigation caches. If the ship's mass hasn't changed,
 	// reuses some of the previous values.
 	void UpdateCaches(bool massLessChange = false);
+	// The slot the AI keeps its records of this ship in, or -1 if it has none.
+	uint32_t GetAISlot() const;
+	void SetAISlot(uint32_t slot);
 
 	// Set the commands for this ship to follow this timestep.
 	void SetCommands(const Command &command);
@@ -680,6 +684,7 @@ private:
 	Personality personality;
 	const Phrase *hail = nullptr;
 	ShipAICache aiCache;
+	uint32_t aiSlot = static_cast<uint32_t>(-1);
 
 	// Installed outfits, cargo, etc.:
 	Outfit attributes;
@@ -25,7 +25,6 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Hazard.h"
 #include "Minable.h"
 #include "Planet.h"
-#include "Random.h"
 #include "image/SpriteSet.h"
 
 #include <algorithm>
@@ -34,12 +33,6 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
-	// Dynamic economy parameters: how much of its production each system keeps
-	// and exports each day:
-	const double KEEP = .89;
-	const double EXPORT = .10;
-	// Standard deviation of the daily production of each commodity:
-	const double VOLUME = 2000.;
 	// Above this supply amount, price differences taper off:
 	const double LIMIT = 20000.;
 }
@@ -981,20 +974,6 @@ bool System::HasTrade() const
 
 
 
-// Update the economy.
-void System::StepEconomy()
-{
-	for(auto &it : trade)
-	{
-		it.second.exports = EXPORT * it.second.supply;
-		it.second.supply *= KEEP;
-		it.second.supply += Random::Normal() * VOLUME;
-		it.second.Update();
-	}
-}
-
-
-
 void System::SetSupply(const string &commodity, double tons)
 {
 	auto it = trade.find(commodity);
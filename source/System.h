@@ -45,6 +45,9 @@ class Sprite;
 // what prices the trade goods have in that system. It also includes the stellar
 // objects in each system, and the hyperspace links between systems.
 class System {
+	// The economy steps every system's supply of trade goods at once.
+	friend class Economy;
+
 public:
 	static const double DEFAULT_NEIGHBOR_DISTANCE;
 
@@ -169,8 +172,6 @@ public:
 	// Get the price of the given commodity in this system.
 	int Trade(const std::string &commodity) const;
 	bool HasTrade() const;
-	// Update the economy. Returns the amount of trade goods this system exports.
-	void StepEconomy();
 	void SetSupply(const std::string &commodity, double tons);
 	double Supply(const std::string &commodity) const;
 	double Exports(const std::string &commodity) const;
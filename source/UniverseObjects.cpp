@@ -127,6 +127,7 @@ void UniverseObjects::FinishLoading()
 		else
 			Logger::Log("Unhandled \"disable\" keyword of type \"" + category.first + "\".", Logger::Level::WARNING);
 	}
+	missionOffers.Build(missions);
 
 	// Sort all category lists.
 	for(auto &list : categories)
@@ -198,6 +199,9 @@ void UniverseObjects::UpdateSystems()
 			if(object.GetPlanet())
 				planets.Get(object.GetPlanet()->TrueName())->FinishLoading(wormholes);
 	}
+
+	distances.Update(systems);
+	economy.Invalidate();
 }
 
 
@@ -343,7 +347,8 @@ void UniverseObjects::LoadFile(const filesystem::path &path, const PlayerInfo &p
 	if(path.extension() != ".txt")
 		return;
 
-	DataFile data(path);
+	DataFile data;
+	data.LoadCached(path);
 	if(debugMode)
 		Logger::Log("Parsing: " + path.string(), Logger::Level::INFO);
 
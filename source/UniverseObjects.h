@@ -22,6 +22,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "CategoryList.h"
 #include "Color.h"
 #include "Conversation.h"
+#include "DistanceTable.h"
+#include "Economy.h"
 #include "Effect.h"
 #include "Fleet.h"
 #include "FormationPattern.h"
@@ -34,6 +36,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Message.h"
 #include "Minable.h"
 #include "Mission.h"
+#include "MissionOfferIndex.h"
 #include "News.h"
 #include "Outfit.h"
 #include "Person.h"
@@ -136,6 +139,9 @@ private:
 	Set<Shop<Outfit>> outfitSales;
 	Set<Wormhole> wormholes;
 	std::set<double> neighborDistances;
+	DistanceTable distances;
+	Economy economy;
+	MissionOfferIndex missionOffers;
 
 	Gamerules gamerules;
 	TextReplacements substitutions;
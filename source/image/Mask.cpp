@@ -19,9 +19,14 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "../Logger.h"
 
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <limits>
 
+#ifdef __SSE2__
+#include <xmmintrin.h>
+#endif
+
 using namespace std;
 
 namespace {
@@ -276,6 +281,103 @@ namespace {
 			radius = max(radius, p.LengthSquared());
 		return sqrt(radius);
 	}
+
+
+	// The number of edges that are tested at once.
+	constexpr size_t EDGE_BATCH = 4;
+
+
+	// Find the closest point along the segment (from s to s + v) where it enters
+	// one of the given edges, as a fraction of its length. Return 1 if it does
+	// not enter any of them. The edge count must be a multiple of EDGE_BATCH.
+	float IntersectEdges(const float *startX, const float *startY, const float *endX, const float *endY,
+		size_t count, float sX, float sY, float vX, float vY)
+	{
+#ifdef __SSE2__
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 sXs = _mm_set1_ps(sX);
+		const __m128 sYs = _mm_set1_ps(sY);
+		const __m128 vXs = _mm_set1_ps(vX);
+		const __m128 vYs = _mm_set1_ps(vY);
+		__m128 closest = one;
+		for(size_t i = 0; i < count; i += EDGE_BATCH)
+		{
+			const __m128 prevX = _mm_loadu_ps(startX + i);
+			const __m128 prevY = _mm_loadu_ps(startY + i);
+			const __m128 dX = _mm_sub_ps(_mm_loadu_ps(endX + i), prevX);
+			const __m128 dY = _mm_sub_ps(_mm_loadu_ps(endY + i), prevY);
+			const __m128 qX = _mm_sub_ps(prevX, sXs);
+			const __m128 qY = _mm_sub_ps(prevY, sYs);
+			const __m128 cross = _mm_sub_ps(_mm_mul_ps(dX, vYs), _mm_mul_ps(dY, vXs));
+			const __m128 uB = _mm_sub_ps(_mm_mul_ps(vXs, qY), _mm_mul_ps(vYs, qX));
+			const __m128 uA = _mm_sub_ps(_mm_mul_ps(dX, qY), _mm_mul_ps(dY, qX));
+			__m128 hit = _mm_and_ps(_mm_cmpgt_ps(cross, zero), _mm_cmpge_ps(uB, zero));
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmplt_ps(uB, cross), _mm_cmpge_ps(uA, zero)));
+			// The division is done for every edge, but only the edges that are
+			// hit keep their result.
+			const __m128 range = _mm_div_ps(uA, cross);
+			closest = _mm_min_ps(closest, _mm_or_ps(_mm_and_ps(hit, range), _mm_andnot_ps(hit, one)));
+		}
+		closest = _mm_min_ps(closest, _mm_movehl_ps(closest, closest));
+		closest = _mm_min_ss(closest, _mm_shuffle_ps(closest, closest, 1));
+		return _mm_cvtss_f32(closest);
+#else
+		float closest = 1.f;
+		for(size_t i = 0; i < count; ++i)
+		{
+			const float dX = endX[i] - startX[i];
+			const float dY = endY[i] - startY[i];
+			const float qX = startX[i] - sX;
+			const float qY = startY[i] - sY;
+			const float cross = dX * vY - dY * vX;
+			const float uB = vX * qY - vY * qX;
+			const float uA = dX * qY - dY * qX;
+			if((cross > 0.f) & (uB >= 0.f) & (uB < cross) & (uA >= 0.f))
+				closest = min(closest, uA / cross);
+		}
+		return closest;
+#endif
+	}
+
+
+	// Count how many of the given edges a ray pointing straight down from the
+	// given point crosses. Edges are closed at the start and open at the end,
+	// and vertical edges are ignored. The edge count must be a multiple of
+	// EDGE_BATCH.
+	int CountCrossings(const float *startX, const float *startY, const float *endX, const float *endY,
+		size_t count, float x, float y)
+	{
+#ifdef __SSE2__
+		const __m128 xs = _mm_set1_ps(x);
+		const __m128 ys = _mm_set1_ps(y);
+		int crossings = 0;
+		for(size_t i = 0; i < count; i += EDGE_BATCH)
+		{
+			const __m128 prevX = _mm_loadu_ps(startX + i);
+			const __m128 prevY = _mm_loadu_ps(startY + i);
+			const __m128 nextX = _mm_loadu_ps(endX + i);
+			const __m128 nextY = _mm_loadu_ps(endY + i);
+			// The edges whose x range does not contain the point.
+			const __m128 outside = _mm_xor_ps(_mm_cmple_ps(prevX, xs), _mm_cmplt_ps(xs, nextX));
+			const __m128 edgeY = _mm_add_ps(prevY, _mm_div_ps(
+				_mm_mul_ps(_mm_sub_ps(nextY, prevY), _mm_sub_ps(xs, prevX)), _mm_sub_ps(nextX, prevX)));
+			const __m128 crosses = _mm_andnot_ps(outside,
+				_mm_and_ps(_mm_cmpneq_ps(prevX, nextX), _mm_cmpge_ps(edgeY, ys)));
+			crossings += popcount(static_cast<unsigned>(_mm_movemask_ps(crosses)));
+		}
+		return crossings;
+#else
+		int crossings = 0;
+		for(size_t i = 0; i < count; ++i)
+			if(startX[i] != endX[i] && (startX[i] <= x) == (x < endX[i]))
+			{
+				const float edgeY = startY[i] + ((endY[i] - startY[i]) * (x - startX[i])) / (endX[i] - startX[i]);
+				crossings += (edgeY >= y);
+			}
+		return crossings;
+#endif
+	}
 }
 
 
@@ -306,6 +408,7 @@ void Mask::Create(const ImageBuffer &image, int frame, const string &fileName)
 		outlines.back().shrink_to_fit();
 	}
 	outlines.shrink_to_fit();
+	Pack();
 }
 
 
@@ -446,6 +549,7 @@ Mask Mask::operator*(Point scale) const
 		if(radius > newMask.radius)
 			newMask.radius = radius;
 	}
+	newMask.Pack();
 	return newMask;
 }
 
@@ -458,35 +562,78 @@ Mask operator*(Point scale, const Mask &mask)
 
 
 
-double Mask::Intersection(Point sA, Point vA) const
+// Copy the outlines into the packed edge arrays.
+void Mask::Pack()
 {
-	// Keep track of the closest intersection point found.
-	double closest = 1.;
-
-	for(auto &&outline : outlines)
+	startX.clear();
+	startY.clear();
+	endX.clear();
+	endY.clear();
+	edgeRanges.clear();
+	edgeRanges.reserve(outlines.size());
+
+	for(const auto &outline : outlines)
 	{
+		EdgeRange range;
+		range.begin = startX.size();
+		range.minX = numeric_limits<float>::infinity();
+		range.minY = numeric_limits<float>::infinity();
+		range.maxX = -numeric_limits<float>::infinity();
+		range.maxY = -numeric_limits<float>::infinity();
+
 		Point prev = outline.back();
-		for(auto &&next : outline)
+		for(const Point &next : outline)
 		{
-			// Check if there is an intersection. (If not, the cross would be 0.) If
-			// there is, handle it only if it is a point where the segment is
-			// entering the polygon rather than exiting it (i.e. cross > 0).
-			Point vB = next - prev;
-			double cross = vB.Cross(vA);
-			if(cross > 0.)
-			{
-				Point vS = prev - sA;
-				double uB = vA.Cross(vS);
-				double uA = vB.Cross(vS);
-				// If the intersection occurs somewhere within this segment of the
-				// outline, find out how far along the query vector it occurs and
-				// remember it if it is the closest so far.
-				if((uB >= 0.) & (uB < cross) & (uA >= 0.))
-					closest = min(closest, uA / cross);
-			}
-
+			startX.push_back(prev.X());
+			startY.push_back(prev.Y());
+			endX.push_back(next.X());
+			endY.push_back(next.Y());
+			range.minX = min(range.minX, endX.back());
+			range.minY = min(range.minY, endY.back());
+			range.maxX = max(range.maxX, endX.back());
+			range.maxY = max(range.maxY, endY.back());
 			prev = next;
 		}
+		// An empty edge is never crossed or entered.
+		while(startX.size() % EDGE_BATCH)
+		{
+			startX.push_back(0.f);
+			startY.push_back(0.f);
+			endX.push_back(0.f);
+			endY.push_back(0.f);
+		}
+
+		range.end = startX.size();
+		edgeRanges.push_back(range);
+	}
+}
+
+
+
+double Mask::Intersection(Point sA, Point vA) const
+{
+	const float sX = sA.X();
+	const float sY = sA.Y();
+	const float vX = vA.X();
+	const float vY = vA.Y();
+	const float minX = min(sX, sX + vX);
+	const float minY = min(sY, sY + vY);
+	const float maxX = max(sX, sX + vX);
+	const float maxY = max(sY, sY + vY);
+
+	// Keep track of the closest intersection point found.
+	float closest = 1.f;
+	for(const EdgeRange &range : edgeRanges)
+	{
+		// Skip any outline that the segment's bounding box does not overlap.
+		if(range.maxX < minX || range.minX > maxX || range.maxY < minY || range.minY > maxY)
+			continue;
+
+		// Check for intersections only where the segment is entering the
+		// polygon rather than exiting it, and remember the closest one.
+		const size_t begin = range.begin;
+		closest = min(closest, IntersectEdges(&startX[begin], &startY[begin], &endX[begin], &endY[begin],
+			range.end - begin, sX, sY, vX, vY));
 	}
 	return closest;
 }
@@ -507,21 +654,19 @@ bool Mask::Contains(Point point) const
 	// intersects only if its x coordinates span the point's coordinates.
 	// Compute the number of intersections across all outlines, not just one, as the
 	// outlines may be nested (i.e. holes) or discontinuous (multiple separate shapes).
+	const float x = point.X();
+	const float y = point.Y();
 	int intersections = 0;
-	for(auto &&outline : outlines)
+	for(const EdgeRange &range : edgeRanges)
 	{
-		Point prev = outline.back();
-		for(auto &&next : outline)
-		{
-			if(prev.X() != next.X())
-				if((prev.X() <= point.X()) == (point.X() < next.X()))
-				{
-					double y = prev.Y() + (next.Y() - prev.Y()) *
-						(point.X() - prev.X()) / (next.X() - prev.X());
-					intersections += (y >= point.Y());
-				}
-			prev = next;
-		}
+		// A ray from outside an outline's bounding box either misses it or
+		// crosses it an even number of times, so it can be skipped.
+		if(x < range.minX || x > range.maxX || y < range.minY || y > range.maxY)
+			continue;
+
+		const size_t begin = range.begin;
+		intersections += CountCrossings(&startX[begin], &startY[begin], &endX[begin], &endY[begin],
+			range.end - begin, x, y);
 	}
 	// If the number of intersections is odd, the point is within the mask.
 	return (intersections & 1);
@@ -67,6 +67,23 @@ public:
 
 
 private:
+	// The edges of an outline, as a range in the packed edge arrays, and the
+	// box that contains them.
+	class EdgeRange {
+	public:
+		size_t begin;
+		size_t end;
+		float minX;
+		float minY;
+		float maxX;
+		float maxY;
+	};
+
+
+private:
+	// Copy the outlines into the packed edge arrays.
+	void Pack();
+
 	double Intersection(Point sA, Point vA) const;
 	bool Contains(Point point) const;
 
@@ -74,4 +91,14 @@ private:
 private:
 	std::vector<std::vector<Point>> outlines;
 	double radius = 0.;
+
+	// The start and end points of every edge of the outlines, packed into
+	// single precision arrays so that several edges can be tested at once.
+	// Each outline's edges are padded with empty ones to a whole number of
+	// vectors' worth.
+	std::vector<float> startX;
+	std::vector<float> startY;
+	std::vector<float> endX;
+	std::vector<float> endY;
+	std::vector<EdgeRange> edgeRanges;
 };
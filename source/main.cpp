@@ -22,6 +22,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "DataFile.h"
 #include "DataNode.h"
 #include "Engine.h"
+#include "FastForward.h"
 #include "Files.h"
 #include "text/Font.h"
 #include "FrameTimer.h"
@@ -51,11 +52,13 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "windows/WinVersion.h"
 #endif
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <map>
 
 #include <cassert>
+#include <cstdlib>
 #include <future>
 #include <exception>
 #include <string>
@@ -88,6 +91,9 @@ int main(int argc, char *argv[])
 	bool printTests = false;
 	bool printData = false;
 	bool noTestMute = false;
+	bool useDataCache = false;
+	int advanceDays = 0;
+	bool saveAdvanced = false;
 	string testToRunName;
 	// Phase 3.1: Multiplayer mode support
 	bool multiplayerMode = false;
@@ -130,6 +136,13 @@ int main(int argc, char *argv[])
 			printTests = true;
 		else if(arg == "--nomute")
 			noTestMute = true;
+		else if(arg == "--data-cache")
+			useDataCache = true;
+		else if((arg == "--advance-days" || arg == "--advance-and-save") && *++it)
+		{
+			advanceDays = max(0, atoi(*it));
+			saveAdvanced = (arg == "--advance-and-save");
+		}
 		// Phase 3.1: Multiplayer command-line arguments
 		else if(arg == "--multiplayer" || arg == "-m")
 			multiplayerMode = true;
@@ -147,10 +160,12 @@ int main(int argc, char *argv[])
 	}
 	printData = PrintData::IsPrintDataArgument(argv);
 	Files::Init(argv);
+	if(useDataCache)
+		DataFile::SetCacheDirectory(Files::Config() / "cache");
 
 	// Whether we are running an integration test.
 	const bool isTesting = !testToRunName.empty();
-	bool isConsoleOnly = loadOnly || printTests || printData;
+	bool isConsoleOnly = loadOnly || printTests || printData || advanceDays;
 
 	Logger::Session logSession{isConsoleOnly || isTesting};
 
@@ -218,16 +233,35 @@ int main(int argc, char *argv[])
 				Audio::Quit();
 			return hasErrors;
 		}
-		assert(!isConsoleOnly && "Attempting to use UI when only data was loaded!");
-
-		Preferences::Load();
-
-		// Load global conditions:
+		// Load global conditions. This must also be done before advancing a
+		// pilot, since saving it writes them back out.
 		DataFile globalConditions(Files::Config() / "global conditions.txt");
 		for(const DataNode &node : globalConditions)
 			if(node.Token(0) == "conditions")
 				GameData::GlobalConditions().Load(node);
 
+		if(advanceDays)
+		{
+			GameData::FinishLoading();
+			if(!player.LoadRecent())
+			{
+				Logger::Log("There is no saved game to advance.", Logger::Level::ERROR);
+				return 1;
+			}
+
+			FastForward::Run(player, advanceDays).Print(cout);
+			if(saveAdvanced)
+			{
+				// Saving needs to know how many backups of the previous save to keep.
+				Preferences::Load();
+				player.Save();
+			}
+			return hasErrors;
+		}
+		assert(!isConsoleOnly && "Attempting to use UI when only data was loaded!");
+
+		Preferences::Load();
+
 		if(!GameWindow::Init(isTesting && !debugMode))
 			return 1;
 
@@ -546,6 +580,10 @@ void PrintHelp()
 	cerr << "    --tests: print table of available tests, then exit." << endl;
 	cerr << "    --test <name>: run given test from resources directory." << endl;
 	cerr << "    --nomute: don't mute the game while running tests." << endl;
+	cerr << "    --data-cache: keep compiled copies of the game data files, to load them faster next time." << endl;
+	cerr << "    --advance-days <n>: load the most recent saved game, advance it by n days without playing them,"
+		" and print how long each part of the daily work took." << endl;
+	cerr << "    --advance-and-save <n>: the same as --advance-days, but also save the game afterwards." << endl;
 	cerr << "    -m, --multiplayer: start in multiplayer client mode." << endl;
 	cerr << "    --server <address[:port]>: specify server address (default: localhost:31337)." << endl;
 	PrintData::Help();
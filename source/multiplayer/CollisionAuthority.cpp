@@ -3,13 +3,15 @@
 #include "CollisionAuthority.h"
 
 #include "ProjectileSync.h"
+#include "../network/NetworkConstants.h"
 #include "../Projectile.h"
 #include "../Ship.h"
 #include "../Minable.h"
 #include "../GameState.h"
 #include "../Body.h"
+#include "../image/Mask.h"
+#include "../Weapon.h"
 
-#include <cmath>
 #include <algorithm>
 
 using namespace std;
@@ -17,7 +19,7 @@ using namespace std;
 
 
 CollisionAuthority::CollisionAuthority()
-	: projectileSync(nullptr), totalCollisions(0), shipHits(0), asteroidHits(0)
+	: projectileSync(nullptr), totalCollisions(0), shipHits(0), asteroidHits(0), lagCompensation(false)
 {
 }
 
@@ -35,23 +37,16 @@ vector<CollisionAuthority::CollisionResult> CollisionAuthority::DetectCollisions
 {
 	vector<CollisionResult> results;
 
-	// Note: In full implementation, we'd iterate through gameState.projectiles
-	// For now, this is a placeholder showing the structure
-
-	// Placeholder implementation
-	// for(auto &projectile : gameState.GetProjectiles())
-	// {
-	//     if(projectile.IsDead())
-	//         continue;
-	//
-	//     uint32_t networkID = projectileSync ? projectileSync->GetNetworkID(&projectile) : 0;
-	//     if(networkID == 0)
-	//         continue;
-	//
-	//     CollisionResult result = CheckProjectileCollision(projectile, networkID, gameState);
-	//     if(result.type != CollisionResult::Type::NONE)
-	//         results.push_back(result);
-	// }
+	for(const Projectile &projectile : gameState.GetProjectiles())
+	{
+		uint32_t networkID = projectileSync ? projectileSync->GetNetworkID(&projectile) : 0;
+		if(networkID == 0)
+			continue;
+
+		CollisionResult result = CheckProjectileCollision(projectile, networkID, gameState);
+		if(result.type != CollisionResult::Type::NONE)
+			results.push_back(result);
+	}
 
 	return results;
 }
@@ -68,35 +63,39 @@ CollisionAuthority::CollisionResult CollisionAuthority::CheckProjectileCollision
 	// Check if projectile lifetime expired
 	if(projectile.IsDead())
 	{
+		ForgetProjectile(networkID);
 		result.type = CollisionResult::Type::EXPIRED;
 		result.impactPosition = projectile.Position();
 		return result;
 	}
 
-	// Check collision with ships
-	// In full implementation:
-	// for(auto &ship : gameState.GetShips())
-	// {
-	//     if(!ship || ship->IsDestroyed())
-	//         continue;
-	//
-	//     // Skip if same government (friendly fire check)
-	//     if(ship->GetGovernment() == projectile.GetGovernment())
-	//         continue;
-	//
-	//     double intersection;
-	//     if(CheckProjectileShipCollision(projectile, *ship, intersection))
-	//     {
-	//         result.type = CollisionResult::Type::SHIP;
-	//         result.targetUUID = ship->UUID();
-	//         result.impactPosition = projectile.Position();
-	//         result.intersection = intersection;
-	//         result.targetDestroyed = (ship->Hull() <= 0); // After applying damage
-	//         shipHits++;
-	//         totalCollisions++;
-	//         return result;
-	//     }
-	// }
+	// Check collision with ships, rewound to what the shooter saw
+	uint64_t collisionTick = GetCollisionTick(networkID, gameState.GetGameTick());
+	const bool collidesShips = projectile.GetWeapon().CanCollideShips();
+	for(auto &ship : gameState.GetShips())
+	{
+		if(!collidesShips || !ship || ship->IsDestroyed())
+			continue;
+
+		// Skip if same government (friendly fire check)
+		if(ship->GetGovernment() == projectile.GetGovernment())
+			continue;
+
+		double intersection;
+		if(CheckProjectileShipCollision(projectile, *ship, collisionTick, intersection))
+		{
+			result.type = CollisionResult::Type::SHIP;
+			result.targetUUID = ship->UUID();
+			result.impactPosition = projectile.Position();
+			result.intersection = intersection;
+			result.targetDestroyed = (ship->Hull() <= 0); // After applying damage
+			if(projectile.HitsRemaining() <= 1)
+				ForgetProjectile(networkID);
+			shipHits++;
+			totalCollisions++;
+			return result;
+		}
+	}
 
 	// Check collision with asteroids
 	// Similar implementation for minables
@@ -109,19 +108,27 @@ CollisionAuthority::CollisionResult CollisionAuthority::CheckProjectileCollision
 bool CollisionAuthority::CheckProjectileShipCollision(const Projectile &projectile,
 	const Ship &ship, double &intersection)
 {
-	// Simple circle-circle collision (actual implementation would use proper masks)
-	double projectileRadius = 5.0;  // Placeholder
-	double shipRadius = ship.Radius();
+	return Collide(projectile, ship, ship.Position(), ship.Facing(),
+		TriggerRadius(projectile, ship), intersection);
+}
+
+
 
-	double distance;
-	if(CirclesCollide(projectile.Position(), projectileRadius,
-		ship.Position(), shipRadius, distance))
+bool CollisionAuthority::CheckProjectileShipCollision(const Projectile &projectile,
+	const Ship &ship, uint64_t gameTick, double &intersection)
+{
+	const CollisionHistory::Pose *pose = history.GetPose(ship, gameTick);
+	if(!pose)
 	{
-		intersection = CalculateIntersection(projectile.Position(), ship.Position(), shipRadius);
-		return true;
+		// A recorded tick without this ship means it was not there yet.
+		if(history.HasTick(gameTick))
+			return false;
+		return CheckProjectileShipCollision(projectile, ship, intersection);
 	}
 
-	return false;
+	// The ship's outline is taken as it is now, placed where it was then.
+	return Collide(projectile, ship, pose->position, pose->facing,
+		TriggerRadius(projectile, ship), intersection);
 }
 
 
@@ -129,19 +136,12 @@ bool CollisionAuthority::CheckProjectileShipCollision(const Projectile &projecti
 bool CollisionAuthority::CheckProjectileAsteroidCollision(const Projectile &projectile,
 	const shared_ptr<Minable> &asteroid, double &intersection)
 {
-	if(!asteroid)
+	if(!asteroid || !projectile.GetWeapon().CanCollideMinables())
 		return false;
 
-	// Simple collision check
-	double projectileRadius = 5.0;  // Placeholder
-	double asteroidRadius = asteroid->Radius();
-
-	double distance;
-	if(CirclesCollide(projectile.Position(), projectileRadius,
-		asteroid->Position(), asteroidRadius, distance))
+	// Asteroids never set off a weapon's trigger.
+	if(Collide(projectile, *asteroid, asteroid->Position(), asteroid->Facing(), 0., intersection))
 	{
-		intersection = CalculateIntersection(projectile.Position(), asteroid->Position(),
-			asteroidRadius);
 		asteroidHits++;
 		totalCollisions++;
 		return true;
@@ -182,24 +182,108 @@ void CollisionAuthority::ResetStatistics()
 
 
 
-bool CollisionAuthority::CirclesCollide(const Point &pos1, double radius1,
-	const Point &pos2, double radius2, double &distance) const
+void CollisionAuthority::SetLagCompensation(bool enable)
+{
+	lagCompensation = enable;
+}
+
+
+
+bool CollisionAuthority::IsLagCompensated() const
+{
+	return lagCompensation;
+}
+
+
+
+void CollisionAuthority::RecordHistory(const GameState &gameState)
+{
+	history.Record(gameState.GetGameTick(), gameState.GetShips());
+}
+
+
+
+const CollisionHistory &CollisionAuthority::GetHistory() const
+{
+	return history;
+}
+
+
+
+void CollisionAuthority::SetShooterLatency(uint32_t projectileNetworkID, uint32_t roundTripTime)
 {
-	Point delta = pos2 - pos1;
-	distance = sqrt(delta.X() * delta.X() + delta.Y() * delta.Y());
+	rewindTicks[projectileNetworkID] = GetRewindTicks(roundTripTime);
+}
+
 
-	return distance < (radius1 + radius2);
+
+void CollisionAuthority::ForgetProjectile(uint32_t projectileNetworkID)
+{
+	rewindTicks.erase(projectileNetworkID);
 }
 
 
 
-double CollisionAuthority::CalculateIntersection(const Point &projectilePos,
-	const Point &targetPos, double targetRadius) const
+uint32_t CollisionAuthority::GetRewindTicks(uint32_t roundTripTime)
 {
-	Point delta = targetPos - projectilePos;
-	double distance = sqrt(delta.X() * delta.X() + delta.Y() * delta.Y());
+	// The state the shooter saw left the server half a round trip before the
+	// shot, was drawn an interpolation delay late, and the shot takes another
+	// half round trip to arrive.
+	uint32_t delay = min(roundTripTime + NetworkConstants::INTERPOLATION_DELAY_MS,
+		NetworkConstants::MAX_LAG_COMPENSATION_MS);
+	return (delay * NetworkConstants::SIMULATION_TICK_RATE + 500) / 1000;
+}
+
+
+
+uint64_t CollisionAuthority::GetCollisionTick(uint32_t projectileNetworkID, uint64_t gameTick) const
+{
+	if(!lagCompensation)
+		return gameTick;
+
+	auto it = rewindTicks.find(projectileNetworkID);
+	if(it == rewindTicks.end())
+		return gameTick;
+
+	uint64_t tick = gameTick - min<uint64_t>(it->second, gameTick);
+	// Never rewind past the recorded history.
+	if(!history.IsEmpty())
+		tick = max(tick, history.GetOldestTick());
+	return tick;
+}
+
 
-	// Intersection is how far into the target the projectile penetrated
-	// (used for visual effects)
-	return max(0.0, targetRadius - distance);
+
+bool CollisionAuthority::Collide(const Projectile &projectile, const Body &body,
+	const Point &position, const Angle &facing, double triggerRadius, double &intersection)
+{
+	const Mask &mask = body.GetMask();
+	Point offset = projectile.Position() - position;
+
+	// A weapon with a trigger radius goes off as soon as the ship is within it.
+	if(triggerRadius && (offset.Length() <= triggerRadius
+			|| mask.WithinRing(offset, facing, 0., triggerRadius)))
+	{
+		intersection = 0.;
+		return true;
+	}
+
+	// Otherwise, the projectile hits if its path this tick crosses the outline.
+	double range = mask.Collide(offset, projectile.Velocity(), facing);
+	if(range >= 1.)
+		return false;
+
+	intersection = range;
+	return true;
+}
+
+
+
+double CollisionAuthority::TriggerRadius(const Projectile &projectile, const Ship &ship)
+{
+	// As in Engine::FindCollisions(), cloaked ships do not set off a trigger
+	// unless they are the projectile's target.
+	if(ship.IsCloaked() && projectile.Target() != &ship)
+		return 0.;
+	return projectile.GetWeapon().TriggerRadius();
 }
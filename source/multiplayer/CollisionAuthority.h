@@ -5,6 +5,7 @@
 #ifndef COLLISION_AUTHORITY_H_
 #define COLLISION_AUTHORITY_H_
 
+#include "CollisionHistory.h"
 #include "../Point.h"
 #include "../EsUuid.h"
 
@@ -13,6 +14,8 @@
 #include <map>
 #include <cstdint>
 
+class Angle;
+class Body;
 class Projectile;
 class Ship;
 class Minable;
@@ -23,6 +26,11 @@ class ProjectileSync;
 
 // CollisionAuthority handles server-side collision detection for projectiles.
 // Only the server runs collision detection; clients receive impact events.
+//
+// With lag compensation enabled, a projectile fired by a player is checked
+// against ships where that player saw them: the server records each ship's
+// collision state every tick (see CollisionHistory) and rewinds by the
+// shooter's round trip time plus the client interpolation delay.
 class CollisionAuthority {
 public:
 	// Collision result for a single projectile
@@ -37,7 +45,7 @@ public:
 
 		EsUuid targetUUID;                // UUID of target (ship/asteroid)
 		Point impactPosition;             // Where the collision occurred
-		double intersection;              // Intersection distance for visual effects
+		double intersection;              // Fraction of this tick's movement at which it hit (see Projectile::Explode)
 		bool targetDestroyed;             // Did this hit destroy the target?
 
 		CollisionResult() : projectileNetworkID(0), type(Type::NONE),
@@ -57,9 +65,15 @@ public:
 	CollisionResult CheckProjectileCollision(const Projectile &projectile,
 		uint32_t networkID, GameState &gameState);
 
-	// Check if projectile hits a specific ship
+	// Check if projectile hits a specific ship. Like Engine::FindCollisions(),
+	// this tests the projectile's movement this tick against the ship's mask,
+	// and a weapon with a trigger radius goes off when the ship comes within it.
 	bool CheckProjectileShipCollision(const Projectile &projectile, const Ship &ship,
 		double &intersection);
+	// Check if projectile hits a specific ship as it was at the given tick.
+	// Uses the ship's current state if the tick is not in the history.
+	bool CheckProjectileShipCollision(const Projectile &projectile, const Ship &ship,
+		uint64_t gameTick, double &intersection);
 
 	// Check if projectile hits a specific asteroid
 	bool CheckProjectileAsteroidCollision(const Projectile &projectile,
@@ -73,6 +87,25 @@ public:
 	// Reset statistics
 	void ResetStatistics();
 
+	// Lag compensation
+	void SetLagCompensation(bool enable);
+	bool IsLagCompensated() const;
+	// Record every ship's collision state at the game state's current tick.
+	// Call once per simulation tick, after ships have moved.
+	void RecordHistory(const GameState &gameState);
+	const CollisionHistory &GetHistory() const;
+	// Set the round trip time (NetworkConnection::GetRoundTripTime) of the
+	// player who fired a projectile. Projectiles without one are checked
+	// against the current state.
+	void SetShooterLatency(uint32_t projectileNetworkID, uint32_t roundTripTime);
+	// Stop tracking a projectile that has been removed
+	void ForgetProjectile(uint32_t projectileNetworkID);
+	// Get how many ticks a player's view is behind the server, capped at
+	// NetworkConstants::MAX_LAG_COMPENSATION_MS.
+	static uint32_t GetRewindTicks(uint32_t roundTripTime);
+	// Get the tick a projectile's collisions are checked at
+	uint64_t GetCollisionTick(uint32_t projectileNetworkID, uint64_t gameTick) const;
+
 
 private:
 	ProjectileSync *projectileSync;
@@ -82,13 +115,18 @@ private:
 	uint64_t shipHits;
 	uint64_t asteroidHits;
 
-	// Helper: Check if two circles collide (simple collision)
-	bool CirclesCollide(const Point &pos1, double radius1,
-		const Point &pos2, double radius2, double &distance) const;
-
-	// Helper: Calculate intersection point for visual effects
-	double CalculateIntersection(const Point &projectilePos, const Point &targetPos,
-		double targetRadius) const;
+	// Lag compensation
+	bool lagCompensation;
+	CollisionHistory history;
+	// Ticks to rewind, by projectile network ID
+	std::map<uint32_t, uint32_t> rewindTicks;
+
+	// Helper: Check a projectile against a body's mask placed at the given
+	// position and facing, with the given trigger radius (0 for none).
+	static bool Collide(const Projectile &projectile, const Body &body, const Point &position,
+		const Angle &facing, double triggerRadius, double &intersection);
+	// Helper: The trigger radius a weapon has against the given ship
+	static double TriggerRadius(const Projectile &projectile, const Ship &ship);
 };
 
 
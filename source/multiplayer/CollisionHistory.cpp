@@ -0,0 +1,111 @@
+// CollisionHistory.cpp
+
+#include "CollisionHistory.h"
+
+#include "../network/NetworkConstants.h"
+#include "../Ship.h"
+
+#include <algorithm>
+
+using namespace std;
+
+
+
+CollisionHistory::CollisionHistory(size_t capacity)
+	: frames(max<size_t>(capacity, 1))
+{
+}
+
+
+
+size_t CollisionHistory::DefaultCapacity()
+{
+	// Round up, plus one for the current tick.
+	return (NetworkConstants::MAX_LAG_COMPENSATION_MS * NetworkConstants::SIMULATION_TICK_RATE + 999) / 1000 + 1;
+}
+
+
+
+void CollisionHistory::Record(uint64_t gameTick, const list<shared_ptr<Ship>> &ships)
+{
+	Frame &frame = frames[gameTick % frames.size()];
+	frame.gameTick = gameTick;
+	frame.recorded = true;
+	frame.poses.clear();
+	for(const shared_ptr<Ship> &ship : ships)
+		if(ship && !ship->IsDestroyed())
+			frame.poses.push_back(Pose{ship, ship->Position(), ship->Facing(),
+				static_cast<float>(ship->Radius())});
+
+	sort(frame.poses.begin(), frame.poses.end(),
+		[](const Pose &a, const Pose &b) { return a.ship.owner_before(b.ship); });
+
+	latestTick = gameTick;
+	recorded = true;
+}
+
+
+
+const CollisionHistory::Pose *CollisionHistory::GetPose(const Ship &ship, uint64_t gameTick) const
+{
+	const Frame *frame = GetFrame(gameTick);
+	// Only ships owned by a shared_ptr can have been recorded.
+	weak_ptr<const Ship> key = ship.weak_from_this();
+	if(!frame || key.expired())
+		return nullptr;
+
+	auto it = lower_bound(frame->poses.begin(), frame->poses.end(), key,
+		[](const Pose &pose, const weak_ptr<const Ship> &key) { return pose.ship.owner_before(key); });
+	if(it == frame->poses.end() || key.owner_before(it->ship))
+		return nullptr;
+	return &*it;
+}
+
+
+
+bool CollisionHistory::HasTick(uint64_t gameTick) const
+{
+	return GetFrame(gameTick);
+}
+
+
+
+uint64_t CollisionHistory::GetOldestTick() const
+{
+	return latestTick - min<uint64_t>(latestTick, frames.size() - 1);
+}
+
+
+
+size_t CollisionHistory::GetMemoryUsage() const
+{
+	size_t total = frames.size() * sizeof(Frame);
+	for(const Frame &frame : frames)
+		total += frame.poses.capacity() * sizeof(Pose);
+	return total;
+}
+
+
+
+void CollisionHistory::Clear()
+{
+	for(Frame &frame : frames)
+	{
+		frame.recorded = false;
+		frame.poses.clear();
+	}
+	latestTick = 0;
+	recorded = false;
+}
+
+
+
+const CollisionHistory::Frame *CollisionHistory::GetFrame(uint64_t gameTick) const
+{
+	// A slot holds another tick's frame if that tick was skipped, or once the
+	// tick has left the history.
+	if(!recorded || gameTick > latestTick)
+		return nullptr;
+	const Frame &frame = frames[gameTick % frames.size()];
+	return (frame.recorded && frame.gameTick == gameTick) ? &frame : nullptr;
+}
@@ -0,0 +1,86 @@
+// CollisionHistory.h
+// Lag compensation: per-tick history of the ship state collision detection needs
+// Lets the server check a projectile against ships where its shooter saw them
+
+#ifndef COLLISION_HISTORY_H_
+#define COLLISION_HISTORY_H_
+
+#include "../Angle.h"
+#include "../Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+class Ship;
+
+
+
+// CollisionHistory records, every simulation tick, where each ship was, which
+// way it faced and how large it was. It keeps only those few values rather
+// than copies of the game state, in a ring of frames indexed by tick whose
+// buffers are reused, so recording every ship every tick does not allocate
+// once the ring has filled.
+//
+// Ships are identified by weak_ptr rather than by address: a ship destroyed
+// while its poses are still in the history keeps its identity, so a new ship
+// allocated at the same address is never matched with the old one's poses.
+class CollisionHistory {
+public:
+	// A ship's collision state at one tick
+	struct Pose {
+		std::weak_ptr<const Ship> ship;
+		Point position;
+		Angle facing;
+		float radius;
+	};
+
+	// Keep the given number of ticks (at least 1)
+	explicit CollisionHistory(size_t capacity = DefaultCapacity());
+
+	// Ticks needed to rewind by NetworkConstants::MAX_LAG_COMPENSATION_MS
+	static size_t DefaultCapacity();
+
+	// Record the state of the given ships at the given tick, replacing the
+	// oldest frame. Destroyed ships are skipped.
+	void Record(uint64_t gameTick, const std::list<std::shared_ptr<Ship>> &ships);
+
+	// Get a ship's state at the given tick, or nullptr if that tick is no
+	// longer (or was never) recorded, or the ship was not present then.
+	const Pose *GetPose(const Ship &ship, uint64_t gameTick) const;
+	// Whether the given tick is recorded
+	bool HasTick(uint64_t gameTick) const;
+
+	// The range of ticks the history can hold. Only valid if not empty.
+	uint64_t GetOldestTick() const;
+	uint64_t GetLatestTick() const { return latestTick; }
+	bool IsEmpty() const { return !recorded; }
+
+	size_t GetCapacity() const { return frames.size(); }
+	size_t GetMemoryUsage() const;
+
+	void Clear();
+
+
+private:
+	struct Frame {
+		uint64_t gameTick = 0;
+		bool recorded = false;
+		// Sorted by ship ownership (weak_ptr::owner_before), for binary search
+		std::vector<Pose> poses;
+	};
+
+	const Frame *GetFrame(uint64_t gameTick) const;
+
+
+private:
+	std::vector<Frame> frames;
+	uint64_t latestTick = 0;
+	bool recorded = false;
+};
+
+
+
+#endif
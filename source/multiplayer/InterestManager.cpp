@@ -2,26 +2,39 @@
 
 #include "InterestManager.h"
 
+#include "../Body.h"
 #include "../Ship.h"
 #include "../Projectile.h"
 #include "../Visual.h"
 
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 using namespace std;
 
+namespace {
+	// Interest grid cells are large compared to ships, since queries cover
+	// the whole low interest range. The grid wraps around every
+	// GRID_CELL_SIZE * GRID_CELLS units; ships in wrapped cells are skipped.
+	const unsigned GRID_CELL_SIZE = 4096;
+	const unsigned GRID_CELLS = 64;
+
+	// Allow for rounding when accumulating fractional priorities.
+	const double PRIORITY_EPSILON = 1e-9;
+}
+
 
 
 InterestManager::InterestManager()
-	: config()
+	: config(), grid(GRID_CELL_SIZE, GRID_CELLS, CollisionType::SHIP)
 {
 }
 
 
 
 InterestManager::InterestManager(const Config &config)
-	: config(config)
+	: config(config), grid(GRID_CELL_SIZE, GRID_CELLS, CollisionType::SHIP)
 {
 }
 
@@ -43,14 +56,24 @@ const InterestManager::Config &InterestManager::GetConfig() const
 
 void InterestManager::SetPlayerInterestCenter(const EsUuid &playerUUID, const Point &position)
 {
-	playerCenters[playerUUID] = position;
+	Player *player = FindPlayer(playerUUID);
+	if(!player)
+	{
+		auto it = lower_bound(players.begin(), players.end(), playerUUID,
+			[](const Player &player, const EsUuid &uuid) { return player.uuid < uuid; });
+		player = &*players.emplace(it);
+		player->uuid.Clone(playerUUID);
+	}
+	player->center = position;
 }
 
 
 
 void InterestManager::RemovePlayer(const EsUuid &playerUUID)
 {
-	playerCenters.erase(playerUUID);
+	Player *player = FindPlayer(playerUUID);
+	if(player)
+		players.erase(players.begin() + (player - players.data()));
 }
 
 
@@ -105,13 +128,18 @@ vector<const Ship *> InterestManager::GetInterestedShips(const EsUuid &playerUUI
 {
 	vector<const Ship *> interestedShips;
 
+	// Look the player up once, rather than once per ship.
+	const Player *player = FindPlayer(playerUUID);
+	if(!player)
+		return interestedShips;
+
 	for(const auto &ship : allShips)
 	{
 		if(!ship)
 			continue;
 
-		InterestLevel level = GetShipInterest(playerUUID, *ship);
-		if(level != InterestLevel::NONE)
+		if(ship->Position().Distance(player->center) < config.lowRange
+				|| ship->GetOwnerPlayerUUID() == playerUUID)
 			interestedShips.push_back(ship.get());
 	}
 
@@ -137,6 +165,65 @@ vector<const Projectile *> InterestManager::GetInterestedProjectiles(const EsUui
 
 
 
+void InterestManager::Update(const vector<Entity> &allShips)
+{
+	for(Player &player : players)
+	{
+		player.ownShips.clear();
+		player.relevancy.targets.clear();
+	}
+
+	// Bucket every ship into the grid, and hand each player-owned ship to its
+	// owner so it is relevant however far it is from the interest center.
+	grid.Clear(0);
+	byAddress.clear();
+	for(const Entity &entity : allShips)
+	{
+		if(!entity.ship || !entity.id)
+			continue;
+
+		// The grid only reads the bodies it holds.
+		grid.Add(const_cast<Ship &>(*entity.ship));
+		byAddress.push_back(entity);
+		if(players.empty() || !entity.ship->HasOwner())
+			continue;
+
+		const EsUuid &owner = entity.ship->GetOwnerPlayerUUID();
+		auto it = lower_bound(players.begin(), players.end(), owner,
+			[](const Player &player, const EsUuid &uuid) { return player.uuid < uuid; });
+		if(it != players.end() && it->uuid == owner)
+			it->ownShips.push_back(entity);
+	}
+	grid.Finish();
+	sort(byAddress.begin(), byAddress.end(),
+		[](const Entity &a, const Entity &b) { return less<const Ship *>()(a.ship, b.ship); });
+
+	for(Player &player : players)
+	{
+		// Targets only count if they are among this update's ships.
+		vector<Entity> &targets = player.relevancy.targets;
+		for(const Entity &own : player.ownShips)
+		{
+			shared_ptr<Ship> target = own.ship->GetTargetShip();
+			uint16_t id = target ? FindId(target.get()) : 0;
+			if(id && find_if(targets.begin(), targets.end(),
+					[id](const Entity &entity) { return entity.id == id; }) == targets.end())
+				targets.push_back({id, target.get()});
+		}
+		UpdateRelevancy(player);
+	}
+}
+
+
+
+const InterestManager::Relevancy *InterestManager::GetRelevancy(const EsUuid &playerUUID) const
+{
+	const Player *player = FindPlayer(playerUUID);
+	return player ? &player->relevancy : nullptr;
+}
+
+
+
 bool InterestManager::ShouldUpdateThisTick(InterestLevel level, uint64_t currentTick) const
 {
 	switch(level)
@@ -175,25 +262,202 @@ InterestManager::InterestLevel InterestManager::GetInterestLevelByDistance(doubl
 
 size_t InterestManager::GetPlayerCount() const
 {
-	return playerCenters.size();
+	return players.size();
 }
 
 
 
 void InterestManager::Clear()
 {
-	playerCenters.clear();
+	players.clear();
+}
+
+
+
+const InterestManager::Relevant *InterestManager::Relevancy::Find(uint16_t id) const
+{
+	auto it = lower_bound(entities.begin(), entities.end(), id,
+		[](const Relevant &entity, uint16_t id) { return entity.id < id; });
+	return (it != entities.end() && it->id == id) ? &*it : nullptr;
+}
+
+
+
+InterestManager::Player *InterestManager::FindPlayer(const EsUuid &playerUUID)
+{
+	auto it = lower_bound(players.begin(), players.end(), playerUUID,
+		[](const Player &player, const EsUuid &uuid) { return player.uuid < uuid; });
+	return (it != players.end() && it->uuid == playerUUID) ? &*it : nullptr;
+}
+
+
+
+const InterestManager::Player *InterestManager::FindPlayer(const EsUuid &playerUUID) const
+{
+	return const_cast<InterestManager *>(this)->FindPlayer(playerUUID);
+}
+
+
+
+uint16_t InterestManager::FindId(const Ship *ship) const
+{
+	auto it = lower_bound(byAddress.begin(), byAddress.end(), ship,
+		[](const Entity &entity, const Ship *ship) { return less<const Ship *>()(entity.ship, ship); });
+	return (it != byAddress.end() && it->ship == ship) ? it->id : 0;
+}
+
+
+
+void InterestManager::UpdateRelevancy(Player &player)
+{
+	Relevancy &relevancy = player.relevancy;
+	relevancy.entered.clear();
+	relevancy.left.clear();
+	relevancy.due.clear();
+
+	// Gather this update's candidates: the player's own ships, plus every ship
+	// in the grid cells the low range (stretched by the hysteresis margin)
+	// overlaps. A ship may show up in both lists.
+	candidates.clear();
+	grid.Nearby(player.center, config.lowRange * (1. + config.hysteresis), candidates);
+
+	nextEntities.clear();
+	for(const Entity &own : player.ownShips)
+	{
+		Relevant &entity = nextEntities.emplace_back();
+		entity.id = own.id;
+		entity.ship = own.ship;
+		entity.level = InterestLevel::CRITICAL;
+		entity.own = true;
+		entity.distance = own.ship->Position().Distance(player.center);
+	}
+	for(const Body *body : candidates)
+	{
+		// Only ships are added to the grid.
+		const Ship *ship = static_cast<const Ship *>(body);
+		if(find_if(player.ownShips.begin(), player.ownShips.end(),
+				[ship](const Entity &own) { return own.ship == ship; }) != player.ownShips.end())
+			continue;
+
+		Relevant &entity = nextEntities.emplace_back();
+		entity.id = FindId(ship);
+		entity.ship = ship;
+		entity.distance = ship->Position().Distance(player.center);
+	}
+	sort(nextEntities.begin(), nextEntities.end(),
+		[](const Relevant &a, const Relevant &b) { return a.id < b.id; });
+
+	// Merge with the previous set (also sorted by ID), carrying over each
+	// ship's level and priority.
+	auto previous = relevancy.entities.begin();
+	const auto previousEnd = relevancy.entities.end();
+	auto next = nextEntities.begin();
+	const auto nextEnd = nextEntities.end();
+	auto out = nextEntities.begin();
+	while(previous != previousEnd || next != nextEnd)
+	{
+		if(next == nextEnd || (previous != previousEnd && previous->id < next->id))
+		{
+			// No longer anywhere near the player.
+			relevancy.left.push_back(previous->id);
+			++previous;
+			continue;
+		}
+
+		Relevant entity = *next;
+		const bool wasRelevant = (previous != previousEnd && previous->id == next->id);
+		// Own ships are always CRITICAL.
+		if(!entity.own)
+			entity.level = wasRelevant
+				? GetInterestLevelWithHysteresis(previous->level, entity.distance)
+				: GetInterestLevelByDistance(entity.distance);
+
+		if(entity.level == InterestLevel::NONE)
+		{
+			if(wasRelevant)
+				relevancy.left.push_back(entity.id);
+		}
+		else if(wasRelevant)
+		{
+			entity.priority = previous->priority + GetPriorityRate(entity.level);
+			*out++ = entity;
+		}
+		else
+		{
+			// Newly relevant ships are sent right away.
+			entity.priority = 1.;
+			relevancy.entered.push_back(entity.id);
+			*out++ = entity;
+		}
+
+		if(wasRelevant)
+			++previous;
+		++next;
+	}
+	nextEntities.erase(out, nextEnd);
+	relevancy.entities.swap(nextEntities);
+
+	// Pick the ships that are due, most overdue first, up to the limit.
+	dueIndices.clear();
+	for(size_t i = 0; i < relevancy.entities.size(); ++i)
+		if(relevancy.entities[i].priority >= 1. - PRIORITY_EPSILON)
+			dueIndices.push_back(i);
+	const vector<Relevant> &entities = relevancy.entities;
+	stable_sort(dueIndices.begin(), dueIndices.end(),
+		[&entities](size_t a, size_t b) { return entities[a].priority > entities[b].priority; });
+	if(config.maxUpdatesPerTick && dueIndices.size() > config.maxUpdatesPerTick)
+		dueIndices.resize(config.maxUpdatesPerTick);
+
+	for(size_t i : dueIndices)
+	{
+		relevancy.due.push_back(relevancy.entities[i].id);
+		relevancy.entities[i].priority = 0.;
+	}
+}
+
+
+
+InterestManager::InterestLevel InterestManager::GetInterestLevelWithHysteresis(InterestLevel previous,
+	double distance) const
+{
+	// Moving closer raises the level immediately.
+	InterestLevel level = GetInterestLevelByDistance(distance);
+	if(level >= previous)
+		return level;
+
+	// Moving away only lowers it once the entity is clearly past the boundary,
+	// i.e. past the ranges stretched by the hysteresis margin.
+	InterestLevel stretched = GetInterestLevelByDistance(distance / (1. + config.hysteresis));
+	return min(previous, stretched);
+}
+
+
+
+double InterestManager::GetPriorityRate(InterestLevel level) const
+{
+	switch(level)
+	{
+		case InterestLevel::CRITICAL:
+			return 1. / max(config.criticalFrequency, 1);
+		case InterestLevel::HIGH:
+			return 1. / max(config.highFrequency, 1);
+		case InterestLevel::MEDIUM:
+			return 1. / max(config.mediumFrequency, 1);
+		case InterestLevel::LOW:
+			return 1. / max(config.lowFrequency, 1);
+		case InterestLevel::NONE:
+		default:
+			return 0.;
+	}
 }
 
 
 
 double InterestManager::GetDistanceToPlayer(const EsUuid &playerUUID, const Point &position) const
 {
-	auto it = playerCenters.find(playerUUID);
-	if(it == playerCenters.end())
+	const Player *player = FindPlayer(playerUUID);
+	if(!player)
 		return numeric_limits<double>::max(); // Player not found, infinite distance
 
-	const Point &playerCenter = it->second;
-	Point delta = position - playerCenter;
-	return sqrt(delta.X() * delta.X() + delta.Y() * delta.Y());
+	return position.Distance(player->center);
 }
@@ -5,11 +5,11 @@
 #ifndef INTEREST_MANAGER_H_
 #define INTEREST_MANAGER_H_
 
+#include "../CollisionSet.h"
 #include "../Point.h"
 #include "../EsUuid.h"
 
-#include <map>
-#include <set>
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -21,6 +21,19 @@ class Visual;
 
 // InterestManager optimizes network bandwidth by only synchronizing entities
 // that are within a client's area of interest (typically based on view distance).
+//
+// Update() puts every ship into a uniform grid (a CollisionSet) once, then
+// finds each player's candidates from the grid cells around their interest
+// center, so the cost grows with the number of nearby ships rather than with
+// players times ships. It keeps a relevancy set for each player that changes
+// incrementally from one update to the next:
+// - Ships entering or leaving the set are reported as events.
+// - A ship only drops to a lower interest level once it is a margin past the
+//   range boundary (hysteresis), so ships near a boundary don't flicker.
+// - Each ship accumulates priority every update at a rate set by its level,
+//   and is due to be sent when that reaches 1. If the number of updates per
+//   player is capped, the ships waiting longest go first, so LOW ships are
+//   delayed but never starved.
 class InterestManager {
 public:
 	// Interest level determines update priority
@@ -45,6 +58,45 @@ public:
 		int highFrequency = 1;      // Every tick
 		int mediumFrequency = 2;    // Every 2nd tick
 		int lowFrequency = 5;       // Every 5th tick
+
+		// Fraction of a range an entity must be past its boundary before it
+		// drops to the lower interest level
+		double hysteresis = 0.1;
+		// Most ships due to be sent to one player per Update() (0 = no limit)
+		size_t maxUpdatesPerTick = 0;
+	};
+
+	// A live ship and the network ID it is known by (see EntityTracker)
+	struct Entity {
+		uint16_t id = 0;
+		const Ship *ship = nullptr;
+	};
+
+	// A ship in a player's relevancy set
+	struct Relevant {
+		uint16_t id = 0;
+		// The ship as passed to the last Update(); only valid until the caller
+		// lets go of it.
+		const Ship *ship = nullptr;
+		InterestLevel level = InterestLevel::NONE;
+		bool own = false;            // Owned by the player
+		double priority = 0.;        // Accumulated update priority (due at 1)
+		double distance = 0.;        // From the player's interest center
+	};
+
+	// The ships relevant to one player, as of the last Update(). Ships are
+	// identified by network ID, which stays meaningful after the ship itself is
+	// gone (IDs in "left" may belong to destroyed ships).
+	struct Relevancy {
+		std::vector<Relevant> entities;        // Sorted by network ID
+		std::vector<uint16_t> entered;         // Became relevant in the last update
+		std::vector<uint16_t> left;            // Stopped being relevant in the last update
+		std::vector<uint16_t> due;             // To be sent this update, most urgent first
+		// Ships the player's own ships are targeting, relevant or not
+		std::vector<Entity> targets;
+
+		// Find a ship in "entities" by network ID, or return nullptr.
+		const Relevant *Find(uint16_t id) const;
 	};
 
 	InterestManager();
@@ -71,6 +123,14 @@ public:
 	std::vector<const Projectile *> GetInterestedProjectiles(const EsUuid &playerUUID,
 		const std::vector<Projectile> &allProjectiles) const;
 
+	// Rebuild the spatial grid from the given ships and advance every player's
+	// relevancy set by one update. Each ship must have a distinct, non-zero
+	// network ID.
+	void Update(const std::vector<Entity> &allShips);
+	// Get a player's relevancy set, or nullptr if the player is not tracked.
+	// The pointer is invalidated when players are added or removed.
+	const Relevancy *GetRelevancy(const EsUuid &playerUUID) const;
+
 	// Check if an entity should be updated this tick based on interest level and frequency
 	bool ShouldUpdateThisTick(InterestLevel level, uint64_t currentTick) const;
 
@@ -84,11 +144,50 @@ public:
 	void Clear();
 
 
+private:
+	// A tracked player. Copying an EsUuid leaves it blank, so players are only
+	// ever moved, and the UUID is set with Clone().
+	struct Player {
+		EsUuid uuid;
+		Point center;            // Interest center (usually their ship's position)
+		Relevancy relevancy;
+		// Ships owned by this player, found during the current Update()
+		std::vector<Entity> ownShips;
+	};
+
+
 private:
 	Config config;
 
-	// Map of player UUID to their current interest center (usually ship position)
-	std::map<EsUuid, Point> playerCenters;
+	// Tracked players, sorted by UUID
+	std::vector<Player> players;
+
+	// Spatial grid of all ships, rebuilt by each Update()
+	CollisionSet grid;
+
+	// The ships passed to the current Update(), sorted by address so that a
+	// ship found in the grid can be mapped back to its network ID
+	std::vector<Entity> byAddress;
+
+	// Scratch space reused between updates
+	std::vector<Body *> candidates;
+	std::vector<Relevant> nextEntities;
+	std::vector<size_t> dueIndices;
+
+	// Find a player by UUID, or return nullptr
+	Player *FindPlayer(const EsUuid &playerUUID);
+	const Player *FindPlayer(const EsUuid &playerUUID) const;
+
+	// Look up the network ID of a ship passed to the current Update(), or
+	// return 0.
+	uint16_t FindId(const Ship *ship) const;
+	// Advance one player's relevancy set (grid must be up to date)
+	void UpdateRelevancy(Player &player);
+	// Interest level of an entity at the given distance that was previously
+	// at the given level, with hysteresis applied
+	InterestLevel GetInterestLevelWithHysteresis(InterestLevel previous, double distance) const;
+	// Priority gained per update at the given interest level
+	double GetPriorityRate(InterestLevel level) const;
 
 	// Calculate distance from player's interest center to a point
 	double GetDistanceToPlayer(const EsUuid &playerUUID, const Point &position) const;
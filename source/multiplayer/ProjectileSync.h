@@ -47,7 +47,7 @@ public:
 		uint32_t projectileID;         // Which projectile hit
 		EsUuid targetUUID;             // What it hit (ship/asteroid UUID)
 		Point impactPosition;          // Where the impact occurred
-		double intersection;           // Intersection distance (for visual effects)
+		double intersection;           // Fraction of the tick's movement at which it hit
 		uint64_t impactTick;           // Game tick when impact occurred
 
 		ProjectileImpact() : projectileID(0), intersection(0.0), impactTick(0) {}
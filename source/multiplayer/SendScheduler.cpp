@@ -0,0 +1,176 @@
+// SendScheduler.cpp
+
+#include "SendScheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace {
+	// Each pressure level reduces the scope of one more category by one step,
+	// starting with distant ships; own ships are never reduced.
+	const int MAX_PRESSURE = 4;
+
+	int GetCategoryRank(SendScheduler::Category category)
+	{
+		switch(category)
+		{
+			case SendScheduler::Category::DISTANT:
+				return 0;
+			case SendScheduler::Category::NEARBY:
+				return 1;
+			case SendScheduler::Category::TARGET:
+				return 2;
+			case SendScheduler::Category::OWN:
+			default:
+				return MAX_PRESSURE;
+		}
+	}
+}
+
+
+
+SendScheduler::SendScheduler(const BandwidthBudget &budget)
+	: budget(budget)
+{
+}
+
+
+
+BandwidthBudget &SendScheduler::GetBudget()
+{
+	return budget;
+}
+
+
+
+const BandwidthBudget &SendScheduler::GetBudget() const
+{
+	return budget;
+}
+
+
+
+const vector<SendScheduler::Scheduled> &SendScheduler::Schedule(const vector<Candidate> &candidates)
+{
+	scheduled.clear();
+	scheduledBytes = 0;
+	degradedCount = 0;
+	deferredCount = 0;
+
+	budget.Refill();
+	const double available = budget.IsUnlimited() ? numeric_limits<double>::infinity() : budget.GetAvailable();
+
+	// Find the lowest pressure level at which everything fits.
+	int pressure = 0;
+	for( ; pressure < MAX_PRESSURE; ++pressure)
+	{
+		size_t demand = 0;
+		for(const Candidate &candidate : candidates)
+			demand += StateSync::GetUpdateSize(GetDegradedScope(candidate, pressure));
+		if(demand <= available)
+			break;
+	}
+
+	// Send order: by category, then longest waiting first, then as given.
+	order.resize(candidates.size());
+	for(size_t i = 0; i < order.size(); ++i)
+		order[i] = i;
+	auto waited = [this](uint16_t id) -> uint32_t
+	{
+		auto it = waiting.find(id);
+		return it == waiting.end() ? 0 : it->second;
+	};
+	stable_sort(order.begin(), order.end(), [&candidates, &waited](size_t a, size_t b)
+		{
+			if(candidates[a].category != candidates[b].category)
+				return candidates[a].category < candidates[b].category;
+			return waited(candidates[a].id) > waited(candidates[b].id);
+		});
+
+	// Fill the budget in that order. A smaller update further down the list
+	// may still fit after a larger one did not.
+	nextWaiting.clear();
+	double remaining = available;
+	for(size_t i : order)
+	{
+		const Candidate &candidate = candidates[i];
+		StateSync::UpdateScope scope = GetDegradedScope(candidate, pressure);
+		size_t size = StateSync::GetUpdateSize(scope);
+		if(candidate.category != Category::OWN && size > remaining)
+		{
+			nextWaiting[candidate.id] = waited(candidate.id) + 1;
+			++deferredCount;
+			continue;
+		}
+
+		scheduled.push_back({candidate.id, candidate.ship, scope});
+		remaining -= size;
+		scheduledBytes += size;
+		degradedCount += (scope != candidate.scope);
+	}
+	waiting.swap(nextWaiting);
+
+	budget.Consume(scheduledBytes);
+	return scheduled;
+}
+
+
+
+bool SendScheduler::IsWaiting(uint16_t id) const
+{
+	return waiting.count(id);
+}
+
+
+
+size_t SendScheduler::GetWaitingCount() const
+{
+	return waiting.size();
+}
+
+
+
+void SendScheduler::Forget(const vector<uint16_t> &ids)
+{
+	for(uint16_t id : ids)
+		waiting.erase(id);
+}
+
+
+
+size_t SendScheduler::GetScheduledBytes() const
+{
+	return scheduledBytes;
+}
+
+
+
+size_t SendScheduler::GetDegradedCount() const
+{
+	return degradedCount;
+}
+
+
+
+size_t SendScheduler::GetDeferredCount() const
+{
+	return deferredCount;
+}
+
+
+
+StateSync::UpdateScope SendScheduler::GetDegradedScope(const Candidate &candidate, int pressure)
+{
+	int steps = min(pressure - GetCategoryRank(candidate.category), 2);
+	StateSync::UpdateScope scope = candidate.scope;
+	for(int i = 0; i < steps; ++i)
+	{
+		if(scope == StateSync::UpdateScope::FULL)
+			scope = StateSync::UpdateScope::POSITION;
+		else
+			scope = StateSync::UpdateScope::MINIMAL;
+	}
+	return scope;
+}
@@ -0,0 +1,102 @@
+// SendScheduler.h
+// Bandwidth-limited scheduling of ship state updates for one connection
+
+#ifndef SEND_SCHEDULER_H_
+#define SEND_SCHEDULER_H_
+
+#include "StateSync.h"
+#include "../network/BandwidthBudget.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Ship;
+
+
+
+// SendScheduler decides which ship updates go into each outgoing world state
+// packet for one connection, so that slow connections get the updates that
+// matter most instead of a growing backlog.
+//
+// Each update, candidates are taken in order of category: the player's own
+// ships, then ships they are targeting, then nearby ships, then distant ones.
+// Within a category, ships left over from earlier updates go first. If the
+// candidates do not all fit in the budget at their preferred scope, scopes are
+// reduced (FULL -> POSITION -> MINIMAL), distant ships first, until they do or
+// nothing more can be reduced. Whatever still does not fit is carried over to
+// the next update. Own ships are always sent in full, even if that overdraws
+// the budget.
+class SendScheduler {
+public:
+	// Send order, most important first
+	enum class Category {
+		OWN,       // The player's own ships
+		TARGET,    // Ships the player's ships are targeting
+		NEARBY,    // CRITICAL or HIGH interest
+		DISTANT    // MEDIUM or LOW interest
+	};
+
+	// A ship that could be sent this update. Ships are identified by network
+	// ID; the pointer is only passed through to the result.
+	struct Candidate {
+		uint16_t id = 0;
+		const Ship *ship = nullptr;
+		Category category = Category::DISTANT;
+		StateSync::UpdateScope scope = StateSync::UpdateScope::FULL;  // Preferred scope
+	};
+
+	// A ship to send this update, and how much of it to send
+	struct Scheduled {
+		uint16_t id = 0;
+		const Ship *ship = nullptr;
+		StateSync::UpdateScope scope = StateSync::UpdateScope::FULL;
+	};
+
+	explicit SendScheduler(const BandwidthBudget &budget = BandwidthBudget());
+
+	// The connection's byte budget (set its rate and network conditions here)
+	BandwidthBudget &GetBudget();
+	const BandwidthBudget &GetBudget() const;
+
+	// Refill the budget for one update and choose which candidates to send.
+	// The cost of the chosen updates is taken from the budget.
+	const std::vector<Scheduled> &Schedule(const std::vector<Candidate> &candidates);
+
+	// Check whether a ship was left over from an earlier update (callers should
+	// offer it again even if it would not otherwise be due).
+	bool IsWaiting(uint16_t id) const;
+	size_t GetWaitingCount() const;
+	// Stop carrying over ships that are no longer relevant, so that their
+	// network IDs can be reused by other ships.
+	void Forget(const std::vector<uint16_t> &ids);
+
+	// Statistics for the last Schedule()
+	size_t GetScheduledBytes() const;
+	size_t GetDegradedCount() const;
+	size_t GetDeferredCount() const;
+
+
+private:
+	BandwidthBudget budget;
+
+	// Ships carried over from earlier updates, with how many updates they
+	// have been waiting
+	std::unordered_map<uint16_t, uint32_t> waiting;
+	std::unordered_map<uint16_t, uint32_t> nextWaiting;
+
+	// Results and scratch space reused between updates
+	std::vector<Scheduled> scheduled;
+	std::vector<size_t> order;
+
+	size_t scheduledBytes = 0;
+	size_t degradedCount = 0;
+	size_t deferredCount = 0;
+
+	// The scope to send a candidate at, at the given pressure level
+	static StateSync::UpdateScope GetDegradedScope(const Candidate &candidate, int pressure);
+};
+
+
+
+#endif
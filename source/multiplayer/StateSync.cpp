@@ -2,11 +2,14 @@
 
 #include "StateSync.h"
 
+#include "SendScheduler.h"
 #include "../Ship.h"
 #include "../GameState.h"
+#include "../Outfit.h"
 #include "../network/PacketWriter.h"
 
 #include <algorithm>
+#include <array>
 
 using namespace std;
 
@@ -47,7 +50,8 @@ uint64_t StateSync::GetCurrentTick() const
 StateSync::ShipUpdate StateSync::CaptureShipState(const Ship &ship, UpdateScope scope)
 {
 	ShipUpdate update;
-	update.shipUUID = ship.UUID();
+	// EsUuid copies are blank by design, so the value must be cloned.
+	update.shipUUID.Clone(ship.UUID());
 	update.timestamp = currentTick;
 	update.scope = scope;
 
@@ -117,20 +121,81 @@ vector<StateSync::ShipUpdate> StateSync::GetUpdatesForPlayer(const EsUuid &playe
 
 
 
+vector<StateSync::ShipUpdate> StateSync::GetUpdatesForPlayer(const EsUuid &playerUUID, SendScheduler &scheduler)
+{
+	const InterestManager::Relevancy *relevancy = interestManager ? interestManager->GetRelevancy(playerUUID) : nullptr;
+	if(!relevancy)
+		return {};
+
+	// Ships that stopped being relevant are no longer carried over; their IDs
+	// may go to other ships.
+	scheduler.Forget(relevancy->left);
+
+	vector<uint16_t> due = relevancy->due;
+	sort(due.begin(), due.end());
+	auto isTarget = [relevancy](uint16_t id) -> bool
+	{
+		return find_if(relevancy->targets.begin(), relevancy->targets.end(),
+			[id](const InterestManager::Entity &target) { return target.id == id; }) != relevancy->targets.end();
+	};
+
+	vector<SendScheduler::Candidate> candidates;
+	for(const InterestManager::Relevant &entity : relevancy->entities)
+	{
+		const bool target = isTarget(entity.id);
+		if(!entity.own && !target && !binary_search(due.begin(), due.end(), entity.id)
+				&& !scheduler.IsWaiting(entity.id))
+			continue;
+
+		SendScheduler::Candidate &candidate = candidates.emplace_back();
+		candidate.id = entity.id;
+		candidate.ship = entity.ship;
+		if(entity.own)
+			candidate.category = SendScheduler::Category::OWN;
+		else if(target)
+			candidate.category = SendScheduler::Category::TARGET;
+		else if(entity.level == InterestManager::InterestLevel::CRITICAL
+				|| entity.level == InterestManager::InterestLevel::HIGH)
+			candidate.category = SendScheduler::Category::NEARBY;
+		else
+			candidate.category = SendScheduler::Category::DISTANT;
+
+		// Targets are shown in detail however far away they are.
+		candidate.scope = (target && !entity.own) ? UpdateScope::FULL
+			: DetermineUpdateScope(InterestToPriority(entity.level));
+	}
+	for(const InterestManager::Entity &target : relevancy->targets)
+		if(!relevancy->Find(target.id))
+			candidates.push_back({target.id, target.ship, SendScheduler::Category::TARGET, UpdateScope::FULL});
+
+	vector<ShipUpdate> updates;
+	for(const SendScheduler::Scheduled &scheduled : scheduler.Schedule(candidates))
+		updates.push_back(CaptureShipState(*scheduled.ship, scheduled.scope));
+
+	return updates;
+}
+
+
+
 void StateSync::ApplyShipUpdate(Ship &ship, const ShipUpdate &update)
 {
 	// Apply position data (always present)
 	ship.SetPosition(update.position);
-	ship.SetVelocity(update.velocity);
-	ship.SetFacing(update.angle);
+	// Minimal updates carry nothing else
+	if(update.scope != UpdateScope::MINIMAL)
+	{
+		ship.SetVelocity(update.velocity);
+		ship.SetFacing(update.angle);
+	}
 
-	// Apply vital data if present
+	// Apply vital data if present. Updates carry fractions of the maximum,
+	// but the ship stores absolute levels.
 	if(update.scope == UpdateScope::FULL || update.scope == UpdateScope::VITAL)
 	{
-		ship.SetShields(update.shields);
-		ship.SetHull(update.hull);
-		ship.SetEnergy(update.energy);
-		ship.SetFuel(update.fuel);
+		ship.SetShields(update.shields * ship.MaxShields());
+		ship.SetHull(update.hull * ship.MaxHull());
+		ship.SetEnergy(update.energy * ship.Attributes().Get("energy capacity"));
+		ship.SetFuel(update.fuel * ship.Attributes().Get("fuel capacity"));
 	}
 
 	// Apply flags if present (full update only)
@@ -150,9 +215,16 @@ void StateSync::ApplyShipUpdate(Ship &ship, const ShipUpdate &update)
 
 void StateSync::UpdateDeadReckoning(const EsUuid &shipUUID, const DeadReckoning::State &state)
 {
-	auto &dr = shipDeadReckoning[shipUUID];
-	dr.SetAuthoritativeState(state);
-	dr.SetCurrentTimestamp(currentTick);
+	auto it = shipDeadReckoning.find(shipUUID);
+	if(it == shipDeadReckoning.end())
+	{
+		// EsUuid copies are blank by design, so the key must be cloned.
+		EsUuid key;
+		key.Clone(shipUUID);
+		it = shipDeadReckoning.emplace(std::move(key), DeadReckoning()).first;
+	}
+	it->second.SetAuthoritativeState(state);
+	it->second.SetCurrentTimestamp(currentTick);
 }
 
 
@@ -182,10 +254,13 @@ void StateSync::WriteShipUpdate(PacketWriter &writer, const ShipUpdate &update)
 	// Write scope
 	writer.WriteUint8(static_cast<uint8_t>(update.scope));
 
-	// Always write position data
+	// Always write position data, and motion data unless minimal
 	writer.WritePoint(update.position);
-	writer.WritePoint(update.velocity);
-	writer.WriteAngle(update.angle);
+	if(update.scope != UpdateScope::MINIMAL)
+	{
+		writer.WritePoint(update.velocity);
+		writer.WriteAngle(update.angle);
+	}
 
 	// Write vital data if scope includes it
 	if(update.scope == UpdateScope::FULL || update.scope == UpdateScope::VITAL)
@@ -205,6 +280,29 @@ void StateSync::WriteShipUpdate(PacketWriter &writer, const ShipUpdate &update)
 
 
 
+size_t StateSync::GetUpdateSize(UpdateScope scope)
+{
+	// Measure each scope once by serializing a dummy update.
+	static const array<size_t, 4> sizes = []()
+	{
+		array<size_t, 4> result;
+		StateSync sync;
+		for(size_t i = 0; i < result.size(); ++i)
+		{
+			PacketWriter writer(NetworkPacket::PacketType::SERVER_SHIP_UPDATE);
+			size_t headerSize = writer.GetSize();
+			ShipUpdate update;
+			update.scope = static_cast<UpdateScope>(i);
+			sync.WriteShipUpdate(writer, update);
+			result[i] = writer.GetSize() - headerSize;
+		}
+		return result;
+	}();
+	return sizes[static_cast<size_t>(scope)];
+}
+
+
+
 StateSync::UpdatePriority StateSync::GetUpdatePriority(const EsUuid &playerUUID, const Ship &ship)
 {
 	if(!interestManager)
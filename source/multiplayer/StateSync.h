@@ -19,6 +19,7 @@
 class Ship;
 class GameState;
 class PacketWriter;
+class SendScheduler;
 
 
 
@@ -77,6 +78,15 @@ public:
 	// Get all ships that need to be updated for a specific player this tick
 	std::vector<ShipUpdate> GetUpdatesForPlayer(const EsUuid &playerUUID,
 		const std::vector<std::shared_ptr<Ship>> &allShips);
+	// Like the above, but driven by the player's relevancy set from the last
+	// InterestManager::Update() rather than by checking every ship. Own ships
+	// and their targets are offered every update, other ships when they are
+	// due or were left over from an earlier update. Only the updates that fit
+	// in the player's connection budget are returned: own ships first, then
+	// their targets, then nearby and distant ships, with scopes reduced under
+	// pressure (see SendScheduler). Ships must not be destroyed between the
+	// interest update and this call.
+	std::vector<ShipUpdate> GetUpdatesForPlayer(const EsUuid &playerUUID, SendScheduler &scheduler);
 
 	// Apply a ship update to local state (client-side)
 	void ApplyShipUpdate(Ship &ship, const ShipUpdate &update);
@@ -89,6 +99,8 @@ public:
 
 	// Serialize ship update to packet
 	void WriteShipUpdate(PacketWriter &writer, const ShipUpdate &update);
+	// Number of bytes WriteShipUpdate() writes for an update of the given scope
+	static size_t GetUpdateSize(UpdateScope scope);
 
 	// Deserialize ship update from packet (would use PacketReader, simplified here)
 	// ShipUpdate ReadShipUpdate(PacketReader &reader);
@@ -0,0 +1,101 @@
+/* BandwidthBudget.cpp
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BandwidthBudget.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+	// How many ticks' worth of bytes the budget can hold.
+	const double BURST_TICKS = 2.;
+	// The lowest the rate is scaled for connection quality.
+	const double MIN_QUALITY = .25;
+}
+
+
+BandwidthBudget::BandwidthBudget(uint32_t bytesPerSecond, uint32_t ticksPerSecond)
+	: bytesPerSecond(bytesPerSecond), ticksPerSecond(max<uint32_t>(ticksPerSecond, 1))
+{
+	available = GetCapacity();
+}
+
+
+void BandwidthBudget::SetBytesPerSecond(uint32_t value)
+{
+	bytesPerSecond = value;
+	available = min(available, GetCapacity());
+}
+
+
+void BandwidthBudget::SetTicksPerSecond(uint32_t value)
+{
+	ticksPerSecond = max<uint32_t>(value, 1);
+	available = min(available, GetCapacity());
+}
+
+
+void BandwidthBudget::SetNetworkConditions(uint32_t roundTripTime, float packetLossPercent)
+{
+	// Scale linearly from full rate at "good" loss to half rate at "poor" loss.
+	double lossScale = 1.;
+	if(packetLossPercent > NetworkConstants::PACKET_LOSS_GOOD)
+	{
+		double range = NetworkConstants::PACKET_LOSS_POOR - NetworkConstants::PACKET_LOSS_GOOD;
+		double excess = min<double>(packetLossPercent - NetworkConstants::PACKET_LOSS_GOOD, range);
+		lossScale = 1. - .5 * excess / range;
+	}
+
+	double latencyScale = 1.;
+	if(roundTripTime > NetworkConstants::LATENCY_POOR)
+		latencyScale = static_cast<double>(NetworkConstants::LATENCY_POOR) / roundTripTime;
+
+	quality = max(MIN_QUALITY, lossScale * latencyScale);
+}
+
+
+double BandwidthBudget::GetEffectiveBytesPerSecond() const
+{
+	return bytesPerSecond * quality;
+}
+
+
+void BandwidthBudget::Refill()
+{
+	if(IsUnlimited())
+		return;
+
+	available = min(available + GetEffectiveBytesPerSecond() / ticksPerSecond, GetCapacity());
+}
+
+
+bool BandwidthBudget::CanSend(size_t bytes) const
+{
+	return IsUnlimited() || bytes <= available || available >= GetCapacity();
+}
+
+
+void BandwidthBudget::Consume(size_t bytes)
+{
+	if(!IsUnlimited())
+		available -= bytes;
+}
+
+
+double BandwidthBudget::GetCapacity() const
+{
+	return BURST_TICKS * GetEffectiveBytesPerSecond() / ticksPerSecond;
+}
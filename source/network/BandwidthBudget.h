@@ -0,0 +1,74 @@
+/* BandwidthBudget.h
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "NetworkConstants.h"
+
+#include <cstddef>
+#include <cstdint>
+
+
+// Token bucket limiting how many bytes are sent to one connection
+//
+// The budget is refilled once per broadcast with bytesPerSecond / ticksPerSecond
+// bytes, and holds at most a few broadcasts' worth, so an idle connection
+// cannot save up for a burst. The rate is scaled down when the connection is
+// struggling:
+// - Packet loss above PACKET_LOSS_GOOD usually means the link is congested;
+//   at PACKET_LOSS_POOR and above the rate is halved.
+// - A round trip time above LATENCY_POOR usually means packets are waiting
+//   in a queue somewhere; the rate is scaled by LATENCY_POOR / RTT.
+//
+// A packet is only sent if the budget covers it, except that a full budget
+// can always send one packet (going into debt), so packets larger than the
+// bucket are delayed rather than never sent.
+//
+// A budget of 0 bytes per second is unlimited.
+class BandwidthBudget {
+public:
+	explicit BandwidthBudget(uint32_t bytesPerSecond = NetworkConstants::RECOMMENDED_DOWNLOAD,
+		uint32_t ticksPerSecond = NetworkConstants::SERVER_UPDATE_RATE);
+
+	void SetBytesPerSecond(uint32_t value);
+	uint32_t GetBytesPerSecond() const { return bytesPerSecond; }
+	void SetTicksPerSecond(uint32_t value);
+
+	// Update the measured connection quality.
+	void SetNetworkConditions(uint32_t roundTripTime, float packetLossPercent);
+	// The rate after scaling for connection quality (bytes per second).
+	double GetEffectiveBytesPerSecond() const;
+
+	// Add one tick's worth of bytes.
+	void Refill();
+	// Check whether a packet of the given size may be sent now.
+	bool CanSend(size_t bytes) const;
+	// Record that bytes were sent.
+	void Consume(size_t bytes);
+
+	bool IsUnlimited() const { return !bytesPerSecond; }
+	// Bytes that may be sent now (negative while paying off a large packet).
+	double GetAvailable() const { return available; }
+	// The most the budget can hold.
+	double GetCapacity() const;
+
+
+private:
+	uint32_t bytesPerSecond;
+	uint32_t ticksPerSecond;
+	// Scale factor for connection quality (0.25 - 1)
+	double quality = 1.;
+	double available = 0.;
+};
@@ -0,0 +1,145 @@
+/* BitReader.cpp
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BitReader.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace {
+	uint64_t LoadBigEndian(const uint8_t *in, int bytes)
+	{
+		uint64_t value = 0;
+		for(int i = 0; i < bytes; ++i)
+			value = (value << 8) | in[i];
+		return value;
+	}
+}
+
+
+
+BitReader::BitReader(const uint8_t *data, size_t size)
+	: data(data), bitCount(size * 8)
+{
+}
+
+
+
+BitReader BitReader::FromPacket(const uint8_t *data, size_t size)
+{
+	using namespace NetworkPacket;
+
+	if(size < PACKET_HEADER_SIZE)
+	{
+		BitReader reader(data, 0);
+		reader.error = true;
+		return reader;
+	}
+
+	BitReader reader(data + PACKET_HEADER_SIZE, size - PACKET_HEADER_SIZE);
+	reader.packetType = static_cast<PacketType>(data[6]);
+	if(LoadBigEndian(data, 4) != PACKET_MAGIC || LoadBigEndian(data + 7, 4) != size - PACKET_HEADER_SIZE)
+		reader.error = true;
+	return reader;
+}
+
+
+
+uint64_t BitReader::ReadVarUint()
+{
+	uint64_t value = 0;
+	for(int shift = 0; shift < 64; shift += 7)
+	{
+		uint32_t byte = ReadBits(8);
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if(!(byte & 0x80))
+			return value;
+	}
+	// More than ten bytes cannot be a valid 64-bit value.
+	error = true;
+	return 0;
+}
+
+
+
+int64_t BitReader::ReadVarInt()
+{
+	uint64_t value = ReadVarUint();
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+
+
+float BitReader::ReadFloat()
+{
+	uint32_t bits = ReadBits(32);
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+
+
+void BitReader::AlignToByte()
+{
+	size_t aligned = (bitPosition + 7) / 8 * 8;
+	if(aligned > bitCount)
+		error = true;
+	else
+		bitPosition = aligned;
+}
+
+
+
+const uint8_t *BitReader::ReadBytes(size_t size)
+{
+	AlignToByte();
+	if(error || bitPosition + size * 8 > bitCount)
+	{
+		error = true;
+		return nullptr;
+	}
+
+	const uint8_t *result = data + bitPosition / 8;
+	bitPosition += size * 8;
+	return result;
+}
+
+
+
+uint32_t BitReader::ReadTailBits(int bits)
+{
+	if(error || bits <= 0)
+		return 0;
+	if(bitPosition + bits > bitCount)
+	{
+		error = true;
+		return 0;
+	}
+
+	// Gather the bytes that hold the requested bits (at most 5 of them),
+	// least significant first, to match BitWriter.
+	size_t byte = bitPosition / 8;
+	int shift = bitPosition % 8;
+	size_t end = (bitPosition + bits + 7) / 8;
+	uint64_t word = 0;
+	for(size_t i = byte; i < end; ++i)
+		word |= static_cast<uint64_t>(data[i]) << (8 * (i - byte));
+
+	bitPosition += bits;
+	word >>= shift;
+	return static_cast<uint32_t>(bits < 32 ? word & ((1ull << bits) - 1) : word);
+}
@@ -0,0 +1,91 @@
+/* BitReader.h
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Packet.h"
+
+#include <cstddef>
+#include <cstdint>
+
+
+// Bit-packed deserializer, the counterpart of BitWriter
+//
+// The reader decodes straight out of the memory it is given (for example the
+// data of a received ENet packet) without copying it, so the data must stay
+// alive while the reader is in use. Reading past the end sets the error flag
+// and returns zeros, like PacketReader.
+class BitReader {
+public:
+	// Read a raw bit stream.
+	BitReader(const uint8_t *data, size_t size);
+
+	// Read the payload of a complete packet written by BitWriter in packet
+	// mode (or by PacketWriter). The header is validated the same way
+	// PacketReader does; an invalid packet results in a reader in the error
+	// state.
+	static BitReader FromPacket(const uint8_t *data, size_t size);
+
+	inline uint32_t ReadBits(int bits);
+	bool ReadBool() { return ReadBits(1); }
+	uint64_t ReadVarUint();
+	int64_t ReadVarInt();
+	float ReadFloat();
+
+	// Skip to the next byte boundary.
+	void AlignToByte();
+	// Get a pointer to the next "size" bytes (after aligning) and skip them.
+	// Returns nullptr if there are not enough bytes left.
+	const uint8_t *ReadBytes(size_t size);
+
+	NetworkPacket::PacketType GetPacketType() const { return packetType; }
+	size_t GetBitsRead() const { return bitPosition; }
+	size_t GetBitsRemaining() const { return error ? 0 : bitCount - bitPosition; }
+	bool HasError() const { return error; }
+
+
+private:
+	// Read bits near the end of the data, one byte at a time.
+	uint32_t ReadTailBits(int bits);
+
+
+private:
+	const uint8_t *data;
+	size_t bitCount;
+	size_t bitPosition = 0;
+	NetworkPacket::PacketType packetType = NetworkPacket::PacketType();
+	bool error = false;
+};
+
+
+
+// ReadBits is on the hot path of every packet, so it is defined inline.
+uint32_t BitReader::ReadBits(int bits)
+{
+	size_t byte = bitPosition / 8;
+	// Away from the end, the bits (at most 32 + 7 of them) can be taken from
+	// one 8-byte little-endian load.
+	if(byte + 8 > bitCount / 8 || error || bits <= 0)
+		return ReadTailBits(bits);
+
+	const uint8_t *in = data + byte;
+	uint64_t word = static_cast<uint64_t>(in[0]) | static_cast<uint64_t>(in[1]) << 8
+		| static_cast<uint64_t>(in[2]) << 16 | static_cast<uint64_t>(in[3]) << 24
+		| static_cast<uint64_t>(in[4]) << 32 | static_cast<uint64_t>(in[5]) << 40
+		| static_cast<uint64_t>(in[6]) << 48 | static_cast<uint64_t>(in[7]) << 56;
+	word >>= bitPosition % 8;
+	bitPosition += bits;
+	return static_cast<uint32_t>(bits < 32 ? word & ((1ull << bits) - 1) : word);
+}
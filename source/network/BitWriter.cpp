@@ -0,0 +1,164 @@
+/* BitWriter.cpp
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BitWriter.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace {
+	void StoreBigEndian(uint8_t *out, uint64_t value, int bytes)
+	{
+		for(int i = bytes - 1; i >= 0; --i)
+		{
+			out[i] = static_cast<uint8_t>(value);
+			value >>= 8;
+		}
+	}
+}
+
+
+
+BitWriter::BitWriter(uint8_t *buffer, size_t capacity)
+	: buffer(buffer), capacity(capacity), headerSize(0), bitCapacity(capacity * 8), packetType()
+{
+}
+
+
+
+BitWriter::BitWriter(uint8_t *buffer, size_t capacity, NetworkPacket::PacketType type)
+	: buffer(buffer), capacity(capacity), headerSize(NetworkPacket::PACKET_HEADER_SIZE),
+	bitCapacity(capacity > headerSize ? (capacity - headerSize) * 8 : 0), packetType(type)
+{
+	Reset();
+}
+
+
+
+void BitWriter::WriteVarUint(uint64_t value)
+{
+	while(value >= 0x80)
+	{
+		WriteBits(static_cast<uint32_t>(value & 0x7F) | 0x80, 8);
+		value >>= 7;
+	}
+	WriteBits(static_cast<uint32_t>(value), 8);
+}
+
+
+
+void BitWriter::WriteVarInt(int64_t value)
+{
+	WriteVarUint(ZigZag(value));
+}
+
+
+
+void BitWriter::WriteFloat(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	WriteBits(bits, 32);
+}
+
+
+
+void BitWriter::AlignToByte()
+{
+	int padding = (8 - scratchBits % 8) % 8;
+	if(padding)
+		WriteBits(0, padding);
+}
+
+
+
+void BitWriter::WriteBytes(const void *data, size_t size)
+{
+	AlignToByte();
+	if(overflow)
+		return;
+	if(bitsWritten + size * 8 > bitCapacity)
+	{
+		overflow = true;
+		return;
+	}
+
+	FlushBytes();
+	memcpy(buffer + bytePosition, data, size);
+	bytePosition += size;
+	bitsWritten += size * 8;
+}
+
+
+
+size_t BitWriter::Finish()
+{
+	// Store the partial word without consuming it, so that more bits can
+	// still be added to it.
+	uint64_t pending = scratch;
+	for(size_t i = bytePosition; i < headerSize + (bitsWritten + 7) / 8; ++i)
+	{
+		buffer[i] = static_cast<uint8_t>(pending);
+		pending >>= 8;
+	}
+
+	size_t size = GetBytesWritten();
+	if(headerSize && !overflow)
+	{
+		// Same layout PacketWriter produces (network byte order).
+		StoreBigEndian(buffer, NetworkPacket::PACKET_MAGIC, 4);
+		StoreBigEndian(buffer + 4, NetworkPacket::PROTOCOL_VERSION, 2);
+		buffer[6] = static_cast<uint8_t>(packetType);
+		StoreBigEndian(buffer + 7, size - headerSize, 4);
+	}
+	return size;
+}
+
+
+
+void BitWriter::Reset()
+{
+	scratch = 0;
+	scratchBits = 0;
+	bytePosition = headerSize;
+	bitsWritten = 0;
+	overflow = capacity < headerSize;
+}
+
+
+
+int BitWriter::VarUintBits(uint64_t value)
+{
+	int bits = 8;
+	while(value >= 0x80)
+	{
+		bits += 8;
+		value >>= 7;
+	}
+	return bits;
+}
+
+
+
+void BitWriter::FlushBytes()
+{
+	while(scratchBits >= 8)
+	{
+		buffer[bytePosition++] = static_cast<uint8_t>(scratch);
+		scratch >>= 8;
+		scratchBits -= 8;
+	}
+}
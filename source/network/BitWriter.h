@@ -0,0 +1,142 @@
+/* BitWriter.h
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Packet.h"
+
+#include <cstddef>
+#include <cstdint>
+
+
+// Bit-packing serializer that writes into a caller-supplied buffer
+//
+// Unlike PacketWriter, a BitWriter never allocates: the caller owns the
+// buffer (typically reused between packets) and the writer only tracks a
+// position in it. Values take only as many bits as they need:
+// - WriteBits:    the low N bits of a value (1-32)
+// - WriteBool:    a single bit
+// - WriteVarUint: 7 bits per byte with a continuation bit (small = short)
+// - WriteVarInt:  zigzag-mapped, so small negative values are short too
+//
+// Bits are packed least significant first into little-endian 32-bit words,
+// which BitReader reads back on any host. Byte-oriented data (WriteBytes) is
+// aligned to the next byte boundary first.
+//
+// If the buffer is too small, the writer stops writing and HasOverflowed()
+// returns true; nothing is ever written past the end of the buffer.
+//
+// In packet mode, the writer leaves room for a PacketHeader at the start of
+// the buffer and fills it in when Finish() is called, producing a packet that
+// PacketReader and BitReader::FromPacket() both accept.
+class BitWriter {
+public:
+	// Write a raw bit stream into the buffer.
+	BitWriter(uint8_t *buffer, size_t capacity);
+	// Write a complete packet (header + bit-packed payload) into the buffer.
+	BitWriter(uint8_t *buffer, size_t capacity, NetworkPacket::PacketType type);
+
+	inline void WriteBits(uint32_t value, int bits);
+	void WriteBool(bool value) { WriteBits(value, 1); }
+	void WriteVarUint(uint64_t value);
+	void WriteVarInt(int64_t value);
+	void WriteFloat(float value);
+
+	// Pad with zero bits up to the next byte boundary.
+	void AlignToByte();
+	// Append raw bytes, starting at the next byte boundary.
+	void WriteBytes(const void *data, size_t size);
+
+	// Write any buffered bits out to the buffer, and (in packet mode) fill in
+	// the packet header. Returns the number of bytes used. Writing may continue
+	// afterwards; call Finish() again when done.
+	size_t Finish();
+
+	// Start over, keeping the same buffer and mode.
+	void Reset();
+
+	size_t GetBitsWritten() const { return bitsWritten; }
+	// Bytes used so far, including the header in packet mode.
+	size_t GetBytesWritten() const { return headerSize + (bitsWritten + 7) / 8; }
+	bool HasOverflowed() const { return overflow; }
+
+	// Encoded sizes, for budgeting before writing.
+	static int VarUintBits(uint64_t value);
+	static int VarIntBits(int64_t value) { return VarUintBits(ZigZag(value)); }
+	static uint64_t ZigZag(int64_t value)
+	{
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+
+private:
+	// Store the next complete 32-bit word of scratch.
+	inline void FlushWord();
+	// Write out the buffered bits that make up whole bytes.
+	void FlushBytes();
+
+
+private:
+	uint8_t *buffer;
+	size_t capacity;
+	size_t headerSize;
+	// Payload capacity in bits.
+	size_t bitCapacity;
+	NetworkPacket::PacketType packetType;
+
+	// Bits not yet stored in the buffer, and their count.
+	uint64_t scratch = 0;
+	int scratchBits = 0;
+	// Next byte of the buffer that scratch will be flushed to.
+	size_t bytePosition = 0;
+	size_t bitsWritten = 0;
+	bool overflow = false;
+};
+
+
+
+// WriteBits is on the hot path of every packet, so it is defined inline.
+void BitWriter::WriteBits(uint32_t value, int bits)
+{
+	if(bitsWritten + bits > bitCapacity || bits <= 0)
+	{
+		overflow |= bits > 0;
+		return;
+	}
+
+	if(bits < 32)
+		value &= (1u << bits) - 1;
+	scratch |= static_cast<uint64_t>(value) << scratchBits;
+	scratchBits += bits;
+	bitsWritten += bits;
+
+	if(scratchBits >= 32)
+		FlushWord();
+}
+
+
+
+void BitWriter::FlushWord()
+{
+	// Little-endian regardless of the host, to match BitReader.
+	uint8_t *out = buffer + bytePosition;
+	out[0] = static_cast<uint8_t>(scratch);
+	out[1] = static_cast<uint8_t>(scratch >> 8);
+	out[2] = static_cast<uint8_t>(scratch >> 16);
+	out[3] = static_cast<uint8_t>(scratch >> 24);
+	bytePosition += 4;
+	scratch >>= 32;
+	scratchBits -= 32;
+}
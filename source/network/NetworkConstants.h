@@ -162,6 +162,10 @@ namespace NetworkConstants {
 	// Maximum extrapolation time (milliseconds)
 	constexpr uint32_t MAX_EXTRAPOLATION_MS = 200;  // Don't predict beyond 200ms
 
+	// Longest the server rewinds targets to match what a shooter saw
+	// (round trip time plus interpolation delay, milliseconds)
+	constexpr uint32_t MAX_LAG_COMPENSATION_MS = 400;
+
 	// Reconciliation threshold (position error in pixels before correction)
 	constexpr double RECONCILIATION_THRESHOLD = 10.0;  // 10 pixels
 
@@ -30,6 +30,8 @@ NetworkServer::NetworkServer()
 NetworkServer::~NetworkServer()
 {
 	Stop();
+	// Packets may have been queued after the server stopped.
+	SendQueuedPackets(true);
 }
 
 
@@ -66,6 +68,8 @@ void NetworkServer::Stop()
 
 	cout << "[NetworkServer] Stopping server..." << endl;
 
+	SendQueuedPackets(true);
+
 	// Disconnect all clients
 	for(auto &connection : connections)
 	{
@@ -82,15 +86,24 @@ void NetworkServer::Stop()
 
 
 void NetworkServer::Update()
+{
+	Service(0);
+}
+
+
+void NetworkServer::Service(uint32_t timeoutMs)
 {
 	if(!IsRunning())
 		return;
 
+	SendQueuedPackets();
+
 	ENetEvent event;
 
-	// Process all pending events
-	while(enet_host_service(host, &event, 0) > 0)
+	// Process all pending events, waiting for the first one only
+	while(enet_host_service(host, &event, timeoutMs) > 0)
 	{
+		timeoutMs = 0;
 		switch(event.type)
 		{
 			case ENET_EVENT_TYPE_CONNECT:
@@ -125,6 +138,36 @@ bool NetworkServer::SendToClient(NetworkConnection &connection, const void *data
 }
 
 
+size_t NetworkServer::SendToClients(const vector<uint32_t> &connectionIds, const void *data, size_t size,
+	NetworkConstants::Channel channel, bool reliable)
+{
+	if(!IsRunning() || connectionIds.empty() || size > NetworkConstants::MAX_PACKET_SIZE)
+		return 0;
+
+	ENetPacket *packet = enet_packet_create(data, size, reliable ? ENET_PACKET_FLAG_RELIABLE : 0);
+	if(!packet)
+		return 0;
+	return SendPacket(packet, connectionIds, channel);
+}
+
+
+void NetworkServer::QueueToClients(vector<uint32_t> connectionIds, const void *data, size_t size,
+	NetworkConstants::Channel channel, bool reliable)
+{
+	if(connectionIds.empty() || size > NetworkConstants::MAX_PACKET_SIZE)
+		return;
+
+	// Creating the packet copies the data, so the caller's buffer can be
+	// reused as soon as this returns.
+	ENetPacket *packet = enet_packet_create(data, size, reliable ? ENET_PACKET_FLAG_RELIABLE : 0);
+	if(!packet)
+		return;
+
+	lock_guard<mutex> lock(queueMutex);
+	queuedPackets.push_back({packet, std::move(connectionIds), channel});
+}
+
+
 void NetworkServer::BroadcastToAll(const void *data, size_t size,
 	NetworkConstants::Channel channel, bool reliable)
 {
@@ -250,3 +293,51 @@ NetworkConnection *NetworkServer::FindConnection(ENetPeer *peer)
 
 	return static_cast<NetworkConnection *>(peer->data);
 }
+
+
+NetworkConnection *NetworkServer::FindConnection(uint32_t connectionId)
+{
+	for(const auto &connection : connections)
+		if(connection && connection->GetConnectionId() == connectionId)
+			return connection.get();
+	return nullptr;
+}
+
+
+size_t NetworkServer::SendPacket(ENetPacket *packet, const vector<uint32_t> &connectionIds,
+	NetworkConstants::Channel channel)
+{
+	// ENet reference counts the packet, so each peer only holds a reference.
+	size_t sent = 0;
+	for(uint32_t id : connectionIds)
+	{
+		NetworkConnection *connection = FindConnection(id);
+		if(connection && connection->IsConnected() && connection->GetPeer()
+				&& !enet_peer_send(connection->GetPeer(), static_cast<uint8_t>(channel), packet))
+			++sent;
+	}
+
+	if(!packet->referenceCount)
+		enet_packet_destroy(packet);
+	return sent;
+}
+
+
+void NetworkServer::SendQueuedPackets(bool discard)
+{
+	{
+		lock_guard<mutex> lock(queueMutex);
+		if(queuedPackets.empty())
+			return;
+		queuedPackets.swap(sendingPackets);
+	}
+
+	for(QueuedPacket &queued : sendingPackets)
+	{
+		if(discard)
+			enet_packet_destroy(queued.packet);
+		else
+			SendPacket(queued.packet, queued.connectionIds, queued.channel);
+	}
+	sendingPackets.clear();
+}
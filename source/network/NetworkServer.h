@@ -20,11 +20,16 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <functional>
 
 
 // Server-side network manager. Handles accepting client connections,
 // receiving client packets, and broadcasting state updates.
+//
+// ENet is not thread-safe, so everything except QueueToClients() must be
+// called from one thread. When a dedicated network thread calls Service(),
+// other threads hand it their outgoing packets through QueueToClients().
 class NetworkServer : public NetworkManager {
 public:
 	// Callback types
@@ -43,6 +48,9 @@ public:
 
 	// Process network events (call once per frame)
 	void Update() override;
+	// Send any queued packets, then process network events, waiting up to the
+	// given time for the first one (for a dedicated network thread).
+	void Service(uint32_t timeoutMs);
 
 	// Shutdown (alias for Stop)
 	void Shutdown() override { Stop(); }
@@ -58,6 +66,16 @@ public:
 	bool SendToClient(NetworkConnection &connection, const void *data, size_t size,
 		NetworkConstants::Channel channel = NetworkConstants::Channel::RELIABLE_ORDERED, bool reliable = true);
 
+	// Send the same packet to several clients, by connection ID. The data is
+	// copied into a single ENet packet that all of them share. Returns the
+	// number of clients it was queued for.
+	size_t SendToClients(const std::vector<uint32_t> &connectionIds, const void *data, size_t size,
+		NetworkConstants::Channel channel = NetworkConstants::Channel::RELIABLE_ORDERED, bool reliable = true);
+	// Like SendToClients(), but may be called from any thread. The packet is
+	// sent the next time Update() or Service() runs.
+	void QueueToClients(std::vector<uint32_t> connectionIds, const void *data, size_t size,
+		NetworkConstants::Channel channel = NetworkConstants::Channel::RELIABLE_ORDERED, bool reliable = true);
+
 	// Send packet to all connected clients
 	void BroadcastToAll(const void *data, size_t size,
 		NetworkConstants::Channel channel = NetworkConstants::Channel::RELIABLE_ORDERED, bool reliable = true);
@@ -81,8 +99,24 @@ private:
 	void HandleDisconnectEvent(ENetEvent &event);
 	void HandleReceiveEvent(ENetEvent &event);
 
-	// Find connection by peer
+	// Find connection by peer or by ID
 	NetworkConnection *FindConnection(ENetPeer *peer);
+	NetworkConnection *FindConnection(uint32_t connectionId);
+
+	// Send a packet to the given clients and release this reference to it.
+	size_t SendPacket(ENetPacket *packet, const std::vector<uint32_t> &connectionIds,
+		NetworkConstants::Channel channel);
+	// Send (or, when stopping, discard) the packets from QueueToClients().
+	void SendQueuedPackets(bool discard = false);
+
+
+private:
+	// A packet handed over by QueueToClients().
+	struct QueuedPacket {
+		ENetPacket *packet;
+		std::vector<uint32_t> connectionIds;
+		NetworkConstants::Channel channel;
+	};
 
 	// Connected clients
 	std::vector<std::unique_ptr<NetworkConnection>> connections;
@@ -90,6 +124,12 @@ private:
 	// Server port
 	uint16_t port;
 
+	// Packets queued by other threads, and a second list to swap them into
+	// so that the lock is not held while sending.
+	std::mutex queueMutex;
+	std::vector<QueuedPacket> queuedPackets;
+	std::vector<QueuedPacket> sendingPackets;
+
 	// Event callbacks
 	OnClientConnectedCallback onClientConnected;
 	OnClientDisconnectedCallback onClientDisconnected;
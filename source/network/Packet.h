@@ -43,10 +43,11 @@ enum class PacketType : uint8_t {
 	CLIENT_COMMAND = 10,          // Ship commands (60Hz)
 	CLIENT_CHAT = 11,
 	CLIENT_READY = 12,
+	CLIENT_SNAPSHOT_ACK = 13,     // Last world state received (delta baseline)
 
 	// Server → Client packets (20-29)
 	SERVER_WELCOME = 20,          // Initial connection data
-	SERVER_WORLD_STATE = 21,      // Full state snapshot (20Hz)
+	SERVER_WORLD_STATE = 21,      // World state snapshot, delta-encoded per client (20Hz)
 	SERVER_SHIP_UPDATE = 22,      // Individual ship update
 	SERVER_PROJECTILE_SPAWN = 23,
 	SERVER_SHIP_DESTROYED = 24,
@@ -15,11 +15,14 @@
 
 #include "PacketReader.h"
 
+#include "PacketStructs.h"
+
 #include "Angle.h"
 #include "Command.h"
 #include "EsUuid.h"
 #include "Point.h"
 
+#include <cstdio>
 #include <cstring>
 
 using namespace std;
@@ -215,8 +218,17 @@ Angle PacketReader::ReadAngle()
 
 EsUuid PacketReader::ReadUuid()
 {
-	// Read string representation and convert to EsUuid
-	string uuidStr = ReadString();
+	// Read the raw 16 bytes and convert them to the string form EsUuid parses.
+	uint8_t bytes[16];
+	ReadBytes(bytes, sizeof(bytes));
+	if(error)
+		return EsUuid();
+
+	char uuidStr[37];
+	snprintf(uuidStr, sizeof(uuidStr),
+		"%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+		bytes[0], bytes[1], bytes[2], bytes[3], bytes[4], bytes[5], bytes[6], bytes[7],
+		bytes[8], bytes[9], bytes[10], bytes[11], bytes[12], bytes[13], bytes[14], bytes[15]);
 	return EsUuid::FromString(uuidStr);
 }
 
@@ -236,6 +248,49 @@ Command PacketReader::ReadCommand()
 }
 
 
+Point PacketReader::ReadQuantizedPosition()
+{
+	if(!CanRead(6))
+	{
+		error = true;
+		return Point();
+	}
+
+	double values[2];
+	for(double &value : values)
+	{
+		// Sign-extend the 24-bit big-endian value.
+		uint32_t fixed = (static_cast<uint32_t>(data[position]) << 16)
+			| (static_cast<uint32_t>(data[position + 1]) << 8) | data[position + 2];
+		if(fixed & 0x800000)
+			fixed |= 0xFF000000;
+		position += 3;
+		value = NetworkPacket::Quantization::FixedToPosition(static_cast<int32_t>(fixed));
+	}
+	return Point(values[0], values[1]);
+}
+
+
+Point PacketReader::ReadQuantizedVelocity()
+{
+	double x = NetworkPacket::Quantization::FixedToVelocity(ReadInt16());
+	double y = NetworkPacket::Quantization::FixedToVelocity(ReadInt16());
+	return Point(x, y);
+}
+
+
+Angle PacketReader::ReadQuantizedAngle()
+{
+	return Angle(NetworkPacket::Quantization::FixedToDegrees(ReadUint16()));
+}
+
+
+float PacketReader::ReadQuantizedUnit()
+{
+	return NetworkPacket::Quantization::FixedToUnit(ReadUint8());
+}
+
+
 void PacketReader::ReadBytes(void *dest, size_t size)
 {
 	if(!CanRead(size))
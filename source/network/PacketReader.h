@@ -64,9 +64,15 @@ public:
 	// Read game types
 	Point ReadPoint();        // 16 bytes (2 doubles)
 	Angle ReadAngle();        // 8 bytes (double, converted to Angle)
-	EsUuid ReadUuid();        // Variable (string representation)
+	EsUuid ReadUuid();        // 16 bytes (raw)
 	Command ReadCommand();    // 16 bytes (uint64_t + double)
 
+	// Read quantized game types (see NetworkPacket::Quantization)
+	Point ReadQuantizedPosition();  // 6 bytes (2 x 24-bit)
+	Point ReadQuantizedVelocity();  // 4 bytes (2 x 16-bit)
+	Angle ReadQuantizedAngle();     // 2 bytes
+	float ReadQuantizedUnit();      // 1 byte (0-1 range)
+
 	// Read raw bytes (for custom data)
 	void ReadBytes(void *data, size_t size);
 
@@ -15,6 +15,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <string>
 
@@ -49,6 +51,25 @@ struct ShipStatePacket {
 	// - modelName (string, length-prefixed)
 };
 
+// Quantized ship update - one ship's entry in a quantized SERVER_WORLD_STATE
+// delta (see DeltaEncoder). Ships are referred to by their 16-bit network ID,
+// which is announced together with the ship's UUID when the ship first
+// appears. Only the fields present in the mask are sent.
+// Typical moving ship (position, velocity, facing): 15 bytes
+// All fields: 21 bytes
+struct QuantizedShipStatePacket {
+	uint16_t networkId;          // 2 bytes - Per-session ship ID
+	uint8_t fieldMask;           // 1 byte - Fields present (DeltaEncoder::ShipField)
+	uint8_t position[6];         // 6 bytes - 2 x 24-bit fixed point (Quantization::POSITION_SCALE)
+	int16_t velocity[2];         // 4 bytes - 2 x 16-bit fixed point (Quantization::VELOCITY_SCALE)
+	uint16_t facing;             // 2 bytes - Angle in 1/65536 turns (lossless)
+	uint8_t shields;             // 1 byte - 0-1 normalized, in 1/255 steps
+	uint8_t hull;                // 1 byte
+	uint8_t energy;              // 1 byte
+	uint8_t fuel;                // 1 byte
+	uint16_t flags;              // 2 bytes - Status flags
+};
+
 // Ship command packet - player input commands
 // Sent from client to server at 60Hz
 // Total payload: 25 bytes
@@ -182,6 +203,46 @@ namespace ShipFlags {
 	constexpr uint16_t OVERHEATED     = 0x0800;
 }
 
+// Fixed-point conversions used by the quantized wire format
+namespace Quantization {
+	// Positions are relative to the system center, in 1/8 unit steps, stored
+	// as 24-bit signed values (range about +/- 1 million units).
+	constexpr double POSITION_SCALE = 8.;
+	constexpr int32_t POSITION_LIMIT = (1 << 23) - 1;
+	// Velocities are in 1/32 unit per frame steps, stored as 16-bit signed
+	// values (range +/- 1024 units per frame).
+	constexpr double VELOCITY_SCALE = 32.;
+	// Angles are stored in the same 1/65536 turn steps the Angle class uses.
+	constexpr double ANGLE_SCALE = 65536. / 360.;
+
+	inline int32_t PositionToFixed(double value)
+	{
+		return static_cast<int32_t>(std::clamp<double>(std::round(value * POSITION_SCALE),
+			-POSITION_LIMIT, POSITION_LIMIT));
+	}
+	inline double FixedToPosition(int32_t value) { return value / POSITION_SCALE; }
+
+	inline int16_t VelocityToFixed(double value)
+	{
+		return static_cast<int16_t>(std::clamp<double>(std::round(value * VELOCITY_SCALE),
+			INT16_MIN, INT16_MAX));
+	}
+	inline double FixedToVelocity(int16_t value) { return value / VELOCITY_SCALE; }
+
+	inline uint16_t DegreesToFixed(double degrees)
+	{
+		return static_cast<uint16_t>(std::llround(degrees * ANGLE_SCALE) & 0xFFFF);
+	}
+	inline double FixedToDegrees(uint16_t value) { return value / ANGLE_SCALE; }
+
+	// Values in the range 0 to 1 (shields, hull, energy, fuel).
+	inline uint8_t UnitToFixed(float value)
+	{
+		return static_cast<uint8_t>(std::lround(std::clamp(value, 0.f, 1.f) * 255.f));
+	}
+	inline float FixedToUnit(uint8_t value) { return value / 255.f; }
+}
+
 // Rejection reason codes for ConnectRejectPacket
 enum class RejectReason : uint8_t {
 	SERVER_FULL = 0,
@@ -15,6 +15,8 @@
 
 #include "PacketWriter.h"
 
+#include "PacketStructs.h"
+
 #include "Angle.h"
 #include "Command.h"
 #include "EsUuid.h"
@@ -24,6 +26,19 @@
 
 using namespace std;
 
+namespace {
+	int HexValue(char c)
+	{
+		if(c >= '0' && c <= '9')
+			return c - '0';
+		if(c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		if(c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		return -1;
+	}
+}
+
 
 PacketWriter::PacketWriter(NetworkPacket::PacketType type)
 	: packetType(type), finalized(false)
@@ -148,15 +163,22 @@ void PacketWriter::WriteAngle(const Angle &angle)
 
 void PacketWriter::WriteUuid(const EsUuid &uuid)
 {
-	finalized = false;
-	// Convert UUID to string, then parse as hex bytes
+	// EsUuid only exposes its value as a string:
+	// "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" (36 chars)
+	// Pack its 32 hex digits into the raw 16 bytes.
 	string uuidStr = uuid.ToString();
 
-	// UUID string format: "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" (36 chars)
-	// We need to write the raw 16 bytes
-	// For now, write the string representation (will be 38 bytes with length prefix)
-	// TODO: Optimize this to write raw 16 bytes
-	WriteString(uuidStr);
+	uint8_t bytes[16] = {};
+	size_t digits = 0;
+	for(char c : uuidStr)
+	{
+		int value = HexValue(c);
+		if(value < 0 || digits >= 32)
+			continue;
+		bytes[digits / 2] |= static_cast<uint8_t>(digits % 2 ? value : value << 4);
+		++digits;
+	}
+	WriteBytes(bytes, sizeof(bytes));
 }
 
 
@@ -172,6 +194,39 @@ void PacketWriter::WriteCommand(const Command &command)
 }
 
 
+void PacketWriter::WriteQuantizedPosition(const Point &point)
+{
+	finalized = false;
+	for(double value : {point.X(), point.Y()})
+	{
+		// 24-bit two's complement, big-endian.
+		uint32_t fixed = static_cast<uint32_t>(NetworkPacket::Quantization::PositionToFixed(value));
+		buffer.push_back(static_cast<uint8_t>(fixed >> 16));
+		buffer.push_back(static_cast<uint8_t>(fixed >> 8));
+		buffer.push_back(static_cast<uint8_t>(fixed));
+	}
+}
+
+
+void PacketWriter::WriteQuantizedVelocity(const Point &velocity)
+{
+	WriteInt16(NetworkPacket::Quantization::VelocityToFixed(velocity.X()));
+	WriteInt16(NetworkPacket::Quantization::VelocityToFixed(velocity.Y()));
+}
+
+
+void PacketWriter::WriteQuantizedAngle(const Angle &angle)
+{
+	WriteUint16(NetworkPacket::Quantization::DegreesToFixed(angle.Degrees()));
+}
+
+
+void PacketWriter::WriteQuantizedUnit(float value)
+{
+	WriteUint8(NetworkPacket::Quantization::UnitToFixed(value));
+}
+
+
 void PacketWriter::WriteBytes(const void *data, size_t size)
 {
 	finalized = false;
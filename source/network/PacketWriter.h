@@ -53,10 +53,16 @@ public:
 
 	// Write game types
 	void WritePoint(const Point &point);        // 16 bytes (2 doubles)
-	void WriteAngle(const Angle &angle);        // 4 bytes (int32_t)
-	void WriteUuid(const EsUuid &uuid);         // 16 bytes
+	void WriteAngle(const Angle &angle);        // 8 bytes (double degrees)
+	void WriteUuid(const EsUuid &uuid);         // 16 bytes (raw)
 	void WriteCommand(const Command &command);  // 16 bytes (uint64_t + double)
 
+	// Write quantized game types (see NetworkPacket::Quantization)
+	void WriteQuantizedPosition(const Point &point);   // 6 bytes (2 x 24-bit)
+	void WriteQuantizedVelocity(const Point &velocity); // 4 bytes (2 x 16-bit)
+	void WriteQuantizedAngle(const Angle &angle);       // 2 bytes
+	void WriteQuantizedUnit(float value);               // 1 byte (0-1 range)
+
 	// Write raw bytes (for custom data)
 	void WriteBytes(const void *data, size_t size);
 
@@ -0,0 +1,548 @@
+/* DeltaEncoder.cpp
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "DeltaEncoder.h"
+
+#include "../EsUuid.h"
+#include "../network/PacketReader.h"
+#include "../network/PacketStructs.h"
+#include "../network/PacketWriter.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+	// Walk two ID-sorted record lists in step, calling the given functions for
+	// records only in the baseline, only in the current list, or in both.
+	// Chunks the two lists share are unchanged and are skipped entirely.
+	template<class Record, class Removed, class Added, class Both>
+	void Merge(const RecordList<Record> *baseline, const RecordList<Record> &current,
+		Removed removed, Added added, Both both)
+	{
+		static const RecordList<Record> EMPTY;
+		const RecordList<Record> &previous = baseline ? *baseline : EMPTY;
+
+		auto prev = previous.begin();
+		auto cur = current.begin();
+		while(prev != previous.end() || cur != current.end())
+		{
+			if(prev != previous.end() && cur != current.end() && prev.AtChunkStart() && cur.AtChunkStart()
+					&& prev.GetChunk() == cur.GetChunk())
+			{
+				prev.SkipChunk();
+				cur.SkipChunk();
+			}
+			else if(cur == current.end() || (prev != previous.end() && prev->id < cur->id))
+				removed(*prev++);
+			else if(prev == previous.end() || cur->id < prev->id)
+				added(*cur++);
+			else
+				both(*prev++, *cur++);
+		}
+	}
+
+	template<class Record>
+	void EraseIds(vector<Record> &records, const vector<uint16_t> &ids)
+	{
+		if(ids.empty())
+			return;
+		records.erase(remove_if(records.begin(), records.end(),
+			[&ids](const Record &record) { return binary_search(ids.begin(), ids.end(), record.id); }),
+			records.end());
+	}
+
+	template<class Record>
+	void SortRecords(vector<Record> &records)
+	{
+		sort(records.begin(), records.end(), [](const Record &a, const Record &b) { return a.id < b.id; });
+	}
+
+	// Read a list of entity IDs, which Encode() always writes in ascending order.
+	bool ReadIds(PacketReader &reader, vector<uint16_t> &ids)
+	{
+		ids.resize(reader.ReadUint16());
+		for(uint16_t &id : ids)
+			id = reader.ReadUint16();
+		return !reader.HasError();
+	}
+}
+
+
+
+DeltaEncoder::DeltaEncoder(const EntityTracker *tracker, bool quantized)
+	: tracker(tracker), quantized(quantized), fragmentData(NetworkPacket::PacketType::SERVER_WORLD_STATE)
+{
+}
+
+
+
+void DeltaEncoder::SetQuantized(bool value)
+{
+	// Pooled fragments were written in the old format.
+	if(value != quantized)
+		fragmentSnapshot = nullptr;
+	quantized = value;
+}
+
+
+
+size_t DeltaEncoder::Encode(const WorldSnapshot *baseline, const WorldSnapshot &current, PacketWriter &writer)
+{
+	size_t startSize = writer.GetSize();
+	BeginFragments(current);
+
+	shipSpawns.clear();
+	shipChanges.clear();
+	shipRemovals.clear();
+	projectileSpawns.clear();
+	projectileDeaths.clear();
+	flotsamSpawns.clear();
+	flotsamChanges.clear();
+	flotsamRemovals.clear();
+
+	// Classify every entity. Records are sorted by ID, so the output lists
+	// are sorted as well, which the decoder relies on.
+	Merge(baseline ? &baseline->ships : nullptr, current.ships,
+		[this](const ShipRecord &record) { shipRemovals.push_back(record.id); },
+		[this](const ShipRecord &record) { shipSpawns.push_back(&record); },
+		[this](const ShipRecord &previous, const ShipRecord &record)
+		{
+			uint8_t mask = DiffShip(previous, record, quantized);
+			if(mask)
+				shipChanges.emplace_back(&record, mask);
+		});
+	Merge(baseline ? &baseline->projectiles : nullptr, current.projectiles,
+		[this](const ProjectileRecord &record) { projectileDeaths.push_back(record.id); },
+		[this](const ProjectileRecord &record) { projectileSpawns.push_back(&record); },
+		[](const ProjectileRecord &, const ProjectileRecord &) {});
+	Merge(baseline ? &baseline->flotsam : nullptr, current.flotsam,
+		[this](const FlotsamRecord &record) { flotsamRemovals.push_back(record.id); },
+		[this](const FlotsamRecord &record) { flotsamSpawns.push_back(&record); },
+		[this](const FlotsamRecord &previous, const FlotsamRecord &record)
+		{
+			uint8_t mask = DiffFlotsam(previous, record, quantized);
+			if(mask)
+				flotsamChanges.emplace_back(&record, mask);
+		});
+
+	// Header.
+	writer.WriteUint64(current.gameTick);
+	writer.WriteUint64(baseline ? baseline->gameTick : 0);
+	writer.WriteUint8((baseline ? 0 : KEYFRAME) | (quantized ? QUANTIZED : 0));
+
+	// Ships.
+	writer.WriteUint16(static_cast<uint16_t>(shipSpawns.size()));
+	for(const ShipRecord *record : shipSpawns)
+		WriteFragment(writer, FragmentKind::SHIP_SPAWN, record->id, SHIP_ALL, [this, record](PacketWriter &out)
+		{
+			out.WriteUint16(record->id);
+			const EsUuid *uuid = tracker ? tracker->GetShipUuid(record->id) : nullptr;
+			out.WriteUuid(uuid ? *uuid : EsUuid());
+			out.WriteUint8(SHIP_ALL);
+			WriteShip(out, *record, SHIP_ALL);
+		});
+	writer.WriteUint16(static_cast<uint16_t>(shipChanges.size()));
+	for(const auto &change : shipChanges)
+		WriteFragment(writer, FragmentKind::SHIP_CHANGE, change.first->id, change.second,
+			[this, &change](PacketWriter &out)
+			{
+				out.WriteUint16(change.first->id);
+				out.WriteUint8(change.second);
+				WriteShip(out, *change.first, change.second);
+			});
+	writer.WriteUint16(static_cast<uint16_t>(shipRemovals.size()));
+	for(uint16_t id : shipRemovals)
+		writer.WriteUint16(id);
+
+	// Projectiles.
+	writer.WriteUint16(static_cast<uint16_t>(projectileSpawns.size()));
+	for(const ProjectileRecord *record : projectileSpawns)
+		WriteFragment(writer, FragmentKind::PROJECTILE_SPAWN, record->id, 0, [this, record](PacketWriter &out)
+		{
+			out.WriteUint16(record->id);
+			if(quantized)
+			{
+				out.WriteQuantizedPosition(record->position);
+				out.WriteQuantizedVelocity(record->velocity);
+				out.WriteQuantizedAngle(record->facing);
+			}
+			else
+			{
+				out.WritePoint(record->position);
+				out.WritePoint(record->velocity);
+				out.WriteAngle(record->facing);
+			}
+		});
+	writer.WriteUint16(static_cast<uint16_t>(projectileDeaths.size()));
+	for(uint16_t id : projectileDeaths)
+		writer.WriteUint16(id);
+
+	// Flotsam.
+	writer.WriteUint16(static_cast<uint16_t>(flotsamSpawns.size()));
+	for(const FlotsamRecord *record : flotsamSpawns)
+		WriteFragment(writer, FragmentKind::FLOTSAM_SPAWN, record->id, FLOTSAM_ALL, [this, record](PacketWriter &out)
+		{
+			out.WriteUint16(record->id);
+			out.WriteUint8(FLOTSAM_ALL);
+			WriteFlotsam(out, *record, FLOTSAM_ALL);
+		});
+	writer.WriteUint16(static_cast<uint16_t>(flotsamChanges.size()));
+	for(const auto &change : flotsamChanges)
+		WriteFragment(writer, FragmentKind::FLOTSAM_CHANGE, change.first->id, change.second,
+			[this, &change](PacketWriter &out)
+			{
+				out.WriteUint16(change.first->id);
+				out.WriteUint8(change.second);
+				WriteFlotsam(out, *change.first, change.second);
+			});
+	writer.WriteUint16(static_cast<uint16_t>(flotsamRemovals.size()));
+	for(uint16_t id : flotsamRemovals)
+		writer.WriteUint16(id);
+
+	return writer.GetSize() - startSize;
+}
+
+
+
+bool DeltaEncoder::ReadHeader(PacketReader &reader, Header &header)
+{
+	header.gameTick = reader.ReadUint64();
+	header.baselineTick = reader.ReadUint64();
+	uint8_t flags = reader.ReadUint8();
+	header.isKeyframe = flags & KEYFRAME;
+	header.isQuantized = flags & QUANTIZED;
+	return !reader.HasError();
+}
+
+
+
+bool DeltaEncoder::Decode(PacketReader &reader, const Header &header, const WorldSnapshot *baseline,
+	WorldSnapshot &result, map<uint16_t, EsUuid> *announced)
+{
+	// A delta can only be applied to the exact baseline it was encoded against.
+	if(!header.isKeyframe && (!baseline || baseline->gameTick != header.baselineTick))
+		return false;
+
+	// Apply the changes to plain copies of the baseline's records, then store
+	// them in the result sharing whatever storage did not change.
+	vector<ShipRecord> ships;
+	vector<ProjectileRecord> projectiles;
+	vector<FlotsamRecord> flotsam;
+	if(!header.isKeyframe)
+	{
+		ships = baseline->ships.ToVector();
+		projectiles = baseline->projectiles.ToVector();
+		flotsam = baseline->flotsam.ToVector();
+	}
+
+	vector<uint16_t> removed;
+	bool quantized = header.isQuantized;
+	size_t sortedShips = ships.size();
+	size_t sortedFlotsam = flotsam.size();
+
+	// Ships.
+	uint16_t count = reader.ReadUint16();
+	for(uint16_t i = 0; i < count && !reader.HasError(); ++i)
+	{
+		ShipRecord &record = ships.emplace_back();
+		record.id = reader.ReadUint16();
+		EsUuid uuid = reader.ReadUuid();
+		if(announced)
+			announced->insert_or_assign(record.id, std::move(uuid));
+		ReadShip(reader, record, reader.ReadUint8(), quantized);
+	}
+	count = reader.ReadUint16();
+	for(uint16_t i = 0; i < count && !reader.HasError(); ++i)
+	{
+		uint16_t id = reader.ReadUint16();
+		uint8_t mask = reader.ReadUint8();
+		// Changed entities always exist in the baseline, which is the sorted
+		// prefix of the list.
+		ShipRecord scratch;
+		auto end = ships.begin() + sortedShips;
+		auto it = lower_bound(ships.begin(), end, id,
+			[](const ShipRecord &r, uint16_t value) { return r.id < value; });
+		ReadShip(reader, (it != end && it->id == id) ? *it : scratch, mask, quantized);
+	}
+	if(!ReadIds(reader, removed))
+		return false;
+	EraseIds(ships, removed);
+	SortRecords(ships);
+
+	// Projectiles.
+	count = reader.ReadUint16();
+	for(uint16_t i = 0; i < count && !reader.HasError(); ++i)
+	{
+		ProjectileRecord &record = projectiles.emplace_back();
+		record.id = reader.ReadUint16();
+		if(quantized)
+		{
+			record.position = reader.ReadQuantizedPosition();
+			record.velocity = reader.ReadQuantizedVelocity();
+			record.facing = reader.ReadQuantizedAngle();
+		}
+		else
+		{
+			record.position = reader.ReadPoint();
+			record.velocity = reader.ReadPoint();
+			record.facing = reader.ReadAngle();
+		}
+	}
+	if(!ReadIds(reader, removed))
+		return false;
+	EraseIds(projectiles, removed);
+	SortRecords(projectiles);
+
+	// Flotsam.
+	count = reader.ReadUint16();
+	for(uint16_t i = 0; i < count && !reader.HasError(); ++i)
+	{
+		FlotsamRecord &record = flotsam.emplace_back();
+		record.id = reader.ReadUint16();
+		ReadFlotsam(reader, record, reader.ReadUint8(), quantized);
+	}
+	count = reader.ReadUint16();
+	for(uint16_t i = 0; i < count && !reader.HasError(); ++i)
+	{
+		uint16_t id = reader.ReadUint16();
+		uint8_t mask = reader.ReadUint8();
+		FlotsamRecord scratch;
+		auto end = flotsam.begin() + sortedFlotsam;
+		auto it = lower_bound(flotsam.begin(), end, id,
+			[](const FlotsamRecord &r, uint16_t value) { return r.id < value; });
+		ReadFlotsam(reader, (it != end && it->id == id) ? *it : scratch, mask, quantized);
+	}
+	if(!ReadIds(reader, removed))
+		return false;
+	EraseIds(flotsam, removed);
+	SortRecords(flotsam);
+
+	result.gameTick = header.gameTick;
+	result.ships.Assign(ships, baseline ? &baseline->ships : nullptr);
+	result.projectiles.Assign(projectiles, baseline ? &baseline->projectiles : nullptr);
+	result.flotsam.Assign(flotsam, baseline ? &baseline->flotsam : nullptr);
+
+	return !reader.HasError();
+}
+
+
+
+uint8_t DeltaEncoder::DiffShip(const ShipRecord &previous, const ShipRecord &current, bool quantized)
+{
+	// In quantized mode, a change too small to survive quantization is not a
+	// change: the client already holds the same quantized value.
+	using namespace NetworkPacket::Quantization;
+	auto samePoint = [quantized](const Point &a, const Point &b, auto toFixed)
+	{
+		return quantized ? (toFixed(a.X()) == toFixed(b.X()) && toFixed(a.Y()) == toFixed(b.Y())) : a == b;
+	};
+	auto sameUnit = [quantized](float a, float b)
+	{
+		return quantized ? UnitToFixed(a) == UnitToFixed(b) : a == b;
+	};
+
+	uint8_t mask = 0;
+	if(!samePoint(previous.position, current.position, PositionToFixed))
+		mask |= SHIP_POSITION;
+	if(!samePoint(previous.velocity, current.velocity, VelocityToFixed))
+		mask |= SHIP_VELOCITY;
+	if(quantized ? DegreesToFixed(previous.facing.Degrees()) != DegreesToFixed(current.facing.Degrees())
+			: previous.facing.Degrees() != current.facing.Degrees())
+		mask |= SHIP_FACING;
+	if(!sameUnit(previous.shields, current.shields))
+		mask |= SHIP_SHIELDS;
+	if(!sameUnit(previous.hull, current.hull))
+		mask |= SHIP_HULL;
+	if(!sameUnit(previous.energy, current.energy))
+		mask |= SHIP_ENERGY;
+	if(!sameUnit(previous.fuel, current.fuel))
+		mask |= SHIP_FUEL;
+	if(previous.flags != current.flags)
+		mask |= SHIP_FLAGS;
+	return mask;
+}
+
+
+
+uint8_t DeltaEncoder::DiffFlotsam(const FlotsamRecord &previous, const FlotsamRecord &current, bool quantized)
+{
+	using namespace NetworkPacket::Quantization;
+	auto samePoint = [quantized](const Point &a, const Point &b, auto toFixed)
+	{
+		return quantized ? (toFixed(a.X()) == toFixed(b.X()) && toFixed(a.Y()) == toFixed(b.Y())) : a == b;
+	};
+
+	uint8_t mask = 0;
+	if(!samePoint(previous.position, current.position, PositionToFixed))
+		mask |= FLOTSAM_POSITION;
+	if(!samePoint(previous.velocity, current.velocity, VelocityToFixed))
+		mask |= FLOTSAM_VELOCITY;
+	if(previous.count != current.count)
+		mask |= FLOTSAM_COUNT;
+	return mask;
+}
+
+
+
+void DeltaEncoder::BeginFragments(const WorldSnapshot &current)
+{
+	if(fragmentSnapshot == &current && fragmentTick == current.gameTick)
+		return;
+
+	fragmentSnapshot = &current;
+	fragmentTick = current.gameTick;
+	fragmentData.Reset(NetworkPacket::PacketType::SERVER_WORLD_STATE);
+	fragments.clear();
+	fragmentReuses = 0;
+}
+
+
+
+template<class Serialize>
+void DeltaEncoder::WriteFragment(PacketWriter &writer, FragmentKind kind, uint16_t id, uint8_t mask,
+	Serialize serialize)
+{
+	uint32_t key = (static_cast<uint32_t>(kind) << 24) | (static_cast<uint32_t>(mask) << 16) | id;
+	auto it = fragments.find(key);
+	if(it == fragments.end())
+	{
+		size_t offset = fragmentData.GetSize();
+		serialize(fragmentData);
+		it = fragments.emplace(key, Fragment{offset, fragmentData.GetSize() - offset}).first;
+	}
+	else
+		++fragmentReuses;
+
+	writer.WriteBytes(fragmentData.GetDataPtr() + it->second.offset, it->second.size);
+}
+
+
+
+void DeltaEncoder::WriteShip(PacketWriter &writer, const ShipRecord &record, uint8_t mask) const
+{
+	if(quantized)
+	{
+		if(mask & SHIP_POSITION)
+			writer.WriteQuantizedPosition(record.position);
+		if(mask & SHIP_VELOCITY)
+			writer.WriteQuantizedVelocity(record.velocity);
+		if(mask & SHIP_FACING)
+			writer.WriteQuantizedAngle(record.facing);
+		if(mask & SHIP_SHIELDS)
+			writer.WriteQuantizedUnit(record.shields);
+		if(mask & SHIP_HULL)
+			writer.WriteQuantizedUnit(record.hull);
+		if(mask & SHIP_ENERGY)
+			writer.WriteQuantizedUnit(record.energy);
+		if(mask & SHIP_FUEL)
+			writer.WriteQuantizedUnit(record.fuel);
+	}
+	else
+	{
+		if(mask & SHIP_POSITION)
+			writer.WritePoint(record.position);
+		if(mask & SHIP_VELOCITY)
+			writer.WritePoint(record.velocity);
+		if(mask & SHIP_FACING)
+			writer.WriteAngle(record.facing);
+		if(mask & SHIP_SHIELDS)
+			writer.WriteFloat(record.shields);
+		if(mask & SHIP_HULL)
+			writer.WriteFloat(record.hull);
+		if(mask & SHIP_ENERGY)
+			writer.WriteFloat(record.energy);
+		if(mask & SHIP_FUEL)
+			writer.WriteFloat(record.fuel);
+	}
+	if(mask & SHIP_FLAGS)
+		writer.WriteUint16(record.flags);
+}
+
+
+
+void DeltaEncoder::WriteFlotsam(PacketWriter &writer, const FlotsamRecord &record, uint8_t mask) const
+{
+	if(mask & FLOTSAM_POSITION)
+	{
+		if(quantized)
+			writer.WriteQuantizedPosition(record.position);
+		else
+			writer.WritePoint(record.position);
+	}
+	if(mask & FLOTSAM_VELOCITY)
+	{
+		if(quantized)
+			writer.WriteQuantizedVelocity(record.velocity);
+		else
+			writer.WritePoint(record.velocity);
+	}
+	if(mask & FLOTSAM_COUNT)
+		writer.WriteInt32(record.count);
+}
+
+
+
+void DeltaEncoder::ReadShip(PacketReader &reader, ShipRecord &record, uint8_t mask, bool quantized)
+{
+	if(quantized)
+	{
+		if(mask & SHIP_POSITION)
+			record.position = reader.ReadQuantizedPosition();
+		if(mask & SHIP_VELOCITY)
+			record.velocity = reader.ReadQuantizedVelocity();
+		if(mask & SHIP_FACING)
+			record.facing = reader.ReadQuantizedAngle();
+		if(mask & SHIP_SHIELDS)
+			record.shields = reader.ReadQuantizedUnit();
+		if(mask & SHIP_HULL)
+			record.hull = reader.ReadQuantizedUnit();
+		if(mask & SHIP_ENERGY)
+			record.energy = reader.ReadQuantizedUnit();
+		if(mask & SHIP_FUEL)
+			record.fuel = reader.ReadQuantizedUnit();
+	}
+	else
+	{
+		if(mask & SHIP_POSITION)
+			record.position = reader.ReadPoint();
+		if(mask & SHIP_VELOCITY)
+			record.velocity = reader.ReadPoint();
+		if(mask & SHIP_FACING)
+			record.facing = reader.ReadAngle();
+		if(mask & SHIP_SHIELDS)
+			record.shields = reader.ReadFloat();
+		if(mask & SHIP_HULL)
+			record.hull = reader.ReadFloat();
+		if(mask & SHIP_ENERGY)
+			record.energy = reader.ReadFloat();
+		if(mask & SHIP_FUEL)
+			record.fuel = reader.ReadFloat();
+	}
+	if(mask & SHIP_FLAGS)
+		record.flags = reader.ReadUint16();
+}
+
+
+
+void DeltaEncoder::ReadFlotsam(PacketReader &reader, FlotsamRecord &record, uint8_t mask, bool quantized)
+{
+	if(mask & FLOTSAM_POSITION)
+		record.position = quantized ? reader.ReadQuantizedPosition() : reader.ReadPoint();
+	if(mask & FLOTSAM_VELOCITY)
+		record.velocity = quantized ? reader.ReadQuantizedVelocity() : reader.ReadPoint();
+	if(mask & FLOTSAM_COUNT)
+		record.count = reader.ReadInt32();
+}
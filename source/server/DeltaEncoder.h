@@ -0,0 +1,196 @@
+/* DeltaEncoder.h
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "WorldSnapshot.h"
+#include "../network/PacketWriter.h"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+class EsUuid;
+class PacketReader;
+
+
+// DeltaEncoder: Field-level delta compression between two WorldSnapshots
+//
+// Wire format (appended to a SERVER_WORLD_STATE payload):
+//   uint64 gameTick
+//   uint64 baselineTick                      (0 for keyframes)
+//   uint8  flags                             (KEYFRAME, QUANTIZED)
+//   Ships:
+//     uint16 count, then per spawned ship:   uint16 id, UUID, uint8 mask, fields
+//     uint16 count, then per changed ship:   uint16 id, uint8 mask, changed fields
+//     uint16 count, then per removed ship:   uint16 id
+//   Projectiles:
+//     uint16 count, then per spawn:          uint16 id, position, velocity, facing
+//     uint16 count, then per death:          uint16 id
+//   Flotsam:
+//     uint16 count, then per spawn:          uint16 id, uint8 mask, fields
+//     uint16 count, then per change:         uint16 id, uint8 mask, changed fields
+//     uint16 count, then per removal:        uint16 id
+//
+// Entities are referred to by their per-session network ID (see
+// EntityTracker); a ship's UUID is only sent when it spawns. A spawned entity
+// always carries every field. Projectile motion after the spawn is
+// deterministic, so only their spawns and deaths are transmitted.
+//
+// In quantized mode, positions, velocities, angles and 0-1 values are sent in
+// the fixed-point forms of NetworkPacket::Quantization (see
+// QuantizedShipStatePacket), and changes smaller than the quantization step
+// are not sent. Otherwise they are sent at full precision.
+//
+// Every client is sent the same snapshot, and most entities change in the
+// same way relative to every client's baseline, so each entity's encoding is
+// kept in a fragment pool for the rest of the tick: an entity is serialized
+// at most once per distinct set of changed fields, and every other packet
+// that needs it copies the bytes. The pool is cleared (keeping its memory)
+// when a different snapshot is encoded.
+//
+// Usage (server):
+//   DeltaEncoder encoder(&tracker);
+//   encoder.Encode(clientBaseline, latest, writer);   // baseline may be nullptr
+//
+// Usage (client):
+//   DeltaEncoder::Header header;
+//   DeltaEncoder::ReadHeader(reader, header);
+//   DeltaEncoder::Decode(reader, header, baselineFor(header.baselineTick), result);
+class DeltaEncoder {
+public:
+	// Presence bits for ship fields.
+	enum ShipField : uint8_t {
+		SHIP_POSITION = 0x01,
+		SHIP_VELOCITY = 0x02,
+		SHIP_FACING = 0x04,
+		SHIP_SHIELDS = 0x08,
+		SHIP_HULL = 0x10,
+		SHIP_ENERGY = 0x20,
+		SHIP_FUEL = 0x40,
+		SHIP_FLAGS = 0x80,
+		SHIP_ALL = 0xFF,
+	};
+
+	// Presence bits for flotsam fields.
+	enum FlotsamField : uint8_t {
+		FLOTSAM_POSITION = 0x01,
+		FLOTSAM_VELOCITY = 0x02,
+		FLOTSAM_COUNT = 0x04,
+		FLOTSAM_ALL = 0x07,
+	};
+
+	// Header flag bits.
+	static constexpr uint8_t KEYFRAME = 0x01;
+	static constexpr uint8_t QUANTIZED = 0x02;
+
+	struct Header {
+		uint64_t gameTick = 0;
+		uint64_t baselineTick = 0;
+		bool isKeyframe = false;
+		bool isQuantized = false;
+	};
+
+
+public:
+	// The tracker supplies the UUIDs of newly announced ships. Without one,
+	// spawned ships are sent with a blank UUID.
+	explicit DeltaEncoder(const EntityTracker *tracker = nullptr, bool quantized = false);
+
+	// Select the quantized or full-precision encoding.
+	void SetQuantized(bool value);
+	bool IsQuantized() const { return quantized; }
+
+	// Append the encoding of "current" relative to "baseline" to the writer.
+	// A null baseline produces a keyframe containing every entity.
+	// Returns the number of bytes appended.
+	size_t Encode(const WorldSnapshot *baseline, const WorldSnapshot &current, PacketWriter &writer);
+
+	// Read the header that Encode() wrote, so the caller can find the baseline.
+	static bool ReadHeader(PacketReader &reader, Header &header);
+	// Rebuild the encoded snapshot from its baseline. The baseline must be the
+	// snapshot at header.baselineTick, or nullptr for a keyframe. UUIDs of newly
+	// announced ships are stored in "announced" if it is given.
+	static bool Decode(PacketReader &reader, const Header &header, const WorldSnapshot *baseline,
+		WorldSnapshot &result, std::map<uint16_t, EsUuid> *announced = nullptr);
+
+	// Get the set of fields that differ between two records of the same entity.
+	// If "quantized" is set, only differences that survive quantization count.
+	static uint8_t DiffShip(const ShipRecord &previous, const ShipRecord &current, bool quantized = false);
+	static uint8_t DiffFlotsam(const FlotsamRecord &previous, const FlotsamRecord &current,
+		bool quantized = false);
+
+	// Fragment pool statistics for the current snapshot: how many entity
+	// encodings were serialized, and how many were copied from the pool.
+	size_t GetFragmentCount() const { return fragments.size(); }
+	uint64_t GetFragmentReuseCount() const { return fragmentReuses; }
+
+
+private:
+	// Kinds of pooled entity encodings.
+	enum class FragmentKind : uint8_t {
+		SHIP_SPAWN,
+		SHIP_CHANGE,
+		PROJECTILE_SPAWN,
+		FLOTSAM_SPAWN,
+		FLOTSAM_CHANGE,
+	};
+
+	// Location of one entity's encoding in the fragment pool.
+	struct Fragment {
+		size_t offset;
+		size_t size;
+	};
+
+
+private:
+	// Clear the fragment pool if it holds encodings of another snapshot.
+	void BeginFragments(const WorldSnapshot &current);
+	// Copy an entity's encoding into the writer, serializing it into the pool
+	// with "serialize" first if this tick has not needed it yet.
+	template<class Serialize>
+	void WriteFragment(PacketWriter &writer, FragmentKind kind, uint16_t id, uint8_t mask, Serialize serialize);
+
+	void WriteShip(PacketWriter &writer, const ShipRecord &record, uint8_t mask) const;
+	void WriteFlotsam(PacketWriter &writer, const FlotsamRecord &record, uint8_t mask) const;
+	static void ReadShip(PacketReader &reader, ShipRecord &record, uint8_t mask, bool quantized);
+	static void ReadFlotsam(PacketReader &reader, FlotsamRecord &record, uint8_t mask, bool quantized);
+
+
+private:
+	const EntityTracker *tracker;
+	bool quantized;
+
+	// Scratch lists reused between calls so that encoding does not allocate
+	// once the lists have grown to the typical entity count.
+	std::vector<const ShipRecord *> shipSpawns;
+	std::vector<std::pair<const ShipRecord *, uint8_t>> shipChanges;
+	std::vector<uint16_t> shipRemovals;
+	std::vector<const ProjectileRecord *> projectileSpawns;
+	std::vector<uint16_t> projectileDeaths;
+	std::vector<const FlotsamRecord *> flotsamSpawns;
+	std::vector<std::pair<const FlotsamRecord *, uint8_t>> flotsamChanges;
+	std::vector<uint16_t> flotsamRemovals;
+
+	// Entity encodings of the snapshot last encoded, keyed by kind, field mask
+	// and ID. The data is stored in the payload of a PacketWriter so that
+	// fragments are written exactly as they are sent.
+	const WorldSnapshot *fragmentSnapshot = nullptr;
+	uint64_t fragmentTick = 0;
+	PacketWriter fragmentData;
+	std::unordered_map<uint32_t, Fragment> fragments;
+	uint64_t fragmentReuses = 0;
+};
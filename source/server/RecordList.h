@@ -0,0 +1,275 @@
+/* RecordList.h
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <vector>
+
+
+
+// RecordList: Immutable, ID-sorted list of entity records with structural sharing
+//
+// Records are stored in small immutable chunks held by shared_ptr. When a list
+// is built from a newer capture of the same entities, every chunk whose
+// records are all unchanged is taken over from the previous list instead of
+// being copied, so a history of consecutive snapshots only pays for the
+// records that actually changed between them.
+//
+// Chunk boundaries follow the previous list wherever possible: a new chunk
+// is closed as soon as the next record would start one of the previous
+// chunks, so a spawn or removal only disturbs the chunk it falls in.
+//
+// When a list is assigned new records, its own chunks that no other list
+// shares are refilled rather than freed, so a list that is captured into
+// over and over stops allocating once it has warmed up.
+//
+// Because shared chunks are identical objects, two lists can also be compared
+// a chunk at a time (see const_iterator::GetChunk()), which lets the delta
+// encoder skip unchanged runs of entities without looking at them.
+template<class Record>
+class RecordList {
+public:
+	static constexpr size_t CHUNK_SIZE = 16;
+	using Chunk = std::vector<Record>;
+
+	// Forward iterator over the records of every chunk in turn.
+	class const_iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Record;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Record *;
+		using reference = const Record &;
+
+		const_iterator() = default;
+
+		reference operator*() const { return (**chunk)[index]; }
+		pointer operator->() const { return &(**chunk)[index]; }
+		const_iterator &operator++();
+		const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+		bool operator==(const const_iterator &other) const { return chunk == other.chunk && index == other.index; }
+		bool operator!=(const const_iterator &other) const { return !(*this == other); }
+
+		// True if this iterator is at the first record of its chunk.
+		bool AtChunkStart() const { return index == 0; }
+		// The chunk this iterator is in. Only valid if it is not at the end.
+		const Chunk *GetChunk() const { return chunk->get(); }
+		// Advance past the rest of the current chunk.
+		void SkipChunk() { ++chunk; index = 0; }
+
+	private:
+		friend class RecordList;
+		using ChunkIterator = typename std::vector<std::shared_ptr<const Chunk>>::const_iterator;
+		explicit const_iterator(ChunkIterator chunk) : chunk(chunk) {}
+
+	private:
+		ChunkIterator chunk;
+		size_t index = 0;
+	};
+
+
+public:
+	RecordList() = default;
+	// Build a list that owns all of its records.
+	explicit RecordList(const std::vector<Record> &records);
+
+	// Replace the contents of this list with the given records, which must be
+	// sorted by ID. Chunks of "previous" whose records are all unchanged are
+	// shared rather than copied.
+	void Assign(const std::vector<Record> &records, const RecordList *previous = nullptr);
+	void Clear();
+
+	const_iterator begin() const { return const_iterator(chunks.begin()); }
+	const_iterator end() const { return const_iterator(chunks.end()); }
+	size_t size() const { return count; }
+	bool empty() const { return !count; }
+
+	// Find a record by entity ID. Returns nullptr if absent.
+	const Record *Find(uint32_t id) const;
+
+	// Copy every record into a plain vector.
+	std::vector<Record> ToVector() const { return std::vector<Record>(begin(), end()); }
+
+	// Number of chunks, and number of chunks shared with the list this one was
+	// built from.
+	size_t GetChunkCount() const { return chunks.size(); }
+	size_t GetSharedChunkCount() const { return sharedChunks; }
+
+	// Bytes used by this list. If "counted" is given, chunks that are already
+	// in it are skipped and the rest are added, so that the memory of several
+	// lists sharing chunks can be totalled without counting any chunk twice.
+	size_t GetMemoryUsage(std::set<const void *> *counted = nullptr) const;
+
+
+private:
+	void AddChunk(typename std::vector<Record>::const_iterator first,
+		typename std::vector<Record>::const_iterator last);
+
+
+private:
+	std::vector<std::shared_ptr<const Chunk>> chunks;
+	// This list's previous chunks while Assign() is running
+	std::vector<std::shared_ptr<const Chunk>> spareChunks;
+	size_t count = 0;
+	size_t sharedChunks = 0;
+};
+
+
+
+template<class Record>
+typename RecordList<Record>::const_iterator &RecordList<Record>::const_iterator::operator++()
+{
+	if(++index == (*chunk)->size())
+	{
+		++chunk;
+		index = 0;
+	}
+	return *this;
+}
+
+
+
+template<class Record>
+RecordList<Record>::RecordList(const std::vector<Record> &records)
+{
+	Assign(records);
+}
+
+
+
+template<class Record>
+void RecordList<Record>::Assign(const std::vector<Record> &records, const RecordList *previous)
+{
+	// If "previous" is this list, keep its chunks alive while building.
+	// Otherwise its chunks are only looked at, and this list's own chunks are
+	// set aside to be refilled.
+	std::vector<std::shared_ptr<const Chunk>> ownChunks;
+	if(previous == this)
+		ownChunks.swap(chunks);
+	else
+		spareChunks.swap(chunks);
+	const auto &oldChunks = (previous && previous != this) ? previous->chunks : ownChunks;
+
+	chunks.clear();
+	chunks.reserve(records.size() / CHUNK_SIZE + 1);
+	count = records.size();
+	sharedChunks = 0;
+
+	auto old = oldChunks.begin();
+	auto it = records.begin();
+	while(it != records.end())
+	{
+		// Find the first old chunk that does not start before this record.
+		while(old != oldChunks.end() && (*old)->front().id < it->id)
+			++old;
+
+		// Reuse the old chunk if it starts here and nothing in it has changed.
+		if(old != oldChunks.end() && (*old)->front().id == it->id
+				&& static_cast<size_t>(records.end() - it) >= (*old)->size()
+				&& std::equal((*old)->begin(), (*old)->end(), it))
+		{
+			it += (*old)->size();
+			chunks.push_back(*old++);
+			++sharedChunks;
+			continue;
+		}
+
+		// Otherwise start a new chunk, ending it early where the next old chunk
+		// begins so that later chunks can still line up.
+		auto last = it + std::min<size_t>(CHUNK_SIZE, records.end() - it);
+		auto next = old;
+		if(next != oldChunks.end() && (*next)->front().id == it->id)
+			++next;
+		if(next != oldChunks.end())
+		{
+			uint32_t boundary = (*next)->front().id;
+			last = std::find_if(it + 1, last, [boundary](const Record &record) { return record.id >= boundary; });
+		}
+		AddChunk(it, last);
+		it = last;
+	}
+	spareChunks.clear();
+}
+
+
+
+template<class Record>
+void RecordList<Record>::Clear()
+{
+	chunks.clear();
+	count = 0;
+	sharedChunks = 0;
+}
+
+
+
+template<class Record>
+const Record *RecordList<Record>::Find(uint32_t id) const
+{
+	// Find the last chunk that starts at or before this ID.
+	auto chunk = std::upper_bound(chunks.begin(), chunks.end(), id,
+		[](uint32_t value, const std::shared_ptr<const Chunk> &c) { return value < c->front().id; });
+	if(chunk == chunks.begin())
+		return nullptr;
+	--chunk;
+
+	auto it = std::lower_bound((*chunk)->begin(), (*chunk)->end(), id,
+		[](const Record &record, uint32_t value) { return record.id < value; });
+	return (it != (*chunk)->end() && it->id == id) ? &*it : nullptr;
+}
+
+
+
+template<class Record>
+size_t RecordList<Record>::GetMemoryUsage(std::set<const void *> *counted) const
+{
+	size_t total = (chunks.capacity() + spareChunks.capacity()) * sizeof(std::shared_ptr<const Chunk>);
+	for(const auto &chunk : chunks)
+	{
+		if(counted && !counted->insert(chunk.get()).second)
+			continue;
+		// The chunk is allocated together with its shared_ptr control block.
+		total += sizeof(Chunk) + 2 * sizeof(long) + chunk->capacity() * sizeof(Record);
+	}
+	return total;
+}
+
+
+
+template<class Record>
+void RecordList<Record>::AddChunk(typename std::vector<Record>::const_iterator first,
+	typename std::vector<Record>::const_iterator last)
+{
+	// Refill a spare chunk that no other list shares, if there is one. Chunks
+	// are always created non-const, so one that is not shared may be changed.
+	while(!spareChunks.empty() && spareChunks.back().use_count() != 1)
+		spareChunks.pop_back();
+	if(spareChunks.empty())
+	{
+		chunks.push_back(std::make_shared<Chunk>(first, last));
+		return;
+	}
+
+	auto chunk = std::const_pointer_cast<Chunk>(std::move(spareChunks.back()));
+	spareChunks.pop_back();
+	chunk->assign(first, last);
+	chunks.push_back(std::move(chunk));
+}
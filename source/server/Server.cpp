@@ -18,21 +18,42 @@
 #include "ServerLoop.h"
 #include "SnapshotManager.h"
 #include "../GameState.h"
-#include "../network/NetworkManager.h"
+#include "../Ship.h"
+#include "../network/NetworkServer.h"
+#include "../network/PacketReader.h"
+#include "../network/PacketWriter.h"
 #include "../multiplayer/PlayerManager.h"
 #include "../multiplayer/CommandBuffer.h"
 #include "../multiplayer/CommandValidator.h"
 #include "../EsUuid.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
 using namespace std;
 
+namespace {
+	double MillisecondsSince(chrono::steady_clock::time_point start)
+	{
+		return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	}
+
+	// Fold a sample into an exponential moving average (as ServerLoop does for
+	// its tick time).
+	void UpdateAverage(double &average, double sample)
+	{
+		const double alpha = 0.1;
+		average = alpha * sample + (1. - alpha) * average;
+	}
+}
+
 
 
 Server::Server()
+	: shipUpdatePacket(NetworkPacket::PacketType::SERVER_SHIP_UPDATE)
 {
+	stateSync.SetInterestManager(&interestManager);
 }
 
 
@@ -93,7 +114,7 @@ bool Server::Start()
 		return false;
 
 	// Start network manager
-	if(!networkManager->StartServer(config.GetPort()))
+	if(!networkServer->Start(config.GetPort()))
 	{
 		cerr << "Failed to start network server!" << endl;
 		return false;
@@ -124,9 +145,25 @@ void Server::Run()
 	serverLoop->SetBroadcastCallback([this](uint64_t tick) { OnBroadcastTick(tick); });
 	serverLoop->SetInputCallback([this]() { OnProcessInput(); });
 
+	// In pipelined mode, ENet belongs to the network thread from here on.
+	if(config.IsPipelined())
+	{
+		networkThreadRunning = true;
+		networkThread = thread(&Server::NetworkThreadLoop, this);
+	}
+
 	// Run the server loop (blocks until Stop() called)
 	serverLoop->Run();
 
+	FinishBroadcast();
+	if(networkThread.joinable())
+	{
+		networkThreadRunning = false;
+		networkThread.join();
+		// Stop() left disconnecting the clients to this thread.
+		networkServer->Shutdown();
+	}
+
 	cout << "Server loop ended" << endl;
 }
 
@@ -143,9 +180,10 @@ void Server::Stop()
 	if(serverLoop)
 		serverLoop->Stop();
 
-	// Disconnect all clients
-	if(networkManager)
-		networkManager->Shutdown();
+	// Disconnect all clients. If the network thread is still running, it is
+	// using ENet; Run() disconnects the clients once that thread has stopped.
+	if(networkServer && !networkThreadRunning.exchange(false))
+		networkServer->Shutdown();
 
 	running = false;
 	cout << "Server stopped" << endl;
@@ -172,7 +210,7 @@ uint64_t Server::GetGameTick() const
 size_t Server::GetPlayerCount() const
 {
 	if(playerManager)
-		return playerManager->GetConnectedPlayerCount();
+		return playerManager->GetConnectedPlayers().size();
 	return 0;
 }
 
@@ -195,13 +233,20 @@ Server::Statistics Server::GetStatistics() const
 	stats.totalCommandsRejected = totalCommandsRejected;
 
 	if(playerManager)
-		stats.connectedPlayers = playerManager->GetConnectedPlayerCount();
+		stats.connectedPlayers = playerManager->GetConnectedPlayers().size();
 
 	if(snapshotManager)
 	{
 		stats.snapshotCount = snapshotManager->GetSnapshotCount();
 		stats.snapshotMemoryUsage = snapshotManager->GetMemoryUsage();
+		stats.snapshotCompressionRatio = snapshotManager->GetAverageCompressionRatio();
 	}
+	stats.totalWorldStateBytes = totalWorldStateBytes;
+	stats.totalWorldStatePackets = totalWorldStatePackets;
+	stats.totalWorldStateEncodes = totalWorldStateEncodes;
+	stats.totalWorldStateDeferred = totalWorldStateDeferred;
+	stats.totalShipUpdateBytes = totalShipUpdateBytes;
+	stats.stageTimings = stageTimings;
 
 	return stats;
 }
@@ -262,10 +307,34 @@ void Server::BroadcastMessage(const string &message)
 
 bool Server::InitializeNetwork()
 {
-	networkManager = make_unique<NetworkManager>();
+	if(!NetworkManager::Initialize())
+	{
+		cerr << "Failed to initialize networking!" << endl;
+		return false;
+	}
+
+	networkServer = make_unique<NetworkServer>();
 
 	// Register connection callbacks
-	// TODO: Set up callbacks when NetworkManager supports them
+	if(config.IsPipelined())
+	{
+		// These run on the network thread, so they only pass the events on.
+		networkServer->SetOnClientConnected([this](NetworkConnection &connection)
+			{ PushNetworkEvent(NetworkEvent::Type::CONNECTED, connection.GetConnectionId()); });
+		networkServer->SetOnClientDisconnected([this](NetworkConnection &connection)
+			{ PushNetworkEvent(NetworkEvent::Type::DISCONNECTED, connection.GetConnectionId()); });
+		networkServer->SetOnPacketReceived([this](NetworkConnection &connection, const uint8_t *data, size_t size)
+			{ PushNetworkEvent(NetworkEvent::Type::PACKET, connection.GetConnectionId(), data, size); });
+	}
+	else
+	{
+		networkServer->SetOnClientConnected([this](NetworkConnection &connection)
+			{ OnClientConnected(connection.GetConnectionId()); });
+		networkServer->SetOnClientDisconnected([this](NetworkConnection &connection)
+			{ OnClientDisconnected(connection.GetConnectionId()); });
+		networkServer->SetOnPacketReceived([this](NetworkConnection &connection, const uint8_t *data, size_t size)
+			{ OnPacketReceived(connection.GetConnectionId(), data, size); });
+	}
 
 	return true;
 }
@@ -296,6 +365,7 @@ bool Server::InitializeSubsystems()
 
 	// Create snapshot manager
 	snapshotManager = make_unique<SnapshotManager>(config.GetSnapshotHistorySize());
+	snapshotManager->SetQuantized(config.IsWorldStateQuantized());
 
 	// Create server loop
 	serverLoop = make_unique<ServerLoop>(config.GetSimulationHz(), config.GetBroadcastHz());
@@ -307,14 +377,22 @@ bool Server::InitializeSubsystems()
 
 void Server::OnSimulationTick(uint64_t gameTick)
 {
+	auto start = chrono::steady_clock::now();
+
 	// Process player commands for this tick
 	ProcessCommands(gameTick);
 
 	// Simulate game world
 	SimulateGameTick();
+	UpdateAverage(stageTimings.simulation, MillisecondsSince(start));
+
+	// A pipelined broadcast may still be encoding the previous snapshot.
+	FinishBroadcast();
 
 	// Create snapshot for history
+	start = chrono::steady_clock::now();
 	snapshotManager->CreateSnapshot(*gameState, gameTick);
+	UpdateAverage(stageTimings.snapshot, MillisecondsSince(start));
 }
 
 
@@ -329,20 +407,161 @@ void Server::OnBroadcastTick(uint64_t gameTick)
 
 void Server::OnProcessInput()
 {
-	// Process network input (non-blocking)
-	if(networkManager)
+	auto start = chrono::steady_clock::now();
+
+	if(config.IsPipelined())
 	{
-		// Poll for new connections, disconnections, and packets
-		// This would call OnClientConnected, OnClientDisconnected, OnClientCommand
-		// TODO: Implement when NetworkManager supports event polling
+		// Handle what the network thread has received.
+		while(NetworkEvent *event = inboundEvents.Front())
+		{
+			if(event->type == NetworkEvent::Type::CONNECTED)
+				OnClientConnected(event->connectionId);
+			else if(event->type == NetworkEvent::Type::DISCONNECTED)
+				OnClientDisconnected(event->connectionId);
+			else if(event->type == NetworkEvent::Type::STATISTICS)
+				OnConnectionStatistics(event->connectionId, event->roundTripTime, event->packetLoss);
+			else
+				OnPacketReceived(event->connectionId, event->data.data(), event->data.size());
+			inboundEvents.Pop();
+		}
 	}
+	// Process network input (non-blocking). This dispatches to
+	// OnClientConnected, OnClientDisconnected and OnPacketReceived.
+	else if(networkServer)
+	{
+		networkServer->Update();
+		CollectConnectionStatistics(false);
+	}
+
+	UpdateAverage(stageTimings.input, MillisecondsSince(start));
 }
 
 
 
-void Server::OnClientConnected(size_t clientId)
+void Server::NetworkThreadLoop()
 {
-	cout << "Client connected: " << clientId << endl;
+	// Waiting inside ENet rather than sleeping means packets are handled as
+	// soon as they arrive, and queued packets go out within a millisecond.
+	while(networkThreadRunning)
+	{
+		networkServer->Service(1);
+		CollectConnectionStatistics(true);
+	}
+}
+
+
+
+void Server::PushNetworkEvent(NetworkEvent::Type type, uint32_t connectionId, const uint8_t *data, size_t size)
+{
+	NetworkEvent *event = AcquireNetworkEvent();
+	if(!event)
+		return;
+
+	// The slot keeps its buffer from the last packet it held.
+	event->type = type;
+	event->connectionId = connectionId;
+	event->data.assign(data, data + size);
+	inboundEvents.Publish();
+}
+
+
+
+Server::NetworkEvent *Server::AcquireNetworkEvent()
+{
+	// If the main thread falls behind, wait for it rather than drop events.
+	NetworkEvent *event = inboundEvents.Acquire();
+	while(!event && networkThreadRunning)
+	{
+		this_thread::yield();
+		event = inboundEvents.Acquire();
+	}
+	return event;
+}
+
+
+
+void Server::CollectConnectionStatistics(bool queue)
+{
+	auto now = chrono::steady_clock::now();
+	if(now - lastConnectionStatistics < chrono::milliseconds(NetworkConstants::PING_INTERVAL_MS))
+		return;
+	lastConnectionStatistics = now;
+
+	for(const auto &connection : networkServer->GetConnections())
+	{
+		if(!queue)
+		{
+			OnConnectionStatistics(connection->GetConnectionId(), connection->GetRoundTripTime(),
+				connection->GetPacketLossPercent());
+			continue;
+		}
+
+		NetworkEvent *event = AcquireNetworkEvent();
+		if(!event)
+			return;
+		event->type = NetworkEvent::Type::STATISTICS;
+		event->connectionId = connection->GetConnectionId();
+		event->data.clear();
+		event->roundTripTime = connection->GetRoundTripTime();
+		event->packetLoss = connection->GetPacketLossPercent();
+		inboundEvents.Publish();
+	}
+}
+
+
+
+void Server::FinishBroadcast()
+{
+	if(broadcastTask.valid())
+	{
+		auto start = chrono::steady_clock::now();
+		broadcastTask.wait();
+		broadcastTask = shared_future<void>();
+		UpdateAverage(stageTimings.broadcastWait, MillisecondsSince(start));
+	}
+	if(!broadcastPending)
+		return;
+	broadcastPending = false;
+
+	UpdateAverage(stageTimings.broadcast, broadcastTime);
+	totalWorldStateBytes += broadcastBytes;
+	totalWorldStatePackets += broadcastPackets;
+	totalWorldStateEncodes += broadcastEncodes;
+	totalWorldStateDeferred += broadcastDeferred;
+
+	// Charge the clients' budgets for what they were sent.
+	for(const auto &charge : broadcastCharges)
+	{
+		auto it = clientBudgets.find(charge.first);
+		if(it != clientBudgets.end())
+			it->second.Consume(charge.second);
+	}
+
+	if(config.IsVerboseLogging())
+	{
+		cout << "Broadcast state at tick " << broadcastTick << " (" << broadcastBytes << " bytes in "
+			<< broadcastPackets << " packets, " << broadcastEncodes << " distinct, "
+			<< broadcastDeferred << " held back, "
+			<< snapshotManager->GetFragmentCount() << " entity fragments, "
+			<< broadcastTime << " ms)" << endl;
+	}
+}
+
+
+
+void Server::OnClientConnected(uint32_t connectionId)
+{
+	cout << "Client connected: " << connectionId << endl;
+	clientIds.push_back(connectionId);
+	clientBudgets.emplace(connectionId, BandwidthBudget(config.GetClientBandwidth(), config.GetBroadcastHz()));
+	if(config.HasShipUpdates())
+	{
+		// The player gets a fresh UUID; their interest moves to their first
+		// ship once they have one.
+		ShipUpdateClient &client = shipUpdateClients.try_emplace(connectionId,
+			BandwidthBudget(config.GetClientBandwidth(), config.GetBroadcastHz())).first->second;
+		interestManager.SetPlayerInterestCenter(client.player, Point());
+	}
 
 	// Create new player
 	// TODO: Create NetworkPlayer and add to PlayerManager
@@ -351,9 +570,20 @@ void Server::OnClientConnected(size_t clientId)
 
 
 
-void Server::OnClientDisconnected(size_t clientId)
+void Server::OnClientDisconnected(uint32_t connectionId)
 {
-	cout << "Client disconnected: " << clientId << endl;
+	cout << "Client disconnected: " << connectionId << endl;
+	clientIds.erase(remove(clientIds.begin(), clientIds.end(), connectionId), clientIds.end());
+	clientBudgets.erase(connectionId);
+	auto shipUpdates = shipUpdateClients.find(connectionId);
+	if(shipUpdates != shipUpdateClients.end())
+	{
+		interestManager.RemovePlayer(shipUpdates->second.player);
+		shipUpdateClients.erase(shipUpdates);
+	}
+
+	// Forget the client's delta baseline
+	snapshotManager->RemoveClient(connectionId);
 
 	// Remove player
 	// TODO: Remove from PlayerManager
@@ -362,7 +592,28 @@ void Server::OnClientDisconnected(size_t clientId)
 
 
 
-void Server::OnClientCommand(size_t clientId, const vector<uint8_t> &data)
+void Server::OnPacketReceived(uint32_t connectionId, const uint8_t *data, size_t size)
+{
+	PacketReader reader(data, size);
+	if(!reader.IsValid())
+		return;
+
+	switch(reader.GetPacketType())
+	{
+		case NetworkPacket::PacketType::CLIENT_COMMAND:
+			OnClientCommand(connectionId, reader);
+			break;
+		case NetworkPacket::PacketType::CLIENT_SNAPSHOT_ACK:
+			OnSnapshotAck(connectionId, reader);
+			break;
+		default:
+			break;
+	}
+}
+
+
+
+void Server::OnClientCommand(uint32_t connectionId, PacketReader &reader)
 {
 	// Deserialize command from packet data
 	// TODO: Use PacketReader to deserialize PlayerCommand
@@ -372,6 +623,28 @@ void Server::OnClientCommand(size_t clientId, const vector<uint8_t> &data)
 
 
 
+void Server::OnSnapshotAck(uint32_t connectionId, PacketReader &reader)
+{
+	// The acknowledged snapshot becomes the baseline for this client's deltas
+	uint64_t ackedTick = reader.ReadUint64();
+	if(!reader.HasError())
+		snapshotManager->AcknowledgeSnapshot(connectionId, ackedTick);
+}
+
+
+
+void Server::OnConnectionStatistics(uint32_t connectionId, uint32_t roundTripTime, float packetLoss)
+{
+	auto it = clientBudgets.find(connectionId);
+	if(it != clientBudgets.end())
+		it->second.SetNetworkConditions(roundTripTime, packetLoss);
+	auto shipUpdates = shipUpdateClients.find(connectionId);
+	if(shipUpdates != shipUpdateClients.end())
+		shipUpdates->second.scheduler.GetBudget().SetNetworkConditions(roundTripTime, packetLoss);
+}
+
+
+
 void Server::ProcessCommands(uint64_t gameTick)
 {
 	// Get all commands for this tick
@@ -418,19 +691,156 @@ void Server::SimulateGameTick()
 
 void Server::BroadcastGameState()
 {
-	// Get latest snapshot
-	const auto *snapshot = snapshotManager->GetLatestSnapshot();
-	if(!snapshot)
+	if(!networkServer)
 		return;
 
-	// TODO: Serialize snapshot to packet
-	// TODO: Broadcast to all connected clients via NetworkManager
-	// TODO: Use delta compression for bandwidth efficiency
+	// Only one broadcast may be in flight.
+	FinishBroadcast();
+	SendShipUpdates();
+
+	// Each client gets the latest snapshot delta-encoded against the last one
+	// it acknowledged. Look up the baselines now, since acknowledgements keep
+	// arriving while the packets are encoded.
+	broadcastRequests.resize(clientIds.size());
+	for(size_t i = 0; i < clientIds.size(); ++i)
+		broadcastRequests[i].clientId = clientIds[i];
+	shared_ptr<const WorldSnapshot> latest = snapshotManager->PrepareBroadcast(broadcastRequests);
+	if(!latest)
+		return;
 
-	if(config.IsVerboseLogging())
+	// Give each client this broadcast's share of its bandwidth. The broadcast
+	// works on copies, which FinishBroadcast() charges afterwards.
+	broadcastBudgets.resize(clientIds.size());
+	for(size_t i = 0; i < clientIds.size(); ++i)
+	{
+		BandwidthBudget &budget = clientBudgets[clientIds[i]];
+		budget.Refill();
+		broadcastBudgets[i] = budget;
+	}
+
+	broadcastTick = latest->gameTick;
+	broadcastPending = true;
+	if(config.IsPipelined())
+		broadcastTask = broadcastQueue.Run([this, latest]() { EncodeBroadcast(*latest, true); });
+	else
+	{
+		EncodeBroadcast(*latest, false);
+		FinishBroadcast();
+	}
+}
+
+
+
+void Server::EncodeBroadcast(const WorldSnapshot &latest, bool queue)
+{
+	auto start = chrono::steady_clock::now();
+	snapshotManager->BuildPackets(latest, broadcastRequests);
+
+	// Hold back packets a client's budget cannot cover yet. Its next packet
+	// will be encoded against the same baseline, so no change is lost.
+	broadcastCharges.clear();
+	broadcastDeferred = 0;
+	for(size_t i = 0; i < broadcastRequests.size(); ++i)
+	{
+		SnapshotManager::PacketRequest &request = broadcastRequests[i];
+		size_t size = request.packet->GetSize();
+		if(broadcastBudgets[i].CanSend(size))
+			broadcastCharges.emplace_back(request.clientId, size);
+		else
+		{
+			request.packet = nullptr;
+			++broadcastDeferred;
+		}
+	}
+
+	// Clients that acknowledged the same snapshot get the same packet, which
+	// is handed to the network once for all of them.
+	sort(broadcastRequests.begin(), broadcastRequests.end(),
+		[](const SnapshotManager::PacketRequest &a, const SnapshotManager::PacketRequest &b)
+			{ return less<const PacketWriter *>()(a.packet, b.packet); });
+
+	broadcastBytes = 0;
+	broadcastPackets = 0;
+	broadcastEncodes = 0;
+	for(auto it = broadcastRequests.begin(); it != broadcastRequests.end(); )
 	{
-		cout << "Broadcasting state at tick " << snapshot->gameTick
-			<< " (" << snapshot->compressedSize << " bytes)" << endl;
+		const PacketWriter *packet = it->packet;
+		broadcastRecipients.clear();
+		for( ; it != broadcastRequests.end() && it->packet == packet; ++it)
+			broadcastRecipients.push_back(it->clientId);
+		if(!packet)
+			continue;
+
+		size_t sent = broadcastRecipients.size();
+		if(queue)
+			networkServer->QueueToClients(broadcastRecipients, packet->GetDataPtr(), packet->GetSize(),
+				NetworkConstants::Channel::UNRELIABLE_SEQUENCED, false);
+		else
+			sent = networkServer->SendToClients(broadcastRecipients, packet->GetDataPtr(), packet->GetSize(),
+				NetworkConstants::Channel::UNRELIABLE_SEQUENCED, false);
+		broadcastBytes += sent * packet->GetSize();
+		broadcastPackets += sent;
+		++broadcastEncodes;
+	}
+	broadcastTime = MillisecondsSince(start);
+}
+
+
+
+void Server::SendShipUpdates()
+{
+	if(shipUpdateClients.empty())
+		return;
+
+	// Identify the ships by the network IDs of the snapshot just captured.
+	const EntityTracker &tracker = snapshotManager->GetEntityTracker();
+	interestEntities.clear();
+	for(const auto &ship : gameState->GetShips())
+		if(uint16_t id = tracker.FindShipId(*ship))
+			interestEntities.push_back({id, ship.get()});
+	sort(interestEntities.begin(), interestEntities.end(),
+		[](const InterestManager::Entity &a, const InterestManager::Entity &b) { return a.id < b.id; });
+
+	// Center each player's interest on the first of their ships the last
+	// update found, if it is still around.
+	for(auto &it : shipUpdateClients)
+	{
+		const EsUuid &player = it.second.player;
+		const InterestManager::Relevancy *relevancy = interestManager.GetRelevancy(player);
+		if(!relevancy)
+			continue;
+		auto own = find_if(relevancy->entities.begin(), relevancy->entities.end(),
+			[](const InterestManager::Relevant &entity) { return entity.own; });
+		if(own == relevancy->entities.end())
+			continue;
+		auto ship = lower_bound(interestEntities.begin(), interestEntities.end(), own->id,
+			[](const InterestManager::Entity &entity, uint16_t id) { return entity.id < id; });
+		if(ship != interestEntities.end() && ship->id == own->id)
+			interestManager.SetPlayerInterestCenter(player, ship->ship->Position());
+	}
+	interestManager.Update(interestEntities);
+	stateSync.SetCurrentTick(gameState->GetGameTick());
+
+	shipUpdateRecipient.resize(1);
+	for(auto &it : shipUpdateClients)
+	{
+		vector<StateSync::ShipUpdate> updates = stateSync.GetUpdatesForPlayer(it.second.player, it.second.scheduler);
+		if(updates.empty())
+			continue;
+
+		shipUpdatePacket.Reset(NetworkPacket::PacketType::SERVER_SHIP_UPDATE);
+		shipUpdatePacket.WriteUint16(static_cast<uint16_t>(updates.size()));
+		for(const StateSync::ShipUpdate &update : updates)
+			stateSync.WriteShipUpdate(shipUpdatePacket, update);
+
+		shipUpdateRecipient[0] = it.first;
+		if(config.IsPipelined())
+			networkServer->QueueToClients(shipUpdateRecipient, shipUpdatePacket.GetDataPtr(),
+				shipUpdatePacket.GetSize(), NetworkConstants::Channel::UNRELIABLE_SEQUENCED, false);
+		else
+			networkServer->SendToClients(shipUpdateRecipient, shipUpdatePacket.GetDataPtr(),
+				shipUpdatePacket.GetSize(), NetworkConstants::Channel::UNRELIABLE_SEQUENCED, false);
+		totalShipUpdateBytes += shipUpdatePacket.GetSize();
 	}
 }
 
@@ -455,6 +865,15 @@ void Server::HandleCommand_Status()
 	cout << "Commands Rejected: " << stats.totalCommandsRejected << endl;
 	cout << "Snapshots: " << stats.snapshotCount << " ("
 		<< (stats.snapshotMemoryUsage / 1024) << " KB)" << endl;
+	cout << "World State: " << (stats.totalWorldStateBytes / 1024) << " KB in " << stats.totalWorldStatePackets
+		<< " packets (" << stats.totalWorldStateEncodes << " encoded, " << stats.totalWorldStateDeferred
+		<< " held back)" << endl;
+	if(config.HasShipUpdates())
+		cout << "Ship Updates: " << (stats.totalShipUpdateBytes / 1024) << " KB" << endl;
+	cout << "Stage Times: input " << stats.stageTimings.input << " ms, simulation "
+		<< stats.stageTimings.simulation << " ms, snapshot " << stats.stageTimings.snapshot
+		<< " ms, broadcast " << stats.stageTimings.broadcast << " ms (waited "
+		<< stats.stageTimings.broadcastWait << " ms)" << endl;
 	cout << endl;
 }
 
@@ -16,19 +16,35 @@
 #pragma once
 
 #include "ServerConfig.h"
+#include "SnapshotManager.h"
+#include "SpscQueue.h"
+#include "../EsUuid.h"
+#include "../TaskQueue.h"
+#include "../multiplayer/InterestManager.h"
+#include "../multiplayer/SendScheduler.h"
+#include "../multiplayer/StateSync.h"
+#include "../network/BandwidthBudget.h"
+#include "../network/PacketWriter.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <map>
 #include <memory>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 class GameState;
-class NetworkManager;
+class NetworkConnection;
+class NetworkServer;
+class PacketReader;
 class PlayerManager;
 class CommandBuffer;
 class CommandValidator;
-class SnapshotManager;
 class ServerLoop;
-class EsUuid;
 
 
 // Server: Main dedicated server class
@@ -44,7 +60,7 @@ class EsUuid;
 // Architecture:
 //   Server
 //   ├── ServerConfig (configuration)
-//   ├── NetworkManager (ENet networking)
+//   ├── NetworkServer (ENet networking)
 //   ├── PlayerManager (player tracking)
 //   ├── CommandBuffer (input queue)
 //   ├── CommandValidator (validation + rate limiting)
@@ -60,8 +76,36 @@ class EsUuid;
 //
 // Thread Safety:
 // - Main simulation runs on single thread (deterministic)
-// - Network I/O may use separate threads (ENet)
 // - Commands are queued and processed on simulation thread
+//
+// Pipelined Mode (ServerConfig::IsPipelined):
+// - A network thread owns ENet. It hands connection events and received
+//   packets to the main thread through a lock-free queue, and sends the
+//   packets other threads queue with NetworkServer::QueueToClients().
+// - The main thread drains that queue (commands go to the CommandBuffer),
+//   runs the simulation and creates snapshots.
+// - The world state packets for a snapshot are encoded on a TaskQueue
+//   worker while the main thread simulates the next tick; the main thread
+//   only waits for them before creating the next snapshot.
+// Statistics::stageTimings shows how long each stage takes, and how long
+// the main thread waited for the broadcast.
+//
+// Bandwidth (ServerConfig::GetClientBandwidth):
+// - Each client has a BandwidthBudget, scaled down when its measured round
+//   trip time or packet loss shows the connection is struggling.
+// - A world state packet the budget cannot cover yet is held back. The
+//   client's next packet is encoded against the same baseline, so it still
+//   carries every change; a slow client gets fewer, larger updates instead of
+//   a backlog.
+//
+// Ship Updates (ServerConfig::HasShipUpdates):
+// - Each client is given a player, whose interest follows their first ship.
+// - Every broadcast, the InterestManager advances each player's relevancy
+//   set, and StateSync turns it into the ship updates that are due, fitted
+//   into the client's SendScheduler budget (own ships and their targets
+//   first). They go out as one SERVER_SHIP_UPDATE packet per client.
+// - Ships are identified by the network IDs the world state uses. The updates
+//   read the live ships, so they are built on the main thread.
 class Server {
 public:
 	Server();
@@ -92,6 +136,16 @@ public:
 	// Get connected player count
 	size_t GetPlayerCount() const;
 
+	// Average time spent in each stage of a tick (milliseconds, exponential
+	// moving averages)
+	struct StageTimings {
+		double input = 0.0;          // Receiving network events (or draining the inbound queue)
+		double simulation = 0.0;     // Commands and game simulation
+		double snapshot = 0.0;       // Capturing the world state
+		double broadcast = 0.0;      // Encoding and sending world state
+		double broadcastWait = 0.0;  // Main thread waiting for a pipelined broadcast
+	};
+
 	// Statistics
 	struct Statistics {
 		uint64_t totalTicks = 0;
@@ -104,6 +158,13 @@ public:
 		double averageTickTime = 0.0;
 		size_t snapshotCount = 0;
 		size_t snapshotMemoryUsage = 0;
+		double snapshotCompressionRatio = 1.0;   // Delta bytes / keyframe bytes
+		uint64_t totalWorldStateBytes = 0;       // Bytes of world state sent to all clients
+		uint64_t totalWorldStatePackets = 0;     // World state packets sent to all clients
+		uint64_t totalWorldStateEncodes = 0;     // Distinct world state packets built
+		uint64_t totalWorldStateDeferred = 0;    // World state packets held back by a client's budget
+		uint64_t totalShipUpdateBytes = 0;       // Bytes of ship updates sent to all clients
+		StageTimings stageTimings;
 	};
 
 	Statistics GetStatistics() const;
@@ -124,7 +185,7 @@ private:
 
 	// Core subsystems
 	std::unique_ptr<GameState> gameState;
-	std::unique_ptr<NetworkManager> networkManager;
+	std::unique_ptr<NetworkServer> networkServer;
 	std::unique_ptr<PlayerManager> playerManager;
 	std::unique_ptr<CommandBuffer> commandBuffer;
 	std::unique_ptr<CommandValidator> commandValidator;
@@ -138,6 +199,70 @@ private:
 	// Statistics
 	uint64_t totalCommandsProcessed = 0;
 	uint64_t totalCommandsRejected = 0;
+	uint64_t totalWorldStateBytes = 0;
+	uint64_t totalWorldStatePackets = 0;
+	uint64_t totalWorldStateEncodes = 0;
+	uint64_t totalWorldStateDeferred = 0;
+	uint64_t totalShipUpdateBytes = 0;
+	StageTimings stageTimings;
+
+	// A connection event or received packet, passed from the network thread
+	// to the main thread in pipelined mode.
+	struct NetworkEvent {
+		enum class Type : uint8_t { CONNECTED, DISCONNECTED, PACKET, STATISTICS };
+
+		Type type = Type::PACKET;
+		uint32_t connectionId = 0;
+		std::vector<uint8_t> data;
+		// Connection quality (STATISTICS only)
+		uint32_t roundTripTime = 0;
+		float packetLoss = 0.f;
+	};
+
+	// Connected clients, as seen by the main thread
+	std::vector<uint32_t> clientIds;
+	// World state byte budget of each client (main thread)
+	std::map<uint32_t, BandwidthBudget> clientBudgets;
+	// A client's player, and the scheduler that fits its ship updates into a
+	// budget of their own (main thread). Copying an EsUuid leaves it blank, so
+	// these are only ever constructed in place.
+	struct ShipUpdateClient {
+		explicit ShipUpdateClient(const BandwidthBudget &budget) : scheduler(budget) {}
+
+		EsUuid player;
+		SendScheduler scheduler;
+	};
+	std::map<uint32_t, ShipUpdateClient> shipUpdateClients;
+	InterestManager interestManager;
+	StateSync stateSync;
+	// Scratch space reused between broadcasts
+	std::vector<InterestManager::Entity> interestEntities;
+	std::vector<uint32_t> shipUpdateRecipient;
+	PacketWriter shipUpdatePacket;
+	// When connection statistics were last collected (thread that owns ENet)
+	std::chrono::steady_clock::time_point lastConnectionStatistics;
+
+	// Pipelined mode
+	SpscQueue<NetworkEvent> inboundEvents;
+	std::thread networkThread;
+	std::atomic<bool> networkThreadRunning = false;
+	TaskQueue broadcastQueue;
+	std::shared_future<void> broadcastTask;
+	// The current broadcast. Results are written by the broadcast task and
+	// read by FinishBroadcast().
+	bool broadcastPending = false;
+	uint64_t broadcastTick = 0;
+	std::vector<SnapshotManager::PacketRequest> broadcastRequests;
+	// Copies of the clients' budgets, in request order, and the bytes each
+	// client was sent
+	std::vector<BandwidthBudget> broadcastBudgets;
+	std::vector<std::pair<uint32_t, size_t>> broadcastCharges;
+	std::vector<uint32_t> broadcastRecipients;
+	size_t broadcastBytes = 0;
+	size_t broadcastPackets = 0;
+	size_t broadcastEncodes = 0;
+	size_t broadcastDeferred = 0;
+	double broadcastTime = 0.0;
 
 	// Initialization helpers
 	bool InitializeNetwork();
@@ -149,15 +274,40 @@ private:
 	void OnBroadcastTick(uint64_t gameTick);
 	void OnProcessInput();
 
-	// Network event handlers
-	void OnClientConnected(size_t clientId);
-	void OnClientDisconnected(size_t clientId);
-	void OnClientCommand(size_t clientId, const std::vector<uint8_t> &data);
+	// Pipelined mode
+	void NetworkThreadLoop();
+	// Queue a network event for the main thread (network thread only)
+	void PushNetworkEvent(NetworkEvent::Type type, uint32_t connectionId, const uint8_t *data = nullptr,
+		size_t size = 0);
+	// Get a free slot in the inbound queue, waiting if it is full. Returns
+	// nullptr if the network thread is stopping.
+	NetworkEvent *AcquireNetworkEvent();
+	// Pass each connection's round trip time and packet loss to the main
+	// thread (or, if not queueing, straight to OnConnectionStatistics()), at
+	// most once per ping interval. Call from the thread that owns ENet.
+	void CollectConnectionStatistics(bool queue);
+	// Wait for the broadcast task, if any, and record its results
+	void FinishBroadcast();
+
+	// Network event handlers (main thread)
+	void OnClientConnected(uint32_t connectionId);
+	void OnClientDisconnected(uint32_t connectionId);
+	void OnPacketReceived(uint32_t connectionId, const uint8_t *data, size_t size);
+	void OnClientCommand(uint32_t connectionId, PacketReader &reader);
+	void OnSnapshotAck(uint32_t connectionId, PacketReader &reader);
+	void OnConnectionStatistics(uint32_t connectionId, uint32_t roundTripTime, float packetLoss);
 
 	// Game logic
 	void ProcessCommands(uint64_t gameTick);
 	void SimulateGameTick();
 	void BroadcastGameState();
+	// Build the packets of the broadcast started by BroadcastGameState() and
+	// send them, or queue them for the network thread (on a TaskQueue worker,
+	// in pipelined mode)
+	void EncodeBroadcast(const WorldSnapshot &latest, bool queue);
+	// Advance the players' interest and send each client the ship updates that
+	// are due and fit its budget (main thread)
+	void SendShipUpdates();
 
 	// Console command handlers
 	void HandleCommand_Status();
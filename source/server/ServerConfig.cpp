@@ -64,6 +64,8 @@ bool ServerConfig::LoadFromFile(const string &filename)
 			maxPlayers = stoul(value);
 		else if(key == "max_connections_per_ip")
 			maxConnectionsPerIP = stoul(value);
+		else if(key == "client_bandwidth")
+			clientBandwidth = stoul(value);
 		else if(key == "simulation_hz")
 			simulationHz = stoul(value);
 		else if(key == "broadcast_hz")
@@ -86,6 +88,12 @@ bool ServerConfig::LoadFromFile(const string &filename)
 			snapshotHistorySize = stoul(value);
 		else if(key == "command_buffer_size")
 			commandBufferSize = stoul(value);
+		else if(key == "quantize_world_state")
+			quantizeWorldState = (value == "true" || value == "1");
+		else if(key == "pipelined")
+			pipelined = (value == "true" || value == "1");
+		else if(key == "ship_updates")
+			shipUpdates = (value == "true" || value == "1");
 		else if(key == "verbose_logging")
 			verboseLogging = (value == "true" || value == "1");
 		else if(key == "enable_console")
@@ -108,7 +116,8 @@ bool ServerConfig::SaveToFile(const string &filename) const
 	file << "# Network Settings\n";
 	file << "port = " << port << "\n";
 	file << "max_players = " << maxPlayers << "\n";
-	file << "max_connections_per_ip = " << maxConnectionsPerIP << "\n\n";
+	file << "max_connections_per_ip = " << maxConnectionsPerIP << "\n";
+	file << "client_bandwidth = " << clientBandwidth << "\n\n";
 
 	file << "# Simulation Timing\n";
 	file << "simulation_hz = " << simulationHz << "\n";
@@ -127,7 +136,10 @@ bool ServerConfig::SaveToFile(const string &filename) const
 
 	file << "# Performance Tuning\n";
 	file << "snapshot_history_size = " << snapshotHistorySize << "\n";
-	file << "command_buffer_size = " << commandBufferSize << "\n\n";
+	file << "command_buffer_size = " << commandBufferSize << "\n";
+	file << "quantize_world_state = " << (quantizeWorldState ? "true" : "false") << "\n";
+	file << "pipelined = " << (pipelined ? "true" : "false") << "\n";
+	file << "ship_updates = " << (shipUpdates ? "true" : "false") << "\n\n";
 
 	file << "# Logging and Debugging\n";
 	file << "verbose_logging = " << (verboseLogging ? "true" : "false") << "\n";
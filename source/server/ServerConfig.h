@@ -15,6 +15,8 @@
 
 #pragma once
 
+#include "../network/NetworkConstants.h"
+
 #include <cstdint>
 #include <string>
 
@@ -53,6 +55,10 @@ public:
 	uint32_t GetMaxConnectionsPerIP() const { return maxConnectionsPerIP; }
 	void SetMaxConnectionsPerIP(uint32_t value) { maxConnectionsPerIP = value; }
 
+	// World state bytes per second each client may be sent (0 = unlimited)
+	uint32_t GetClientBandwidth() const { return clientBandwidth; }
+	void SetClientBandwidth(uint32_t value) { clientBandwidth = value; }
+
 	// Simulation timing
 	uint32_t GetSimulationHz() const { return simulationHz; }
 	void SetSimulationHz(uint32_t value) { simulationHz = value; }
@@ -91,6 +97,19 @@ public:
 	uint32_t GetCommandBufferSize() const { return commandBufferSize; }
 	void SetCommandBufferSize(uint32_t value) { commandBufferSize = value; }
 
+	bool IsWorldStateQuantized() const { return quantizeWorldState; }
+	void SetWorldStateQuantized(bool value) { quantizeWorldState = value; }
+
+	// Run network I/O on its own thread and encode broadcasts alongside the
+	// next tick's simulation (see Server)
+	bool IsPipelined() const { return pipelined; }
+	void SetPipelined(bool value) { pipelined = value; }
+
+	// Also send each client interest-managed SERVER_SHIP_UPDATE packets for
+	// the ships around its player, within a budget of their own (see Server)
+	bool HasShipUpdates() const { return shipUpdates; }
+	void SetShipUpdates(bool value) { shipUpdates = value; }
+
 	// Logging and debugging
 	bool IsVerboseLogging() const { return verboseLogging; }
 	void SetVerboseLogging(bool value) { verboseLogging = value; }
@@ -104,6 +123,7 @@ private:
 	uint16_t port = 31337;                      // Default port
 	uint32_t maxPlayers = 32;                   // Maximum concurrent players
 	uint32_t maxConnectionsPerIP = 3;           // Prevent IP flooding
+	uint32_t clientBandwidth = NetworkConstants::RECOMMENDED_DOWNLOAD;  // Bytes/second per client
 
 	// Simulation timing
 	uint32_t simulationHz = 60;                 // Server tick rate (60 FPS)
@@ -123,6 +143,9 @@ private:
 	// Performance tuning
 	uint32_t snapshotHistorySize = 120;         // 2 seconds at 60 Hz
 	uint32_t commandBufferSize = 10000;         // Max buffered commands
+	bool quantizeWorldState = true;             // Fixed-point world state packets
+	bool pipelined = false;                     // Threaded network I/O and broadcast
+	bool shipUpdates = false;                   // Interest-managed ship updates
 
 	// Logging and debugging
 	bool verboseLogging = false;                // Detailed logs
@@ -139,12 +139,12 @@ void ServerLoop::ProcessSimulation()
 {
 	auto tickStart = high_resolution_clock::now();
 
-	// Run simulation callback
+	// Advance the tick counter first, so that the callback and GetGameTick()
+	// agree on the number of the tick being simulated.
+	++gameTick;
 	if(simulationCallback)
 		simulationCallback(gameTick);
 
-	// Increment tick counter
-	++gameTick;
 	++totalSimulationTicks;
 	++ticksSinceLastStats;
 
@@ -83,6 +83,7 @@ void PrintUsage(const char *programName)
 	cout << "  --name <name>      Server name" << endl;
 	cout << "  --max-players <n>  Maximum players (default: 32)" << endl;
 	cout << "  --no-console       Disable console interface" << endl;
+	cout << "  --pipelined        Run network I/O and broadcasts on worker threads" << endl;
 	cout << "  --help             Show this help" << endl;
 	cout << endl;
 }
@@ -101,6 +102,7 @@ int main(int argc, char *argv[])
 	ServerConfig config;
 	string configFile;
 	bool enableConsole = true;
+	bool pipelined = false;
 
 	for(int i = 1; i < argc; ++i)
 	{
@@ -131,6 +133,10 @@ int main(int argc, char *argv[])
 		{
 			enableConsole = false;
 		}
+		else if(arg == "--pipelined")
+		{
+			pipelined = true;
+		}
 		else
 		{
 			cerr << "Unknown argument: " << arg << endl;
@@ -151,6 +157,8 @@ int main(int argc, char *argv[])
 
 	// Override console setting
 	config.SetConsoleEnabled(enableConsole);
+	if(pipelined)
+		config.SetPipelined(true);
 
 	// Validate configuration
 	if(!config.IsValid())
@@ -17,16 +17,17 @@
 
 #include "../GameState.h"
 
-#include <chrono>
 #include <algorithm>
+#include <chrono>
+#include <set>
 
 using namespace std;
 
 
 
 // Snapshot implementation
-Snapshot::Snapshot(uint64_t tick, shared_ptr<GameState> gameState)
-	: gameTick(tick), state(gameState)
+Snapshot::Snapshot(uint64_t tick)
+	: gameTick(tick)
 {
 	// Record timestamp
 	auto now = chrono::system_clock::now();
@@ -37,7 +38,8 @@ Snapshot::Snapshot(uint64_t tick, shared_ptr<GameState> gameState)
 
 // SnapshotManager implementation
 SnapshotManager::SnapshotManager(size_t historySize)
-	: historySize(historySize)
+	: ring(max<size_t>(historySize, 1)), historySize(max<size_t>(historySize, 1)), tracker(historySize),
+	encoder(&tracker), scratch(NetworkPacket::PacketType::SERVER_WORLD_STATE)
 {
 }
 
@@ -45,29 +47,24 @@ SnapshotManager::SnapshotManager(size_t historySize)
 
 void SnapshotManager::CreateSnapshot(const GameState &currentState, uint64_t gameTick, bool forceKeyframe)
 {
-	// Check if we should create a keyframe
-	bool isKeyframe = forceKeyframe || ShouldCreateKeyframe();
-
-	// Create snapshot
-	auto state = make_shared<GameState>(currentState);
-	Snapshot snapshot(gameTick, state);
-	snapshot.isKeyframe = isKeyframe;
-
-	// Estimate sizes
-	size_t uncompressedSize = EstimateSnapshotSize(currentState);
-	size_t compressedSize = uncompressedSize;
-
-	// Calculate delta compression if not a keyframe
-	if(!isKeyframe && !snapshots.empty())
+	// Ticks only move forward; an earlier tick means the game was restarted.
+	if(snapshotCount && gameTick < latestTick)
 	{
-		const auto &previousState = snapshots.back().state;
-		if(previousState)
-			compressedSize = CalculateDelta(*previousState, currentState);
+		for(Snapshot &slot : ring)
+			ClearSlot(slot);
+		pinned.clear();
 	}
 
-	snapshot.compressedSize = compressedSize;
+	// Check if we should create a keyframe. The first snapshot always is one,
+	// since there is nothing to encode it against.
+	const Snapshot *latest = GetLatestSnapshot();
+	bool isKeyframe = forceKeyframe || !latest || ShouldCreateKeyframe();
+
+	// Hold on to the previous snapshot's world while slots are cleared, so
+	// that it cannot become the spare the new snapshot is captured into.
+	shared_ptr<const WorldSnapshot> previous = latest ? latest->world : nullptr;
 
-	// Update statistics
+	// Update statistics. Encoded sizes are recorded as packets are built.
 	++totalSnapshots;
 	if(isKeyframe)
 	{
@@ -77,40 +74,53 @@ void SnapshotManager::CreateSnapshot(const GameState &currentState, uint64_t gam
 	else
 		++snapshotsSinceLastKeyframe;
 
-	totalUncompressedBytes += uncompressedSize;
-	totalCompressedBytes += compressedSize;
-
-	// Add to history
-	snapshots.push_back(snapshot);
-
-	// Prune if exceeds history size
-	while(snapshots.size() > historySize)
-		snapshots.pop_front();
+	// Ticks skipped since the latest snapshot have no snapshot, so clear
+	// whatever older snapshots their slots hold. The slot for this tick holds
+	// either nothing or the snapshot that is leaving the history.
+	if(snapshotCount && gameTick > latestTick)
+	{
+		uint64_t skipped = min<uint64_t>(gameTick - latestTick - 1, ring.size());
+		for(uint64_t i = 1; i <= skipped; ++i)
+			ClearSlot(GetSlot(latestTick + i));
+	}
+	Snapshot &slot = GetSlot(gameTick);
+	ClearSlot(slot);
+
+	// Capture the new snapshot, sharing unchanged records with the previous
+	// one, into the storage of one that left the history if there is one.
+	shared_ptr<WorldSnapshot> world = std::move(spareWorld);
+	if(!world)
+		world = make_shared<WorldSnapshot>();
+	world->Capture(currentState, tracker, previous.get());
+
+	slot = Snapshot(gameTick);
+	slot.isKeyframe = isKeyframe;
+	slot.world = std::move(world);
+	++snapshotCount;
+	latestTick = gameTick;
 }
 
 
 
 const Snapshot *SnapshotManager::GetLatestSnapshot() const
 {
-	if(snapshots.empty())
+	if(!snapshotCount)
 		return nullptr;
-	return &snapshots.back();
+	return &GetSlot(latestTick);
 }
 
 
 
 const Snapshot *SnapshotManager::GetSnapshotAtTick(uint64_t gameTick) const
 {
-	// Binary search for tick
-	auto it = lower_bound(snapshots.begin(), snapshots.end(), gameTick,
-		[](const Snapshot &snap, uint64_t tick) {
-			return snap.gameTick < tick;
-		});
-
-	if(it != snapshots.end() && it->gameTick == gameTick)
-		return &(*it);
-
-	return nullptr;
+	// The slot may hold another tick's snapshot, or none.
+	const Snapshot &slot = GetSlot(gameTick);
+	if(slot.world && slot.gameTick == gameTick)
+		return &slot;
+
+	// Clients' baselines are kept after they leave the history.
+	auto it = pinned.find(gameTick);
+	return it == pinned.end() ? nullptr : &it->second;
 }
 
 
@@ -118,54 +128,167 @@ const Snapshot *SnapshotManager::GetSnapshotAtTick(uint64_t gameTick) const
 vector<const Snapshot *> SnapshotManager::GetSnapshotsSince(uint64_t gameTick) const
 {
 	vector<const Snapshot *> result;
+	GetSnapshotsSince(gameTick, result);
+	return result;
+}
 
-	for(const auto &snap : snapshots)
-	{
-		if(snap.gameTick > gameTick)
-			result.push_back(&snap);
-	}
 
-	return result;
+
+void SnapshotManager::GetSnapshotsSince(uint64_t gameTick, vector<const Snapshot *> &result) const
+{
+	result.clear();
+	if(!snapshotCount || gameTick >= latestTick)
+		return;
+
+	for(uint64_t tick = max(gameTick + 1, GetOldestTick()); tick <= latestTick; ++tick)
+		if(const Snapshot *snapshot = GetSnapshotAtTick(tick))
+			result.push_back(snapshot);
 }
 
 
 
-size_t SnapshotManager::CalculateDelta(const GameState &previous, const GameState &current) const
+size_t SnapshotManager::CalculateDelta(const WorldSnapshot &previous, const WorldSnapshot &current)
 {
-	// Simplified delta calculation
-	// In a full implementation, this would compare:
-	// - Ship positions/velocities (send only if changed > threshold)
-	// - Projectile lists (send spawns/destroys)
-	// - Visual effects (send new effects only)
-	// - Player states (send only changes)
+	return MeasureEncodedSize(&previous, current);
+}
+
+
+
+void SnapshotManager::AcknowledgeSnapshot(uint32_t clientId, uint64_t gameTick)
+{
+	// Acks may arrive out of order over the unreliable channel; never move a
+	// client's baseline backwards.
+	auto it = clientAcks.find(clientId);
+	if(it == clientAcks.end())
+		clientAcks.emplace(clientId, gameTick);
+	else if(gameTick > it->second)
+		it->second = gameTick;
+	else
+		return;
+	UpdateOldestBaseline();
+}
 
-	size_t deltaSize = 0;
 
-	// Header overhead
-	deltaSize += 32;  // Tick, timestamp, flags
 
-	// Ships: Assume ~30% of ships changed position significantly
-	size_t shipCount = current.GetShipCount();
-	size_t changedShips = shipCount * 30 / 100;
-	deltaSize += changedShips * 48;  // UUID + position + velocity + facing
+void SnapshotManager::RemoveClient(uint32_t clientId)
+{
+	if(clientAcks.erase(clientId))
+		UpdateOldestBaseline();
+}
+
+
+
+const Snapshot *SnapshotManager::GetClientBaseline(uint32_t clientId) const
+{
+	auto it = clientAcks.find(clientId);
+	if(it == clientAcks.end())
+		return nullptr;
+
+	const Snapshot *baseline = GetSnapshotAtTick(it->second);
+	return (baseline && baseline->world) ? baseline : nullptr;
+}
+
+
+
+size_t SnapshotManager::WriteSnapshotForClient(uint32_t clientId, PacketWriter &writer)
+{
+	const Snapshot *latest = GetLatestSnapshot();
+	if(!latest || !latest->world)
+		return 0;
+
+	const Snapshot *baseline = GetClientBaseline(clientId);
+	// A client that is already up to date still gets an (empty) delta, which
+	// doubles as a heartbeat carrying the current tick.
+	return encoder.Encode(baseline ? baseline->world.get() : nullptr, *latest->world, writer);
+}
+
+
+
+const PacketWriter *SnapshotManager::GetPacketForClient(uint32_t clientId)
+{
+	const Snapshot *latest = GetLatestSnapshot();
+	if(!latest || !latest->world)
+		return nullptr;
+
+	const Snapshot *baseline = GetClientBaseline(clientId);
+	return GetPacket(*latest->world, baseline ? baseline->world.get() : nullptr);
+}
+
+
+
+shared_ptr<const WorldSnapshot> SnapshotManager::PrepareBroadcast(vector<PacketRequest> &requests) const
+{
+	const Snapshot *latest = GetLatestSnapshot();
+	if(!latest || !latest->world)
+		return nullptr;
+
+	for(PacketRequest &request : requests)
+	{
+		const Snapshot *baseline = GetClientBaseline(request.clientId);
+		request.baseline = baseline ? baseline->world : nullptr;
+		request.packet = nullptr;
+	}
+	return latest->world;
+}
 
-	// Projectiles: Send all (short-lived, change frequently)
-	deltaSize += current.GetProjectileCount() * 32;  // Position + velocity + type
 
-	// Visuals: Send all new effects (temporary)
-	deltaSize += current.GetVisuals().size() * 24;
 
-	// Estimate compression: typical 60-80% reduction
-	return deltaSize * 3 / 10;  // 70% compression
+void SnapshotManager::BuildPackets(const WorldSnapshot &latest, vector<PacketRequest> &requests)
+{
+	for(PacketRequest &request : requests)
+		request.packet = GetPacket(latest, request.baseline.get());
 }
 
 
 
 void SnapshotManager::PruneOlderThan(uint64_t gameTick)
 {
+	// Keep every snapshot a client's delta baseline may refer to.
+	gameTick = min(gameTick, oldestBaselineTick);
+
 	// Remove snapshots older than specified tick
-	while(!snapshots.empty() && snapshots.front().gameTick < gameTick)
-		snapshots.pop_front();
+	if(!snapshotCount)
+		return;
+	for(uint64_t tick = GetOldestTick(); tick < gameTick && tick <= latestTick; ++tick)
+	{
+		Snapshot &slot = GetSlot(tick);
+		if(slot.gameTick == tick)
+			ClearSlot(slot);
+	}
+}
+
+
+
+void SnapshotManager::SetHistorySize(size_t size)
+{
+	size = max<size_t>(size, 1);
+	if(size != ring.size())
+	{
+		// Move the snapshots that still fit into a ring of the new size.
+		vector<Snapshot> resized(size);
+		size_t count = 0;
+		if(snapshotCount)
+			for(uint64_t tick = latestTick - min<uint64_t>(latestTick, size - 1); tick <= latestTick; ++tick)
+			{
+				Snapshot &slot = GetSlot(tick);
+				if(slot.world && slot.gameTick == tick)
+				{
+					resized[tick % size] = std::move(slot);
+					++count;
+				}
+			}
+		// Snapshots that no longer fit are dropped, unless they are baselines.
+		for(Snapshot &slot : ring)
+			if(slot.world && IsBaseline(slot.gameTick))
+				pinned.emplace(slot.gameTick, std::move(slot));
+		ring.swap(resized);
+		snapshotCount = count;
+	}
+
+	historySize = size;
+	// Network IDs must not be reused while a baseline that still refers to
+	// them could be in the history.
+	tracker.SetReuseDelay(size);
 }
 
 
@@ -174,17 +297,17 @@ size_t SnapshotManager::GetMemoryUsage() const
 {
 	size_t total = 0;
 
-	// Snapshot overhead
-	total += snapshots.size() * sizeof(Snapshot);
+	// Snapshot overhead (every slot is allocated up front)
+	total += ring.size() * sizeof(Snapshot);
 
-	// GameState memory (rough estimate)
-	// Each GameState contains:
-	// - std::list<shared_ptr<Ship>> (assume 10 ships avg, 1KB each)
-	// - std::list<Projectile> (assume 20 projectiles, 128 bytes each)
-	// - std::list<Visual> (assume 10 visuals, 64 bytes each)
-	// - Other metadata
-	size_t avgStateSize = 10 * 1024 + 20 * 128 + 10 * 64 + 256;
-	total += snapshots.size() * avgStateSize;
+	// Captured entity records. Consecutive snapshots share the storage of
+	// unchanged entities, which must only be counted once.
+	set<const void *> counted;
+	for(const Snapshot &snapshot : ring)
+		if(snapshot.world)
+			total += snapshot.world->GetMemoryUsage(&counted);
+	for(const auto &it : pinned)
+		total += sizeof(it.second) + it.second.world->GetMemoryUsage(&counted);
 
 	return total;
 }
@@ -193,10 +316,11 @@ size_t SnapshotManager::GetMemoryUsage() const
 
 double SnapshotManager::GetAverageCompressionRatio() const
 {
-	if(totalUncompressedBytes == 0)
+	uint64_t uncompressed = totalUncompressedBytes;
+	if(uncompressed == 0)
 		return 1.0;
 
-	return static_cast<double>(totalCompressedBytes) / totalUncompressedBytes;
+	return static_cast<double>(totalCompressedBytes) / uncompressed;
 }
 
 
@@ -209,27 +333,129 @@ bool SnapshotManager::ShouldCreateKeyframe() const
 
 
 
-size_t SnapshotManager::EstimateSnapshotSize(const GameState &state) const
+void SnapshotManager::ClearSlot(Snapshot &slot)
 {
-	size_t size = 0;
+	if(!slot.world)
+		return;
 
-	// Header
-	size += 32;
+	if(IsBaseline(slot.gameTick))
+		pinned.emplace(slot.gameTick, std::move(slot));
+	else if(slot.world.use_count() == 1)
+	{
+		// Worlds are only ever created by CreateSnapshot(), as non-const
+		// objects, and nothing else refers to this one.
+		spareWorld = const_pointer_cast<WorldSnapshot>(std::move(slot.world));
+	}
+	slot.world.reset();
+	--snapshotCount;
+}
 
-	// Ships (UUID + full state)
-	size += state.GetShipCount() * 128;
 
-	// Projectiles
-	size += state.GetProjectileCount() * 32;
 
-	// Visuals
-	size += state.GetVisuals().size() * 24;
+bool SnapshotManager::IsBaseline(uint64_t gameTick) const
+{
+	if(gameTick < oldestBaselineTick)
+		return false;
+	for(const auto &it : clientAcks)
+		if(it.second == gameTick)
+			return true;
+	return false;
+}
 
-	// Flotsam
-	size += state.GetFlotsam().size() * 64;
 
-	// Metadata
-	size += 64;
 
-	return size;
+uint64_t SnapshotManager::GetOldestTick() const
+{
+	return latestTick - min<uint64_t>(latestTick, ring.size() - 1);
+}
+
+
+
+void SnapshotManager::UpdateOldestBaseline()
+{
+	oldestBaselineTick = NO_BASELINE;
+	for(const auto &it : clientAcks)
+		oldestBaselineTick = min(oldestBaselineTick, it.second);
+
+	for(auto it = pinned.begin(); it != pinned.end(); )
+	{
+		if(IsBaseline(it->first))
+			++it;
+		else
+			it = pinned.erase(it);
+	}
+
+	// An ID released after a baseline was captured must not go to another
+	// entity while that baseline may still be used.
+	uint64_t oldestCapture = NO_BASELINE;
+	for(const auto &it : clientAcks)
+		if(const Snapshot *baseline = GetSnapshotAtTick(it.second))
+			oldestCapture = min(oldestCapture, baseline->world->captureIndex);
+	tracker.SetOldestBaseline(oldestCapture);
+}
+
+
+
+const PacketWriter *SnapshotManager::GetPacket(const WorldSnapshot &latest, const WorldSnapshot *baseline)
+{
+	// Start over when there is a new snapshot to send.
+	if(packetWorld != &latest || packetTick != latest.gameTick)
+	{
+		packetWorld = &latest;
+		packetTick = latest.gameTick;
+		packetsByBaseline.clear();
+	}
+
+	auto it = packetsByBaseline.find(baseline);
+	if(it != packetsByBaseline.end())
+		return &packetPool[it->second];
+
+	size_t index = packetsByBaseline.size();
+	if(index == packetPool.size())
+		packetPool.emplace_back(NetworkPacket::PacketType::SERVER_WORLD_STATE);
+	PacketWriter &writer = packetPool[index];
+	writer.Reset(NetworkPacket::PacketType::SERVER_WORLD_STATE);
+	RecordPacketSize(latest, baseline, encoder.Encode(baseline, latest, writer));
+	packetsByBaseline.emplace(baseline, index);
+	return &writer;
+}
+
+
+
+void SnapshotManager::RecordPacketSize(const WorldSnapshot &latest, const WorldSnapshot *baseline, size_t size)
+{
+	// Deltas are compared against the snapshot's size as a keyframe. If no
+	// client has needed a keyframe lately, measure one, but only once per
+	// keyframe interval rather than for every snapshot.
+	if(!baseline)
+	{
+		keyframeSize = size;
+		keyframeSizeTick = latest.gameTick;
+	}
+	else if(!keyframeSize || latest.gameTick < keyframeSizeTick
+			|| latest.gameTick - keyframeSizeTick >= max<uint32_t>(keyframeInterval, 1))
+	{
+		keyframeSize = MeasureEncodedSize(nullptr, latest);
+		keyframeSizeTick = latest.gameTick;
+	}
+	totalUncompressedBytes += keyframeSize;
+	totalCompressedBytes += size;
+
+	// The latest snapshot stays in its slot until the next one is created,
+	// which never happens while packets are being built.
+	Snapshot &slot = GetSlot(latest.gameTick);
+	if(slot.world.get() != &latest)
+		return;
+	if(keyframeSizeTick == latest.gameTick)
+		slot.uncompressedSize = keyframeSize;
+	if(baseline && (!slot.compressedSize || size < slot.compressedSize))
+		slot.compressedSize = size;
+}
+
+
+
+size_t SnapshotManager::MeasureEncodedSize(const WorldSnapshot *baseline, const WorldSnapshot &current)
+{
+	scratch.Reset(NetworkPacket::PacketType::SERVER_WORLD_STATE);
+	return encoder.Encode(baseline, current, scratch);
 }
@@ -15,8 +15,14 @@
 
 #pragma once
 
+#include "DeltaEncoder.h"
+#include "WorldSnapshot.h"
+#include "../network/PacketWriter.h"
+
+#include <atomic>
 #include <cstdint>
-#include <deque>
+#include <limits>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -27,12 +33,13 @@ class GameState;
 struct Snapshot {
 	uint64_t gameTick = 0;
 	uint64_t timestamp = 0;                     // System time (milliseconds)
-	std::shared_ptr<GameState> state;
-	size_t compressedSize = 0;                  // Size after delta compression
+	std::shared_ptr<const WorldSnapshot> world; // Networked entity records
+	size_t uncompressedSize = 0;                // Encoded size as a keyframe (bytes), 0 until measured
+	size_t compressedSize = 0;                  // Smallest delta built for this snapshot (bytes), 0 if none
 	bool isKeyframe = false;                    // Full state (no delta)
 
 	Snapshot() = default;
-	Snapshot(uint64_t tick, std::shared_ptr<GameState> gameState);
+	explicit Snapshot(uint64_t tick);
 };
 
 
@@ -48,12 +55,26 @@ struct Snapshot {
 // Delta Compression Strategy:
 // - Every Nth snapshot is a keyframe (full state)
 // - Other snapshots store only differences from previous
-// - Reduces network bandwidth by 80-90% for typical gameplay
+// - Each client is sent the latest snapshot encoded against the most recent
+//   snapshot it acknowledged, field by field (see DeltaEncoder)
+// - Clients without a usable baseline receive a keyframe
 //
 // Snapshot History:
 // - Keep last N snapshots (configurable, default 120 = 2 sec at 60 Hz)
 // - Enables client catchup and lag compensation
-// - Old snapshots automatically pruned
+// - Stored in a ring of N preallocated slots indexed by tick % N, so looking
+//   up a tick is O(1) and creating a snapshot reuses the oldest slot
+// - Old snapshots automatically pruned, except that PruneOlderThan() keeps
+//   every snapshot a client's baseline may still refer to
+// - A snapshot a client has acknowledged is never dropped while that client
+//   may still use it as its baseline: if its slot is needed, it is moved
+//   aside ("pinned") until every client has acknowledged something newer.
+//   Network IDs are not reused while such a baseline still refers to them.
+// - The world of a snapshot leaving the history is captured into again
+//   rather than freed, unless a broadcast still holds it
+// - Snapshots hold compact entity records rather than copies of the game
+//   state, and consecutive snapshots share the records of entities that did
+//   not change, so memory grows with the amount of change, not entity count
 class SnapshotManager {
 public:
 	explicit SnapshotManager(size_t historySize = 120);
@@ -69,30 +90,83 @@ public:
 	// Returns nullptr if not found (too old or doesn't exist)
 	const Snapshot *GetSnapshotAtTick(uint64_t gameTick) const;
 
-	// Get all snapshots since a specific tick (for client catchup)
+	// Get all snapshots since a specific tick (for client catchup), oldest
+	// first. The second form reuses the caller's vector.
 	std::vector<const Snapshot *> GetSnapshotsSince(uint64_t gameTick) const;
+	void GetSnapshotsSince(uint64_t gameTick, std::vector<const Snapshot *> &result) const;
 
 	// Calculate delta between two snapshots
-	// Returns estimated size of delta (for statistics)
-	size_t CalculateDelta(const GameState &previous, const GameState &current) const;
-
-	// Prune snapshots older than specified tick
+	// Returns the encoded size of the delta in bytes
+	size_t CalculateDelta(const WorldSnapshot &previous, const WorldSnapshot &current);
+
+	// Per-client baselines
+	// Record that a client has received the snapshot at the given tick.
+	void AcknowledgeSnapshot(uint32_t clientId, uint64_t gameTick);
+	void RemoveClient(uint32_t clientId);
+	// Get the snapshot a client last acknowledged, or nullptr if it has none
+	// that is still in the history.
+	const Snapshot *GetClientBaseline(uint32_t clientId) const;
+	// Get the oldest tick any client has acknowledged, or NO_BASELINE if no
+	// client has acknowledged one.
+	static constexpr uint64_t NO_BASELINE = std::numeric_limits<uint64_t>::max();
+	uint64_t GetOldestBaselineTick() const { return oldestBaselineTick; }
+	// Append the latest snapshot to the writer, delta-encoded against the
+	// client's baseline (or as a keyframe if it has none).
+	// Returns the number of bytes written.
+	size_t WriteSnapshotForClient(uint32_t clientId, PacketWriter &writer);
+	// Get the SERVER_WORLD_STATE packet carrying the latest snapshot for a
+	// client. Clients with the same baseline share one packet, which is only
+	// built once per snapshot; the packet buffers are reused from snapshot to
+	// snapshot. Returns nullptr if there is no snapshot yet.
+	const PacketWriter *GetPacketForClient(uint32_t clientId);
+
+	// GetPacketForClient() in two steps, for building the packets on another
+	// thread. PrepareBroadcast() looks up each client's baseline and returns
+	// the latest snapshot (nullptr if there is none). BuildPackets() only uses
+	// the encoder and the packet pool, so new acknowledgements may be recorded
+	// while it runs, but no snapshot may be created.
+	struct PacketRequest {
+		uint32_t clientId = 0;
+		std::shared_ptr<const WorldSnapshot> baseline;
+		const PacketWriter *packet = nullptr;
+	};
+	std::shared_ptr<const WorldSnapshot> PrepareBroadcast(std::vector<PacketRequest> &requests) const;
+	void BuildPackets(const WorldSnapshot &latest, std::vector<PacketRequest> &requests);
+
+	// Entity ID assignments shared by every snapshot
+	const EntityTracker &GetEntityTracker() const { return tracker; }
+
+	// Entity fragment pool statistics for the latest encoded snapshot
+	size_t GetFragmentCount() const { return encoder.GetFragmentCount(); }
+	uint64_t GetFragmentReuseCount() const { return encoder.GetFragmentReuseCount(); }
+	// Number of distinct world state packets built for the latest snapshot
+	size_t GetPacketCount() const { return packetsByBaseline.size(); }
+
+	// Send world state in the quantized wire format (see DeltaEncoder)
+	void SetQuantized(bool value) { encoder.SetQuantized(value); packetWorld = nullptr; }
+	bool IsQuantized() const { return encoder.IsQuantized(); }
+
+	// Prune snapshots older than specified tick, but never one at or after
+	// the oldest client baseline
 	void PruneOlderThan(uint64_t gameTick);
 
-	// Get snapshot count
-	size_t GetSnapshotCount() const { return snapshots.size(); }
+	// Get snapshot count, including baselines kept past the history window
+	size_t GetSnapshotCount() const { return snapshotCount + pinned.size(); }
 
-	// Get total memory usage (estimated)
+	// Get total memory usage of the snapshot history in bytes, counting
+	// storage shared between snapshots once
 	size_t GetMemoryUsage() const;
 
-	// Statistics
+	// Statistics. Encoded sizes are taken from the packets that are actually
+	// built for clients; a delta is compared to the size of its snapshot as a
+	// keyframe, which is only measured separately once per keyframe interval.
 	uint64_t GetTotalSnapshots() const { return totalSnapshots; }
 	uint64_t GetTotalKeyframes() const { return totalKeyframes; }
 	uint64_t GetTotalDeltaSnapshots() const { return totalSnapshots - totalKeyframes; }
 	double GetAverageCompressionRatio() const;
 
 	// Configuration
-	void SetHistorySize(size_t size) { historySize = size; }
+	void SetHistorySize(size_t size);
 	size_t GetHistorySize() const { return historySize; }
 
 	void SetKeyframeInterval(uint32_t interval) { keyframeInterval = interval; }
@@ -100,23 +174,72 @@ public:
 
 
 private:
-	// Snapshot storage (circular buffer via deque)
-	std::deque<Snapshot> snapshots;
+	// Snapshot storage: historySize slots, the snapshot for a tick living in
+	// slot tick % historySize. A slot is in use if it has a world.
+	std::vector<Snapshot> ring;
 	size_t historySize;                         // Max snapshots to keep
+	size_t snapshotCount = 0;                   // Slots in use
+	uint64_t latestTick = 0;                    // Only valid if snapshotCount > 0
+	// Client baselines whose slots were needed for newer snapshots, by tick
+	std::map<uint64_t, Snapshot> pinned;
+	// The world of a snapshot that left the history, to capture the next
+	// snapshot into
+	std::shared_ptr<WorldSnapshot> spareWorld;
 
 	// Keyframe configuration
 	uint32_t keyframeInterval = 30;             // Generate keyframe every N snapshots
 	uint32_t snapshotsSinceLastKeyframe = 0;
 
-	// Statistics
+	// Entity capture and encoding
+	EntityTracker tracker;
+	DeltaEncoder encoder;
+	PacketWriter scratch;
+
+	// Last acknowledged tick for each client, and the oldest of them
+	std::map<uint32_t, uint64_t> clientAcks;
+	uint64_t oldestBaselineTick = NO_BASELINE;
+
+	// World state packets for the latest snapshot, by baseline (nullptr for
+	// keyframes). Entries index into packetPool, whose writers keep their
+	// buffers between snapshots.
+	const WorldSnapshot *packetWorld = nullptr;
+	uint64_t packetTick = 0;
+	std::map<const WorldSnapshot *, size_t> packetsByBaseline;
+	std::vector<PacketWriter> packetPool;
+
+	// Statistics. The byte totals are updated while packets are built, which
+	// may happen on the broadcast thread.
 	uint64_t totalSnapshots = 0;
 	uint64_t totalKeyframes = 0;
-	uint64_t totalUncompressedBytes = 0;
-	uint64_t totalCompressedBytes = 0;
+	std::atomic<uint64_t> totalUncompressedBytes = 0;
+	std::atomic<uint64_t> totalCompressedBytes = 0;
+	// The most recently measured keyframe size, and the tick it was measured at
+	size_t keyframeSize = 0;
+	uint64_t keyframeSizeTick = 0;
 
 	// Helper: Check if next snapshot should be keyframe
 	bool ShouldCreateKeyframe() const;
 
-	// Helper: Estimate snapshot size
-	size_t EstimateSnapshotSize(const GameState &state) const;
+	// Helpers: ring slots
+	Snapshot &GetSlot(uint64_t gameTick) { return ring[gameTick % ring.size()]; }
+	const Snapshot &GetSlot(uint64_t gameTick) const { return ring[gameTick % ring.size()]; }
+	// Empty a slot. Its snapshot is pinned if it is a client's baseline, and
+	// otherwise its world becomes the spare if nothing else holds it.
+	void ClearSlot(Snapshot &slot);
+	// Helper: Check whether any client's baseline is the snapshot at this tick
+	bool IsBaseline(uint64_t gameTick) const;
+	// Helper: The oldest tick still in the history window
+	uint64_t GetOldestTick() const;
+	// Helper: Recompute oldestBaselineTick, unpin snapshots no client needs
+	// any more, and tell the tracker which IDs baselines still refer to
+	void UpdateOldestBaseline();
+
+	// Helper: Get the packet encoding "latest" against "baseline", building
+	// it if no other client has needed it yet
+	const PacketWriter *GetPacket(const WorldSnapshot &latest, const WorldSnapshot *baseline);
+	// Helper: Add a packet that was built to the statistics
+	void RecordPacketSize(const WorldSnapshot &latest, const WorldSnapshot *baseline, size_t size);
+
+	// Helper: Measure the encoded size of a snapshot (baseline may be nullptr)
+	size_t MeasureEncodedSize(const WorldSnapshot *baseline, const WorldSnapshot &current);
 };
@@ -0,0 +1,126 @@
+/* SpscQueue.h
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+
+// SpscQueue: Bounded lock-free queue between exactly two threads
+//
+// One thread (the producer) adds items and one other thread (the consumer)
+// removes them; neither ever blocks on a lock. Items live in a fixed ring of
+// slots that are filled and read in place, so a slot's buffers (for example
+// the vector holding a received packet) keep their memory from one use to
+// the next and a steady stream of items does not allocate.
+//
+// Producer:
+//   if(Item *item = queue.Acquire()) { fill *item; queue.Publish(); }
+// Consumer:
+//   while(Item *item = queue.Front()) { use *item; queue.Pop(); }
+template<class Type>
+class SpscQueue {
+public:
+	// The capacity is rounded up to a power of two.
+	explicit SpscQueue(size_t capacity = 1024);
+
+	SpscQueue(const SpscQueue &) = delete;
+	SpscQueue &operator=(const SpscQueue &) = delete;
+
+	// Producer: get the next free slot, or nullptr if the queue is full. The
+	// slot still holds whatever it held when it was last consumed.
+	Type *Acquire();
+	// Producer: make the slot returned by Acquire() visible to the consumer.
+	void Publish();
+
+	// Consumer: get the oldest item, or nullptr if the queue is empty.
+	Type *Front();
+	// Consumer: release the item returned by Front().
+	void Pop();
+
+	// Approximate, since the other thread may be changing it.
+	size_t Size() const;
+	size_t Capacity() const { return slots.size(); }
+
+
+private:
+	std::vector<Type> slots;
+	size_t mask;
+
+	// Index of the next slot to read, written only by the consumer.
+	alignas(64) std::atomic<size_t> head = 0;
+	// Index of the next slot to write, written only by the producer.
+	alignas(64) std::atomic<size_t> tail = 0;
+};
+
+
+
+template<class Type>
+SpscQueue<Type>::SpscQueue(size_t capacity)
+{
+	size_t size = 1;
+	while(size < capacity)
+		size <<= 1;
+	slots.resize(size);
+	mask = size - 1;
+}
+
+
+
+template<class Type>
+Type *SpscQueue<Type>::Acquire()
+{
+	size_t index = tail.load(std::memory_order_relaxed);
+	if(index - head.load(std::memory_order_acquire) == slots.size())
+		return nullptr;
+	return &slots[index & mask];
+}
+
+
+
+template<class Type>
+void SpscQueue<Type>::Publish()
+{
+	tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+
+
+template<class Type>
+Type *SpscQueue<Type>::Front()
+{
+	size_t index = head.load(std::memory_order_relaxed);
+	if(index == tail.load(std::memory_order_acquire))
+		return nullptr;
+	return &slots[index & mask];
+}
+
+
+
+template<class Type>
+void SpscQueue<Type>::Pop()
+{
+	head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+
+
+template<class Type>
+size_t SpscQueue<Type>::Size() const
+{
+	return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
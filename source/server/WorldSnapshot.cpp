@@ -0,0 +1,340 @@
+/* WorldSnapshot.cpp
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WorldSnapshot.h"
+
+#include "../Flotsam.h"
+#include "../GameState.h"
+#include "../network/PacketStructs.h"
+#include "../Projectile.h"
+#include "../Ship.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+	// Drop every entry that was not seen during the last capture, returning its
+	// ID to the pool, and reset the flag on the survivors.
+	template<class Map, class Pool>
+	void EraseUnseen(Map &entries, Pool &pool, uint64_t capture)
+	{
+		for(auto it = entries.begin(); it != entries.end(); )
+		{
+			if(!it->second.seen)
+			{
+				pool.Release(it->second.id, capture);
+				it = entries.erase(it);
+			}
+			else
+			{
+				it->second.seen = false;
+				++it;
+			}
+		}
+	}
+
+	template<class Record>
+	void SortById(vector<Record> &records)
+	{
+		// Records are usually captured in ID order already (new entities are
+		// appended to the GameState lists), so this is nearly always a no-op.
+		if(!is_sorted(records.begin(), records.end(),
+				[](const Record &a, const Record &b) { return a.id < b.id; }))
+			sort(records.begin(), records.end(),
+				[](const Record &a, const Record &b) { return a.id < b.id; });
+	}
+}
+
+
+
+uint16_t EntityTracker::IdPool::Allocate(uint64_t capture, uint64_t reuseDelay, uint64_t oldestBaseline)
+{
+	if(next <= UINT16_MAX)
+		return static_cast<uint16_t>(next++);
+	if(released.empty())
+		return 0;
+	// A baseline captured before the release still holds the old entity.
+	uint64_t releasedAt = released.front().second;
+	if(releasedAt + reuseDelay > capture || releasedAt > oldestBaseline)
+		return 0;
+
+	uint16_t id = released.front().first;
+	released.pop_front();
+	return id;
+}
+
+
+
+EntityTracker::EntityTracker(uint64_t reuseDelay)
+	: reuseDelay(reuseDelay)
+{
+}
+
+
+
+uint16_t EntityTracker::ShipId(const shared_ptr<Ship> &ship)
+{
+	const EsUuid &uuid = ship->UUID();
+	auto it = shipIdsByUuid.find(uuid);
+	if(it == shipIdsByUuid.end())
+	{
+		uint16_t id = shipIds.Allocate(captureCount, reuseDelay, oldestBaseline);
+		if(!id)
+			return 0;
+		// EsUuid copies are blank by design, so the value must be cloned.
+		EsUuid key;
+		key.Clone(uuid);
+		it = shipIdsByUuid.emplace(std::move(key), id).first;
+		ships[id].uuid.Clone(uuid);
+	}
+	ships[it->second].seen = true;
+	return it->second;
+}
+
+
+
+uint16_t EntityTracker::FindShipId(const Ship &ship) const
+{
+	auto it = shipIdsByUuid.find(ship.UUID());
+	return it == shipIdsByUuid.end() ? 0 : it->second;
+}
+
+
+
+uint16_t EntityTracker::ProjectileId(const Projectile &projectile)
+{
+	const Weapon *weapon = &projectile.GetWeapon();
+	double distance = projectile.DistanceTraveled();
+
+	auto it = projectiles.find(&projectile);
+	// A projectile never changes weapon and never travels backwards, so either
+	// of those happening means the list node was freed and reused.
+	if(it != projectiles.end() && (it->second.weapon != weapon || it->second.distanceTraveled > distance))
+	{
+		projectileIds.Release(it->second.id, captureCount);
+		projectiles.erase(it);
+		it = projectiles.end();
+	}
+	if(it == projectiles.end())
+	{
+		uint16_t id = projectileIds.Allocate(captureCount, reuseDelay, oldestBaseline);
+		if(!id)
+			return 0;
+		it = projectiles.try_emplace(&projectile).first;
+		it->second.id = id;
+		it->second.weapon = weapon;
+	}
+	it->second.distanceTraveled = distance;
+	it->second.seen = true;
+	return it->second.id;
+}
+
+
+
+uint16_t EntityTracker::FlotsamId(const shared_ptr<Flotsam> &item)
+{
+	auto it = flotsam.find(item.get());
+	if(it != flotsam.end() && it->second.flotsam.lock() != item)
+	{
+		flotsamIds.Release(it->second.id, captureCount);
+		flotsam.erase(it);
+		it = flotsam.end();
+	}
+	if(it == flotsam.end())
+	{
+		uint16_t id = flotsamIds.Allocate(captureCount, reuseDelay, oldestBaseline);
+		if(!id)
+			return 0;
+		it = flotsam.try_emplace(item.get()).first;
+		it->second.id = id;
+		it->second.flotsam = item;
+	}
+	it->second.seen = true;
+	return it->second.id;
+}
+
+
+
+void EntityTracker::EndCapture()
+{
+	for(auto it = ships.begin(); it != ships.end(); )
+	{
+		if(!it->second.seen)
+		{
+			shipIds.Release(it->first, captureCount);
+			shipIdsByUuid.erase(it->second.uuid);
+			it = ships.erase(it);
+		}
+		else
+		{
+			it->second.seen = false;
+			++it;
+		}
+	}
+	EraseUnseen(projectiles, projectileIds, captureCount);
+	EraseUnseen(flotsam, flotsamIds, captureCount);
+	++captureCount;
+}
+
+
+
+void EntityTracker::Clear()
+{
+	ships.clear();
+	shipIdsByUuid.clear();
+	projectiles.clear();
+	flotsam.clear();
+	shipIds.Clear();
+	projectileIds.Clear();
+	flotsamIds.Clear();
+}
+
+
+
+void WorldSnapshot::Capture(const GameState &state, EntityTracker &tracker, const WorldSnapshot *previous)
+{
+	gameTick = state.GetGameTick();
+	captureIndex = tracker.captureCount;
+
+	// Every live entity has to be looked at to find out whether it changed,
+	// but its record only goes into new storage if it did; chunks of records
+	// that are all unchanged are shared with the previous snapshot.
+	vector<ShipRecord> &shipRecords = tracker.shipScratch;
+	shipRecords.clear();
+	for(const auto &ship : state.GetShips())
+	{
+		if(!ship)
+			continue;
+
+		uint16_t id = tracker.ShipId(ship);
+		if(!id)
+			continue;
+
+		ShipRecord &record = shipRecords.emplace_back();
+		record.id = id;
+		record.position = ship->Position();
+		record.velocity = ship->Velocity();
+		record.facing = ship->Facing();
+		record.shields = static_cast<float>(ship->Shields());
+		record.hull = static_cast<float>(ship->Hull());
+		record.energy = static_cast<float>(ship->Energy());
+		record.fuel = static_cast<float>(ship->Fuel());
+		record.flags = ShipFlagsFor(*ship);
+	}
+
+	vector<ProjectileRecord> &projectileRecords = tracker.projectileScratch;
+	projectileRecords.clear();
+	for(const Projectile &projectile : state.GetProjectiles())
+	{
+		if(projectile.IsDead())
+			continue;
+
+		uint16_t id = tracker.ProjectileId(projectile);
+		if(!id)
+			continue;
+
+		ProjectileRecord &record = projectileRecords.emplace_back();
+		record.id = id;
+		record.position = projectile.Position();
+		record.velocity = projectile.Velocity();
+		record.facing = projectile.Facing();
+	}
+
+	vector<FlotsamRecord> &flotsamRecords = tracker.flotsamScratch;
+	flotsamRecords.clear();
+	for(const auto &item : state.GetFlotsam())
+	{
+		if(!item)
+			continue;
+
+		uint16_t id = tracker.FlotsamId(item);
+		if(!id)
+			continue;
+
+		FlotsamRecord &record = flotsamRecords.emplace_back();
+		record.id = id;
+		record.position = item->Position();
+		record.velocity = item->Velocity();
+		record.count = item->Count();
+	}
+
+	tracker.EndCapture();
+
+	SortById(shipRecords);
+	SortById(projectileRecords);
+	SortById(flotsamRecords);
+
+	ships.Assign(shipRecords, previous ? &previous->ships : nullptr);
+	projectiles.Assign(projectileRecords, previous ? &previous->projectiles : nullptr);
+	flotsam.Assign(flotsamRecords, previous ? &previous->flotsam : nullptr);
+}
+
+
+
+uint16_t WorldSnapshot::ShipFlagsFor(const Ship &ship)
+{
+	using namespace NetworkPacket;
+
+	uint16_t flags = 0;
+	if(ship.IsThrusting())
+		flags |= ShipFlags::THRUSTING;
+	if(ship.IsReversing())
+		flags |= ShipFlags::REVERSE;
+	if(ship.IsSteering())
+		flags |= ship.SteeringDirection() < 0. ? ShipFlags::TURNING_LEFT : ShipFlags::TURNING_RIGHT;
+	if(ship.IsCloaked())
+		flags |= ShipFlags::CLOAKED;
+	if(ship.IsHyperspacing())
+		flags |= ShipFlags::HYPERSPACING;
+	if(ship.IsLanding())
+		flags |= ShipFlags::LANDING;
+	if(ship.IsDisabled())
+		flags |= ShipFlags::DISABLED;
+	if(ship.IsOverheated())
+		flags |= ShipFlags::OVERHEATED;
+	return flags;
+}
+
+
+
+const ShipRecord *WorldSnapshot::FindShip(uint16_t id) const
+{
+	return ships.Find(id);
+}
+
+
+
+const ProjectileRecord *WorldSnapshot::FindProjectile(uint16_t id) const
+{
+	return projectiles.Find(id);
+}
+
+
+
+const FlotsamRecord *WorldSnapshot::FindFlotsam(uint16_t id) const
+{
+	return flotsam.Find(id);
+}
+
+
+
+size_t WorldSnapshot::GetMemoryUsage(set<const void *> *counted) const
+{
+	return sizeof(WorldSnapshot)
+		+ ships.GetMemoryUsage(counted)
+		+ projectiles.GetMemoryUsage(counted)
+		+ flotsam.GetMemoryUsage(counted);
+}
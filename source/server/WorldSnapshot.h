@@ -0,0 +1,223 @@
+/* WorldSnapshot.h
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Endless Sky is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "RecordList.h"
+
+#include "../Angle.h"
+#include "../EsUuid.h"
+#include "../Point.h"
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+class Flotsam;
+class GameState;
+class Projectile;
+class Ship;
+class Weapon;
+
+
+// ShipRecord: The networked subset of a ship's state at one tick
+struct ShipRecord {
+	uint16_t id = 0;                            // Network ID (see EntityTracker)
+	Point position;
+	Point velocity;
+	Angle facing;
+	float shields = 0.f;                        // 0-1 normalized
+	float hull = 0.f;                           // 0-1 normalized
+	float energy = 0.f;                         // 0-1 normalized
+	float fuel = 0.f;                           // 0-1 normalized
+	uint16_t flags = 0;                         // NetworkPacket::ShipFlags
+
+	bool operator==(const ShipRecord &other) const = default;
+};
+
+
+// ProjectileRecord: Kinematic state of a projectile in flight
+struct ProjectileRecord {
+	uint16_t id = 0;
+	Point position;
+	Point velocity;
+	Angle facing;
+
+	bool operator==(const ProjectileRecord &other) const = default;
+};
+
+
+// FlotsamRecord: State of a piece of floating cargo or salvage
+struct FlotsamRecord {
+	uint16_t id = 0;
+	Point position;
+	Point velocity;
+	int32_t count = 0;
+
+	bool operator==(const FlotsamRecord &other) const = default;
+};
+
+
+// EntityTracker: Assigns per-session 16-bit network IDs to live objects
+//
+// Ships are tracked by network ID and found by UUID, so a ship keeps its ID
+// for as long as it lives, and a new ship can never inherit a dead one's
+// entry. The GameState containers hold flotsam through shared_ptr and
+// projectiles by value in a std::list, so the address of a live object of
+// those kinds is stable for as long as it stays in the state; they are
+// tracked by address. Network IDs let consecutive captures be diffed entity
+// by entity, and let the wire format refer to an entity with two bytes
+// instead of its UUID.
+//
+// Ships, projectiles and flotsam each have their own ID space. An ID is not
+// handed out again until "reuse delay" captures after its entity disappeared,
+// which must be at least the snapshot history length: a client holding any
+// baseline that is still in the history can then never confuse a new entity
+// with a dead one. Baselines kept beyond the history are covered by
+// SetOldestBaseline(). If every ID of a type is in use, further entities of
+// that type get ID 0 and are left out of the capture.
+//
+// Ship UUIDs are remembered for live ships so that the delta encoder can
+// announce the UUID the first time a client sees a given network ID.
+class EntityTracker {
+public:
+	explicit EntityTracker(uint64_t reuseDelay = 120);
+
+	// Look up (or assign) the network ID for a live entity. Returns 0 if no ID
+	// is available.
+	uint16_t ShipId(const std::shared_ptr<Ship> &ship);
+	uint16_t ProjectileId(const Projectile &projectile);
+	uint16_t FlotsamId(const std::shared_ptr<Flotsam> &flotsam);
+	// Get the network ID of a ship seen by an earlier lookup, without assigning
+	// one. Returns 0 if the ship is not tracked.
+	uint16_t FindShipId(const Ship &ship) const;
+
+	// Drop every entity that was not seen since the last call. Must be called
+	// once per capture, after all entities have been looked up.
+	void EndCapture();
+
+	// Get the UUID of a ship that is still alive. Returns nullptr if the ID is
+	// not (or no longer) tracked.
+	const EsUuid *GetShipUuid(uint16_t id) const
+	{
+		auto it = ships.find(id);
+		return it == ships.end() ? nullptr : &it->second.uuid;
+	}
+
+	size_t GetTrackedCount() const { return ships.size() + projectiles.size() + flotsam.size(); }
+
+	// Number of captures a released ID stays unused.
+	void SetReuseDelay(uint64_t delay) { reuseDelay = delay; }
+	uint64_t GetReuseDelay() const { return reuseDelay; }
+	// The capture index (see WorldSnapshot::captureIndex) of the oldest
+	// snapshot a client may still use as its baseline. IDs released after
+	// that capture are not reused, however long ago it was.
+	void SetOldestBaseline(uint64_t capture) { oldestBaseline = capture; }
+
+	void Clear();
+
+
+private:
+	struct ShipEntry {
+		EsUuid uuid;
+		bool seen = false;
+	};
+	struct ProjectileEntry {
+		uint16_t id = 0;
+		const Weapon *weapon = nullptr;
+		double distanceTraveled = 0.;
+		bool seen = false;
+	};
+	struct FlotsamEntry {
+		uint16_t id = 0;
+		std::weak_ptr<Flotsam> flotsam;
+		bool seen = false;
+	};
+
+	// Allocator for one 16-bit ID space. Unused IDs are handed out in
+	// increasing order first, so that new entities sort after existing ones;
+	// after that, released IDs are reused oldest first.
+	class IdPool {
+	public:
+		uint16_t Allocate(uint64_t capture, uint64_t reuseDelay, uint64_t oldestBaseline);
+		void Release(uint16_t id, uint64_t capture) { released.emplace_back(id, capture); }
+		void Clear() { next = 1; released.clear(); }
+
+	private:
+		uint32_t next = 1;
+		// IDs of entities that disappeared, with the capture they vanished in.
+		std::deque<std::pair<uint16_t, uint64_t>> released;
+	};
+
+
+private:
+	uint64_t reuseDelay;
+	uint64_t captureCount = 0;
+	uint64_t oldestBaseline = std::numeric_limits<uint64_t>::max();
+
+	IdPool shipIds;
+	IdPool projectileIds;
+	IdPool flotsamIds;
+
+	// Live ships by network ID, and their IDs by UUID
+	std::map<uint16_t, ShipEntry> ships;
+	std::map<EsUuid, uint16_t> shipIdsByUuid;
+	std::map<const Projectile *, ProjectileEntry> projectiles;
+	std::map<const Flotsam *, FlotsamEntry> flotsam;
+
+	// Scratch space for WorldSnapshot::Capture(), kept from one capture to the
+	// next so that capturing does not allocate once it has warmed up.
+	friend struct WorldSnapshot;
+	std::vector<ShipRecord> shipScratch;
+	std::vector<ProjectileRecord> projectileScratch;
+	std::vector<FlotsamRecord> flotsamScratch;
+};
+
+
+// WorldSnapshot: Compact capture of the networked entities in a GameState
+//
+// Each record list is sorted by entity ID so that two snapshots can be diffed
+// with a single linear merge. Record storage is shared with the snapshot a
+// capture was based on wherever the entities did not change (see RecordList),
+// so keeping a long history of snapshots costs little more than the changes.
+struct WorldSnapshot {
+	uint64_t gameTick = 0;
+	// Which of its tracker's captures this is, counting from 0
+	uint64_t captureIndex = 0;
+	RecordList<ShipRecord> ships;
+	RecordList<ProjectileRecord> projectiles;
+	RecordList<FlotsamRecord> flotsam;
+
+	// Replace this snapshot with the current contents of a game state, reusing
+	// its storage. If "previous" is given, its records of entities that did not
+	// change are shared instead of copied.
+	void Capture(const GameState &state, EntityTracker &tracker, const WorldSnapshot *previous = nullptr);
+
+	// Build the ShipFlags bitmask describing a ship's current status.
+	static uint16_t ShipFlagsFor(const Ship &ship);
+
+	// Find a record by entity ID (binary search). Returns nullptr if absent.
+	const ShipRecord *FindShip(uint16_t id) const;
+	const ProjectileRecord *FindProjectile(uint16_t id) const;
+	const FlotsamRecord *FindFlotsam(uint16_t id) const;
+
+	// Memory used by this snapshot's record storage. Storage already listed in
+	// "counted" is skipped, and newly counted storage is added to it.
+	size_t GetMemoryUsage(std::set<const void *> *counted = nullptr) const;
+};
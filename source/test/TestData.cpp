@@ -137,6 +137,7 @@ bool TestData::InjectMission(const ConditionsStore *playerConditions,
 	for(const DataNode &node : dataNode)
 		if(node.Token(0) == "mission" && node.Size() > 1)
 			GameData::Objects().missions.Get(node.Token(1))->Load(node, playerConditions, visitedSystems, visitedPlanets);
+	GameData::Objects().missionOffers.Build(GameData::Objects().missions);
 
 	return true;
 }
@@ -0,0 +1,203 @@
+/* benchmark_bit_packing.cpp
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Microbenchmark comparing PacketWriter/PacketReader with BitWriter/BitReader
+ * for building and parsing per-client world state packets
+ */
+
+#include "../../source/network/BitReader.h"
+#include "../../source/network/BitWriter.h"
+#include "../../source/network/PacketReader.h"
+#include "../../source/network/PacketStructs.h"
+#include "../../source/network/PacketWriter.h"
+#include "../../source/Angle.h"
+#include "../../source/Point.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace NetworkPacket;
+
+// Stub Random class for Angle and EsUuid
+namespace Random {
+	void Seed(uint64_t seed) {}
+	uint64_t Int() { return 0; }
+	uint32_t Int(uint32_t max) { return max > 0 ? 0 : 0; }
+}
+
+// Stub Logger class for EsUuid
+namespace Logger {
+	enum class Level { ERROR };
+	void Log(const std::string &message, Level level = Level::ERROR) {}
+}
+
+
+namespace {
+	// One broadcast: every client gets a packet with every ship's update.
+	constexpr int CLIENTS = 32;
+	constexpr int SHIPS = 64;
+	constexpr int BROADCASTS = 200;
+
+	struct Ship {
+		uint16_t id;
+		Point position;
+		Point velocity;
+		Angle facing;
+	};
+
+	// Keep the optimizer from discarding results.
+	volatile uint64_t sink = 0;
+
+
+	vector<Ship> MakeShips()
+	{
+		vector<Ship> ships;
+		for(int i = 0; i < SHIPS; ++i)
+			ships.push_back({static_cast<uint16_t>(i * 3 + 1), Point(i * 137.5, i * -42.25),
+				Point(i % 7 - 3., i % 5 - 2.), Angle(i * 11.)});
+		return ships;
+	}
+
+
+	// The byte-oriented format used by the quantized DeltaEncoder.
+	size_t WriteWithPacketWriter(PacketWriter &writer, const vector<Ship> &ships)
+	{
+		writer.Reset(PacketType::SERVER_WORLD_STATE);
+		writer.WriteUint16(static_cast<uint16_t>(ships.size()));
+		for(const Ship &ship : ships)
+		{
+			writer.WriteUint16(ship.id);
+			writer.WriteUint8(0x07);
+			writer.WriteQuantizedPosition(ship.position);
+			writer.WriteQuantizedVelocity(ship.velocity);
+			writer.WriteQuantizedAngle(ship.facing);
+		}
+		return writer.GetSize();
+	}
+
+
+	// The same fields, bit-packed: IDs as varint deltas from the previous
+	// ID, the three-bit field mask, 24/16/16-bit fixed point values.
+	size_t WriteWithBitWriter(uint8_t *buffer, size_t capacity, const vector<Ship> &ships)
+	{
+		BitWriter writer(buffer, capacity, PacketType::SERVER_WORLD_STATE);
+		writer.WriteVarUint(ships.size());
+		uint16_t previousId = 0;
+		for(const Ship &ship : ships)
+		{
+			writer.WriteVarUint(ship.id - previousId);
+			previousId = ship.id;
+			writer.WriteBits(0x07, 3);
+			writer.WriteBits(static_cast<uint32_t>(Quantization::PositionToFixed(ship.position.X())), 24);
+			writer.WriteBits(static_cast<uint32_t>(Quantization::PositionToFixed(ship.position.Y())), 24);
+			writer.WriteBits(static_cast<uint16_t>(Quantization::VelocityToFixed(ship.velocity.X())), 16);
+			writer.WriteBits(static_cast<uint16_t>(Quantization::VelocityToFixed(ship.velocity.Y())), 16);
+			writer.WriteBits(Quantization::DegreesToFixed(ship.facing.Degrees()), 16);
+		}
+		return writer.Finish();
+	}
+
+
+	uint64_t ReadWithPacketReader(const uint8_t *data, size_t size)
+	{
+		PacketReader reader(data, size);
+		uint64_t checksum = 0;
+		uint16_t count = reader.ReadUint16();
+		for(uint16_t i = 0; i < count; ++i)
+		{
+			checksum += reader.ReadUint16();
+			checksum += reader.ReadUint8();
+			checksum += static_cast<uint64_t>(reader.ReadQuantizedPosition().X());
+			checksum += static_cast<uint64_t>(reader.ReadQuantizedVelocity().Y() + 10.);
+			checksum += static_cast<uint64_t>(reader.ReadQuantizedAngle().Degrees());
+		}
+		return checksum;
+	}
+
+
+	uint64_t ReadWithBitReader(const uint8_t *data, size_t size)
+	{
+		BitReader reader = BitReader::FromPacket(data, size);
+		uint64_t checksum = 0;
+		uint64_t count = reader.ReadVarUint();
+		uint64_t id = 0;
+		for(uint64_t i = 0; i < count; ++i)
+		{
+			id += reader.ReadVarUint();
+			checksum += id;
+			checksum += reader.ReadBits(3);
+			int32_t x = static_cast<int32_t>(reader.ReadBits(24) << 8) >> 8;
+			reader.ReadBits(24);
+			checksum += static_cast<uint64_t>(Quantization::FixedToPosition(x));
+			reader.ReadBits(16);
+			int16_t vy = static_cast<int16_t>(reader.ReadBits(16));
+			checksum += static_cast<uint64_t>(Quantization::FixedToVelocity(vy) + 10.);
+			Angle facing(Quantization::FixedToDegrees(static_cast<uint16_t>(reader.ReadBits(16))));
+			checksum += static_cast<uint64_t>(facing.Degrees());
+		}
+		return checksum;
+	}
+
+
+	template<class Function>
+	double Measure(Function function)
+	{
+		auto start = chrono::steady_clock::now();
+		for(int broadcast = 0; broadcast < BROADCASTS; ++broadcast)
+			for(int client = 0; client < CLIENTS; ++client)
+				function();
+		auto elapsed = chrono::steady_clock::now() - start;
+		return chrono::duration<double, nano>(elapsed).count() / (BROADCASTS * CLIENTS);
+	}
+
+
+	void Report(const string &name, double nanoseconds, size_t bytes)
+	{
+		cout << left << setw(28) << name << right << setw(10) << fixed << setprecision(0) << nanoseconds
+			<< " ns/packet" << setw(8) << bytes << " bytes" << endl;
+	}
+}
+
+
+
+int main()
+{
+	cout << "=== Bit Packing Benchmark ===" << endl;
+	cout << CLIENTS << " clients x " << SHIPS << " ships x " << BROADCASTS << " broadcasts" << endl;
+	cout << endl;
+
+	vector<Ship> ships = MakeShips();
+
+	PacketWriter packetWriter(PacketType::SERVER_WORLD_STATE);
+	size_t packetWriterSize = 0;
+	double packetWriterTime = Measure([&]() { packetWriterSize = WriteWithPacketWriter(packetWriter, ships); });
+
+	vector<uint8_t> buffer(1500);
+	size_t bitWriterSize = 0;
+	double bitWriterTime = Measure([&]() {
+		bitWriterSize = WriteWithBitWriter(buffer.data(), buffer.size(), ships);
+	});
+
+	Report("PacketWriter (write)", packetWriterTime, packetWriterSize);
+	Report("BitWriter (write)", bitWriterTime, bitWriterSize);
+
+	vector<uint8_t> packetData = packetWriter.GetData();
+	uint64_t expected = ReadWithPacketReader(packetData.data(), packetData.size());
+	uint64_t bitChecksum = ReadWithBitReader(buffer.data(), bitWriterSize);
+
+	double packetReaderTime = Measure([&]() { sink = sink + ReadWithPacketReader(packetData.data(), packetData.size()); });
+	double bitReaderTime = Measure([&]() { sink = sink + ReadWithBitReader(buffer.data(), bitWriterSize); });
+
+	Report("PacketReader (read)", packetReaderTime, packetData.size());
+	Report("BitReader (read)", bitReaderTime, bitWriterSize);
+
+	cout << endl;
+	// The two encodings carry the same values, so they must decode alike.
+	bool consistent = (expected == bitChecksum) && bitWriterSize < packetWriterSize;
+	cout << (consistent ? "Decoded values match" : "MISMATCH between encodings") << endl;
+
+	return consistent ? 0 : 1;
+}
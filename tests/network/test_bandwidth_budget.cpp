@@ -0,0 +1,152 @@
+/* test_bandwidth_budget.cpp
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Unit tests for the per-connection BandwidthBudget token bucket
+ */
+
+#include "../../source/network/BandwidthBudget.h"
+
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+
+// Test result tracking
+int testsRun = 0;
+int testsPassed = 0;
+
+void ReportTest(const string &name, bool passed)
+{
+	testsRun++;
+	if(passed)
+	{
+		testsPassed++;
+		cout << "[PASS] " << name << endl;
+	}
+	else
+	{
+		cout << "[FAIL] " << name << endl;
+	}
+}
+
+
+// Test 1: Each refill adds one tick's share, up to two ticks' worth
+bool TestRefill()
+{
+	// 20000 bytes/s at 20 Hz = 1000 bytes per tick
+	BandwidthBudget budget(20000, 20);
+	if(budget.GetAvailable() != 2000. || budget.GetCapacity() != 2000.)
+		return false;
+
+	budget.Consume(2000);
+	if(budget.GetAvailable() != 0.)
+		return false;
+	budget.Refill();
+	if(budget.GetAvailable() != 1000.)
+		return false;
+	budget.Refill();
+	budget.Refill();
+	return budget.GetAvailable() == 2000.;
+}
+
+
+// Test 2: Packets are held back until the budget covers them
+bool TestCanSend()
+{
+	BandwidthBudget budget(20000, 20);
+	budget.Consume(1500);
+	if(!budget.CanSend(500) || budget.CanSend(501))
+		return false;
+
+	budget.Consume(500);
+	if(budget.CanSend(1))
+		return false;
+	budget.Refill();
+	return budget.CanSend(1000) && !budget.CanSend(1001);
+}
+
+
+// Test 3: A packet bigger than the bucket goes out once the bucket is full,
+// and the debt delays the packets after it
+bool TestLargePacket()
+{
+	BandwidthBudget budget(20000, 20);
+	if(!budget.CanSend(5000))
+		return false;
+	budget.Consume(5000);
+	if(budget.CanSend(1))
+		return false;
+
+	// -3000 takes five refills to reach the full 2000 again.
+	int refills = 0;
+	while(!budget.CanSend(5000) && refills < 100)
+	{
+		budget.Refill();
+		++refills;
+	}
+	return refills == 5;
+}
+
+
+// Test 4: Packet loss and high latency reduce the rate
+bool TestNetworkConditions()
+{
+	BandwidthBudget budget(100000, 20);
+	budget.SetNetworkConditions(NetworkConstants::LATENCY_GOOD, 0.f);
+	if(budget.GetEffectiveBytesPerSecond() != 100000.)
+		return false;
+
+	// Halved at "poor" loss, and no further for worse loss
+	budget.SetNetworkConditions(NetworkConstants::LATENCY_GOOD, NetworkConstants::PACKET_LOSS_POOR);
+	if(fabs(budget.GetEffectiveBytesPerSecond() - 50000.) > 1e-6)
+		return false;
+	budget.SetNetworkConditions(NetworkConstants::LATENCY_GOOD, 50.f);
+	if(fabs(budget.GetEffectiveBytesPerSecond() - 50000.) > 1e-6)
+		return false;
+
+	// Twice the "poor" latency halves the rate
+	budget.SetNetworkConditions(2 * NetworkConstants::LATENCY_POOR, 0.f);
+	if(fabs(budget.GetEffectiveBytesPerSecond() - 50000.) > 1e-6)
+		return false;
+
+	// Never below a quarter of the configured rate
+	budget.SetNetworkConditions(10 * NetworkConstants::LATENCY_POOR, 50.f);
+	if(fabs(budget.GetEffectiveBytesPerSecond() - 25000.) > 1e-6)
+		return false;
+
+	// The bucket shrinks with the rate.
+	budget.Refill();
+	return fabs(budget.GetAvailable() - 2500.) < 1e-6;
+}
+
+
+// Test 5: A rate of zero is unlimited
+bool TestUnlimited()
+{
+	BandwidthBudget budget(0, 20);
+	budget.Consume(1000000);
+	budget.SetNetworkConditions(1000, 50.f);
+	return budget.IsUnlimited() && budget.CanSend(1000000000);
+}
+
+
+int main()
+{
+	cout << "=== Bandwidth Budget Tests ===" << endl;
+	cout << endl;
+
+	ReportTest("Test 1: Refill", TestRefill());
+	ReportTest("Test 2: Held Back Until Covered", TestCanSend());
+	ReportTest("Test 3: Oversized Packets", TestLargePacket());
+	ReportTest("Test 4: Network Conditions", TestNetworkConditions());
+	ReportTest("Test 5: Unlimited", TestUnlimited());
+
+	cout << endl;
+	cout << "=== Test Results ===" << endl;
+	cout << "Tests Run: " << testsRun << endl;
+	cout << "Tests Passed: " << testsPassed << endl;
+	cout << "Tests Failed: " << (testsRun - testsPassed) << endl;
+
+	return (testsPassed == testsRun) ? 0 : 1;
+}
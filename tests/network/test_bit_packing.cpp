@@ -0,0 +1,256 @@
+/* test_bit_packing.cpp
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Unit tests for the bit-packing BitWriter/BitReader pair
+ */
+
+#include "../../source/network/BitReader.h"
+#include "../../source/network/BitWriter.h"
+#include "../../source/network/PacketReader.h"
+#include "../../source/network/PacketWriter.h"
+
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+using namespace NetworkPacket;
+
+// Stub Random class for Angle and EsUuid
+namespace Random {
+	void Seed(uint64_t seed) {}
+	uint64_t Int() { return 0; }
+	uint32_t Int(uint32_t max) { return max > 0 ? 0 : 0; }
+}
+
+// Stub Logger class for EsUuid
+namespace Logger {
+	enum class Level { ERROR };
+	void Log(const std::string &message, Level level = Level::ERROR) {}
+}
+
+
+// Test result tracking
+int testsRun = 0;
+int testsPassed = 0;
+
+void ReportTest(const string &name, bool passed)
+{
+	testsRun++;
+	if(passed)
+	{
+		testsPassed++;
+		cout << "[PASS] " << name << endl;
+	}
+	else
+	{
+		cout << "[FAIL] " << name << endl;
+	}
+}
+
+
+// Test 1: N-bit fields and booleans pack tightly and read back
+bool TestBitFields()
+{
+	uint8_t buffer[16] = {};
+	BitWriter writer(buffer, sizeof(buffer));
+	writer.WriteBits(5, 3);
+	writer.WriteBool(true);
+	writer.WriteBool(false);
+	writer.WriteBits(0x1FFFF, 17);
+	writer.WriteBits(0xDEADBEEF, 32);
+	writer.WriteBits(0xFF, 4);  // Only the low 4 bits are kept.
+	size_t size = writer.Finish();
+
+	// 3 + 1 + 1 + 17 + 32 + 4 = 58 bits
+	if(writer.GetBitsWritten() != 58 || size != 8)
+		return false;
+
+	BitReader reader(buffer, size);
+	return reader.ReadBits(3) == 5 && reader.ReadBool() && !reader.ReadBool()
+		&& reader.ReadBits(17) == 0x1FFFF && reader.ReadBits(32) == 0xDEADBEEF
+		&& reader.ReadBits(4) == 0xF && !reader.HasError();
+}
+
+
+// Test 2: Varints use one byte per 7 bits
+bool TestVarUint()
+{
+	uint8_t buffer[64];
+	BitWriter writer(buffer, sizeof(buffer));
+	const uint64_t values[] = {0, 1, 127, 128, 16383, 16384, numeric_limits<uint64_t>::max()};
+	for(uint64_t value : values)
+		writer.WriteVarUint(value);
+	size_t size = writer.Finish();
+	if(size != 1 + 1 + 1 + 2 + 2 + 3 + 10)
+		return false;
+	if(BitWriter::VarUintBits(128) != 16)
+		return false;
+
+	BitReader reader(buffer, size);
+	for(uint64_t value : values)
+		if(reader.ReadVarUint() != value)
+			return false;
+	return !reader.HasError() && !reader.GetBitsRemaining();
+}
+
+
+// Test 3: Zigzag keeps small negative numbers small
+bool TestVarInt()
+{
+	if(BitWriter::ZigZag(0) != 0 || BitWriter::ZigZag(-1) != 1 || BitWriter::ZigZag(1) != 2
+			|| BitWriter::ZigZag(-2) != 3)
+		return false;
+	if(BitWriter::VarIntBits(-64) != 8 || BitWriter::VarIntBits(64) != 16)
+		return false;
+
+	uint8_t buffer[64];
+	BitWriter writer(buffer, sizeof(buffer));
+	const int64_t values[] = {0, -1, 1, -64, 63, -1000000, numeric_limits<int64_t>::min(),
+		numeric_limits<int64_t>::max()};
+	for(int64_t value : values)
+		writer.WriteVarInt(value);
+	size_t size = writer.Finish();
+
+	BitReader reader(buffer, size);
+	for(int64_t value : values)
+		if(reader.ReadVarInt() != value)
+			return false;
+	return !reader.HasError();
+}
+
+
+// Test 4: Unaligned varints, floats and byte blocks mix correctly
+bool TestMixed()
+{
+	uint8_t buffer[64];
+	BitWriter writer(buffer, sizeof(buffer));
+	writer.WriteBool(true);
+	writer.WriteVarInt(-300);
+	writer.WriteFloat(3.25f);
+	writer.WriteBits(3, 2);
+	writer.WriteBytes("abc", 3);
+	writer.WriteBits(1, 1);
+	size_t size = writer.Finish();
+
+	BitReader reader(buffer, size);
+	if(!reader.ReadBool() || reader.ReadVarInt() != -300 || reader.ReadFloat() != 3.25f
+			|| reader.ReadBits(2) != 3)
+		return false;
+	const uint8_t *bytes = reader.ReadBytes(3);
+	// Byte blocks are read in place, without copying.
+	if(!bytes || bytes < buffer || bytes >= buffer + size || memcmp(bytes, "abc", 3))
+		return false;
+	return reader.ReadBits(1) == 1 && !reader.HasError();
+}
+
+
+// Test 5: The writer never writes past the caller's buffer
+bool TestOverflow()
+{
+	uint8_t buffer[8];
+	memset(buffer, 0xAA, sizeof(buffer));
+	BitWriter writer(buffer, 4);
+	writer.WriteBits(0x12345678, 32);
+	if(writer.HasOverflowed())
+		return false;
+	writer.WriteBool(true);
+	writer.WriteBytes("x", 1);
+	writer.Finish();
+	if(!writer.HasOverflowed() || writer.GetBytesWritten() != 4)
+		return false;
+	for(size_t i = 4; i < sizeof(buffer); ++i)
+		if(buffer[i] != 0xAA)
+			return false;
+
+	// Reset clears the overflow.
+	writer.Reset();
+	writer.WriteBits(1, 8);
+	return !writer.HasOverflowed() && writer.Finish() == 1;
+}
+
+
+// Test 6: The reader flags reads past the end
+bool TestUnderflow()
+{
+	uint8_t buffer[2] = {0xFF, 0xFF};
+	BitReader reader(buffer, sizeof(buffer));
+	reader.ReadBits(12);
+	if(reader.HasError() || reader.GetBitsRemaining() != 4)
+		return false;
+	if(reader.ReadBits(5) != 0 || !reader.HasError())
+		return false;
+
+	// An unterminated varint is an error too.
+	BitReader varint(buffer, sizeof(buffer));
+	varint.ReadVarUint();
+	return varint.HasError();
+}
+
+
+// Test 7: Packet mode produces packets PacketReader accepts
+bool TestPacketMode()
+{
+	uint8_t buffer[64];
+	BitWriter writer(buffer, sizeof(buffer), PacketType::SERVER_WORLD_STATE);
+	writer.WriteVarUint(1234);
+	writer.WriteBits(7, 3);
+	size_t size = writer.Finish();
+	if(size != PACKET_HEADER_SIZE + 3)
+		return false;
+
+	PacketReader header(buffer, size);
+	if(!header.IsValid() || header.GetPacketType() != PacketType::SERVER_WORLD_STATE
+			|| header.GetPayloadSize() != 3)
+		return false;
+
+	BitReader reader = BitReader::FromPacket(buffer, size);
+	if(reader.HasError() || reader.GetPacketType() != PacketType::SERVER_WORLD_STATE)
+		return false;
+	if(reader.ReadVarUint() != 1234 || reader.ReadBits(3) != 7)
+		return false;
+
+	// A truncated packet is rejected.
+	return BitReader::FromPacket(buffer, size - 1).HasError();
+}
+
+
+// Test 8: Finish can be called part way through
+bool TestIncrementalFinish()
+{
+	uint8_t buffer[16];
+	BitWriter writer(buffer, sizeof(buffer));
+	writer.WriteBits(0x5, 4);
+	writer.Finish();
+	writer.WriteBits(0xA, 4);
+	writer.WriteBits(0xBEEF, 16);
+	size_t size = writer.Finish();
+
+	BitReader reader(buffer, size);
+	return size == 3 && reader.ReadBits(4) == 0x5 && reader.ReadBits(4) == 0xA
+		&& reader.ReadBits(16) == 0xBEEF;
+}
+
+
+int main()
+{
+	cout << "=== Bit Packing Tests ===" << endl;
+	cout << endl;
+
+	ReportTest("Test 1: Bit Fields", TestBitFields());
+	ReportTest("Test 2: Varint", TestVarUint());
+	ReportTest("Test 3: Zigzag Varint", TestVarInt());
+	ReportTest("Test 4: Mixed Fields", TestMixed());
+	ReportTest("Test 5: Overflow Protection", TestOverflow());
+	ReportTest("Test 6: Underflow Detection", TestUnderflow());
+	ReportTest("Test 7: Packet Mode", TestPacketMode());
+	ReportTest("Test 8: Incremental Finish", TestIncrementalFinish());
+
+	cout << endl;
+	cout << "=== Test Results ===" << endl;
+	cout << "Tests Run: " << testsRun << endl;
+	cout << "Tests Passed: " << testsPassed << endl;
+	cout << "Tests Failed: " << (testsRun - testsPassed) << endl;
+
+	return (testsPassed == testsRun) ? 0 : 1;
+}
@@ -3,16 +3,31 @@
 
 #include "../../source/multiplayer/ProjectileSync.h"
 #include "../../source/multiplayer/CollisionAuthority.h"
+#include "../../source/multiplayer/CollisionHistory.h"
+#include "../../source/DataFile.h"
+#include "../../source/DataNode.h"
+#include "../../source/GameData.h"
+#include "../../source/GameState.h"
+#include "../../source/Ship.h"
 #include "../../source/Projectile.h"
 #include "../../source/Point.h"
 #include "../../source/Angle.h"
 #include "../../source/EsUuid.h"
+#include "../../source/Weapon.h"
+#include "../../source/image/ImageBuffer.h"
+#include "../../source/image/Mask.h"
+#include "../../source/image/MaskManager.h"
+#include "../../source/image/Sprite.h"
+#include "../../source/image/SpriteSet.h"
 
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <list>
 #include <vector>
 #include <memory>
+#include <sstream>
+#include <string>
 
 using namespace std;
 
@@ -40,6 +55,32 @@ bool DoubleEqual(double a, double b, double epsilon = 0.001)
 	return abs(a - b) < epsilon;
 }
 
+// Parse the first root node of the given data file text
+DataNode ParseNode(const string &text)
+{
+	istringstream in(text);
+	DataFile file(in);
+	return *file.begin();
+}
+
+// Create a sprite whose collision mask is an opaque square of the given size,
+// without uploading any texture
+const Sprite *SquareSprite(const string &name, int size)
+{
+	ImageBuffer image;
+	image.Allocate(size, size);
+	for(int i = 0; i < size * size; ++i)
+		image.Pixels()[i] = 0xFF000000;
+	vector<Mask> masks(1);
+	masks[0].Create(image, 0, name);
+
+	Sprite *sprite = SpriteSet::Modify(name);
+	GameData::GetMaskManager().SetMasks(sprite, std::move(masks));
+	image.Clear();
+	sprite->AddFrames(image, false, true);
+	return sprite;
+}
+
 
 // ============================================================================
 // ProjectileSync Tests
@@ -90,11 +131,11 @@ void TestProjectileSpawnStructure()
 	ProjectileSync::ProjectileSpawn spawn;
 	spawn.projectileID = 42;
 	spawn.weaponName = "Laser Cannon";
-	spawn.firingShipUUID = EsUuid::Generate();
-	spawn.targetShipUUID = EsUuid::Generate();
+	spawn.firingShipUUID = EsUuid::FromString("3a9f0c52-6c1e-4a5b-9d7e-0b1c2d3e4f50");
+	spawn.targetShipUUID = EsUuid::FromString("7d2e8b41-1f3a-4c6d-8e9f-a0b1c2d3e4f5");
 	spawn.position = Point(100, 200);
 	spawn.velocity = Point(10, 5);
-	spawn.angle = Angle(45);
+	spawn.angle = Angle(45.);
 	spawn.spawnTick = 100;
 
 	TEST("ProjectileSpawn stores projectile ID", spawn.projectileID == 42);
@@ -116,7 +157,6 @@ void TestProjectileImpactRegistration()
 	TEST("ProjectileSync has no pending impacts initially", sync.GetPendingImpacts().empty());
 
 	// Register an impact
-	EsUuid targetUUID = EsUuid::Generate();
 	sync.RegisterImpact(42, nullptr, Point(500, 600), 0.5);
 
 	auto impacts = sync.GetPendingImpacts();
@@ -304,6 +344,149 @@ void TestCollisionAuthorityIntegration()
 
 
 
+void TestCollisionHistory()
+{
+	cout << "\n=== CollisionHistory Tests ===" << endl;
+
+	CollisionHistory history(4);
+	auto first = make_shared<Ship>();
+	auto second = make_shared<Ship>();
+	list<shared_ptr<Ship>> ships = {first, second};
+
+	TEST("CollisionHistory starts empty", history.IsEmpty() && !history.GetPose(*first, 0));
+
+	// Ticks 10..15, with the first ship moving 10 units per tick
+	for(uint64_t tick = 10; tick < 16; ++tick)
+	{
+		first->SetPosition(Point(10. * tick, 0.));
+		second->SetPosition(Point(0., 500.));
+		history.Record(tick, ships);
+	}
+
+	const CollisionHistory::Pose *pose = history.GetPose(*first, 13);
+	TEST("CollisionHistory returns a recorded pose", pose && pose->ship.lock() == first);
+	TEST("CollisionHistory pose holds the old position", pose && DoubleEqual(pose->position.X(), 130.));
+	pose = history.GetPose(*second, 15);
+	TEST("CollisionHistory finds every ship", pose && DoubleEqual(pose->position.Y(), 500.));
+	TEST("CollisionHistory forgets ticks beyond its capacity",
+		!history.GetPose(*first, 11) && history.GetOldestTick() == 12);
+	TEST("CollisionHistory has no future ticks", !history.HasTick(16));
+
+	// A ship that appears later has no pose in earlier ticks
+	auto third = make_shared<Ship>();
+	ships.push_back(third);
+	history.Record(16, ships);
+	TEST("CollisionHistory skips ships not yet present",
+		!history.GetPose(*third, 15) && history.GetPose(*third, 16));
+
+	// Poses of a destroyed ship are never matched with a ship created after it
+	ships.pop_front();
+	first.reset();
+	auto replacement = make_shared<Ship>();
+	pose = history.GetPose(*replacement, 15);
+	TEST("CollisionHistory does not confuse a new ship with a destroyed one", !pose);
+	pose = history.GetPose(*second, 15);
+	TEST("CollisionHistory keeps other poses of the tick", pose && DoubleEqual(pose->position.Y(), 500.));
+
+	history.Clear();
+	TEST("CollisionHistory clear removes all ticks", history.IsEmpty() && !history.HasTick(16));
+}
+
+
+
+void TestCollisionAuthorityLagCompensation()
+{
+	cout << "\n=== CollisionAuthority Lag Compensation Tests ===" << endl;
+
+	// 60 Hz: a 100 ms round trip plus 100 ms interpolation is 12 ticks
+	TEST("Rewind covers round trip and interpolation", CollisionAuthority::GetRewindTicks(100) == 12);
+	TEST("Rewind is capped", CollisionAuthority::GetRewindTicks(5000) == CollisionAuthority::GetRewindTicks(1000));
+
+	CollisionAuthority authority;
+	GameState state;
+	auto ship = make_shared<Ship>();
+	state.AddShip(ship);
+	for(uint64_t tick = 0; tick < 100; ++tick)
+	{
+		state.SetGameTick(tick);
+		ship->SetPosition(Point(10. * tick, 0.));
+		authority.RecordHistory(state);
+	}
+
+	authority.SetShooterLatency(7, 100);
+	TEST("Lag compensation is off by default", authority.GetCollisionTick(7, 99) == 99);
+
+	authority.SetLagCompensation(true);
+	TEST("Player projectiles are rewound", authority.GetCollisionTick(7, 99) == 87);
+	TEST("Other projectiles use the current tick", authority.GetCollisionTick(8, 99) == 99);
+	authority.SetShooterLatency(9, 5000);
+	TEST("Rewind never passes the history",
+		authority.GetCollisionTick(9, 99) >= authority.GetHistory().GetOldestTick());
+
+	const CollisionHistory::Pose *pose = authority.GetHistory().GetPose(*ship, 87);
+	TEST("Rewound ship position is where the shooter saw it", pose && DoubleEqual(pose->position.X(), 870.));
+
+	authority.ForgetProjectile(7);
+	TEST("Forgotten projectiles use the current tick", authority.GetCollisionTick(7, 99) == 99);
+}
+
+
+
+void TestCollisionAuthorityMasks()
+{
+	cout << "\n=== CollisionAuthority Mask Tests ===" << endl;
+
+	// Sprites are drawn at half size, so this ship is a square about 20 units
+	// across at the origin. Projectiles move 100 units per tick.
+	SquareSprite("test/square", 40);
+	auto ship = make_shared<Ship>();
+	ship->Load(ParseNode("ship \"Square\"\n\tsprite \"test/square\"\n"), nullptr);
+	auto shooter = make_shared<Ship>();
+	Weapon weapon(ParseNode("weapon\n\tvelocity 100\n\tlifetime 10\n"));
+	Weapon fused(ParseNode("weapon\n\tvelocity 100\n\tlifetime 10\n\t\"trigger radius\" 6\n"));
+
+	CollisionAuthority authority;
+	double intersection = 1.;
+	Projectile across(*shooter, Point(-30., 0.), Angle(90.), &weapon);
+	TEST("Projectile crossing the mask hits",
+		authority.CheckProjectileShipCollision(across, *ship, intersection));
+	TEST("Hit is reported as a fraction of the tick's movement",
+		intersection > .15 && intersection < .25);
+
+	// This path is within the ship's radius plus any projectile radius, but
+	// misses the square itself until the square is turned by 45 degrees.
+	Projectile past(*shooter, Point(-30., 11.), Angle(90.), &weapon);
+	TEST("Projectile passing the mask misses",
+		!authority.CheckProjectileShipCollision(past, *ship, intersection));
+	ship->SetFacing(Angle(45.));
+	TEST("Mask is tested at the ship's facing",
+		authority.CheckProjectileShipCollision(past, *ship, intersection));
+	ship->SetFacing(Angle());
+
+	// Moving away from the ship, about 4 units from its corner
+	Projectile away(*shooter, Point(13., 13.), Angle(135.), &weapon);
+	Projectile awayFused(*shooter, Point(13., 13.), Angle(135.), &fused);
+	TEST("Projectile without a trigger radius misses a near ship",
+		!authority.CheckProjectileShipCollision(away, *ship, intersection));
+	TEST("Trigger radius sets the projectile off",
+		authority.CheckProjectileShipCollision(awayFused, *ship, intersection) && intersection == 0.);
+
+	// Rewound checks use the recorded position with the ship's own mask.
+	GameState state;
+	state.AddShip(ship);
+	state.SetGameTick(5);
+	authority.RecordHistory(state);
+	ship->SetPosition(Point(500., 0.));
+	state.SetGameTick(6);
+	authority.RecordHistory(state);
+	TEST("Rewound check hits the ship where it was",
+		authority.CheckProjectileShipCollision(across, *ship, 5, intersection));
+	TEST("Current check misses the ship that moved away",
+		!authority.CheckProjectileShipCollision(across, *ship, 6, intersection));
+}
+
+
+
 // ============================================================================
 // Serialization Tests
 // ============================================================================
@@ -318,11 +501,11 @@ void TestSpawnSerializationStructure()
 	ProjectileSync::ProjectileSpawn spawn;
 	spawn.projectileID = 123;
 	spawn.weaponName = "Heavy Laser";
-	spawn.firingShipUUID = EsUuid::Generate();
-	spawn.targetShipUUID = EsUuid::Generate();
+	spawn.firingShipUUID = EsUuid::FromString("5b6c7d8e-9fa0-4b1c-8d2e-3f4a5b6c7d8e");
+	spawn.targetShipUUID = EsUuid::FromString("c1d2e3f4-a5b6-4c7d-8e9f-0a1b2c3d4e5f");
 	spawn.position = Point(1000, 2000);
 	spawn.velocity = Point(50, 100);
-	spawn.angle = Angle(90);
+	spawn.angle = Angle(90.);
 	spawn.spawnTick = 500;
 
 	// Verify structure
@@ -341,7 +524,7 @@ void TestImpactSerializationStructure()
 
 	ProjectileSync::ProjectileImpact impact;
 	impact.projectileID = 456;
-	impact.targetUUID = EsUuid::Generate();
+	impact.targetUUID = EsUuid::FromString("e5f6a7b8-c9d0-4e1f-a2b3-c4d5e6f7a8b9");
 	impact.impactPosition = Point(3000, 4000);
 	impact.intersection = 0.75;
 	impact.impactTick = 600;
@@ -394,6 +577,9 @@ int main()
 	TestCollisionAuthorityStatistics();
 	TestCollisionResultStructure();
 	TestCollisionAuthorityIntegration();
+	TestCollisionHistory();
+	TestCollisionAuthorityLagCompensation();
+	TestCollisionAuthorityMasks();
 
 	// Serialization tests
 	TestSpawnSerializationStructure();
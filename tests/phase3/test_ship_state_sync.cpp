@@ -4,12 +4,16 @@
 #include "../../source/multiplayer/InterestManager.h"
 #include "../../source/multiplayer/DeadReckoning.h"
 #include "../../source/multiplayer/StateSync.h"
+#include "../../source/multiplayer/SendScheduler.h"
+#include "../../source/server/WorldSnapshot.h"
 #include "../../source/Ship.h"
 #include "../../source/GameState.h"
+#include "../../source/Outfit.h"
 #include "../../source/Point.h"
 #include "../../source/Angle.h"
 #include "../../source/EsUuid.h"
 
+#include <chrono>
 #include <iostream>
 #include <cassert>
 #include <cmath>
@@ -42,19 +46,35 @@ bool DoubleEqual(double a, double b, double epsilon = 0.001)
 	return abs(a - b) < epsilon;
 }
 
+// Gives test ships their shield, hull, energy and fuel capacities
+const Outfit &TestHull()
+{
+	static const Outfit hull = []()
+	{
+		Outfit outfit;
+		outfit.Set("shields", 100.);
+		outfit.Set("hull", 200.);
+		outfit.Set("energy capacity", 50.);
+		outfit.Set("fuel capacity", 400.);
+		return outfit;
+	}();
+	return hull;
+}
+
 // Helper function to create a test ship
 shared_ptr<Ship> CreateTestShip(const EsUuid &uuid, const Point &position, const Point &velocity,
 	const Angle &angle, const EsUuid &ownerUUID = EsUuid())
 {
 	auto ship = make_shared<Ship>();
 	ship->SetUUID(uuid);
+	ship->AddOutfit(&TestHull(), 1);
 	ship->SetPosition(position);
 	ship->SetVelocity(velocity);
 	ship->SetFacing(angle);
-	ship->SetShields(1.0);
-	ship->SetHull(1.0);
-	ship->SetEnergy(1.0);
-	ship->SetFuel(1.0);
+	ship->SetShields(100.);
+	ship->SetHull(200.);
+	ship->SetEnergy(50.);
+	ship->SetFuel(400.);
 	if(!ownerUUID.ToString().empty())
 		ship->SetOwnerPlayerUUID(ownerUUID);
 	return ship;
@@ -77,7 +97,7 @@ void TestInterestManagerBasics()
 	config.lowRange = 10000.0;
 	manager.SetConfig(config);
 
-	EsUuid playerUUID = EsUuid::Generate();
+	EsUuid playerUUID;
 
 	// Test player count initially zero
 	TEST("InterestManager starts with zero players", manager.GetPlayerCount() == 0);
@@ -109,26 +129,26 @@ void TestInterestManagerShipFiltering()
 	cout << "\n=== InterestManager Ship Filtering Tests ===" << endl;
 
 	InterestManager manager;
-	EsUuid playerUUID = EsUuid::Generate();
+	EsUuid playerUUID;
 	manager.SetPlayerInterestCenter(playerUUID, Point(0, 0));
 
 	// Create test ships at various distances
 	vector<shared_ptr<Ship>> allShips;
 
 	// Ship 1: Very close (CRITICAL range)
-	allShips.push_back(CreateTestShip(EsUuid::Generate(), Point(500, 0), Point(0, 0), Angle()));
+	allShips.push_back(CreateTestShip(EsUuid(), Point(500, 0), Point(0, 0), Angle()));
 
 	// Ship 2: Close (HIGH range)
-	allShips.push_back(CreateTestShip(EsUuid::Generate(), Point(2000, 0), Point(0, 0), Angle()));
+	allShips.push_back(CreateTestShip(EsUuid(), Point(2000, 0), Point(0, 0), Angle()));
 
 	// Ship 3: Medium distance
-	allShips.push_back(CreateTestShip(EsUuid::Generate(), Point(5000, 0), Point(0, 0), Angle()));
+	allShips.push_back(CreateTestShip(EsUuid(), Point(5000, 0), Point(0, 0), Angle()));
 
 	// Ship 4: Far (LOW range)
-	allShips.push_back(CreateTestShip(EsUuid::Generate(), Point(8000, 0), Point(0, 0), Angle()));
+	allShips.push_back(CreateTestShip(EsUuid(), Point(8000, 0), Point(0, 0), Angle()));
 
 	// Ship 5: Out of range (NONE)
-	allShips.push_back(CreateTestShip(EsUuid::Generate(), Point(15000, 0), Point(0, 0), Angle()));
+	allShips.push_back(CreateTestShip(EsUuid(), Point(15000, 0), Point(0, 0), Angle()));
 
 	// Get interested ships
 	vector<const Ship *> interestedShips = manager.GetInterestedShips(playerUUID, allShips);
@@ -137,7 +157,7 @@ void TestInterestManagerShipFiltering()
 	TEST("InterestManager filters out of range ships", interestedShips.size() == 4);
 
 	// Test player's own ship is always CRITICAL
-	auto ownShip = CreateTestShip(EsUuid::Generate(), Point(5000, 0), Point(0, 0), Angle(), playerUUID);
+	auto ownShip = CreateTestShip(EsUuid(), Point(5000, 0), Point(0, 0), Angle(), playerUUID);
 	InterestManager::InterestLevel ownInterest = manager.GetShipInterest(playerUUID, *ownShip);
 	TEST("Player's own ship is CRITICAL interest", ownInterest == InterestManager::InterestLevel::CRITICAL);
 }
@@ -180,6 +200,181 @@ void TestInterestManagerUpdateFrequency()
 }
 
 
+// Pair each ship with the network ID the server's entity tracker gives it
+vector<InterestManager::Entity> Entities(EntityTracker &tracker, const vector<shared_ptr<Ship>> &ships)
+{
+	vector<InterestManager::Entity> entities;
+	for(const auto &ship : ships)
+		entities.push_back({tracker.ShipId(ship), ship.get()});
+	return entities;
+}
+
+
+InterestManager::InterestLevel GetRelevantLevel(const InterestManager::Relevancy &relevancy, const Ship *ship)
+{
+	for(const auto &entity : relevancy.entities)
+		if(entity.ship == ship)
+			return entity.level;
+	return InterestManager::InterestLevel::NONE;
+}
+
+
+void TestInterestManagerRelevancy()
+{
+	cout << "\n=== InterestManager Relevancy Set Tests ===" << endl;
+
+	InterestManager manager;
+	EsUuid playerUUID;
+	manager.SetPlayerInterestCenter(playerUUID, Point(0, 0));
+
+	EntityTracker tracker;
+	vector<shared_ptr<Ship>> allShips;
+	allShips.push_back(CreateTestShip(EsUuid(), Point(2000, 0), Point(0, 0), Angle()));
+	allShips.push_back(CreateTestShip(EsUuid(), Point(8000, 0), Point(0, 0), Angle()));
+	allShips.push_back(CreateTestShip(EsUuid(), Point(15000, 0), Point(0, 0), Angle()));
+	// The player's own ship is relevant however far away it is
+	allShips.push_back(CreateTestShip(EsUuid(), Point(50000, 0), Point(0, 0), Angle(), playerUUID));
+	const Ship *high = allShips[0].get();
+	const uint16_t lowId = tracker.ShipId(allShips[1]);
+
+	manager.Update(Entities(tracker, allShips));
+	const InterestManager::Relevancy *relevancy = manager.GetRelevancy(playerUUID);
+	TEST("Relevancy set exists for tracked player", relevancy != nullptr);
+	if(!relevancy)
+		return;
+	TEST("Relevancy set skips out of range ships", relevancy->entities.size() == 3);
+	TEST("New ships are reported as entering", relevancy->entered.size() == 3);
+	TEST("New ships are due immediately", relevancy->due.size() == 3);
+	TEST("Own ship is CRITICAL in relevancy set",
+		GetRelevantLevel(*relevancy, allShips[3].get()) == InterestManager::InterestLevel::CRITICAL);
+
+	manager.Update(Entities(tracker, allShips));
+	TEST("No events when nothing moves", relevancy->entered.empty() && relevancy->left.empty());
+
+	// HIGH ends at 3000; with 10% hysteresis it only drops to MEDIUM past 3300
+	allShips[0]->SetPosition(Point(3100, 0));
+	manager.Update(Entities(tracker, allShips));
+	TEST("Hysteresis keeps HIGH just past the boundary",
+		GetRelevantLevel(*relevancy, high) == InterestManager::InterestLevel::HIGH);
+	allShips[0]->SetPosition(Point(3400, 0));
+	manager.Update(Entities(tracker, allShips));
+	TEST("Level drops once clearly past the boundary",
+		GetRelevantLevel(*relevancy, high) == InterestManager::InterestLevel::MEDIUM);
+	allShips[0]->SetPosition(Point(2900, 0));
+	manager.Update(Entities(tracker, allShips));
+	TEST("Level rises as soon as the boundary is crossed",
+		GetRelevantLevel(*relevancy, high) == InterestManager::InterestLevel::HIGH);
+
+	// LOW ends at 10000; the ship only leaves past 11000
+	allShips[1]->SetPosition(Point(10500, 0));
+	manager.Update(Entities(tracker, allShips));
+	TEST("Hysteresis keeps a ship just past the low range", relevancy->left.empty());
+	allShips[1]->SetPosition(Point(11500, 0));
+	manager.Update(Entities(tracker, allShips));
+	TEST("Ship leaving the range is reported",
+		relevancy->left.size() == 1 && relevancy->left[0] == lowId);
+
+	// Ships removed from the game leave the set too
+	const uint16_t removedId = tracker.ShipId(allShips[0]);
+	allShips.erase(allShips.begin());
+	manager.Update(Entities(tracker, allShips));
+	TEST("Removed ship is reported as leaving",
+		relevancy->left.size() == 1 && relevancy->left[0] == removedId);
+}
+
+
+void TestInterestManagerPriority()
+{
+	cout << "\n=== InterestManager Priority Tests ===" << endl;
+
+	InterestManager::Config config;
+	config.maxUpdatesPerTick = 3;
+	InterestManager manager(config);
+	EsUuid playerUUID;
+	manager.SetPlayerInterestCenter(playerUUID, Point(0, 0));
+
+	// More HIGH ships than fit in one update, plus one LOW ship
+	EntityTracker tracker;
+	vector<shared_ptr<Ship>> allShips;
+	for(int i = 0; i < 6; ++i)
+		allShips.push_back(CreateTestShip(EsUuid(), Point(1500 + i, 0), Point(0, 0), Angle()));
+	allShips.push_back(CreateTestShip(EsUuid(), Point(9000, 0), Point(0, 0), Angle()));
+	const uint16_t lowId = tracker.ShipId(allShips.back());
+
+	bool capped = true;
+	int lowUpdates = 0;
+	for(int tick = 0; tick < 100; ++tick)
+	{
+		manager.Update(Entities(tracker, allShips));
+		const InterestManager::Relevancy *relevancy = manager.GetRelevancy(playerUUID);
+		capped &= relevancy->due.size() <= config.maxUpdatesPerTick;
+		for(uint16_t id : relevancy->due)
+			lowUpdates += (id == lowId);
+	}
+	TEST("Due ships are capped per update", capped);
+	TEST("Starved LOW ship still gets updated", lowUpdates >= 5);
+
+	// Without a cap, LOW ships are sent every lowFrequency updates
+	InterestManager uncapped;
+	uncapped.SetPlayerInterestCenter(playerUUID, Point(0, 0));
+	uncapped.Update(Entities(tracker, allShips));
+	lowUpdates = 0;
+	for(int tick = 0; tick < 100; ++tick)
+	{
+		uncapped.Update(Entities(tracker, allShips));
+		for(uint16_t id : uncapped.GetRelevancy(playerUUID)->due)
+			lowUpdates += (id == lowId);
+	}
+	TEST("LOW ship is sent at its update frequency", lowUpdates == 100 / uncapped.GetConfig().lowFrequency);
+}
+
+
+void TestInterestManagerScaling()
+{
+	cout << "\n=== InterestManager Scaling Tests ===" << endl;
+
+	// A full server: 32 players among 2000 ships spread over a large system
+	const int PLAYERS = 32;
+	const int SHIPS = 2000;
+	InterestManager manager;
+	EntityTracker tracker;
+	vector<shared_ptr<Ship>> allShips;
+	for(int i = 0; i < SHIPS; ++i)
+	{
+		Point position((i * 7919) % 80000 - 40000., (i * 104729) % 80000 - 40000.);
+		allShips.push_back(CreateTestShip(EsUuid(), position, Point(10, 0), Angle()));
+	}
+	// Default-constructed UUIDs are each given a distinct value when first used.
+	vector<EsUuid> players(PLAYERS);
+	for(int i = 0; i < PLAYERS; ++i)
+	{
+		allShips[i]->SetOwnerPlayerUUID(players[i]);
+		manager.SetPlayerInterestCenter(players[i], allShips[i]->Position());
+	}
+
+	vector<InterestManager::Entity> entities = Entities(tracker, allShips);
+	manager.Update(entities);
+	const int UPDATES = 100;
+	auto start = chrono::steady_clock::now();
+	for(int tick = 0; tick < UPDATES; ++tick)
+	{
+		for(auto &ship : allShips)
+			ship->SetPosition(ship->Position() + ship->Velocity());
+		manager.Update(entities);
+	}
+	double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / UPDATES;
+	cout << "  Update with " << PLAYERS << " players and " << SHIPS << " ships: "
+		<< milliseconds << " ms" << endl;
+
+	// The grid must find the same ships as checking every ship
+	const InterestManager::Relevancy *relevancy = manager.GetRelevancy(players[0]);
+	vector<const Ship *> interested = manager.GetInterestedShips(players[0], allShips);
+	bool found = relevancy != nullptr;
+	for(const Ship *ship : interested)
+		found &= relevancy && GetRelevantLevel(*relevancy, ship) != InterestManager::InterestLevel::NONE;
+	TEST("Grid finds every ship in range", found);
+}
+
 // ============================================================================
 // DeadReckoning Tests
 // ============================================================================
@@ -210,7 +405,7 @@ void TestDeadReckoningPrediction()
 	DeadReckoning dr;
 
 	// Start at position (0, 0) with velocity (10, 5) at tick 100
-	DeadReckoning::State initialState(Point(0, 0), Point(10, 5), Angle(0), 100);
+	DeadReckoning::State initialState(Point(0, 0), Point(10, 5), Angle(0.), 100);
 	dr.SetAuthoritativeState(initialState);
 
 	// Predict 10 ticks ahead (should be at position (100, 50))
@@ -233,8 +428,8 @@ void TestDeadReckoningError()
 	cout << "\n=== DeadReckoning Error Detection Tests ===" << endl;
 
 	DeadReckoning dr;
-	DeadReckoning::State predictedState(Point(100, 50), Point(10, 5), Angle(0), 110);
-	DeadReckoning::State actualState(Point(110, 55), Point(10, 5), Angle(0), 110);
+	DeadReckoning::State predictedState(Point(100, 50), Point(10, 5), Angle(0.), 110);
+	DeadReckoning::State actualState(Point(110, 55), Point(10, 5), Angle(0.), 110);
 
 	// Calculate error (distance between predicted and actual)
 	double error = dr.GetPositionError(predictedState, actualState);
@@ -255,7 +450,7 @@ void TestDeadReckoningReset()
 	cout << "\n=== DeadReckoning Reset Tests ===" << endl;
 
 	DeadReckoning dr;
-	dr.SetAuthoritativeState(DeadReckoning::State(Point(100, 100), Point(10, 10), Angle(45), 100));
+	dr.SetAuthoritativeState(DeadReckoning::State(Point(100, 100), Point(10, 10), Angle(45.), 100));
 	dr.SetCurrentTimestamp(100);
 
 	// Reset
@@ -297,15 +492,17 @@ void TestStateSyncCaptureShipState()
 	stateSync.SetCurrentTick(100);
 
 	// Create a test ship
-	auto ship = CreateTestShip(EsUuid::Generate(), Point(100, 200), Point(5, 10), Angle(90));
-	ship->SetShields(0.8);
-	ship->SetHull(0.9);
-	ship->SetEnergy(0.7);
-	ship->SetFuel(0.6);
+	auto ship = CreateTestShip(EsUuid(), Point(100, 200), Point(5, 10), Angle(90.));
+	// Ships store absolute levels; updates carry fractions of the maximum.
+	ship->SetShields(80.);
+	ship->SetHull(180.);
+	ship->SetEnergy(35.);
+	ship->SetFuel(240.);
 
 	// Capture full state
 	StateSync::ShipUpdate update = stateSync.CaptureShipState(*ship, StateSync::UpdateScope::FULL);
 
+	TEST("StateSync captures ship UUID", update.shipUUID == ship->UUID());
 	TEST("StateSync captures position", DoubleEqual(update.position.X(), 100));
 	TEST("StateSync captures velocity", DoubleEqual(update.velocity.Y(), 10));
 	TEST("StateSync captures shields", DoubleEqual(update.shields, 0.8));
@@ -329,14 +526,14 @@ void TestStateSyncApplyUpdate()
 	stateSync.SetCurrentTick(100);
 
 	// Create a ship with initial state
-	auto ship = CreateTestShip(EsUuid::Generate(), Point(0, 0), Point(0, 0), Angle(0));
+	auto ship = CreateTestShip(EsUuid(), Point(0, 0), Point(0, 0), Angle(0.));
 
 	// Create an update
 	StateSync::ShipUpdate update;
-	update.shipUUID = ship->UUID();
+	update.shipUUID.Clone(ship->UUID());
 	update.position = Point(100, 200);
 	update.velocity = Point(5, 10);
-	update.angle = Angle(45);
+	update.angle = Angle(45.);
 	update.shields = 0.8f;
 	update.hull = 0.9f;
 	update.energy = 0.7f;
@@ -365,13 +562,13 @@ void TestStateSyncUpdatePriority()
 	InterestManager manager;
 	stateSync.SetInterestManager(&manager);
 
-	EsUuid playerUUID = EsUuid::Generate();
+	EsUuid playerUUID;
 	manager.SetPlayerInterestCenter(playerUUID, Point(0, 0));
 
 	// Create ships at different distances
-	auto closeShip = CreateTestShip(EsUuid::Generate(), Point(500, 0), Point(0, 0), Angle());
-	auto mediumShip = CreateTestShip(EsUuid::Generate(), Point(5000, 0), Point(0, 0), Angle());
-	auto farShip = CreateTestShip(EsUuid::Generate(), Point(15000, 0), Point(0, 0), Angle());
+	auto closeShip = CreateTestShip(EsUuid(), Point(500, 0), Point(0, 0), Angle());
+	auto mediumShip = CreateTestShip(EsUuid(), Point(5000, 0), Point(0, 0), Angle());
+	auto farShip = CreateTestShip(EsUuid(), Point(15000, 0), Point(0, 0), Angle());
 
 	// Test priority levels
 	StateSync::UpdatePriority closePriority = stateSync.GetUpdatePriority(playerUUID, *closeShip);
@@ -412,14 +609,14 @@ void TestStateSyncGetUpdatesForPlayer()
 	stateSync.SetInterestManager(&manager);
 	stateSync.SetCurrentTick(100);
 
-	EsUuid playerUUID = EsUuid::Generate();
+	EsUuid playerUUID;
 	manager.SetPlayerInterestCenter(playerUUID, Point(0, 0));
 
 	// Create test ships
 	vector<shared_ptr<Ship>> allShips;
-	allShips.push_back(CreateTestShip(EsUuid::Generate(), Point(500, 0), Point(0, 0), Angle()));     // Close
-	allShips.push_back(CreateTestShip(EsUuid::Generate(), Point(2000, 0), Point(0, 0), Angle()));    // Medium
-	allShips.push_back(CreateTestShip(EsUuid::Generate(), Point(15000, 0), Point(0, 0), Angle()));   // Far (out of range)
+	allShips.push_back(CreateTestShip(EsUuid(), Point(500, 0), Point(0, 0), Angle()));     // Close
+	allShips.push_back(CreateTestShip(EsUuid(), Point(2000, 0), Point(0, 0), Angle()));    // Medium
+	allShips.push_back(CreateTestShip(EsUuid(), Point(15000, 0), Point(0, 0), Angle()));   // Far (out of range)
 
 	// Get updates for this player
 	vector<StateSync::ShipUpdate> updates = stateSync.GetUpdatesForPlayer(playerUUID, allShips);
@@ -429,15 +626,84 @@ void TestStateSyncGetUpdatesForPlayer()
 }
 
 
+void TestStateSyncBandwidthScheduling()
+{
+	cout << "\n=== StateSync Bandwidth Scheduling Tests ===" << endl;
+
+	StateSync stateSync;
+	InterestManager manager;
+	stateSync.SetInterestManager(&manager);
+	stateSync.SetCurrentTick(100);
+
+	EsUuid playerUUID;
+	manager.SetPlayerInterestCenter(playerUUID, Point(0, 0));
+
+	TEST("MINIMAL updates are smaller than POSITION updates",
+		StateSync::GetUpdateSize(StateSync::UpdateScope::MINIMAL)
+			< StateSync::GetUpdateSize(StateSync::UpdateScope::POSITION));
+	TEST("POSITION updates are smaller than FULL updates",
+		StateSync::GetUpdateSize(StateSync::UpdateScope::POSITION)
+			< StateSync::GetUpdateSize(StateSync::UpdateScope::FULL));
+
+	vector<shared_ptr<Ship>> allShips;
+	allShips.push_back(CreateTestShip(EsUuid(), Point(0, 0), Point(0, 0), Angle(), playerUUID));
+	for(int i = 0; i < 10; ++i)
+		allShips.push_back(CreateTestShip(EsUuid(), Point(2000, i * 10.), Point(0, 0), Angle()));
+	EntityTracker tracker;
+	vector<InterestManager::Entity> entities = Entities(tracker, allShips);
+
+	// With no limit, every interesting ship is sent in full.
+	manager.Update(entities);
+	SendScheduler unlimited(BandwidthBudget(0));
+	vector<StateSync::ShipUpdate> updates = stateSync.GetUpdatesForPlayer(playerUUID, unlimited);
+	TEST("Unlimited budget sends every ship", updates.size() == allShips.size());
+	TEST("Unlimited budget does not degrade", unlimited.GetDegradedCount() == 0);
+
+	// Room for the own ship and a few reduced updates per tick
+	const size_t perTick = StateSync::GetUpdateSize(StateSync::UpdateScope::FULL)
+		+ 3 * StateSync::GetUpdateSize(StateSync::UpdateScope::POSITION);
+	SendScheduler limited(BandwidthBudget(perTick * NetworkConstants::SERVER_UPDATE_RATE));
+	limited.GetBudget().Consume(static_cast<size_t>(limited.GetBudget().GetAvailable()));
+	updates = stateSync.GetUpdatesForPlayer(playerUUID, limited);
+	TEST("Own ship is sent first", !updates.empty() && updates[0].scope == StateSync::UpdateScope::FULL
+		&& updates[0].position.X() == 0.);
+	TEST("Limited budget degrades scope", limited.GetDegradedCount() > 0);
+	TEST("Limited budget carries ships over", limited.GetDeferredCount() > 0
+		&& limited.GetWaitingCount() == limited.GetDeferredCount());
+	TEST("Limited budget is not exceeded", limited.GetScheduledBytes() <= perTick);
+
+	// Carried-over ships go out in later ticks.
+	size_t sent = updates.size() - 1;
+	for(int tick = 0; tick < 10 && limited.GetWaitingCount(); ++tick)
+	{
+		stateSync.SetCurrentTick(101 + tick);
+		manager.Update(entities);
+		sent += stateSync.GetUpdatesForPlayer(playerUUID, limited).size() - 1;
+	}
+	TEST("Every ship is eventually sent", sent >= allShips.size() - 1);
+
+	// A ship the player is targeting is sent in full, however far away it is.
+	auto target = CreateTestShip(EsUuid(), Point(50000, 0), Point(0, 0), Angle());
+	allShips[0]->SetTargetShip(target);
+	allShips.push_back(target);
+	entities = Entities(tracker, allShips);
+	manager.Update(entities);
+	updates = stateSync.GetUpdatesForPlayer(playerUUID, unlimited);
+	bool targetSent = false;
+	for(const StateSync::ShipUpdate &update : updates)
+		targetSent |= (update.shipUUID == target->UUID() && update.scope == StateSync::UpdateScope::FULL);
+	TEST("Distant target is sent in full", targetSent);
+}
+
 void TestStateSyncDeadReckoningIntegration()
 {
 	cout << "\n=== StateSync Dead Reckoning Integration Tests ===" << endl;
 
 	StateSync stateSync;
-	EsUuid shipUUID = EsUuid::Generate();
+	EsUuid shipUUID;
 
 	// Update dead reckoning state
-	DeadReckoning::State drState(Point(0, 0), Point(10, 5), Angle(0), 100);
+	DeadReckoning::State drState(Point(0, 0), Point(10, 5), Angle(0.), 100);
 	stateSync.UpdateDeadReckoning(shipUUID, drState);
 
 	TEST("StateSync tracks ship for dead reckoning", stateSync.GetTrackedShipCount() == 1);
@@ -466,6 +732,9 @@ int main()
 	TestInterestManagerBasics();
 	TestInterestManagerShipFiltering();
 	TestInterestManagerUpdateFrequency();
+	TestInterestManagerRelevancy();
+	TestInterestManagerPriority();
+	TestInterestManagerScaling();
 
 	// DeadReckoning tests
 	TestDeadReckoningBasics();
@@ -480,6 +749,7 @@ int main()
 	TestStateSyncUpdatePriority();
 	TestStateSyncUpdateScope();
 	TestStateSyncGetUpdatesForPlayer();
+	TestStateSyncBandwidthScheduling();
 	TestStateSyncDeadReckoningIntegration();
 
 	// Summary
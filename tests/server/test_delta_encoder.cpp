@@ -0,0 +1,490 @@
+/* test_delta_encoder.cpp
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Unit tests for field-level world state delta compression:
+ * - Keyframe round trip
+ * - Only changed fields are transmitted
+ * - Entity spawns and removals
+ * - Baseline validation on decode
+ * - Record sharing between consecutive snapshots
+ * - Quantized encoding
+ * - Entity fragments shared between clients' packets
+ */
+
+#include "../../source/server/DeltaEncoder.h"
+#include "../../source/network/PacketReader.h"
+#include "../../source/network/PacketStructs.h"
+#include "../../source/network/PacketWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <set>
+
+using namespace std;
+using namespace NetworkPacket;
+
+// Stub Random class for Angle and EsUuid
+namespace Random {
+	void Seed(uint64_t seed) {}
+	uint64_t Int() { return 0; }
+	uint32_t Int(uint32_t max) { return max > 0 ? 0 : 0; }
+}
+
+// Stub Logger class for EsUuid
+namespace Logger {
+	enum class Level { ERROR };
+	void Log(const std::string &message, Level level = Level::ERROR) {}
+}
+
+
+// Test result tracking
+int testsRun = 0;
+int testsPassed = 0;
+
+void ReportTest(const string &name, bool passed)
+{
+	testsRun++;
+	if(passed)
+	{
+		testsPassed++;
+		cout << "[PASS] " << name << endl;
+	}
+	else
+	{
+		cout << "[FAIL] " << name << endl;
+	}
+}
+
+
+ShipRecord MakeShip(uint16_t id, double x, double y)
+{
+	ShipRecord ship;
+	ship.id = id;
+	ship.position = Point(x, y);
+	ship.velocity = Point(1., -2.);
+	ship.facing = Angle(45.);
+	ship.shields = .75f;
+	ship.hull = 1.f;
+	ship.energy = .5f;
+	ship.fuel = .25f;
+	ship.flags = 0x0001;
+	return ship;
+}
+
+
+// Plain record lists, which tests modify before building a snapshot.
+struct Entities {
+	vector<ShipRecord> ships;
+	vector<ProjectileRecord> projectiles;
+	vector<FlotsamRecord> flotsam;
+};
+
+
+Entities MakeEntities()
+{
+	Entities entities;
+	entities.ships.push_back(MakeShip(1, 100., 200.));
+	entities.ships.push_back(MakeShip(2, -300., 50.));
+	entities.ships.push_back(MakeShip(3, 0., 0.));
+
+	ProjectileRecord projectile;
+	projectile.id = 10;
+	projectile.position = Point(5., 5.);
+	projectile.velocity = Point(20., 0.);
+	projectile.facing = Angle(90.);
+	entities.projectiles.push_back(projectile);
+
+	FlotsamRecord flotsam;
+	flotsam.id = 20;
+	flotsam.position = Point(-5., 7.);
+	flotsam.velocity = Point(.1, .1);
+	flotsam.count = 4;
+	entities.flotsam.push_back(flotsam);
+
+	return entities;
+}
+
+
+WorldSnapshot MakeWorld(uint64_t tick, const Entities &entities = MakeEntities(),
+	const WorldSnapshot *previous = nullptr)
+{
+	WorldSnapshot world;
+	world.gameTick = tick;
+	world.ships.Assign(entities.ships, previous ? &previous->ships : nullptr);
+	world.projectiles.Assign(entities.projectiles, previous ? &previous->projectiles : nullptr);
+	world.flotsam.Assign(entities.flotsam, previous ? &previous->flotsam : nullptr);
+	return world;
+}
+
+
+bool SameShip(const ShipRecord &a, const ShipRecord &b)
+{
+	return a.id == b.id && a.position == b.position && a.velocity == b.velocity
+		&& a.facing.Degrees() == b.facing.Degrees() && a.shields == b.shields && a.hull == b.hull
+		&& a.energy == b.energy && a.fuel == b.fuel && a.flags == b.flags;
+}
+
+
+bool SameWorld(const WorldSnapshot &a, const WorldSnapshot &b)
+{
+	if(a.gameTick != b.gameTick || a.ships.size() != b.ships.size()
+			|| a.projectiles.size() != b.projectiles.size() || a.flotsam.size() != b.flotsam.size())
+		return false;
+	if(!equal(a.ships.begin(), a.ships.end(), b.ships.begin(), SameShip))
+		return false;
+	if(!equal(a.projectiles.begin(), a.projectiles.end(), b.projectiles.begin(),
+			[](const ProjectileRecord &x, const ProjectileRecord &y)
+			{ return x.id == y.id && x.position == y.position; }))
+		return false;
+	return equal(a.flotsam.begin(), a.flotsam.end(), b.flotsam.begin(),
+		[](const FlotsamRecord &x, const FlotsamRecord &y)
+		{ return x.id == y.id && x.position == y.position && x.count == y.count; });
+}
+
+
+// Encode current against baseline and decode it again.
+bool RoundTrip(const WorldSnapshot *baseline, const WorldSnapshot &current, WorldSnapshot &decoded,
+	size_t *encodedSize = nullptr, bool quantized = false)
+{
+	DeltaEncoder encoder(nullptr, quantized);
+	PacketWriter writer(PacketType::SERVER_WORLD_STATE);
+	size_t size = encoder.Encode(baseline, current, writer);
+	if(encodedSize)
+		*encodedSize = size;
+
+	PacketReader reader(writer.GetDataPtr(), writer.GetSize());
+	DeltaEncoder::Header header;
+	if(!reader.IsValid() || !DeltaEncoder::ReadHeader(reader, header))
+		return false;
+	if(header.gameTick != current.gameTick || header.isKeyframe != (baseline == nullptr)
+			|| header.isQuantized != quantized)
+		return false;
+
+	return DeltaEncoder::Decode(reader, header, baseline, decoded) && reader.GetRemainingBytes() == 0;
+}
+
+
+// Test 1: A keyframe reproduces every entity
+bool TestKeyframeRoundTrip()
+{
+	WorldSnapshot world = MakeWorld(100);
+	WorldSnapshot decoded;
+	if(!RoundTrip(nullptr, world, decoded))
+		return false;
+
+	return SameWorld(world, decoded);
+}
+
+
+// Test 2: Unchanged entities cost nothing beyond the section headers
+bool TestUnchangedDelta()
+{
+	WorldSnapshot baseline = MakeWorld(100);
+	WorldSnapshot current = MakeWorld(103);
+
+	WorldSnapshot decoded;
+	size_t size = 0;
+	if(!RoundTrip(&baseline, current, decoded, &size))
+		return false;
+
+	// Header (8 + 8 + 1) plus eight empty section counts.
+	if(size != 17 + 8 * 2)
+		return false;
+
+	return SameWorld(current, decoded);
+}
+
+
+// Test 3: Only the changed fields of a changed ship are sent
+bool TestChangedFields()
+{
+	WorldSnapshot baseline = MakeWorld(100);
+	Entities entities = MakeEntities();
+	entities.ships[1].position = Point(-290., 55.);
+	entities.ships[1].hull = .5f;
+	WorldSnapshot current = MakeWorld(103, entities);
+
+	WorldSnapshot decoded;
+	size_t size = 0;
+	if(!RoundTrip(&baseline, current, decoded, &size))
+		return false;
+
+	// One change: ID (2) + mask (1) + position (16) + hull (4).
+	if(size != 17 + 8 * 2 + 2 + 1 + 16 + 4)
+		return false;
+
+	if(DeltaEncoder::DiffShip(*baseline.ships.Find(2), *current.ships.Find(2))
+			!= (DeltaEncoder::SHIP_POSITION | DeltaEncoder::SHIP_HULL))
+		return false;
+
+	return SameWorld(current, decoded);
+}
+
+
+// Test 4: Spawns and removals of every entity type
+bool TestSpawnsAndRemovals()
+{
+	WorldSnapshot baseline = MakeWorld(100);
+	Entities entities = MakeEntities();
+
+	// Ship 1 is destroyed and ship 4 arrives.
+	entities.ships.erase(entities.ships.begin());
+	entities.ships.push_back(MakeShip(4, 1000., 1000.));
+	// The projectile dies and a new one is fired.
+	entities.projectiles[0].id = 11;
+	// Some of the flotsam is picked up.
+	entities.flotsam[0].count = 2;
+	WorldSnapshot current = MakeWorld(103, entities);
+
+	WorldSnapshot decoded;
+	if(!RoundTrip(&baseline, current, decoded))
+		return false;
+
+	return SameWorld(current, decoded);
+}
+
+
+// Test 5: A delta is rejected if applied to the wrong baseline
+bool TestBaselineMismatch()
+{
+	WorldSnapshot baseline = MakeWorld(100);
+	WorldSnapshot other = MakeWorld(97);
+	WorldSnapshot current = MakeWorld(103);
+
+	DeltaEncoder encoder;
+	PacketWriter writer(PacketType::SERVER_WORLD_STATE);
+	encoder.Encode(&baseline, current, writer);
+
+	PacketReader reader(writer.GetDataPtr(), writer.GetSize());
+	DeltaEncoder::Header header;
+	DeltaEncoder::ReadHeader(reader, header);
+	if(header.baselineTick != 100)
+		return false;
+
+	WorldSnapshot decoded;
+	return !DeltaEncoder::Decode(reader, header, &other, decoded)
+		&& !DeltaEncoder::Decode(reader, header, nullptr, decoded);
+}
+
+
+// Test 6: A delta is much smaller than a keyframe for a mostly idle world
+bool TestCompressionRatio()
+{
+	Entities entities;
+	for(uint16_t i = 1; i <= 200; ++i)
+		entities.ships.push_back(MakeShip(i, i * 10., i * -10.));
+	WorldSnapshot baseline = MakeWorld(100, entities);
+	// A tenth of the ships move.
+	for(size_t i = 0; i < entities.ships.size(); i += 10)
+		entities.ships[i].position += Point(1., 1.);
+	WorldSnapshot current = MakeWorld(103, entities);
+
+	DeltaEncoder encoder;
+	PacketWriter keyframe(PacketType::SERVER_WORLD_STATE);
+	PacketWriter delta(PacketType::SERVER_WORLD_STATE);
+	size_t keyframeSize = encoder.Encode(nullptr, current, keyframe);
+	size_t deltaSize = encoder.Encode(&baseline, current, delta);
+
+	return deltaSize * 10 < keyframeSize;
+}
+
+
+// Test 7: Unchanged records are shared with the previous snapshot
+bool TestStructuralSharing()
+{
+	Entities entities;
+	for(uint16_t i = 1; i <= 160; ++i)
+		entities.ships.push_back(MakeShip(i, i * 10., i * -10.));
+	WorldSnapshot first = MakeWorld(100, entities);
+	size_t chunks = first.ships.GetChunkCount();
+
+	// One ship moves, one is destroyed and one arrives.
+	entities.ships[5].position += Point(1., 1.);
+	entities.ships.erase(entities.ships.begin() + 100);
+	entities.ships.push_back(MakeShip(161, 0., 0.));
+	WorldSnapshot second = MakeWorld(101, entities, &first);
+
+	// Only the chunks touched by the changes (and the appended ship) are new.
+	if(second.ships.GetSharedChunkCount() + 3 < chunks)
+		return false;
+	if(second.ships.size() != entities.ships.size()
+			|| !equal(second.ships.begin(), second.ships.end(), entities.ships.begin()))
+		return false;
+	if(!second.ships.Find(161) || second.ships.Find(101) || second.ships.Find(6)->position != entities.ships[5].position)
+		return false;
+
+	// The shared storage is only counted once.
+	set<const void *> counted;
+	size_t firstBytes = first.ships.GetMemoryUsage(&counted);
+	size_t secondBytes = second.ships.GetMemoryUsage(&counted);
+	if(secondBytes * 4 > firstBytes)
+		return false;
+
+	// Encoding skips the shared chunks but still finds every change.
+	WorldSnapshot decoded;
+	return RoundTrip(&first, second, decoded) && SameWorld(second, decoded);
+}
+
+
+// Test 8: Quantized values stay within one quantization step
+bool TestQuantizedRoundTrip()
+{
+	Entities entities = MakeEntities();
+	entities.ships[0].position = Point(123456.789, -98765.4321);
+	entities.ships[0].velocity = Point(12.345, -6.789);
+	entities.ships[0].facing = Angle(123.456);
+	entities.ships[0].shields = .333f;
+	entities.ships[0].hull = 0.f;
+	entities.ships[0].energy = 1.f;
+	WorldSnapshot world = MakeWorld(100, entities);
+
+	WorldSnapshot decoded;
+	if(!RoundTrip(nullptr, world, decoded, nullptr, true))
+		return false;
+
+	const ShipRecord &original = entities.ships[0];
+	const ShipRecord *ship = decoded.ships.Find(original.id);
+	if(!ship)
+		return false;
+	// Facing is quantized to the Angle class's own resolution, so it is exact.
+	return ship->position.Distance(original.position) <= .5 / Quantization::POSITION_SCALE * 1.5
+		&& ship->velocity.Distance(original.velocity) <= .5 / Quantization::VELOCITY_SCALE * 1.5
+		&& ship->facing.Degrees() == original.facing.Degrees()
+		&& abs(ship->shields - original.shields) <= .5f / 255.f
+		&& ship->hull == 0.f && ship->energy == 1.f && ship->flags == original.flags;
+}
+
+
+// Test 9: A moving ship costs under 20 bytes in the quantized format
+bool TestQuantizedSize()
+{
+	Entities entities;
+	for(uint16_t i = 1; i <= 50; ++i)
+		entities.ships.push_back(MakeShip(i, i * 10., i * -10.));
+	WorldSnapshot baseline = MakeWorld(100, entities);
+
+	// Every ship moves and turns, as ships in flight do.
+	for(ShipRecord &ship : entities.ships)
+	{
+		ship.position += Point(3., 4.);
+		ship.velocity += Point(.5, .5);
+		ship.facing += 2.;
+	}
+	WorldSnapshot current = MakeWorld(103, entities);
+
+	WorldSnapshot decoded;
+	size_t size = 0;
+	if(!RoundTrip(&baseline, current, decoded, &size, true))
+		return false;
+
+	size_t perShip = (size - (17 + 8 * 2)) / entities.ships.size();
+	if(perShip >= 20)
+		return false;
+
+	// Changes below the quantization step are not sent at all.
+	Entities jitter = entities;
+	for(ShipRecord &ship : jitter.ships)
+		ship.position += Point(.001, -.001);
+	WorldSnapshot jittered = MakeWorld(106, jitter);
+	if(!RoundTrip(&current, jittered, decoded, &size, true))
+		return false;
+	return size == 17 + 8 * 2;
+}
+
+
+// Test 10: UUIDs are written as 16 raw bytes
+bool TestRawUuid()
+{
+	EsUuid uuid = EsUuid::FromString("550e8400-e29b-41d4-a716-446655440000");
+	PacketWriter writer(PacketType::SERVER_WORLD_STATE);
+	writer.WriteUuid(uuid);
+	if(writer.GetSize() != PACKET_HEADER_SIZE + 16)
+		return false;
+
+	PacketReader reader(writer.GetDataPtr(), writer.GetSize());
+	return reader.ReadUuid().ToString() == uuid.ToString() && !reader.HasError();
+}
+
+
+// Test 11: Packets for several baselines reuse each other's entity encodings
+bool TestFragmentReuse()
+{
+	Entities entities = MakeEntities();
+	WorldSnapshot older = MakeWorld(100, entities);
+	entities.ships[0].position = Point(110., 200.);
+	WorldSnapshot baseline = MakeWorld(101, entities, &older);
+	entities.ships[0].position = Point(120., 200.);
+	entities.ships[1].hull = .5f;
+	WorldSnapshot current = MakeWorld(102, entities, &baseline);
+
+	// One encoder serves every client, as in SnapshotManager.
+	DeltaEncoder shared;
+	const vector<const WorldSnapshot *> baselines = {&older, &baseline, nullptr, &older};
+	vector<vector<uint8_t>> packets;
+	for(const WorldSnapshot *base : baselines)
+	{
+		PacketWriter writer(PacketType::SERVER_WORLD_STATE);
+		shared.Encode(base, current, writer);
+		packets.push_back(writer.GetData());
+	}
+	// Ship 1 moved relative to both baselines, so its encoding is shared, and
+	// the repeated baseline reuses every fragment.
+	if(!shared.GetFragmentReuseCount())
+		return false;
+
+	// Every packet decodes correctly against its own baseline. (Spawned ships
+	// carry fresh blank UUIDs, so the bytes differ from an unshared encoder's.)
+	for(size_t i = 0; i < packets.size(); ++i)
+	{
+		PacketReader reader(packets[i].data(), packets[i].size());
+		DeltaEncoder::Header header;
+		WorldSnapshot decoded;
+		if(!DeltaEncoder::ReadHeader(reader, header)
+				|| !DeltaEncoder::Decode(reader, header, baselines[i], decoded) || !SameWorld(current, decoded))
+			return false;
+	}
+	// Identical baselines produce identical packets.
+	if(packets[0] != packets[3])
+		return false;
+
+	// A new snapshot starts a new pool.
+	size_t fragments = shared.GetFragmentCount();
+	WorldSnapshot next = MakeWorld(103, entities, &current);
+	PacketWriter writer(PacketType::SERVER_WORLD_STATE);
+	shared.Encode(&current, next, writer);
+	return fragments && !shared.GetFragmentCount() && !shared.GetFragmentReuseCount();
+}
+
+
+int main()
+{
+	cout << "==================================" << endl;
+	cout << "Delta Encoder Tests" << endl;
+	cout << "==================================" << endl;
+	cout << endl;
+
+	ReportTest("Keyframe round trip", TestKeyframeRoundTrip());
+	ReportTest("Unchanged delta", TestUnchangedDelta());
+	ReportTest("Changed fields only", TestChangedFields());
+	ReportTest("Spawns and removals", TestSpawnsAndRemovals());
+	ReportTest("Baseline mismatch", TestBaselineMismatch());
+	ReportTest("Compression ratio", TestCompressionRatio());
+	ReportTest("Structural sharing", TestStructuralSharing());
+	ReportTest("Quantized round trip", TestQuantizedRoundTrip());
+	ReportTest("Quantized size", TestQuantizedSize());
+	ReportTest("Raw UUID", TestRawUuid());
+	ReportTest("Fragment reuse", TestFragmentReuse());
+	cout << endl;
+
+	// Summary
+	cout << "==================================" << endl;
+	cout << "Tests: " << testsPassed << "/" << testsRun << " passed";
+	if(testsPassed == testsRun)
+		cout << " ✓" << endl;
+	else
+		cout << " ✗" << endl;
+	cout << "==================================" << endl;
+
+	return (testsPassed == testsRun) ? 0 : 1;
+}
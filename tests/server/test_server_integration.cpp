@@ -14,6 +14,7 @@
 #include "../../source/server/SnapshotManager.h"
 #include "../../source/server/ServerLoop.h"
 #include "../../source/GameState.h"
+#include "../../source/Ship.h"
 
 #include <iostream>
 #include <fstream>
@@ -97,6 +98,7 @@ bool TestServerConfigFile()
 	config1.SetPort(55555);
 	config1.SetServerName("Saved Server");
 	config1.SetMaxPlayers(100);
+	config1.SetShipUpdates(true);
 
 	// Save to file
 	string filename = "test_config.txt";
@@ -118,6 +120,9 @@ bool TestServerConfigFile()
 	if(config2.GetMaxPlayers() != 100)
 		return false;
 
+	if(!config2.HasShipUpdates())
+		return false;
+
 	// Cleanup
 	remove(filename.c_str());
 
@@ -246,6 +251,292 @@ bool TestSnapshotManagerKeyframes()
 }
 
 
+// SnapshotManager ring buffer: lookups by tick and catchup order
+bool TestSnapshotManagerRing()
+{
+	SnapshotManager manager(4);
+
+	// Ticks 10..15, skipping 13
+	for(uint64_t i = 10; i < 16; ++i)
+	{
+		if(i == 13)
+			continue;
+		GameState state;
+		state.SetGameTick(i);
+		manager.CreateSnapshot(state, i);
+	}
+
+	// History covers ticks 12..15, and tick 13 was never created
+	if(manager.GetSnapshotCount() != 3)
+		return false;
+	if(manager.GetSnapshotAtTick(11) || manager.GetSnapshotAtTick(13))
+		return false;
+	for(uint64_t tick : {12, 14, 15})
+	{
+		const Snapshot *snap = manager.GetSnapshotAtTick(tick);
+		if(!snap || snap->gameTick != tick)
+			return false;
+	}
+
+	// Catchup returns the remaining snapshots oldest first
+	vector<const Snapshot *> since = manager.GetSnapshotsSince(10);
+	if(since.size() != 3 || since[0]->gameTick != 12 || since[1]->gameTick != 14 || since[2]->gameTick != 15)
+		return false;
+	manager.GetSnapshotsSince(14, since);
+	if(since.size() != 1 || since[0]->gameTick != 15)
+		return false;
+
+	// Shrinking the history keeps the most recent snapshots
+	manager.SetHistorySize(2);
+	if(manager.GetSnapshotCount() != 2 || !manager.GetSnapshotAtTick(14) || !manager.GetSnapshotAtTick(15))
+		return false;
+
+	return true;
+}
+
+
+// SnapshotManager pruning keeps acknowledged baselines
+bool TestSnapshotManagerPruneBaseline()
+{
+	SnapshotManager manager(10);
+	for(uint64_t i = 0; i < 8; ++i)
+	{
+		GameState state;
+		state.SetGameTick(i);
+		manager.CreateSnapshot(state, i);
+	}
+
+	manager.AcknowledgeSnapshot(1, 5);
+	manager.AcknowledgeSnapshot(2, 3);
+	if(manager.GetOldestBaselineTick() != 3)
+		return false;
+
+	// Client 2's baseline at tick 3 must survive
+	manager.PruneOlderThan(7);
+	if(manager.GetSnapshotCount() != 5 || !manager.GetSnapshotAtTick(3) || manager.GetSnapshotAtTick(2))
+		return false;
+	if(!manager.GetClientBaseline(2))
+		return false;
+
+	// Once client 2 leaves, only client 1's baseline holds pruning back
+	manager.RemoveClient(2);
+	if(manager.GetOldestBaselineTick() != 5)
+		return false;
+	manager.PruneOlderThan(7);
+	if(manager.GetSnapshotCount() != 3 || !manager.GetSnapshotAtTick(5) || manager.GetSnapshotAtTick(4))
+		return false;
+
+	return true;
+}
+
+
+// SnapshotManager keeps a client's baseline after its slot is reused
+bool TestSnapshotManagerPinnedBaseline()
+{
+	SnapshotManager manager(4);
+	for(uint64_t i = 0; i < 4; ++i)
+	{
+		GameState state;
+		state.SetGameTick(i);
+		manager.CreateSnapshot(state, i);
+	}
+	manager.AcknowledgeSnapshot(1, 1);
+
+	// Ticks 4..9 wrap around the ring twice
+	for(uint64_t i = 4; i < 10; ++i)
+	{
+		GameState state;
+		state.SetGameTick(i);
+		manager.CreateSnapshot(state, i);
+	}
+	const Snapshot *baseline = manager.GetClientBaseline(1);
+	if(!baseline || baseline->gameTick != 1 || baseline != manager.GetSnapshotAtTick(1))
+		return false;
+	if(manager.GetSnapshotCount() != 5 || manager.GetSnapshotAtTick(2))
+		return false;
+
+	// Shrinking the history keeps it too
+	manager.AcknowledgeSnapshot(2, 7);
+	manager.SetHistorySize(2);
+	if(!manager.GetSnapshotAtTick(1) || !manager.GetSnapshotAtTick(7) || manager.GetSnapshotCount() != 4)
+		return false;
+
+	// Once every client has moved on, the old baselines are released
+	manager.AcknowledgeSnapshot(1, 9);
+	manager.AcknowledgeSnapshot(2, 9);
+	if(manager.GetSnapshotAtTick(1) || manager.GetSnapshotAtTick(7) || manager.GetSnapshotCount() != 2)
+		return false;
+
+	return true;
+}
+
+
+// SnapshotManager captures into the storage of snapshots leaving the history
+bool TestSnapshotManagerStorageReuse()
+{
+	GameState state;
+	vector<shared_ptr<Ship>> ships;
+	for(int i = 0; i < 40; ++i)
+	{
+		ships.push_back(make_shared<Ship>());
+		state.AddShip(ships.back());
+	}
+	SnapshotManager manager(2);
+	auto createSnapshot = [&](uint64_t tick)
+	{
+		// Move every ship so that no records are shared between snapshots.
+		for(size_t i = 0; i < ships.size(); ++i)
+			ships[i]->SetPosition(Point(100. * i, 10. * tick));
+		state.SetGameTick(tick);
+		manager.CreateSnapshot(state, tick);
+		return manager.GetSnapshotAtTick(tick)->world;
+	};
+	auto chunksOf = [](const WorldSnapshot &world)
+	{
+		set<const void *> chunks;
+		for(auto it = world.ships.begin(); it != world.ships.end(); it.SkipChunk())
+			chunks.insert(it.GetChunk());
+		return chunks;
+	};
+
+	const WorldSnapshot *first = createSnapshot(0).get();
+	set<const void *> firstChunks = chunksOf(*first);
+	createSnapshot(1);
+
+	// Tick 2 takes over tick 0's slot, world and record chunks.
+	shared_ptr<const WorldSnapshot> second = createSnapshot(2);
+	if(second.get() != first || second->gameTick != 2 || second->ships.size() != ships.size())
+		return false;
+	if(chunksOf(*second) != firstChunks)
+		return false;
+
+	// A world that is still held elsewhere is left alone.
+	createSnapshot(3);
+	shared_ptr<const WorldSnapshot> fourth = createSnapshot(4);
+	if(fourth == second || second->gameTick != 2 || !second->FindShip(1))
+		return false;
+
+	return true;
+}
+
+
+// WorldSnapshot captures share unchanged records and reuse their storage
+bool TestWorldSnapshotCapture()
+{
+	GameState state;
+	vector<shared_ptr<Ship>> ships;
+	for(int i = 0; i < 40; ++i)
+	{
+		ships.push_back(make_shared<Ship>());
+		ships.back()->SetPosition(Point(100. * i, 0.));
+		state.AddShip(ships.back());
+	}
+
+	EntityTracker tracker;
+	WorldSnapshot first;
+	WorldSnapshot second;
+	state.SetGameTick(1);
+	first.Capture(state, tracker);
+	if(first.gameTick != 1 || first.ships.size() != 40 || first.ships.GetSharedChunkCount())
+		return false;
+
+	// Only the chunk holding the ship that moved is new.
+	ships[5]->SetPosition(Point(-50., 0.));
+	state.SetGameTick(2);
+	second.Capture(state, tracker, &first);
+	if(second.ships.size() != 40 || second.ships.GetSharedChunkCount() + 1 != second.ships.GetChunkCount())
+		return false;
+	const ShipRecord *moved = second.FindShip(first.ships.ToVector()[5].id);
+	if(!moved || moved->position.X() != -50.)
+		return false;
+
+	// Capturing into an older snapshot replaces its contents.
+	state.RemoveShip(ships[0]);
+	state.SetGameTick(3);
+	first.Capture(state, tracker, &second);
+	if(first.gameTick != 3 || first.ships.size() != 39 || !first.FindShip(moved->id))
+		return false;
+	if(first.FindShip(second.ships.ToVector()[0].id))
+		return false;
+
+	return true;
+}
+
+
+// EntityTracker keeps a ship's network ID for as long as the ship lives
+bool TestEntityTrackerShipIds()
+{
+	EntityTracker tracker(2);
+	auto first = make_shared<Ship>();
+	auto second = make_shared<Ship>();
+	uint16_t firstId = tracker.ShipId(first);
+	uint16_t secondId = tracker.ShipId(second);
+	tracker.EndCapture();
+	if(!firstId || !secondId || firstId == secondId)
+		return false;
+	if(tracker.FindShipId(*first) != firstId || !tracker.GetShipUuid(firstId)
+			|| *tracker.GetShipUuid(firstId) != first->UUID())
+		return false;
+
+	// A ship that disappears loses its ID; a new ship never takes over its
+	// entry, even if it is allocated at the same address.
+	tracker.ShipId(second);
+	tracker.EndCapture();
+	if(tracker.FindShipId(*first) || tracker.GetShipUuid(firstId))
+		return false;
+	first.reset();
+	auto third = make_shared<Ship>();
+	uint16_t thirdId = tracker.ShipId(third);
+	if(!thirdId || thirdId == firstId || thirdId == secondId || tracker.ShipId(second) != secondId)
+		return false;
+
+	return true;
+}
+
+
+// SnapshotManager statistics come from the packets that are built
+bool TestSnapshotManagerStatistics()
+{
+	SnapshotManager manager(10);
+	GameState state;
+	for(int i = 0; i < 20; ++i)
+	{
+		auto ship = make_shared<Ship>();
+		ship->SetPosition(Point(100. * i, 0.));
+		state.AddShip(ship);
+	}
+
+	// Creating snapshots does not encode anything.
+	for(uint64_t i = 0; i < 3; ++i)
+	{
+		state.SetGameTick(i);
+		manager.CreateSnapshot(state, i);
+	}
+	if(manager.GetAverageCompressionRatio() != 1.0 || manager.GetLatestSnapshot()->uncompressedSize)
+		return false;
+
+	// A client without a baseline is sent a keyframe.
+	const PacketWriter *keyframe = manager.GetPacketForClient(1);
+	const Snapshot *latest = manager.GetLatestSnapshot();
+	if(!keyframe || !latest->uncompressedSize || latest->uncompressedSize > keyframe->GetSize())
+		return false;
+	if(latest->compressedSize || manager.GetAverageCompressionRatio() != 1.0)
+		return false;
+
+	// Once it has a baseline, it gets a much smaller delta, since nothing moved.
+	manager.AcknowledgeSnapshot(1, 2);
+	state.SetGameTick(3);
+	manager.CreateSnapshot(state, 3);
+	if(!manager.GetPacketForClient(1))
+		return false;
+	latest = manager.GetLatestSnapshot();
+	if(!latest->compressedSize || manager.GetAverageCompressionRatio() >= .6)
+		return false;
+
+	return true;
+}
+
+
 // Test 8: ServerLoop timing configuration
 bool TestServerLoopTiming()
 {
@@ -367,6 +658,13 @@ int main()
 	ReportTest("SnapshotManager basic", TestSnapshotManagerBasic());
 	ReportTest("SnapshotManager history limit", TestSnapshotManagerHistory());
 	ReportTest("SnapshotManager keyframes", TestSnapshotManagerKeyframes());
+	ReportTest("SnapshotManager ring buffer", TestSnapshotManagerRing());
+	ReportTest("SnapshotManager prune keeps baselines", TestSnapshotManagerPruneBaseline());
+	ReportTest("SnapshotManager pinned baselines", TestSnapshotManagerPinnedBaseline());
+	ReportTest("SnapshotManager storage reuse", TestSnapshotManagerStorageReuse());
+	ReportTest("SnapshotManager statistics", TestSnapshotManagerStatistics());
+	ReportTest("WorldSnapshot capture", TestWorldSnapshotCapture());
+	ReportTest("EntityTracker ship IDs", TestEntityTrackerShipIds());
 	cout << endl;
 
 	// ServerLoop tests
@@ -0,0 +1,167 @@
+/* test_spsc_queue.cpp
+ * Copyright (c) 2025 by Endless Sky Development Team
+ *
+ * Unit tests for the lock-free queue between the network and main threads:
+ * - Items come out in order
+ * - A full queue refuses new items
+ * - Slots keep their buffers between uses
+ * - Two threads can use it concurrently
+ */
+
+#include "../../source/server/SpscQueue.h"
+
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+
+// Test result tracking
+int testsRun = 0;
+int testsPassed = 0;
+
+void ReportTest(const string &name, bool passed)
+{
+	testsRun++;
+	if(passed)
+	{
+		testsPassed++;
+		cout << "[PASS] " << name << endl;
+	}
+	else
+	{
+		cout << "[FAIL] " << name << endl;
+	}
+}
+
+
+// Test 1: Items are consumed in the order they were published
+bool TestOrder()
+{
+	SpscQueue<int> queue(8);
+	for(int i = 0; i < 5; ++i)
+	{
+		*queue.Acquire() = i;
+		queue.Publish();
+	}
+	if(queue.Size() != 5)
+		return false;
+
+	for(int i = 0; i < 5; ++i)
+	{
+		int *item = queue.Front();
+		if(!item || *item != i)
+			return false;
+		queue.Pop();
+	}
+	return !queue.Front() && !queue.Size();
+}
+
+
+// Test 2: The capacity is a power of two, and a full queue refuses items
+bool TestFull()
+{
+	SpscQueue<int> queue(5);
+	if(queue.Capacity() != 8)
+		return false;
+
+	for(int i = 0; i < 8; ++i)
+	{
+		int *item = queue.Acquire();
+		if(!item)
+			return false;
+		*item = i;
+		queue.Publish();
+	}
+	if(queue.Acquire())
+		return false;
+
+	// Consuming one item frees one slot.
+	queue.Pop();
+	return queue.Acquire() != nullptr;
+}
+
+
+// Test 3: Slots are reused in place, keeping their memory
+bool TestSlotReuse()
+{
+	SpscQueue<vector<uint8_t>> queue(2);
+	vector<uint8_t> *slot = queue.Acquire();
+	slot->assign(1000, 1);
+	queue.Publish();
+	queue.Front();
+	queue.Pop();
+
+	// Go around the ring once.
+	queue.Acquire()->clear();
+	queue.Publish();
+	queue.Pop();
+
+	vector<uint8_t> *again = queue.Acquire();
+	return again == slot && again->capacity() >= 1000;
+}
+
+
+// Test 4: One producer and one consumer thread
+bool TestConcurrent()
+{
+	const uint64_t COUNT = 200000;
+	SpscQueue<uint64_t> queue(64);
+
+	thread producer([&queue, COUNT]()
+	{
+		for(uint64_t i = 0; i < COUNT; ++i)
+		{
+			uint64_t *item;
+			while(!(item = queue.Acquire()))
+				this_thread::yield();
+			*item = i;
+			queue.Publish();
+		}
+	});
+
+	uint64_t expected = 0;
+	bool inOrder = true;
+	while(expected < COUNT)
+	{
+		uint64_t *item = queue.Front();
+		if(!item)
+		{
+			this_thread::yield();
+			continue;
+		}
+		inOrder &= (*item == expected++);
+		queue.Pop();
+	}
+	producer.join();
+
+	return inOrder && !queue.Front();
+}
+
+
+int main()
+{
+	cout << "==================================" << endl;
+	cout << "SPSC Queue Tests" << endl;
+	cout << "==================================" << endl;
+	cout << endl;
+
+	ReportTest("Order", TestOrder());
+	ReportTest("Full queue", TestFull());
+	ReportTest("Slot reuse", TestSlotReuse());
+	ReportTest("Concurrent producer and consumer", TestConcurrent());
+	cout << endl;
+
+	// Summary
+	cout << "==================================" << endl;
+	cout << "Tests: " << testsPassed << "/" << testsRun << " passed";
+	if(testsPassed == testsRun)
+		cout << " ✓" << endl;
+	else
+		cout << " ✗" << endl;
+	cout << "==================================" << endl;
+
+	return (testsPassed == testsRun) ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+/* test_mask.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../../source/image/Mask.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../../source/Angle.h"
+#include "../../../../source/image/ImageBuffer.h"
+#include "../../../../source/Point.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// A mask traced from a fully opaque square image.
+Mask SquareMask(int size)
+{
+	ImageBuffer image;
+	image.Allocate(size, size);
+	for(int i = 0; i < size * size; ++i)
+		image.Pixels()[i] = 0xFF000000;
+
+	Mask mask;
+	mask.Create(image, 0, "square");
+	return mask;
+}
+
+// A mask traced from an image of the given size in which the pixels for which
+// "inside" is true are opaque. The function gets pixel coordinates.
+template<class Shape>
+Mask ShapeMask(int size, Shape inside)
+{
+	ImageBuffer image;
+	image.Allocate(size, size);
+	for(int y = 0; y < size; ++y)
+		for(int x = 0; x < size; ++x)
+			image.Pixels()[x + y * size] = inside(x, y) ? 0xFF000000 : 0;
+
+	Mask mask;
+	mask.Create(image, 0, "shape");
+	return mask;
+}
+
+// A ring next to a square frame: two outlines, each with a hole.
+Mask HolesMask()
+{
+	return ShapeMask(100, [](int x, int y) {
+		const int r2 = (x - 30) * (x - 30) + (y - 50) * (y - 50);
+		const bool ring = r2 < 25 * 25 && r2 > 10 * 10;
+		const bool frame = x > 65 && x < 90 && y > 20 && y < 80 && !(x > 72 && x < 83 && y > 35 && y < 65);
+		return ring || frame;
+	});
+}
+
+// A disc, a triangle and an L shape, none touching the others.
+Mask IslandsMask()
+{
+	return ShapeMask(100, [](int x, int y) {
+		const bool disc = (x - 25) * (x - 25) + (y - 25) * (y - 25) < 15 * 15;
+		const bool triangle = y > 60 && y < 95 && x > 10 && x - 10 < (y - 60);
+		const bool ell = x > 55 && x < 90 && ((y > 55 && y < 65) || (x < 65 && y > 10 && y < 65));
+		return disc || triangle || ell;
+	});
+}
+
+// Double-precision versions of the mask queries, computed directly from the
+// outlines in a different way than Mask does, to check its packed single
+// precision versions against. Points are in the mask's frame of reference.
+double DistanceToEdge(const Point &point, const Point &start, const Point &end)
+{
+	const Point edge = end - start;
+	const double t = std::clamp((point - start).Dot(edge) / edge.LengthSquared(), 0., 1.);
+	return point.Distance(start + t * edge);
+}
+
+double DistanceToOutlines(const Mask &mask, const Point &point)
+{
+	double distance = std::numeric_limits<double>::infinity();
+	for(const auto &outline : mask.Outlines())
+		for(size_t i = 0; i < outline.size(); ++i)
+			distance = std::min(distance, DistanceToEdge(point, outline[i], outline[(i + 1) % outline.size()]));
+	return distance;
+}
+
+// Count the crossings of a ray pointing towards positive x.
+bool ReferenceContains(const Mask &mask, const Point &point)
+{
+	bool inside = false;
+	for(const auto &outline : mask.Outlines())
+		for(size_t i = 0; i < outline.size(); ++i)
+		{
+			const Point &a = outline[i];
+			const Point &b = outline[(i + 1) % outline.size()];
+			if((a.Y() > point.Y()) != (b.Y() > point.Y())
+					&& point.X() < a.X() + (b.X() - a.X()) * (point.Y() - a.Y()) / (b.Y() - a.Y()))
+				inside = !inside;
+		}
+	return inside;
+}
+
+// The first point where the segment meets any edge, whether entering or not.
+double ReferenceCollide(const Mask &mask, const Point &start, const Point &motion)
+{
+	if(ReferenceContains(mask, start))
+		return 0.;
+
+	double closest = 1.;
+	for(const auto &outline : mask.Outlines())
+		for(size_t i = 0; i < outline.size(); ++i)
+		{
+			const Point &a = outline[i];
+			const Point edge = outline[(i + 1) % outline.size()] - a;
+			const double denominator = motion.Cross(edge);
+			if(!denominator)
+				continue;
+			const double t = (a - start).Cross(edge) / denominator;
+			const double u = (a - start).Cross(motion) / denominator;
+			if(t >= 0. && t < closest && u >= 0. && u <= 1.)
+				closest = t;
+		}
+	return closest;
+}
+
+double ReferenceRange(const Mask &mask, const Point &point)
+{
+	if(ReferenceContains(mask, point))
+		return 0.;
+
+	double range = std::numeric_limits<double>::infinity();
+	for(const auto &outline : mask.Outlines())
+		for(const Point &p : outline)
+			range = std::min(range, p.Distance(point));
+	return range;
+}
+
+// Check random queries against the reference versions. Queries that come
+// within rounding distance of an outline are skipped, since single and double
+// precision may then legitimately disagree.
+void CheckAgainstReference(const Mask &mask)
+{
+	static const double EPSILON = 1e-3;
+	std::mt19937 gen(1234567);
+	const double extent = 1.5 * mask.Radius();
+	std::uniform_real_distribution<double> coordinate(-extent, extent);
+	std::uniform_real_distribution<double> degrees(0., 360.);
+
+	int contained = 0;
+	int hit = 0;
+	for(int i = 0; i < 5000; ++i)
+	{
+		const Angle facing(degrees(gen));
+		const Point point(coordinate(gen), coordinate(gen));
+		const Point motion(coordinate(gen), coordinate(gen));
+		const Point local = (-facing).Rotate(point);
+		const Point localEnd = (-facing).Rotate(point + motion);
+
+		if(DistanceToOutlines(mask, local) > EPSILON)
+		{
+			const bool expected = ReferenceContains(mask, local);
+			contained += expected;
+			CHECK( mask.Contains(point, facing) == expected );
+			CHECK_THAT( mask.Range(point, facing), Catch::Matchers::WithinAbs(ReferenceRange(mask, local), EPSILON) );
+		}
+
+		// Skip segments that start or end on an outline or pass by a vertex.
+		bool nearVertex = false;
+		for(const auto &outline : mask.Outlines())
+			for(const Point &vertex : outline)
+				nearVertex |= DistanceToEdge(vertex, local, localEnd) <= EPSILON;
+		if(nearVertex || DistanceToOutlines(mask, local) <= EPSILON || DistanceToOutlines(mask, localEnd) <= EPSILON)
+			continue;
+
+		const double expected = ReferenceCollide(mask, local, localEnd - local);
+		hit += (expected < 1.);
+		CHECK_THAT( mask.Collide(point, motion, facing) * motion.Length(),
+			Catch::Matchers::WithinAbs(expected * motion.Length(), EPSILON) );
+	}
+	// Make sure that the queries covered both outcomes.
+	CHECK( contained > 100 );
+	CHECK( hit > 500 );
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Testing lines and points against a mask", "[mask]" ) {
+	GIVEN( "a square mask" ) {
+		const Mask mask = SquareMask(20);
+		REQUIRE( mask.IsLoaded() );
+
+		THEN( "a line through it collides partway along" ) {
+			const double range = mask.Collide(Point(-30., 0.), Point(60., 0.), Angle());
+			CHECK( range > 0. );
+			CHECK( range < .5 );
+		}
+		THEN( "a line that passes it does not collide" ) {
+			CHECK( mask.Collide(Point(-30., 30.), Point(60., 0.), Angle()) == 1. );
+			CHECK( mask.Collide(Point(-30., 0.), Point(10., 0.), Angle()) == 1. );
+		}
+		THEN( "a line starting inside it collides immediately" ) {
+			CHECK( mask.Collide(Point(1., 1.), Point(60., 0.), Angle()) == 0. );
+		}
+		THEN( "points inside it are contained" ) {
+			CHECK( mask.Contains(Point(), Angle()) );
+			CHECK( mask.Contains(Point(2., -2.), Angle(45.)) );
+			CHECK_FALSE( mask.Contains(Point(20., 0.), Angle()) );
+			CHECK_FALSE( mask.Contains(Point(0., -20.), Angle(90.)) );
+		}
+
+		WHEN( "it is scaled up" ) {
+			const Mask scaled = mask * Point(2., 2.);
+			THEN( "it contains points that the original does not" ) {
+				const Point point(.6 * scaled.Radius(), 0.);
+				CHECK( scaled.Contains(point, Angle()) );
+				CHECK_FALSE( mask.Contains(point, Angle()) );
+			}
+			THEN( "lines collide with it sooner" ) {
+				CHECK( scaled.Collide(Point(-30., 0.), Point(60., 0.), Angle())
+					< mask.Collide(Point(-30., 0.), Point(60., 0.), Angle()) );
+			}
+		}
+	}
+}
+
+SCENARIO( "Testing masks with holes and several outlines", "[mask]" ) {
+	GIVEN( "a ring and a frame" ) {
+		const Mask mask = HolesMask();
+		REQUIRE( mask.IsLoaded() );
+		REQUIRE( mask.Outlines().size() == 4 );
+
+		THEN( "points in the holes are not contained" ) {
+			// Masks are traced at half the image's size, centered on it.
+			CHECK_FALSE( mask.Contains(Point(-10., 0.), Angle()) );
+			CHECK( mask.Contains(Point(-10. + 8.5, 0.), Angle()) );
+			CHECK_FALSE( mask.Contains(Point(13.75, 0.), Angle()) );
+			CHECK( mask.Contains(Point(9.25, 0.), Angle()) );
+		}
+		THEN( "a line through a hole hits the far side of it" ) {
+			const double range = mask.Collide(Point(-10., 0.), Point(0., 20.), Angle());
+			CHECK_THAT( range * 20., Catch::Matchers::WithinAbs(5., 1.) );
+		}
+		THEN( "every query agrees with a double-precision reference" ) {
+			CheckAgainstReference(mask);
+		}
+	}
+	GIVEN( "three separate shapes" ) {
+		const Mask mask = IslandsMask();
+		REQUIRE( mask.IsLoaded() );
+		REQUIRE( mask.Outlines().size() == 3 );
+
+		THEN( "every query agrees with a double-precision reference" ) {
+			CheckAgainstReference(mask);
+		}
+	}
+}
+
+// When writing assertions, prefer the CHECK and CHECK_FALSE macros when probing the scenario, and prefer
+// the REQUIRE / REQUIRE_FALSE macros for fundamental / "validity" assertions. If a CHECK fails, the rest
+// of the block's statements will still be evaluated, but a REQUIRE failure will exit the current block.
+
+// #endregion unit tests
+
+
+
+} // test namespace
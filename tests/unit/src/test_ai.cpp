@@ -0,0 +1,307 @@
+/* test_ai.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/AI.h"
+
+// Include a helper for creating well-formed DataNodes.
+#include "datanode-factory.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../source/Command.h"
+#include "../../../source/FireCommand.h"
+#include "../../../source/Flotsam.h"
+#include "../../../source/GameData.h"
+#include "../../../source/Government.h"
+#include "../../../source/image/ImageBuffer.h"
+#include "../../../source/image/Mask.h"
+#include "../../../source/image/MaskManager.h"
+#include "../../../source/image/Sprite.h"
+#include "../../../source/image/SpriteSet.h"
+#include "../../../source/Minable.h"
+#include "../../../source/Outfit.h"
+#include "../../../source/Personality.h"
+#include "../../../source/PlayerInfo.h"
+#include "../../../source/Projectile.h"
+#include "../../../source/Random.h"
+#include "../../../source/Set.h"
+#include "../../../source/Ship.h"
+#include "../../../source/System.h"
+#include "../../../source/Visual.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// Two hostile governments and a third that is at peace with both, in a system
+// with a planet to land on.
+const std::string GALAXY = R"(
+government "AI Test Blue"
+	"attitude toward"
+		"AI Test Red" -1
+government "AI Test Red"
+	"attitude toward"
+		"AI Test Blue" -1
+government "AI Test Merchant"
+planet "AI Test Prime"
+	spaceport "Test"
+system "AI Test"
+	pos 0 0
+	object "AI Test Prime"
+		distance 500
+		period 100
+)";
+
+const std::string GUN = R"(
+outfit "AI Test Gun"
+	category "Guns"
+	"gun ports" -1
+	weapon
+		velocity 20
+		lifetime 100
+		reload 10
+		"shield damage" 10
+)";
+
+const std::string TURRET = R"(
+outfit "AI Test Turret"
+	category "Turrets"
+	"turret mounts" -1
+	weapon
+		velocity 20
+		lifetime 100
+		reload 10
+		"turret turn" 2
+		"shield damage" 10
+)";
+
+const std::string SCANNER = R"(
+outfit "AI Test Scanner"
+	"cargo scan power" 10
+	"outfit scan power" 10
+)";
+
+const std::string WARSHIP = R"(
+ship "AI Test Warship"
+	sprite "test/ai warship"
+	attributes
+		category "Heavy Warship"
+		automaton 1
+		hull 1000
+		shields 1000
+		mass 100
+		drag 1
+		thrust 10
+		turn 100
+		"energy capacity" 1000
+		"fuel capacity" 300
+		"gun ports" 1
+		"turret mounts" 1
+	gun 0 -10
+	turret 0 0
+)";
+
+// The personalities to cycle through, so that each kind of planned decision is made.
+const std::vector<std::string> PERSONALITIES = {
+	"personality heroic",
+	"personality swarming",
+	"personality surveillance",
+	"personality timid coward",
+	"personality nemesis hunting",
+};
+
+void ApplyChanges(const std::string &text, PlayerInfo &player)
+{
+	for(const DataNode &node : AsDataNodes(text))
+		GameData::Change(node, player);
+}
+
+// A square sprite with a collision mask, so that ships can be seen and hit.
+void MakeSprite()
+{
+	const int size = 40;
+	ImageBuffer image;
+	image.Allocate(size, size);
+	std::fill(image.Pixels(), image.Pixels() + size * size, 0xFF000000);
+	std::vector<Mask> masks(1);
+	masks[0].Create(image, 0, "test/ai warship");
+
+	Sprite *sprite = SpriteSet::Modify("test/ai warship");
+	GameData::GetMaskManager().SetMasks(sprite, std::move(masks));
+	image.Clear();
+	sprite->AddFrames(image, false, true);
+}
+
+Outfit LoadOutfit(const std::string &text)
+{
+	Outfit outfit;
+	outfit.Load(AsDataNode(text), nullptr);
+	return outfit;
+}
+
+// A battle between two fleets, with merchants caught in the middle.
+struct Battle {
+	Battle()
+	{
+		static const Outfit gun = LoadOutfit(GUN);
+		static const Outfit turret = LoadOutfit(TURRET);
+		static const Outfit scanner = LoadOutfit(SCANNER);
+		if(!SpriteSet::Modify("test/ai warship")->Frames())
+			MakeSprite();
+		Ship model(AsDataNode(WARSHIP), nullptr);
+		model.FinishLoading(true);
+		model.AddOutfit(&gun, 1);
+		model.AddOutfit(&turret, 1);
+		model.AddOutfit(&scanner, 1);
+
+		const System *system = GameData::Systems().Get("AI Test");
+		const char *const GOVERNMENTS[] = {"AI Test Blue", "AI Test Red", "AI Test Merchant"};
+		for(int i = 0; i < 48; ++i)
+		{
+			auto ship = std::make_shared<Ship>(model);
+			ship->SetSystem(system);
+			ship->SetGovernment(GameData::Governments().Get(GOVERNMENTS[i % 3]));
+			Personality personality;
+			personality.Load(AsDataNode(PERSONALITIES[i % PERSONALITIES.size()]));
+			ship->SetPersonality(personality);
+			ship->Place(Point(150. * (i % 8) - 500., 200. * (i / 8) - 500.), Point(i % 5 - 2., i % 3 - 1.),
+				Angle(45. * i), false);
+			ship->Recharge();
+			// Ships can only be targeted once they have taken part in a step.
+			std::vector<Projectile> projectiles;
+			std::vector<Visual> visuals;
+			ship->Fire(projectiles, visuals, nullptr);
+			// A few ships are disabled, and may ask their allies for help.
+			if(i % 11 == 10)
+				ship->Disable();
+			ships.push_back(ship);
+		}
+	}
+
+	AI::List<Ship> ships;
+	AI::List<Minable> minables;
+	AI::List<Flotsam> flotsam;
+};
+
+// Everything the AI decided for each ship in one step.
+struct Decisions {
+	std::vector<Command> commands;
+	std::vector<double> aims;
+	std::vector<int> targets;
+	std::vector<int> helpers;
+
+	bool operator==(const Decisions &other) const
+	{
+		if(commands.size() != other.commands.size())
+			return false;
+		for(size_t i = 0; i < commands.size(); ++i)
+			if(commands[i] < other.commands[i] || other.commands[i] < commands[i]
+					|| commands[i].Turn() != other.commands[i].Turn())
+				return false;
+		return aims == other.aims && targets == other.targets && helpers == other.helpers;
+	}
+};
+
+int IndexOf(const AI::List<Ship> &ships, const Ship *ship)
+{
+	int index = 0;
+	for(const auto &it : ships)
+	{
+		if(it.get() == ship)
+			return index;
+		++index;
+	}
+	return -1;
+}
+
+Decisions Record(const AI::List<Ship> &ships)
+{
+	Decisions decisions;
+	for(const auto &ship : ships)
+	{
+		decisions.commands.push_back(ship->Commands());
+		const FireCommand &fire = ship->FiringCommands();
+		for(size_t i = 0; i < ship->Weapons().size(); ++i)
+			decisions.aims.push_back(fire.HasFire(i) + fire.Aim(i));
+		decisions.targets.push_back(IndexOf(ships, ship->GetTargetShip().get()));
+		decisions.helpers.push_back(IndexOf(ships, ship->GetShipToAssist().get()));
+	}
+	return decisions;
+}
+
+// Run the AI for a second of game time, planning with the given number of threads.
+std::vector<Decisions> Run(PlayerInfo &player, unsigned threads)
+{
+	Battle battle;
+	AI ai(player, battle.ships, battle.minables, battle.flotsam);
+	ai.SetPlanningThreads(threads);
+	Random::Seed(20250101);
+
+	std::vector<Decisions> steps;
+	for(int step = 0; step < 60; ++step)
+	{
+		Command command;
+		ai.Step(command);
+		steps.push_back(Record(battle.ships));
+	}
+	return steps;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Planning ships' decisions in parallel", "[AI]" ) {
+	PlayerInfo player;
+	ApplyChanges(GALAXY, player);
+	player.SetSystem(*GameData::Systems().Get("AI Test"));
+	REQUIRE( GameData::Governments().Get("AI Test Blue")->IsEnemy(GameData::Governments().Get("AI Test Red")) );
+
+	GIVEN( "a battle planned on one thread" ) {
+		const std::vector<Decisions> serial = Run(player, 1);
+		THEN( "the ships pick targets to attack, scan, or swarm around" ) {
+			int targeting = 0;
+			for(int target : serial.back().targets)
+				targeting += (target >= 0);
+			CHECK( targeting > 24 );
+		}
+		WHEN( "it is planned on several threads" ) {
+			THEN( "every ship is given the same commands and targets in every step" ) {
+				for(unsigned threads : {2u, 5u, 48u, 0u})
+				{
+					CAPTURE( threads );
+					const std::vector<Decisions> parallel = Run(player, threads);
+					REQUIRE( parallel.size() == serial.size() );
+					for(size_t step = 0; step < serial.size(); ++step)
+					{
+						CAPTURE( step );
+						CHECK( parallel[step] == serial[step] );
+					}
+				}
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,65 @@
+/* test_attribute.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/Attribute.h"
+
+// ... and any system includes needed for the test file.
+#include <cstring>
+#include <string>
+
+namespace { // test namespace
+
+// #region mock data
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Looking up attribute IDs", "[attribute]" ) {
+	GIVEN( "the name of a well-known attribute" ) {
+		THEN( "it resolves to its ID" ) {
+			CHECK( Attribute::Find("thrust") == Attribute::THRUST );
+			CHECK( Attribute::Find("turn") == Attribute::TURN );
+			CHECK( Attribute::Find("energy generation") == Attribute::ENERGY_GENERATION );
+			CHECK( Attribute::Find(std::string("reverse thrusting heat").c_str()) == Attribute::REVERSE_THRUSTING_HEAT );
+		}
+	}
+	GIVEN( "any other name" ) {
+		THEN( "it has no ID" ) {
+			CHECK( Attribute::Find("") == Attribute::COUNT );
+			CHECK( Attribute::Find("outfit space") == Attribute::COUNT );
+			CHECK( Attribute::Find("thrust ") == Attribute::COUNT );
+		}
+	}
+	GIVEN( "every ID" ) {
+		THEN( "the names are sorted and resolve back to the same ID" ) {
+			for(int i = 0; i < Attribute::COUNT; ++i)
+			{
+				auto id = static_cast<Attribute::Id>(i);
+				CHECK( Attribute::Find(Attribute::Name(id)) == id );
+				if(i)
+					CHECK( std::strcmp(Attribute::Name(static_cast<Attribute::Id>(i - 1)), Attribute::Name(id)) < 0 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
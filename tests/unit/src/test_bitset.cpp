@@ -100,6 +100,16 @@ SCENARIO( "A Bitset instance is being used", "[bitset]") {
 
 			CHECK( bitset.Any() );
 		}
+		THEN( "resetting single bits works" ) {
+			bitset.Set(4);
+			bitset.Set(5);
+			bitset.Reset(4);
+			CHECK_FALSE( bitset.Test(4) );
+			CHECK( bitset.Test(5) );
+
+			bitset.Reset(5);
+			CHECK( bitset.None() );
+		}
 		THEN( "clearing it works" ) {
 			bitset.Clear();
 			CHECK( bitset.Size() == 0 );
@@ -0,0 +1,286 @@
+/* test_collisionSet.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/CollisionSet.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../source/Angle.h"
+#include "../../../source/Body.h"
+#include "../../../source/Collision.h"
+#include "../../../source/GameData.h"
+#include "../../../source/image/ImageBuffer.h"
+#include "../../../source/image/Mask.h"
+#include "../../../source/image/MaskManager.h"
+#include "../../../source/image/Sprite.h"
+#include "../../../source/image/SpriteSet.h"
+#include "../../../source/Point.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+using BroadPhase = CollisionSet::BroadPhase;
+
+// Create a sprite of the given size whose collision mask is traced from the
+// pixels for which "inside" is true. The function is given pixel coordinates
+// relative to the center of the image. No texture is uploaded.
+template<class Shape>
+const Sprite *MaskedSprite(const std::string &name, int size, Shape inside)
+{
+	ImageBuffer image;
+	image.Allocate(size, size);
+	for(int y = 0; y < size; ++y)
+		for(int x = 0; x < size; ++x)
+			image.Pixels()[x + y * size] = inside(x - size / 2, y - size / 2) ? 0xFF000000 : 0;
+	std::vector<Mask> masks(1);
+	masks[0].Create(image, 0, name);
+
+	Sprite *sprite = SpriteSet::Modify(name);
+	GameData::GetMaskManager().SetMasks(sprite, std::move(masks));
+	// Keep the image's dimensions for the sprite, but not its pixels.
+	image.Clear();
+	sprite->AddFrames(image, false, true);
+	return sprite;
+}
+
+// Sprites with a square, a long thin rectangle and a ring with a gap in it,
+// so that objects' masks differ from their bounding circles.
+const std::vector<const Sprite *> &Sprites()
+{
+	static const std::vector<const Sprite *> sprites = {
+		MaskedSprite("test/collision square", 60, [](int, int) { return true; }),
+		MaskedSprite("test/collision rod", 120, [](int, int y) { return std::abs(y) < 12; }),
+		MaskedSprite("test/collision ring", 100, [](int x, int y) {
+			const int r2 = x * x + y * y;
+			return r2 < 48 * 48 && r2 > 30 * 30 && (x < 0 || std::abs(y) > 10);
+		}),
+	};
+	return sprites;
+}
+
+// A recording of a battle: the positions of every object in each step, and
+// the queries that were made against them in that step.
+struct Frame {
+	std::vector<Body> bodies;
+	std::vector<Point> lineStarts;
+	std::vector<Point> lineEnds;
+	std::vector<Point> blasts;
+};
+
+// Record a deterministic battle of the given number of objects circling the
+// system center at different speeds, each firing one projectile per step and
+// every tenth one also setting off a blast.
+std::vector<Frame> RecordBattle(int objects, int steps)
+{
+	std::vector<Frame> frames(steps);
+	for(int step = 0; step < steps; ++step)
+	{
+		Frame &frame = frames[step];
+		for(int i = 0; i < objects; ++i)
+		{
+			const double orbit = 200. + 37. * (i % 97);
+			const double angle = .01 * step * (1. + i % 7) + i;
+			const Point position(orbit * std::cos(angle), orbit * std::sin(angle));
+			const Point velocity(-std::sin(angle), std::cos(angle));
+			frame.bodies.emplace_back(Sprites()[i % Sprites().size()], position, velocity, Angle(17. * i));
+			frame.lineStarts.push_back(position);
+			frame.lineEnds.push_back(position + velocity * (i % 5 ? 20. : 2000.));
+			if(!(i % 10))
+				frame.blasts.push_back(position);
+		}
+	}
+	return frames;
+}
+
+void Fill(CollisionSet &set, Frame &frame, int step)
+{
+	set.Clear(step);
+	for(Body &body : frame.bodies)
+		set.Add(body);
+	set.Finish();
+}
+
+std::vector<Body *> Sorted(std::vector<Body *> bodies)
+{
+	std::sort(bodies.begin(), bodies.end());
+	return bodies;
+}
+
+// The object and intersection range of each collision, in a canonical order.
+std::vector<std::pair<const Body *, double>> Sorted(std::vector<Collision> &collisions)
+{
+	std::vector<std::pair<const Body *, double>> result;
+	for(Collision &collision : collisions)
+		result.emplace_back(collision.HitBody(), collision.IntersectionRange());
+	std::sort(result.begin(), result.end());
+	return result;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Finding objects with either broad phase", "[collisionSet]" ) {
+	std::vector<Frame> frames = RecordBattle(300, 20);
+	CollisionSet grid(256u, 32u, CollisionType::SHIP);
+	CollisionSet sweep(256u, 32u, CollisionType::SHIP, BroadPhase::SWEEP);
+	REQUIRE( grid.GetBroadPhase() == BroadPhase::GRID );
+	REQUIRE( sweep.GetBroadPhase() == BroadPhase::SWEEP );
+
+	GIVEN( "the same objects in both sets, step after step" ) {
+		REQUIRE( frames[0].bodies[0].HasSprite() );
+		REQUIRE( frames[0].bodies[0].GetMask().IsLoaded() );
+
+		THEN( "line queries find the same collisions" ) {
+			size_t hits = 0;
+			for(int step = 0; step < static_cast<int>(frames.size()); ++step)
+			{
+				Frame &frame = frames[step];
+				Fill(grid, frame, step);
+				Fill(sweep, frame, step);
+
+				for(size_t i = 0; i < frame.lineStarts.size(); ++i)
+				{
+					std::vector<Collision> expected;
+					std::vector<Collision> actual;
+					grid.Line(frame.lineStarts[i], frame.lineEnds[i], expected);
+					sweep.Line(frame.lineStarts[i], frame.lineEnds[i], actual);
+					CHECK( Sorted(expected) == Sorted(actual) );
+					hits += expected.size();
+				}
+			}
+			// Every line starts at an object, so most lines hit at least one.
+			CHECK( hits > frames.size() * frames[0].lineStarts.size() / 2 );
+		}
+		THEN( "circle and ring queries find the same objects" ) {
+			for(int step = 0; step < static_cast<int>(frames.size()); ++step)
+			{
+				Frame &frame = frames[step];
+				Fill(grid, frame, step);
+				Fill(sweep, frame, step);
+				REQUIRE( grid.All().size() == sweep.All().size() );
+
+				for(const Point &center : frame.blasts)
+				{
+					std::vector<Body *> expected;
+					std::vector<Body *> actual;
+					grid.Circle(center, 300., expected);
+					sweep.Circle(center, 300., actual);
+					CHECK( Sorted(expected) == Sorted(actual) );
+
+					expected.clear();
+					actual.clear();
+					grid.Ring(center, 100., 500., expected);
+					sweep.Ring(center, 100., 500., actual);
+					CHECK( Sorted(expected) == Sorted(actual) );
+
+					// A thin ring only finds objects whose outlines it touches.
+					expected.clear();
+					actual.clear();
+					grid.Ring(center, 40., 44., expected);
+					sweep.Ring(center, 40., 44., actual);
+					CHECK( Sorted(expected) == Sorted(actual) );
+				}
+			}
+		}
+		THEN( "nearby objects include every object in the circle" ) {
+			for(int step = 0; step < static_cast<int>(frames.size()); ++step)
+			{
+				Frame &frame = frames[step];
+				Fill(sweep, frame, step);
+
+				for(const Point &center : frame.blasts)
+				{
+					std::vector<Body *> inCircle;
+					std::vector<Body *> nearby;
+					sweep.Circle(center, 300., inCircle);
+					sweep.Nearby(center, 300., nearby);
+					nearby = Sorted(nearby);
+					for(Body *body : inCircle)
+						CHECK( std::binary_search(nearby.begin(), nearby.end(), body) );
+				}
+			}
+		}
+	}
+	GIVEN( "a set with no objects" ) {
+		sweep.Clear(0);
+		sweep.Finish();
+		THEN( "queries find nothing" ) {
+			std::vector<Body *> bodies;
+			std::vector<Collision> collisions;
+			sweep.Circle(Point(), 1000., bodies);
+			sweep.Nearby(Point(), 1000., bodies);
+			sweep.Line(Point(), Point(1000., 1000.), collisions);
+			CHECK( bodies.empty() );
+			CHECK( collisions.empty() );
+		}
+	}
+}
+
+// When writing assertions, prefer the CHECK and CHECK_FALSE macros when probing the scenario, and prefer
+// the REQUIRE / REQUIRE_FALSE macros for fundamental / "validity" assertions. If a CHECK fails, the rest
+// of the block's statements will still be evaluated, but a REQUIRE failure will exit the current block.
+
+// #endregion unit tests
+
+// #region benchmarks
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE( "Benchmark CollisionSet broad phases", "[!benchmark][collisionSet]" ) {
+	// Replay the same recorded battle through each broad phase: rebuild the set
+	// every step, then run that step's projectile and blast queries.
+	std::vector<Frame> frames = RecordBattle(1000, 60);
+	const auto replay = [&frames](CollisionSet &set) -> size_t {
+		size_t found = 0;
+		std::vector<Collision> collisions;
+		std::vector<Body *> bodies;
+		for(int step = 0; step < static_cast<int>(frames.size()); ++step)
+		{
+			Frame &frame = frames[step];
+			Fill(set, frame, step);
+			for(size_t i = 0; i < frame.lineStarts.size(); ++i)
+				set.Line(frame.lineStarts[i], frame.lineEnds[i], collisions);
+			for(const Point &center : frame.blasts)
+				set.Circle(center, 300., bodies);
+			found += collisions.size() + bodies.size();
+			collisions.clear();
+			bodies.clear();
+		}
+		return found;
+	};
+
+	CollisionSet grid(256u, 32u, CollisionType::SHIP);
+	CollisionSet sweep(256u, 32u, CollisionType::SHIP, BroadPhase::SWEEP);
+	BENCHMARK( "Grid" ) {
+		return replay(grid);
+	};
+	BENCHMARK( "Sweep and prune" ) {
+		return replay(sweep);
+	};
+}
+#endif
+// #endregion benchmarks
+
+
+
+} // test namespace
@@ -27,18 +27,28 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 // Include ConditionStore, to enable usage of them for testing ConditionSets.
 #include "../../../source/ConditionsStore.h"
+#include "../../../source/DataFile.h"
 
 // ... and any system includes needed for the test file.
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace { // test namespace
 using Conditions = std::map<std::string, int64_t>;
 // #region mock data
-
-
-
+// Find the conditions under every "to ..." and "branch" node, as used by missions, events and conversations.
+void CollectConditionNodes(const DataNode &node, std::vector<const DataNode *> &found)
+{
+	if((node.Token(0) == "to" || node.Token(0) == "branch") && node.HasChildren())
+		found.push_back(&node);
+	for(const DataNode &child : node)
+		CollectConditionNodes(child, found);
+}
 // #endregion mock data
 
 
@@ -230,6 +240,7 @@ SCENARIO( "Determining if condition requirements are met", "[ConditionSet][Usage
 			auto answer = std::get<1>(expressionAndAnswer);
 			bool boolAnswer = answer;
 			REQUIRE( numberSet.Evaluate() == answer );
+			REQUIRE( numberSet.EvaluateTree() == answer );
 			REQUIRE( numberSet.Test() == boolAnswer );
 		}
 	}
@@ -260,8 +271,95 @@ SCENARIO( "Determining if condition requirements are met", "[ConditionSet][Usage
 	}
 }
 
+SCENARIO( "Evaluating a compiled ConditionSet after its conditions change", "[ConditionSet][Usage]" ) {
+	GIVEN( "a ConditionSet that has been evaluated" ) {
+		auto store = ConditionsStore{{"first", 3}, {"second", 0}};
+		const auto set = ConditionSet{AsDataNode("toplevel\n\tfirst > 2\n\tor\n\t\tsecond\n\t\tthird\n"
+			"\t\t\"prefixed: value\""), &store};
+		REQUIRE( set.Evaluate() == 0 );
+
+		WHEN( "an existing condition changes" ) {
+			store.Set("second", 4);
+			THEN( "the new value is used" ) {
+				CHECK( set.Evaluate() == 1 );
+				CHECK( set.EvaluateTree() == 1 );
+			}
+		}
+		WHEN( "a condition that did not exist yet is set" ) {
+			store.Set("third", 5);
+			THEN( "the new condition is used" ) {
+				CHECK( set.Evaluate() == 1 );
+				CHECK( set.EvaluateTree() == 1 );
+			}
+		}
+		WHEN( "a prefixed provider for one of its conditions is added" ) {
+			store["prefixed: "].ProvidePrefixed([](const ConditionEntry &entry) -> int64_t {
+				return entry.NameWithoutPrefix().size();
+			});
+			THEN( "the provided value is used" ) {
+				CHECK( set.Evaluate() == 1 );
+				CHECK( set.EvaluateTree() == 1 );
+			}
+		}
+		WHEN( "the store is replaced by a different one" ) {
+			store = ConditionsStore{{"first", 3}, {"third", 2}};
+			THEN( "the conditions of the new store are used" ) {
+				CHECK( set.Evaluate() == 1 );
+				store.Set("first", 0);
+				CHECK( set.Evaluate() == 0 );
+				CHECK( set.EvaluateTree() == 0 );
+			}
+		}
+	}
+}
+
 // #endregion unit tests
 
+// #region benchmarks
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE( "Benchmark ConditionSet evaluation", "[!benchmark][ConditionSet]" ) {
+	// Load the conditions of every mission, event and conversation in the game data.
+	std::list<DataFile> files;
+	std::vector<const DataNode *> nodes;
+	for(const auto &entry : std::filesystem::recursive_directory_iterator("../data"))
+		if(entry.path().extension() == ".txt")
+		{
+			std::ifstream in(entry.path());
+			for(const DataNode &node : files.emplace_back(in))
+				CollectConditionNodes(node, nodes);
+		}
+
+	// Give some of the conditions that they use a value, so that not every expression stops at its first term.
+	ConditionsStore store;
+	std::vector<ConditionSet> sets;
+	sets.reserve(nodes.size());
+	int64_t value = 0;
+	for(const DataNode *node : nodes)
+	{
+		const ConditionSet &set = sets.emplace_back(*node, &store);
+		for(const std::string &name : set.RelevantConditions())
+			if(++value % 3)
+				store.Set(name, value % 7);
+	}
+	for(const ConditionSet &set : sets)
+		REQUIRE( set.Evaluate() == set.EvaluateTree() );
+
+	BENCHMARK( "ConditionSet::EvaluateTree()" ) {
+		int64_t result = 0;
+		for(const ConditionSet &set : sets)
+			result += set.EvaluateTree();
+		return result;
+	};
+	BENCHMARK( "ConditionSet::Evaluate()" ) {
+		int64_t result = 0;
+		for(const ConditionSet &set : sets)
+			result += set.Evaluate();
+		return result;
+	};
+}
+#endif
+// #endregion benchmarks
+
 
 
 } // test namespace
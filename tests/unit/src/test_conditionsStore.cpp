@@ -596,6 +596,46 @@ SCENARIO( "Providing multiple derived conditions", "[ConditionStore][DerivedMult
 	}
 }
 
+SCENARIO( "Tracking changes to conditions", "[ConditionStore][ConditionChanges]" )
+{
+	GIVEN( "A store with a primary and a derived condition" )
+	{
+		auto store = ConditionsStore();
+		store.Set("primary", 1);
+		ConditionEntry &primary = store["primary"];
+		ConditionEntry &derived = store["derived"];
+		derived.ProvideNamed([](const ConditionEntry &) -> int64_t { return 7; });
+		const uint64_t revision = ConditionEntry::LastRevision();
+
+		THEN( "the primary condition has not changed since then" )
+		{
+			REQUIRE_FALSE( primary.ChangedSince(revision) );
+		}
+		THEN( "the derived condition always counts as changed" )
+		{
+			REQUIRE( derived.ChangedSince(revision) );
+		}
+		WHEN( "the primary condition is set" )
+		{
+			store.Set("primary", 1);
+			THEN( "it has changed, even though its value is the same" )
+			{
+				REQUIRE( primary.ChangedSince(revision) );
+				REQUIRE_FALSE( primary.ChangedSince(ConditionEntry::LastRevision()) );
+			}
+		}
+		WHEN( "another condition is set" )
+		{
+			store.Add("other", 2);
+			THEN( "the primary condition has not changed" )
+			{
+				REQUIRE_FALSE( primary.ChangedSince(revision) );
+				REQUIRE( store["other"].ChangedSince(revision) );
+			}
+		}
+	}
+}
+
 
 // #endregion unit tests
 
@@ -26,6 +26,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 // ... and any system includes needed for the test file.
 #include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iterator>
 #include <set>
 #include <sstream>
@@ -54,6 +57,21 @@ std::vector<std::string> Split(const std::string &str)
 	return result;
 }
 
+// Check that two trees of nodes have the same tokens and structure.
+bool SameNodes(std::list<DataNode>::const_iterator it, std::list<DataNode>::const_iterator end,
+	std::list<DataNode>::const_iterator otherIt, std::list<DataNode>::const_iterator otherEnd)
+{
+	for( ; it != end && otherIt != otherEnd; ++it, ++otherIt)
+		if(it->Tokens() != otherIt->Tokens() || !SameNodes(it->begin(), it->end(), otherIt->begin(), otherIt->end()))
+			return false;
+	return it == end && otherIt == otherEnd;
+}
+
+size_t CountFiles(const std::filesystem::path &directory)
+{
+	return std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator());
+}
+
 // #endregion mock data
 
 
@@ -289,6 +307,102 @@ now with
 		}
 	}
 }
+SCENARIO( "Copying nodes out of a DataFile", "[DataFile]" ) {
+	GIVEN( "a node copied from a file that no longer exists" ) {
+		DataNode copy;
+		{
+			std::istringstream stream("system foo\n\tobject \"a long token that is not stored inline\"\n");
+			const DataFile file(stream);
+			REQUIRE( std::distance(file.begin(), file.end()) == 1 );
+			copy = *file.begin();
+		}
+		THEN( "the copy still has its tokens and children" ) {
+			REQUIRE( copy.Size() == 2 );
+			CHECK( copy.Token(1) == "foo" );
+			REQUIRE( copy.HasChildren() );
+			CHECK( copy.begin()->Token(1) == "a long token that is not stored inline" );
+			CHECK( copy.begin()->Tokens().get_allocator() == std::pmr::polymorphic_allocator<std::string>() );
+		}
+	}
+}
+
+SCENARIO( "Loading a DataFile through the data cache", "[DataFile]" ) {
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "es-test-datafile-cache";
+	const std::filesystem::path cache = directory / "cache";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+	DataFile::SetCacheDirectory(cache);
+
+	GIVEN( "a file that parses without warnings" ) {
+		const std::filesystem::path path = directory / "clean.txt";
+		std::ofstream(path) << "system foo\n\tpos 1 2\n\tobject \"a b\"\n\t\tsprite `c \"d\"`\n# comment\nship bar\n";
+		const DataFile parsed(path);
+
+		WHEN( "it is loaded through the cache" ) {
+			DataFile first;
+			first.LoadCached(path);
+			THEN( "the nodes are the same as parsing it, and a compiled copy is saved" ) {
+				CHECK( SameNodes(first.begin(), first.end(), parsed.begin(), parsed.end()) );
+				CHECK( CountFiles(cache) == 1 );
+			}
+			AND_WHEN( "it is loaded again" ) {
+				DataFile second;
+				second.LoadCached(path);
+				THEN( "the compiled copy gives the same nodes" ) {
+					CHECK( SameNodes(second.begin(), second.end(), parsed.begin(), parsed.end()) );
+					CHECK( CountFiles(cache) == 1 );
+				}
+			}
+			AND_WHEN( "the text changes but the file keeps its timestamp" ) {
+				const auto time = std::filesystem::last_write_time(path);
+				std::ofstream(path) << "ship baz\n";
+				std::filesystem::last_write_time(path, time);
+				DataFile second;
+				second.LoadCached(path);
+				THEN( "the nodes come from the compiled copy, not the text" ) {
+					CHECK( SameNodes(second.begin(), second.end(), parsed.begin(), parsed.end()) );
+				}
+			}
+			AND_WHEN( "the file is modified after the copy was saved" ) {
+				const auto time = std::filesystem::last_write_time(path);
+				std::ofstream(path) << "ship baz\n";
+				std::filesystem::last_write_time(path, time + std::chrono::seconds(10));
+				std::istringstream stream("ship baz\n");
+				const DataFile changed(stream);
+				DataFile second;
+				second.LoadCached(path);
+				THEN( "the file is parsed again" ) {
+					CHECK( SameNodes(second.begin(), second.end(), changed.begin(), changed.end()) );
+					CHECK( CountFiles(cache) == 1 );
+				}
+				AND_THEN( "the compiled copy is replaced by one of the new text" ) {
+					std::ofstream(path) << "ship bar\n";
+					std::filesystem::last_write_time(path, time + std::chrono::seconds(10));
+					DataFile third;
+					third.LoadCached(path);
+					CHECK( SameNodes(third.begin(), third.end(), changed.begin(), changed.end()) );
+				}
+			}
+		}
+	}
+	GIVEN( "a file with warnings" ) {
+		OutputSink sink(std::cerr);
+		const std::filesystem::path path = directory / "warnings.txt";
+		std::ofstream(path) << "system foo\n\tobject \"a b\n";
+
+		WHEN( "it is loaded through the cache" ) {
+			DataFile file;
+			file.LoadCached(path);
+			THEN( "no compiled copy is saved, so the warnings are shown every time" ) {
+				CHECK( CountFiles(cache) == 0 );
+				CHECK_FALSE( sink.Flush().empty() );
+			}
+		}
+	}
+
+	DataFile::SetCacheDirectory({});
+	std::filesystem::remove_all(directory);
+}
 // #endregion unit tests
 
 
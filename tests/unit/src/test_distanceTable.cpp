@@ -0,0 +1,168 @@
+/* test_distanceTable.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/DistanceTable.h"
+
+// Include a helper for creating well-formed DataNodes.
+#include "datanode-factory.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../source/DistanceMap.h"
+#include "../../../source/Planet.h"
+#include "../../../source/Set.h"
+#include "../../../source/System.h"
+
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace { // test namespace
+
+// #region mock data
+// A line of linked systems a little less than a jump apart, with one system
+// that can only be jumped to, and one that cannot be reached at all.
+const std::string GALAXY = R"(
+system A
+	pos 0 0
+system B
+	pos 90 0
+system C
+	pos 180 0
+system D
+	pos 270 0
+system Jump
+	pos 45 80
+system Far
+	pos 5000 5000
+)";
+
+void LoadGalaxy(Set<System> &systems, Set<Planet> &planets)
+{
+	for(const DataNode &node : AsDataNodes(GALAXY))
+		systems.Get(node.Token(1))->Load(node, planets, nullptr);
+	systems.Get("A")->Link(systems.Get("B"));
+	systems.Get("B")->Link(systems.Get("C"));
+	systems.Get("C")->Link(systems.Get("D"));
+}
+
+void UpdateGalaxy(Set<System> &systems)
+{
+	const std::set<double> neighborDistances = {System::DEFAULT_NEIGHBOR_DISTANCE};
+	for(auto &it : systems)
+		it.second.UpdateSystem(systems, neighborDistances);
+}
+
+// Check that the table agrees with a DistanceMap between every pair of systems.
+bool MatchesDistanceMaps(const DistanceTable &table, const Set<System> &systems, bool useJumpDrive)
+{
+	for(const auto &from : systems)
+	{
+		DistanceMap distance(&from.second, WormholeStrategy::NONE, useJumpDrive);
+		for(const auto &to : systems)
+			if(table.Days(from.second, to.second, WormholeStrategy::NONE, useJumpDrive) != distance.Days(to.second))
+				return false;
+	}
+	return true;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Looking up how far apart systems are", "[DistanceTable]" ) {
+	GIVEN( "a table that has not been built" ) {
+		Set<Planet> planets;
+		Set<System> systems;
+		LoadGalaxy(systems, planets);
+		DistanceTable table;
+		THEN( "it does not know any distances" ) {
+			CHECK_FALSE( table.Days(*systems.Get("A"), *systems.Get("B"), WormholeStrategy::NONE, false).has_value() );
+		}
+	}
+	GIVEN( "a table built from a small galaxy" ) {
+		Set<Planet> planets;
+		Set<System> systems;
+		LoadGalaxy(systems, planets);
+		UpdateGalaxy(systems);
+		DistanceTable table;
+		table.Update(systems);
+		const System &a = *systems.Get("A");
+
+		THEN( "hyperdrive distances follow the links" ) {
+			CHECK( table.Days(a, a, WormholeStrategy::NONE, false) == 0 );
+			CHECK( table.Days(a, *systems.Get("D"), WormholeStrategy::NONE, false) == 3 );
+			CHECK( table.Days(a, *systems.Get("Jump"), WormholeStrategy::NONE, false) == -1 );
+			CHECK( MatchesDistanceMaps(table, systems, false) );
+		}
+		THEN( "jump drive distances include the nearby unlinked system" ) {
+			CHECK( table.Days(a, *systems.Get("Jump"), WormholeStrategy::NONE, true) == 1 );
+			CHECK( table.Days(a, *systems.Get("Far"), WormholeStrategy::NONE, true) == -1 );
+			CHECK( MatchesDistanceMaps(table, systems, true) );
+		}
+		THEN( "systems it was not built with are unknown" ) {
+			System other;
+			CHECK_FALSE( table.Days(a, other, WormholeStrategy::NONE, false).has_value() );
+		}
+
+		WHEN( "a link is removed" ) {
+			systems.Get("B")->Unlink(systems.Get("C"));
+			UpdateGalaxy(systems);
+			table.Update(systems);
+			THEN( "the table matches the new links" ) {
+				CHECK( table.Days(a, *systems.Get("D"), WormholeStrategy::NONE, false) == -1 );
+				CHECK( MatchesDistanceMaps(table, systems, false) );
+				CHECK( MatchesDistanceMaps(table, systems, true) );
+			}
+		}
+		WHEN( "another thread reads the table while it is updated" ) {
+			const System &d = *systems.Get("D");
+			std::atomic<bool> done = false;
+			std::atomic<int> unexpected = 0;
+			std::thread reader([&]() -> void
+				{
+					while(!done)
+					{
+						const auto days = table.Days(a, d, WormholeStrategy::NONE, false);
+						if(days != 3 && days != -1)
+							++unexpected;
+					}
+				});
+			for(int i = 0; i < 50; ++i)
+			{
+				if(i % 2)
+					systems.Get("B")->Link(systems.Get("C"));
+				else
+					systems.Get("B")->Unlink(systems.Get("C"));
+				UpdateGalaxy(systems);
+				table.Update(systems);
+			}
+			done = true;
+			reader.join();
+			THEN( "it only ever sees complete tables" ) {
+				CHECK( unexpected == 0 );
+				CHECK( table.Days(a, d, WormholeStrategy::NONE, false) == 3 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
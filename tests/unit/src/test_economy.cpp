@@ -0,0 +1,184 @@
+/* test_economy.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/Economy.h"
+
+// Include a helper for creating well-formed DataNodes.
+#include "datanode-factory.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../source/Planet.h"
+#include "../../../source/Random.h"
+#include "../../../source/Set.h"
+#include "../../../source/System.h"
+#include "../../../source/Trade.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+namespace { // test namespace
+
+// #region mock data
+const std::string COMMODITIES = R"(
+trade
+	commodity Food 100 300
+	commodity Metal 200 500
+	commodity Plastic 300 700
+)";
+
+// Three systems in a line, where the middle one does not trade plastic, but
+// does trade something that is not a commodity. The last system is not linked.
+const std::string GALAXY = R"(
+system A
+	pos 0 0
+	trade Food 200
+	trade Metal 350
+	trade Plastic 500
+system B
+	pos 90 0
+	trade Food 210
+	trade Metal 340
+	trade Widgets 900
+system C
+	pos 180 0
+	trade Food 190
+	trade Metal 360
+	trade Plastic 490
+system D
+	pos 270 0
+	trade Food 220
+)";
+
+void UpdateGalaxy(Set<System> &systems)
+{
+	const std::set<double> neighborDistances = {System::DEFAULT_NEIGHBOR_DISTANCE};
+	for(auto &it : systems)
+		it.second.UpdateSystem(systems, neighborDistances);
+}
+
+void LoadGalaxy(Set<System> &systems, Set<Planet> &planets)
+{
+	for(const DataNode &node : AsDataNodes(GALAXY))
+		systems.Get(node.Token(1))->Load(node, planets, nullptr);
+	systems.Get("A")->Link(systems.Get("B"));
+	systems.Get("B")->Link(systems.Get("C"));
+	UpdateGalaxy(systems);
+}
+
+// Step the economy the way it was done one system and one commodity at a time.
+void ReferenceStep(Set<System> &systems, const Trade &trade)
+{
+	const double KEEP = .89;
+	const double EXPORT = .10;
+	const double VOLUME = 2000.;
+	const std::string goods[] = {"Food", "Metal", "Plastic", "Widgets"};
+
+	std::map<const System *, std::map<std::string, double>> exports;
+	for(auto &it : systems)
+		for(const std::string &good : goods)
+			if(it.second.Trade(good))
+			{
+				double supply = it.second.Supply(good);
+				exports[&it.second][good] = EXPORT * supply;
+				it.second.SetSupply(good, supply * KEEP + Random::Normal() * VOLUME);
+			}
+
+	for(auto &it : systems)
+	{
+		System &system = it.second;
+		if(!system.Links().empty())
+			for(const Trade::Commodity &commodity : trade.Commodities())
+			{
+				double supply = system.Supply(commodity.name);
+				for(const System *neighbor : system.Links())
+					supply += exports[neighbor][commodity.name] / neighbor->Links().size();
+				system.SetSupply(commodity.name, supply);
+			}
+	}
+}
+
+std::map<std::string, double> Supplies(const Set<System> &systems)
+{
+	std::map<std::string, double> result;
+	for(const auto &it : systems)
+		for(const std::string good : {"Food", "Metal", "Plastic", "Widgets"})
+			result[it.first + " " + good] = it.second.Supply(good);
+	return result;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Stepping the economy", "[Economy]" ) {
+	GIVEN( "two copies of a small galaxy" ) {
+		Set<Planet> planets;
+		Set<System> systems;
+		Set<System> referenceSystems;
+		Trade trade;
+		trade.Load(AsDataNode(COMMODITIES));
+		LoadGalaxy(systems, planets);
+		LoadGalaxy(referenceSystems, planets);
+		Economy economy;
+
+		WHEN( "both are stepped with the same random numbers" ) {
+			for(int day = 0; day < 5; ++day)
+			{
+				Random::Seed(day);
+				economy.Step(systems, trade);
+				Random::Seed(day);
+				ReferenceStep(referenceSystems, trade);
+			}
+			THEN( "the economy matches stepping each system on its own" ) {
+				CHECK( Supplies(systems) == Supplies(referenceSystems) );
+				CHECK( systems.Get("A")->Trade("Food") == referenceSystems.Get("A")->Trade("Food") );
+				CHECK( systems.Get("B")->Trade("Widgets") == referenceSystems.Get("B")->Trade("Widgets") );
+			}
+			THEN( "goods that a system does not trade stay at zero" ) {
+				CHECK( systems.Get("B")->Supply("Plastic") == 0. );
+				CHECK( systems.Get("D")->Supply("Metal") == 0. );
+			}
+		}
+
+		WHEN( "a link is removed after the economy has been stepped" ) {
+			Random::Seed(0);
+			economy.Step(systems, trade);
+			Random::Seed(0);
+			ReferenceStep(referenceSystems, trade);
+
+			systems.Get("A")->Unlink(systems.Get("B"));
+			referenceSystems.Get("A")->Unlink(referenceSystems.Get("B"));
+			UpdateGalaxy(systems);
+			UpdateGalaxy(referenceSystems);
+			economy.Invalidate();
+			Random::Seed(1);
+			economy.Step(systems, trade);
+			Random::Seed(1);
+			ReferenceStep(referenceSystems, trade);
+			THEN( "the economy follows the new links" ) {
+				CHECK( Supplies(systems) == Supplies(referenceSystems) );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,132 @@
+/* test_fastForward.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/FastForward.h"
+
+// Include a helper for creating well-formed DataNodes.
+#include "datanode-factory.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../source/Date.h"
+#include "../../../source/GameData.h"
+#include "../../../source/GameEvent.h"
+#include "../../../source/Planet.h"
+#include "../../../source/PlayerInfo.h"
+#include "../../../source/Set.h"
+#include "../../../source/Ship.h"
+#include "../../../source/StartConditions.h"
+
+#include <string>
+
+namespace { // test namespace
+
+// #region mock data
+const std::string GALAXY = R"(
+planet "Fast Forward Prime"
+system "Fast Forward"
+	pos 0 0
+	object "Fast Forward Prime"
+)";
+
+const std::string START = R"(
+start
+	date 16 11 3013
+	system "Fast Forward"
+	planet "Fast Forward Prime"
+)";
+
+// An event that marks the planet it changes, so that it can be seen to have happened.
+const std::string EVENT = R"(
+event "fast forward test"
+	planet "Fast Forward Prime"
+		add attributes "fast forwarded"
+)";
+
+const Planet &TestPlanet()
+{
+	return *GameData::Planets().Get("Fast Forward Prime");
+}
+
+// Create a new pilot in the test galaxy. Starting a pilot reverts the universe
+// to how it was when loading finished, so the galaxy must be added before that.
+void StartPilot(PlayerInfo &player)
+{
+	for(const DataNode &node : AsDataNodes(GALAXY))
+		GameData::Change(node, player);
+	GameData::FinishLoading();
+	const StartConditions start(AsDataNode(START), nullptr, &player.Conditions());
+	player.New(start);
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Advancing a pilot by whole days", "[FastForward]" ) {
+	GIVEN( "a new pilot" ) {
+		PlayerInfo player;
+		StartPilot(player);
+		const Date start = player.GetDate();
+		REQUIRE( start == Date(16, 11, 3013) );
+
+		WHEN( "it is advanced by a number of days" ) {
+			const FastForward::Timings timings = FastForward::Run(player, 10);
+			THEN( "the date moves forward by that many days" ) {
+				CHECK( timings.days == 10 );
+				CHECK( player.GetDate() == start + 10 );
+			}
+		}
+		WHEN( "it is advanced by no days" ) {
+			const FastForward::Timings timings = FastForward::Run(player, 0);
+			THEN( "nothing happens" ) {
+				CHECK( timings.days == 0 );
+				CHECK( player.GetDate() == start );
+			}
+		}
+		WHEN( "an event is scheduled a few days later" ) {
+			player.AddEvent(GameEvent(AsDataNode(EVENT), &player.Conditions()), start + 3);
+			REQUIRE_FALSE( TestPlanet().Attributes().contains("fast forwarded") );
+
+			THEN( "it has not happened before that day" ) {
+				FastForward::Run(player, 2);
+				CHECK_FALSE( TestPlanet().Attributes().contains("fast forwarded") );
+			}
+			THEN( "it happens once that day is reached" ) {
+				FastForward::Run(player, 3);
+				CHECK( TestPlanet().Attributes().contains("fast forwarded") );
+			}
+
+			// Undo the event's changes to the global game data.
+			GameData::Change(AsDataNode("planet \"Fast Forward Prime\"\n\tremove attributes \"fast forwarded\""),
+				player);
+		}
+		WHEN( "the pilot is dead" ) {
+			player.Die();
+			const FastForward::Timings timings = FastForward::Run(player, 10);
+			THEN( "no days are advanced" ) {
+				CHECK( timings.days == 0 );
+				CHECK( player.GetDate() == start );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
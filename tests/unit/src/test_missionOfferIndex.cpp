@@ -0,0 +1,209 @@
+/* test_missionOfferIndex.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/MissionOfferIndex.h"
+
+// Include a helper for creating well-formed DataNodes.
+#include "datanode-factory.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../source/GameData.h"
+#include "../../../source/LocationFilter.h"
+#include "../../../source/Mission.h"
+#include "../../../source/Planet.h"
+#include "../../../source/PlayerInfo.h"
+#include "../../../source/Set.h"
+
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// Two systems of two planets each, with different governments and attributes.
+const std::string GALAXY = R"(
+government Republic
+government Pirate
+planet "Alpha I"
+	attributes farming
+planet "Alpha II"
+	attributes mining
+planet "Beta I"
+	attributes urban
+	government Republic
+planet "Beta II"
+system Alpha
+	pos 0 0
+	government Republic
+	object "Alpha I"
+	object "Alpha II"
+system Beta
+	pos 100 0
+	government Pirate
+	object "Beta I"
+	object "Beta II"
+)";
+
+// Missions filed under each kind of bucket, and one that is not offered when
+// landing. Each filter has only one part, so that the index finds no more
+// missions than a full scan does.
+const std::string MISSIONS = R"(
+mission "By Planet"
+	source "Alpha I"
+mission "By Planets"
+	source
+		planet "Alpha II" "Beta I"
+mission "By System"
+	source
+		system Beta
+mission "By Government"
+	source
+		government Republic
+mission "By Attribute"
+	source
+		attributes farming urban
+mission "Anywhere"
+mission "Boarding"
+	boarding
+	source
+		government Pirate
+)";
+
+const std::vector<std::string> PLANETS = {"Alpha I", "Alpha II", "Beta I", "Beta II"};
+
+void ApplyChanges(const std::string &text, PlayerInfo &player)
+{
+	for(const DataNode &node : AsDataNodes(text))
+		GameData::Change(node, player);
+}
+
+void LoadMissions(Set<Mission> &missions, const PlayerInfo &player)
+{
+	for(const DataNode &node : AsDataNodes(MISSIONS))
+		missions.Get(node.Token(1))->Load(node, &player.Conditions(), &player.VisitedSystems(), &player.VisitedPlanets());
+}
+
+std::vector<std::string> Names(const std::vector<const Mission *> &missions)
+{
+	std::vector<std::string> names;
+	for(const Mission *mission : missions)
+		names.push_back(mission->TrueName());
+	return names;
+}
+
+// Check every landing mission against the planet, as CreateMissions did before
+// it had an index.
+std::vector<std::string> Scan(const Set<Mission> &missions, const Planet *planet)
+{
+	std::vector<std::string> names;
+	for(const auto &it : missions)
+	{
+		const Mission &mission = it.second;
+		if(mission.IsAtLocation(Mission::BOARDING) || mission.IsAtLocation(Mission::ASSISTING)
+				|| mission.IsAtLocation(Mission::ENTERING))
+			continue;
+		if(mission.SourcePlanet() && mission.SourcePlanet() != planet)
+			continue;
+		if(mission.SourceFilter().Matches(planet))
+			names.push_back(mission.TrueName());
+	}
+	return names;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Finding the missions that may be offered on a planet", "[MissionOfferIndex]" ) {
+	PlayerInfo player;
+	ApplyChanges(GALAXY, player);
+	Set<Mission> missions;
+	LoadMissions(missions, player);
+	for(const std::string &name : PLANETS)
+		REQUIRE( GameData::Planets().Get(name)->IsValid() );
+
+	GIVEN( "an index of missions filed in each way" ) {
+		MissionOfferIndex index;
+		index.Build(missions);
+
+		THEN( "each planet gets exactly the missions that a full scan finds" ) {
+			for(const std::string &name : PLANETS)
+			{
+				const Planet *planet = GameData::Planets().Get(name);
+				CHECK( Names(index.Candidates(planet)) == Scan(missions, planet) );
+			}
+			CHECK( Names(index.Candidates(GameData::Planets().Get("Alpha I"))) == std::vector<std::string>{
+				"Anywhere", "By Attribute", "By Government", "By Planet"} );
+			CHECK( Names(index.Candidates(GameData::Planets().Get("Beta II"))) == std::vector<std::string>{
+				"Anywhere", "By System"} );
+		}
+		THEN( "without a planet, every landing mission is a candidate" ) {
+			CHECK( Names(index.Candidates(nullptr)) == std::vector<std::string>{"Anywhere", "By Attribute",
+				"By Government", "By Planet", "By Planets", "By System"} );
+		}
+
+		WHEN( "events change a planet's government and attributes" ) {
+			ApplyChanges(R"(
+planet "Beta II"
+	government Republic
+	add attributes farming
+planet "Alpha II"
+	government Pirate
+	remove attributes mining
+	add attributes urban
+planet "Beta I"
+	add attributes mining
+	government Pirate
+)", player);
+			THEN( "the candidates still match a full scan" ) {
+				for(const std::string &name : PLANETS)
+				{
+					const Planet *planet = GameData::Planets().Get(name);
+					CHECK( Names(index.Candidates(planet)) == Scan(missions, planet) );
+				}
+				CHECK( Names(index.Candidates(GameData::Planets().Get("Beta II"))) == std::vector<std::string>{
+					"Anywhere", "By Attribute", "By Government", "By System"} );
+			}
+		}
+		WHEN( "the index is built again" ) {
+			const int version = index.Version();
+			index.Build(missions);
+			THEN( "its version changes" ) {
+				CHECK( index.Version() != version );
+			}
+		}
+	}
+
+	// Undo the changes to the global game data.
+	ApplyChanges(R"(
+planet "Alpha II"
+	remove government
+	attributes mining
+planet "Beta I"
+	attributes urban
+	government Republic
+planet "Beta II"
+	remove government
+	remove attributes
+)", player);
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,129 @@
+/* test_projectilePool.cpp
+Copyright (c) 2025 by Endless Sky Development Team
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/ProjectilePool.h"
+
+// Include a helper for creating well-formed DataNodes.
+#include "datanode-factory.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../source/Angle.h"
+#include "../../../source/Point.h"
+#include "../../../source/Random.h"
+#include "../../../source/Ship.h"
+#include "../../../source/Visual.h"
+#include "../../../source/Weapon.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+Weapon LoadWeapon(const std::string &text)
+{
+	Weapon weapon;
+	weapon.Load(AsDataNode(text));
+	return weapon;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Moving projectiles in a pool", "[projectilePool]" ) {
+	const Weapon ballistic = LoadWeapon("weapon\n\tvelocity 10\n\tlifetime 3");
+	const Weapon accelerating = LoadWeapon("weapon\n\tvelocity 10\n\tacceleration 1\n\tlifetime 3");
+	const Ship ship;
+	std::vector<Visual> visuals;
+	std::vector<Projectile> spawned;
+
+	GIVEN( "projectiles with and without acceleration" ) {
+		ProjectilePool pool;
+		pool.Add(Projectile(ship, Point(0., 0.), Angle(90.), &ballistic));
+		pool.Add(Projectile(ship, Point(0., 0.), Angle(90.), &accelerating));
+		REQUIRE( pool.size() == 2 );
+		CHECK( pool[0].IsBallistic() );
+		CHECK_FALSE( pool[1].IsBallistic() );
+
+		// Move copies of the projectiles one at a time, for comparison.
+		std::vector<Projectile> expected(pool.begin(), pool.end());
+
+		WHEN( "they are moved" ) {
+			pool.Move(visuals, spawned);
+			for(Projectile &projectile : expected)
+				projectile.Move(visuals, spawned);
+
+			THEN( "each moves as it would on its own" ) {
+				for(size_t i = 0; i < pool.size(); ++i)
+				{
+					CHECK( pool[i].Position().X() == expected[i].Position().X() );
+					CHECK( pool[i].Position().Y() == expected[i].Position().Y() );
+					CHECK( pool[i].DistanceTraveled() == expected[i].DistanceTraveled() );
+					CHECK( pool[i].Velocity().X() == expected[i].Velocity().X() );
+					CHECK( pool[i].Velocity().Y() == expected[i].Velocity().Y() );
+				}
+			}
+		}
+		WHEN( "they are moved from the same random seed" ) {
+			Random::Seed(42);
+			pool.Move(visuals, spawned);
+			const uint32_t afterPool = Random::Int();
+			Random::Seed(42);
+			for(Projectile &projectile : expected)
+				projectile.Move(visuals, spawned);
+			const uint32_t afterEach = Random::Int();
+
+			THEN( "the same random numbers are used" ) {
+				CHECK( afterPool == afterEach );
+			}
+		}
+		WHEN( "their lifetime runs out" ) {
+			for(int i = 0; i < 3; ++i)
+				pool.Move(visuals, spawned);
+			pool.Prune();
+
+			THEN( "they are removed" ) {
+				CHECK( pool.empty() );
+			}
+		}
+	}
+	GIVEN( "a pool in which only the first projectile is dead" ) {
+		ProjectilePool pool;
+		pool.Add(Projectile(ship, Point(0., 0.), Angle(0.), &ballistic));
+		pool.Add(Projectile(ship, Point(100., 0.), Angle(0.), &ballistic));
+		pool.Add(Projectile(ship, Point(200., 0.), Angle(0.), &ballistic));
+		pool[0].Kill();
+		pool.Move(visuals, spawned);
+
+		WHEN( "it is pruned" ) {
+			pool.Prune();
+
+			THEN( "the last projectile takes the dead one's place" ) {
+				REQUIRE( pool.size() == 2 );
+				CHECK( pool[0].Position().X() == 200. );
+				CHECK( pool[1].Position().X() == 100. );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace